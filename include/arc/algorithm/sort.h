@@ -0,0 +1,100 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @addtogroup Sort
+ * @{
+ *
+ * @author Anil M. Mahtani Mirchandani
+ * @date September, 2015
+ * @ingroup Algorithm
+ *
+ * @brief Sorting of plain arrays
+ *
+ * arc_sort is an introsort: a quicksort with a median of three pivot which
+ * switches to heapsort if the recursion gets too deep, and finishes the
+ * small partitions with insertion sort. When the comparison function is one
+ * of arc_cmp_int, arc_cmp_uint, arc_cmp_long, arc_cmp_ulong, arc_cmp_float or
+ * arc_cmp_double and the element has the size of that type, a version for
+ * that type is used which compares the elements directly.
+ *
+ * arc_radix_sort is a stable LSD radix sort over the unsigned keys returned
+ * by a key function, such as arc_key_int or arc_key_double.
+ *
+ * arc_parallel_sort is a sample sort running on a thread pool: one chunk per
+ * thread is sorted with arc_sort, the chunks are split by splitters taken
+ * from samples of every chunk and each part is merged from all the chunks
+ * by a different thread.
+ */
+#ifndef ARC_SORT_H_
+#define ARC_SORT_H_
+
+#include <stdlib.h>
+#include <arc/type/function.h>
+#include <arc/thread/pool.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/** @brief Fewest elements per thread sorted by arc_parallel_sort */
+#define ARC_PARALLEL_SORT_MIN_CHUNK 4096
+
+/**
+ * @brief Sorts an array in ascending order, the sort is not stable
+ *
+ * @param[in] base First element of the array
+ * @param[in] num Number of elements
+ * @param[in] size Size of each element
+ * @param[in] cmp_fn Comparison function, NULL compares the bytes with memcmp
+ */
+void arc_sort(void * base, size_t num, size_t size, arc_cmp_fn_t cmp_fn);
+/**
+ * @brief Sorts an array by the keys of its elements, the sort is stable
+ *
+ * The keys are extracted once per element and sorted one byte at a time,
+ * bytes which are the same for every key are skipped. It needs memory for a
+ * copy of the array and two keys per element.
+ *
+ * @param[in] base First element of the array
+ * @param[in] num Number of elements
+ * @param[in] size Size of each element
+ * @param[in] key_fn Key extraction function
+ * @retval ARC_SUCCESS If the array was sorted
+ * @retval ARC_OUT_OF_MEMORY If memory could not be allocated, the array is
+ * left untouched
+ */
+int arc_radix_sort(void * base, size_t num, size_t size, arc_key_fn_t key_fn);
+/**
+ * @brief Sorts an array in ascending order using the threads of a pool, the
+ * sort is not stable
+ *
+ * Small arrays, or pools with a single thread, are sorted by the caller with
+ * arc_sort. It needs memory for a copy of the array. It waits for the pool,
+ * so it must not be called from one of its tasks, nor while other tasks are
+ * being submitted to it.
+ *
+ * @param[in] base First element of the array
+ * @param[in] num Number of elements
+ * @param[in] size Size of each element
+ * @param[in] cmp_fn Comparison function, NULL compares the bytes with memcmp
+ * @param[in] pool Pool whose threads sort the array
+ * @retval ARC_SUCCESS If the array was sorted
+ * @retval ARC_OUT_OF_MEMORY If memory could not be allocated, the array is
+ * left untouched
+ */
+int arc_parallel_sort(void * base, size_t num, size_t size,
+                      arc_cmp_fn_t cmp_fn, arc_pool_t pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARC_SORT_H_ */
+
+/** @} */
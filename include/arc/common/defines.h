@@ -37,7 +37,7 @@
 extern "C"{
 #endif
 
-#ifdef ARC_C99
+#if defined(ARC_C99) || defined(__cplusplus)
 # include <stdint.h>
 #else
 /** @brief Maximum size of size_t type */
@@ -59,6 +59,22 @@ extern "C"{
 /** @brief Used to mark variables as unused */
 #define ARC_UNUSED(x) (void)(x)
 
+/** @brief Hints the processor to bring the memory at addr into the cache */
+#ifdef __GNUC__
+# define ARC_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+# define ARC_PREFETCH(addr) (void)(addr)
+#endif
+
+/** @brief Suggests the compiler to inline a function, C89 has no keyword */
+#if defined(__cplusplus) || defined(ARC_C99)
+# define ARC_INLINE inline
+#elif defined(__GNUC__)
+# define ARC_INLINE __inline__
+#else
+# define ARC_INLINE
+#endif
+
 #ifndef NDEBUG
 #define ARC_DEBUG(fmt) printf(fmt);fflush(stdout);
 #define ARC_DEBUG1(fmt,param1) printf(fmt,param1);fflush(stdout);
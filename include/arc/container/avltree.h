@@ -31,7 +31,9 @@
 #define ARC_AVLTREE_H_
 
 #include <stdlib.h>
+#include <arc/memory/allocator.h>
 #include <arc/type/function.h>
+#include <arc/thread/pool.h>
 
 #ifdef __cplusplus
 extern "C"{
@@ -54,6 +56,33 @@ typedef struct arc_tree_iterator * arc_avltree_iterator_t;
  * @retval NULL if memory cannot be allocated
  */
 arc_avltree_t arc_avltree_create(size_t data_size, arc_cmp_fn_t cmp_fn);
+/**
+ * @brief Creates a new avltree whose nodes are allocated with the given
+ * allocator
+ *
+ * @param[in] data_size Size of the data element
+ * @param[in] cmp_fn Comparison function for the data type
+ * @param[in] allocator Allocator for the nodes, NULL for the default one
+ * @return New empty avltree
+ * @retval NULL if memory cannot be allocated
+ */
+arc_avltree_t
+arc_avltree_create_with_allocator(size_t data_size,
+                                  arc_cmp_fn_t cmp_fn,
+                                  const struct arc_allocator *allocator);
+/**
+ * @brief Creates a new avltree whose nodes are allocated from its own pool
+ *
+ * The nodes are carved out of large chunks which are kept until the avltree is
+ * destroyed, so inserting and removing elements rarely calls malloc and the
+ * nodes are stored close to each other.
+ *
+ * @param[in] data_size Size of the data element
+ * @param[in] cmp_fn Comparison function for the data type
+ * @return New empty avltree
+ * @retval NULL if memory cannot be allocated
+ */
+arc_avltree_t arc_avltree_create_pooled(size_t data_size, arc_cmp_fn_t cmp_fn);
 /**
  * @brief Destroys the memory associated to a avltree
  *
@@ -70,6 +99,184 @@ void arc_avltree_destroy(arc_avltree_t avltree);
  * @retval ARC_OUT_OF_MEMORY If memory could not be allocated
  */
 int arc_avltree_insert(arc_avltree_t avltree, const void * data);
+/**
+ * @brief Builds the avltree from sorted elements in linear time
+ *
+ * The nodes are linked into a perfectly balanced tree with their balance
+ * factors set directly, no rotation takes place. The nodes of a pooled
+ * avltree are allocated in a single block.
+ *
+ * @param[in] avltree Empty binary search tree to perform the operation on
+ * @param[in] data Array of n contiguous data elements in strictly increasing
+ *                 order
+ * @param[in] n Number of elements
+ * @retval ARC_SUCCESS If the elements were inserted successfully
+ * @retval ARC_ERROR If the avltree is not empty or the elements are not in
+ * strictly increasing order, nothing is inserted
+ * @retval ARC_OUT_OF_MEMORY If memory could not be allocated, nothing is
+ * inserted
+ */
+int arc_avltree_build_sorted(arc_avltree_t avltree, const void * data,
+                             size_t n);
+/**
+ * @brief Inserts sorted elements into the avltree in linear time
+ *
+ * The elements are merged with the ones of the avltree and every node is
+ * relinked into a perfectly balanced tree, so it takes time proportional to
+ * the size of the avltree plus n. The elements which are already in the
+ * avltree are skipped. When n is much smaller than the size of the avltree,
+ * inserting the elements one by one is faster.
+ *
+ * @param[in] avltree Binary search tree to perform the operation on
+ * @param[in] data Array of n contiguous data elements in increasing order
+ * @param[in] n Number of elements
+ * @retval ARC_SUCCESS If the elements were inserted successfully
+ * @retval ARC_ERROR If the elements are not in increasing order, nothing is
+ * inserted
+ * @retval ARC_OUT_OF_MEMORY If memory could not be allocated, nothing is
+ * inserted
+ */
+int arc_avltree_insert_sorted(arc_avltree_t avltree, const void * data,
+                              size_t n);
+/**
+ * @brief Moves every element of right to the end of left
+ *
+ * Every element of left must be less than every element of right. No node
+ * is copied or reallocated, both trees are joined in logarithmic time, so
+ * they must use the same allocator (pooled avltrees have one of their own).
+ *
+ * @param[in] left Binary search tree which receives the elements
+ * @param[in] right Binary search tree which is left empty
+ * @retval ARC_SUCCESS If the avltrees were joined successfully
+ * @retval ARC_ERROR If the avltrees hold different types or use different
+ * allocators, or if the elements are not in order. Nothing is moved
+ */
+int arc_avltree_join(arc_avltree_t left, arc_avltree_t right);
+/**
+ * @brief Moves the elements less than the key to left and those greater
+ * than the key to right
+ *
+ * The element equal to the key, if any, stays in the avltree. No node is
+ * copied or reallocated and it takes logarithmic time, so the three avltrees
+ * must use the same allocator.
+ *
+ * @param[in] avltree Binary search tree to perform the operation on
+ * @param[in] key Data element to split by
+ * @param[in] left Empty binary search tree
+ * @param[in] right Empty binary search tree
+ * @retval ARC_SUCCESS If the avltree was split successfully
+ * @retval ARC_ERROR If left or right are not empty, hold a different type or
+ * use a different allocator. Nothing is moved
+ */
+int arc_avltree_split(arc_avltree_t avltree, const void * key,
+                      arc_avltree_t left, arc_avltree_t right);
+/**
+ * @brief Moves the elements of other into the avltree
+ *
+ * The nodes of other are relinked into the avltree, so both must use the
+ * same allocator. When an element is in both, the one of the avltree is
+ * kept. With m the size of the smaller avltree and n the size of the larger
+ * one, it takes time proportional to m log(n/m + 1).
+ *
+ * @param[in] avltree Binary search tree to perform the operation on
+ * @param[in] other Binary search tree which is left empty
+ * @retval ARC_SUCCESS If the elements were moved successfully
+ * @retval ARC_ERROR If the avltrees hold different types or use different
+ * allocators. Nothing is moved
+ */
+int arc_avltree_union(arc_avltree_t avltree, arc_avltree_t other);
+/**
+ * @brief Removes the elements of the avltree which are not in other
+ *
+ * Other is left as it is. It takes time proportional to m log(n/m + 1), with
+ * m the size of the smaller avltree and n the size of the larger one.
+ *
+ * @param[in] avltree Binary search tree to perform the operation on
+ * @param[in] other Binary search tree holding the elements to keep
+ * @retval ARC_SUCCESS If the operation was performed successfully
+ * @retval ARC_ERROR If the avltrees hold different types
+ */
+int arc_avltree_intersection(arc_avltree_t avltree, arc_avltree_t other);
+/**
+ * @brief Removes the elements of the avltree which are in other
+ *
+ * Other is left as it is. It takes time proportional to m log(n/m + 1), with
+ * m the size of the smaller avltree and n the size of the larger one.
+ *
+ * @param[in] avltree Binary search tree to perform the operation on
+ * @param[in] other Binary search tree holding the elements to remove
+ * @retval ARC_SUCCESS If the operation was performed successfully
+ * @retval ARC_ERROR If the avltrees hold different types
+ */
+int arc_avltree_difference(arc_avltree_t avltree, arc_avltree_t other);
+/**
+ * @brief Same as arc_avltree_build_sorted, with the threads of a pool
+ * building separate subtrees
+ *
+ * The nodes are allocated from the threads of the pool, so the allocator of
+ * the avltree must be thread safe. A pooled avltree takes them from a single
+ * block allocated beforehand.
+ *
+ * @param[in] avltree Empty binary search tree to perform the operation on
+ * @param[in] data Array of n contiguous data elements in strictly increasing
+ *                 order
+ * @param[in] n Number of elements
+ * @param[in] pool Threads to use, NULL to use just the calling thread
+ * @retval ARC_SUCCESS If the elements were inserted successfully
+ * @retval ARC_ERROR If the avltree is not empty or the elements are not in
+ * strictly increasing order, nothing is inserted
+ * @retval ARC_OUT_OF_MEMORY If memory could not be allocated, nothing is
+ * inserted
+ */
+int arc_avltree_parallel_build_sorted(arc_avltree_t avltree,
+                                      const void * data, size_t n,
+                                      arc_pool_t pool);
+/**
+ * @brief Same as arc_avltree_union, with the threads of a pool merging
+ * separate subtrees
+ *
+ * The repeated nodes are released from the threads of the pool, so the
+ * allocator must be thread safe.
+ *
+ * @param[in] avltree Binary search tree to perform the operation on
+ * @param[in] other Binary search tree which is left empty
+ * @param[in] pool Threads to use, NULL to use just the calling thread
+ * @retval ARC_SUCCESS If the elements were moved successfully
+ * @retval ARC_ERROR If the avltrees hold different types or use different
+ * allocators. Nothing is moved
+ */
+int arc_avltree_parallel_union(arc_avltree_t avltree, arc_avltree_t other,
+                               arc_pool_t pool);
+/**
+ * @brief Same as arc_avltree_intersection, with the threads of a pool
+ * filtering separate subtrees
+ *
+ * The removed nodes are released from the threads of the pool, so the
+ * allocator must be thread safe. A pooled avltree is filtered by the calling
+ * thread alone.
+ *
+ * @param[in] avltree Binary search tree to perform the operation on
+ * @param[in] other Binary search tree holding the elements to keep
+ * @param[in] pool Threads to use, NULL to use just the calling thread
+ * @retval ARC_SUCCESS If the operation was performed successfully
+ * @retval ARC_ERROR If the avltrees hold different types
+ */
+int arc_avltree_parallel_intersection(arc_avltree_t avltree,
+                                      arc_avltree_t other, arc_pool_t pool);
+/**
+ * @brief Same as arc_avltree_difference, with the threads of a pool
+ * filtering separate subtrees
+ *
+ * The same restrictions as in arc_avltree_parallel_intersection apply.
+ *
+ * @param[in] avltree Binary search tree to perform the operation on
+ * @param[in] other Binary search tree holding the elements to remove
+ * @param[in] pool Threads to use, NULL to use just the calling thread
+ * @retval ARC_SUCCESS If the operation was performed successfully
+ * @retval ARC_ERROR If the avltrees hold different types
+ */
+int arc_avltree_parallel_difference(arc_avltree_t avltree,
+                                    arc_avltree_t other, arc_pool_t pool);
 /**
  * @brief Finds an element in the avltree
  *
@@ -79,6 +286,45 @@ int arc_avltree_insert(arc_avltree_t avltree, const void * data);
  * @retval 1 If the element was found
  */
 void *arc_avltree_retrieve(arc_avltree_t avltree, const void * data);
+/**
+ * @brief Finds several elements in the avltree at once
+ *
+ * The lookups are interleaved so that the memory accesses of the different
+ * searches overlap, which is faster than calling arc_avltree_retrieve on every
+ * key when the tree doesn't fit in the cache.
+ *
+ * @param[in] avltree Binary search tree to perform the operation on
+ * @param[in] keys Array of n contiguous data elements to be found
+ * @param[in] n Number of elements to be found
+ * @param[out] results Array of n pointers, filled with the element found for
+ *                     every key or NULL if it's not in the avltree
+ * @return Number of elements found
+ */
+size_t arc_avltree_retrieve_batch(arc_avltree_t avltree, const void * keys,
+                                  size_t n, void **results);
+/**
+ * @brief Returns the element at the given position in the order of the
+ * avltree
+ *
+ * Every node keeps the size of its subtree, so it takes logarithmic time.
+ *
+ * @param[in] avltree Binary search tree to perform the operation on
+ * @param[in] k Position of the element, from 0 to the size minus one
+ * @return Data pointer of the element
+ * @retval NULL If k is not smaller than the size of the avltree
+ */
+void *arc_avltree_select(arc_avltree_t avltree, size_t k);
+/**
+ * @brief Returns the number of elements which are less than the given one
+ *
+ * It is the position of the element if it's in the avltree, or the position
+ * it would have after inserting it. It takes logarithmic time.
+ *
+ * @param[in] avltree Binary search tree to perform the operation on
+ * @param[in] data Data element to compare with
+ * @return Number of elements less than data
+ */
+size_t arc_avltree_rank(arc_avltree_t avltree, const void * data);
 /**
  * @brief Returns whether the avltree is empty or not
  *
@@ -172,6 +418,66 @@ void * arc_avltree_data(arc_avltree_iterator_t it);
  * @retval 1 If the avltree is empty
  */
 int arc_avltree_position(arc_avltree_iterator_t it, const void * data);
+/**
+ * @brief Sets an iterator to the element at the given position (see
+ * arc_avltree_select)
+ *
+ * @param[in] it Iterator
+ * @param[in] k Position of the element, from 0 to the size minus one
+ * @retval 0 If k is not smaller than the size, the iterator is set after the
+ * end
+ * @retval 1 If the current element is in the avltree
+ */
+int arc_avltree_position_select(arc_avltree_iterator_t it, size_t k);
+/**
+ * @brief Sets an iterator to the first element which is not less than the
+ * given one
+ *
+ * @param[in] it Iterator
+ * @param[in] data Data element to compare with
+ * @retval 0 If every element is less, the iterator is set after the end
+ * @retval 1 If the current element is in the avltree
+ */
+int arc_avltree_lower_bound(arc_avltree_iterator_t it, const void * data);
+/**
+ * @brief Sets an iterator to the first element which is greater than the
+ * given one
+ *
+ * @param[in] it Iterator
+ * @param[in] data Data element to compare with
+ * @retval 0 If no element is greater, the iterator is set after the end
+ * @retval 1 If the current element is in the avltree
+ */
+int arc_avltree_upper_bound(arc_avltree_iterator_t it, const void * data);
+/**
+ * @brief Sets an iterator to the first element of the range [first, last)
+ *
+ * Together with arc_avltree_range_next it visits the elements of the range
+ * without looking at the rest:
+ *
+ * @code
+ * for (found = arc_avltree_range(it, &first, &last); found;
+ *      found = arc_avltree_range_next(it, &last))
+ * @endcode
+ *
+ * @param[in] it Iterator
+ * @param[in] first Smallest element of the range
+ * @param[in] last Element after the range, it is not part of it
+ * @retval 0 If the range is empty
+ * @retval 1 If the current element is in the range
+ */
+int arc_avltree_range(arc_avltree_iterator_t it, const void * first,
+                      const void * last);
+/**
+ * @brief Sets the iterator to the next node if it is still in the range
+ * (see arc_avltree_range)
+ *
+ * @param[in] it Iterator
+ * @param[in] last Element after the range, it is not part of it
+ * @retval 0 If the end of the range has been reached
+ * @retval 1 If the current element is in the range
+ */
+int arc_avltree_range_next(arc_avltree_iterator_t it, const void * last);
 /**
  * @brief Removes the iterator position from the avltree
  *
@@ -0,0 +1,475 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @addtogroup AVLTree
+ * @{
+ *
+ * @brief C++ ordered set based on the AVL tree
+ *
+ * arc::avl_set<T, Cmp> stores its nodes with the layout of struct
+ * arc_avltree_node, so the rebalancing and the removal of nodes are shared
+ * with the C avltree. The element is constructed in place inside the node and
+ * the comparator is a template parameter, so it's inlined in the searches.
+ *
+ * As the rest of the library it doesn't throw, the functions which allocate
+ * memory return ARC_SUCCESS, ARC_DUPLICATE or ARC_OUT_OF_MEMORY.
+ */
+
+#ifndef ARC_AVLTREE_HPP_
+#define ARC_AVLTREE_HPP_
+
+#if __cplusplus < 201103L
+# error "arc/container/avltree.hpp requires C++11"
+#endif
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <arc/common/defines.h>
+#include <arc/memory/allocator.h>
+#include <arc/container/avltree.h>
+
+extern "C" {
+#include <arc/container/tree_def.h>
+#include <arc/container/avltree_def.h>
+}
+
+namespace arc {
+
+/**
+ * @brief Ordered set of unique elements of type T
+ *
+ * Cmp is a strict weak ordering as in the standard containers, it returns
+ * true if the first argument goes before the second one.
+ */
+template <typename T, typename Cmp = std::less<T> >
+class avl_set
+{
+    /* Same layout as struct arc_avltree_node up to the data */
+    struct node
+    {
+        node *parent;
+        node *left;
+        node *right;
+        int balance_factor;
+        size_t count;
+        T data;
+    };
+
+public:
+    typedef T value_type;
+
+    /**
+     * @brief Iterator through the elements in order
+     */
+    class iterator
+    {
+    public:
+        iterator(const avl_set *set, node *n) : m_set(set), m_node(n) {}
+
+        const T &operator*() const { return m_node->data; }
+        const T *operator->() const { return &m_node->data; }
+
+        iterator &operator++()
+        {
+            m_node = successor(m_node);
+            return *this;
+        }
+
+        iterator &operator--()
+        {
+            m_node = (m_node == NULL ? m_set->max_node() :
+                                       predecessor(m_node));
+            return *this;
+        }
+
+        bool operator==(const iterator &other) const
+        {
+            return m_node == other.m_node;
+        }
+
+        bool operator!=(const iterator &other) const
+        {
+            return m_node != other.m_node;
+        }
+
+    private:
+        friend class avl_set;
+
+        static node *successor(node *n)
+        {
+            if (n->right != NULL)
+            {
+                n = n->right;
+
+                while (n->left != NULL)
+                {
+                    n = n->left;
+                }
+
+                return n;
+            }
+
+            while (n->parent != NULL && n->parent->right == n)
+            {
+                n = n->parent;
+            }
+
+            return n->parent;
+        }
+
+        static node *predecessor(node *n)
+        {
+            if (n->left != NULL)
+            {
+                n = n->left;
+
+                while (n->right != NULL)
+                {
+                    n = n->right;
+                }
+
+                return n;
+            }
+
+            while (n->parent != NULL && n->parent->left == n)
+            {
+                n = n->parent;
+            }
+
+            return n->parent;
+        }
+
+        const avl_set *m_set;
+        node *m_node;
+    };
+
+    typedef iterator const_iterator;
+
+    /**
+     * @brief Creates an empty set
+     *
+     * @param[in] allocator Allocator for the nodes, NULL for the default one
+     */
+    explicit avl_set(const struct arc_allocator *allocator = NULL)
+    {
+        arc_avltree_init_with_layout(&m_tree, sizeof(T),
+                                     offsetof(node, data), sizeof(node),
+                                     &avl_set::cmp_fn, allocator);
+    }
+
+    /**
+     * @brief Takes the nodes of other, which is left empty
+     */
+    avl_set(avl_set &&other) : m_tree(other.m_tree)
+    {
+        other.m_tree.root = NULL;
+        other.m_tree.size = 0;
+        other.m_tree.pool = NULL;
+    }
+
+    avl_set &operator=(avl_set &&other)
+    {
+        if (this != &other)
+        {
+            destroy_elements();
+            arc_avltree_fini(&m_tree);
+            m_tree = other.m_tree;
+            other.m_tree.root = NULL;
+            other.m_tree.size = 0;
+            other.m_tree.pool = NULL;
+        }
+
+        return *this;
+    }
+
+    avl_set(const avl_set &) = delete;
+    avl_set &operator=(const avl_set &) = delete;
+
+    ~avl_set()
+    {
+        destroy_elements();
+        arc_avltree_fini(&m_tree);
+    }
+
+    /**
+     * @brief Constructs a new element in place and inserts it into the set
+     *
+     * @retval ARC_SUCCESS If the element was inserted successfully
+     * @retval ARC_DUPLICATE If an equivalent element is already in the set
+     * @retval ARC_OUT_OF_MEMORY If memory could not be allocated
+     */
+    template <typename... Args>
+    int emplace(Args&&... args)
+    {
+        node *n = static_cast<node *>(ARC_ALLOC(&m_tree.allocator,
+                                                m_tree.node_size));
+        int retval;
+
+        if (n == NULL)
+        {
+            return ARC_OUT_OF_MEMORY;
+        }
+
+        new (&n->data) T(std::forward<Args>(args)...);
+
+        retval = link(n);
+
+        if (retval != ARC_SUCCESS)
+        {
+            n->data.~T();
+            ARC_FREE(&m_tree.allocator, n);
+        }
+
+        return retval;
+    }
+
+    /**
+     * @brief Inserts a copy of value into the set
+     *
+     * The node is only allocated if the value is not in the set yet.
+     *
+     * @retval ARC_SUCCESS If the element was inserted successfully
+     * @retval ARC_DUPLICATE If an equivalent element is already in the set
+     * @retval ARC_OUT_OF_MEMORY If memory could not be allocated
+     */
+    int insert(const T &value)
+    {
+        return insert_value(value);
+    }
+
+    /** @copydoc insert(const T &) */
+    int insert(T &&value)
+    {
+        return insert_value(std::move(value));
+    }
+
+    /**
+     * @brief Finds an element in the set
+     *
+     * @return Pointer to the element
+     * @retval NULL If the element is not in the set
+     */
+    const T *retrieve(const T &value) const
+    {
+        node *n = find_node(value);
+        return (n == NULL ? NULL : &n->data);
+    }
+
+    iterator find(const T &value) const
+    {
+        return iterator(this, find_node(value));
+    }
+
+    bool contains(const T &value) const
+    {
+        return find_node(value) != NULL;
+    }
+
+    /**
+     * @brief Removes an element from the set, if it's there
+     */
+    void remove(const T &value)
+    {
+        node *n = find_node(value);
+
+        if (n != NULL)
+        {
+            erase_node(n);
+        }
+    }
+
+    /**
+     * @brief Removes the element at the iterator position
+     *
+     * @return Iterator to the element following the removed one
+     */
+    iterator erase(iterator it)
+    {
+        node *n = it.m_node;
+        ++it;
+        erase_node(n);
+        return it;
+    }
+
+    /**
+     * @brief Destroys all the elements
+     */
+    void clear()
+    {
+        destroy_elements();
+        arc_avltree_clear(&m_tree);
+    }
+
+    iterator begin() const
+    {
+        return iterator(this, (m_tree.root == NULL ? NULL :
+                               reinterpret_cast<node *>(
+                                   arc_tree_min(m_tree.root))));
+    }
+
+    iterator end() const { return iterator(this, NULL); }
+
+    size_t size() const { return m_tree.size; }
+    bool empty() const { return m_tree.size == 0; }
+
+private:
+    /* Used by the generic functions of the tree */
+    static int cmp_fn(const void *a, const void *b)
+    {
+        const T &ta = *static_cast<const T *>(a);
+        const T &tb = *static_cast<const T *>(b);
+        Cmp cmp;
+
+        return (cmp(ta, tb) ? -1 : (cmp(tb, ta) ? 1 : 0));
+    }
+
+    node *max_node() const
+    {
+        return (m_tree.root == NULL ? NULL :
+                reinterpret_cast<node *>(arc_tree_max(m_tree.root)));
+    }
+
+    node *find_node(const T &value) const
+    {
+        node *n = reinterpret_cast<node *>(m_tree.root);
+
+        while (n != NULL)
+        {
+            if (m_cmp(value, n->data))
+            {
+                n = n->left;
+            }
+            else if (m_cmp(n->data, value))
+            {
+                n = n->right;
+            }
+            else
+            {
+                return n;
+            }
+        }
+
+        return NULL;
+    }
+
+    /* Searches for the parent of the new node, NULL if it's a duplicate */
+    node **find_ref(const T &value, node **parent)
+    {
+        node **ref = reinterpret_cast<node **>(&m_tree.root);
+        node *n = *ref;
+
+        *parent = NULL;
+
+        while (n != NULL)
+        {
+            if (m_cmp(value, n->data))
+            {
+                ref = &n->left;
+            }
+            else if (m_cmp(n->data, value))
+            {
+                ref = &n->right;
+            }
+            else
+            {
+                return NULL;
+            }
+
+            *parent = n;
+            n = *ref;
+        }
+
+        return ref;
+    }
+
+    void attach(node *n, node *parent, node **ref)
+    {
+        n->parent = parent;
+        n->left = NULL;
+        n->right = NULL;
+        n->balance_factor = 0;
+        *ref = n;
+
+        arc_avltree_insert_fixup(&m_tree,
+                                 reinterpret_cast<struct arc_tree_snode *>(n));
+    }
+
+    int link(node *n)
+    {
+        node *parent;
+        node **ref = find_ref(n->data, &parent);
+
+        if (ref == NULL)
+        {
+            return ARC_DUPLICATE;
+        }
+
+        attach(n, parent, ref);
+
+        return ARC_SUCCESS;
+    }
+
+    template <typename U>
+    int insert_value(U &&value)
+    {
+        node *parent, *n;
+        node **ref = find_ref(value, &parent);
+
+        if (ref == NULL)
+        {
+            return ARC_DUPLICATE;
+        }
+
+        n = static_cast<node *>(ARC_ALLOC(&m_tree.allocator, m_tree.node_size));
+
+        if (n == NULL)
+        {
+            return ARC_OUT_OF_MEMORY;
+        }
+
+        new (&n->data) T(std::forward<U>(value));
+        attach(n, parent, ref);
+
+        return ARC_SUCCESS;
+    }
+
+    void erase_node(node *n)
+    {
+        n->data.~T();
+        (*m_tree.remove_fn)(&m_tree,
+                            reinterpret_cast<struct arc_tree_snode *>(n));
+    }
+
+    void destroy_elements()
+    {
+        if (!std::is_trivially_destructible<T>::value)
+        {
+            iterator it = begin();
+
+            while (it != end())
+            {
+                node *n = it.m_node;
+                ++it;
+                n->data.~T();
+            }
+        }
+    }
+
+    struct arc_tree m_tree;
+    Cmp m_cmp;
+};
+
+} /* namespace arc */
+
+#endif /* ARC_AVLTREE_HPP_ */
+
+/** @} */
@@ -0,0 +1,223 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @addtogroup BPTree
+ * @{
+ *
+ * @author Anil M. Mahtani Mirchandani
+ * @date December, 2015
+ * @ingroup Container
+ *
+ * @brief B+ Tree
+ *
+ * A B+ tree is a balanced search tree with a high branching factor. Every node
+ * spans a few cache lines and stores its elements contiguously, the elements
+ * themselves are only stored in the leaves, which are linked to each other in
+ * order, while the inner nodes only hold copies of some of them to guide the
+ * searches. Compared to a binary search tree a lookup touches far fewer nodes
+ * and an in-order traversal is a sequential scan of the leaves.
+ *
+ * Unlike the binary search trees the elements are moved inside and between
+ * the nodes, so the pointers returned by the retrieval functions and the
+ * iterators are only valid until the tree is modified.
+ *
+ * @see https://en.wikipedia.org/wiki/B%2B_tree
+ */
+
+#ifndef ARC_BPTREE_H_
+#define ARC_BPTREE_H_
+
+#include <stdlib.h>
+#include <arc/memory/allocator.h>
+#include <arc/type/function.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @typedef arc_bptree_t
+ * @brief B+ tree definition
+ *
+ */
+typedef struct arc_bptree * arc_bptree_t;
+typedef struct arc_bptree_iterator * arc_bptree_iterator_t;
+
+/**
+ * @brief Creates a new bptree
+ *
+ * @param[in] data_size Size of the data element
+ * @param[in] cmp_fn Comparison function (-1, 0, 1)
+ * @return New empty bptree
+ * @retval NULL if memory cannot be allocated
+ */
+arc_bptree_t arc_bptree_create(size_t data_size, arc_cmp_fn_t cmp_fn);
+/**
+ * @brief Creates a new bptree whose nodes are allocated with the given
+ * allocator
+ *
+ * @param[in] data_size Size of the data element
+ * @param[in] cmp_fn Comparison function (-1, 0, 1)
+ * @param[in] allocator Allocator for the nodes, NULL for the default one
+ * @return New empty bptree
+ * @retval NULL if memory cannot be allocated
+ */
+arc_bptree_t
+arc_bptree_create_with_allocator(size_t data_size,
+                                 arc_cmp_fn_t cmp_fn,
+                                 const struct arc_allocator *allocator);
+/**
+ * @brief Destroys the memory associated to a bptree
+ *
+ * @param[in] bptree B+ tree to perform the operation on
+ */
+void arc_bptree_destroy(arc_bptree_t bptree);
+/**
+ * @brief Inserts an element into the bptree
+ *
+ * @param[in] bptree B+ tree to perform the operation on
+ * @param[in] data Data element to be inserted
+ * @retval ARC_SUCCESS If the element was inserted successfully
+ * @retval ARC_DUPLICATE If the element is already in the bptree
+ * @retval ARC_OUT_OF_MEMORY If memory could not be allocated
+ */
+int arc_bptree_insert(arc_bptree_t bptree, const void * data);
+/**
+ * @brief Retrieves an element from the bptree
+ *
+ * @param[in] bptree B+ tree to perform the operation on
+ * @param[in] data Data element to be found
+ * @return Element stored in the bptree, valid until the bptree is modified
+ * @retval NULL If the element was not found
+ */
+void * arc_bptree_retrieve(arc_bptree_t bptree, const void * data);
+/**
+ * @brief Returns whether the bptree is empty or not
+ *
+ * @param[in] bptree B+ tree to perform the operation on
+ * @retval 0 If the bptree is not empty
+ * @retval 1 If the bptree is empty
+ */
+int arc_bptree_empty(arc_bptree_t bptree);
+/**
+ * @brief Returns the size of the bptree
+ *
+ * @param[in] bptree B+ tree to perform the operation on
+ * @return Size of the bptree
+ */
+size_t arc_bptree_size(arc_bptree_t bptree);
+/**
+ * @brief Clears the contents of the bptree
+ *
+ * @param[in] bptree B+ tree to perform the operation on
+ */
+void arc_bptree_clear(arc_bptree_t bptree);
+/**
+ * @brief Removes an element from the bptree
+ *
+ * @param[in] bptree B+ tree to perform the operation on
+ * @param[in] data Data element to be removed
+ */
+void arc_bptree_remove(arc_bptree_t bptree, const void * data);
+/**
+ * @brief Creates a new iterator
+ *
+ * The memory is allocated in the heap and has to be destroyed by the user.
+ *
+ * @param[in] bptree Container to iterate through
+ * @return New iterator for the specified container
+ * @retval NULL if memory cannot be allocated
+ */
+arc_bptree_iterator_t arc_bptree_iterator_create(arc_bptree_t bptree);
+/**
+ * @brief Destroys the memory associated to a iterator
+ *
+ * @param[in] it Iterator to delete
+ */
+void arc_bptree_iterator_destroy(arc_bptree_iterator_t it);
+/**
+ * @brief Sets an iterator to the element before the beginning of the bptree
+ *
+ * @warning The data pointer of this iterator must not be requested, the
+ *          iterator cannot be dereferenced as there is no memory allocated
+ *          for data.
+ *
+ * @param[in] it Iterator
+ */
+void arc_bptree_before_begin(arc_bptree_iterator_t it);
+/**
+ * @brief Sets an iterator to the initial element of the bptree
+ *
+ * @param[in] it Iterator
+ */
+void arc_bptree_begin(arc_bptree_iterator_t it);
+/**
+ * @brief Sets an iterator to the last element of the bptree
+ *
+ * @param[in] it Iterator
+ */
+void arc_bptree_end(arc_bptree_iterator_t it);
+/**
+ * @brief Sets an iterator to the element after the end of the bptree
+ *
+ * @warning The data pointer of this iterator must not be requested, the
+ *          iterator cannot be dereferenced as there is no memory allocated
+ *          for data.
+ *
+ * @param[in] it Iterator
+ */
+void arc_bptree_after_end(arc_bptree_iterator_t it);
+/**
+ * @brief Returns the data associated to the Iterator
+ *
+ * @param[in] it Iterator
+ * @return Data pointer of the element
+ */
+void * arc_bptree_data(arc_bptree_iterator_t it);
+/**
+ * @brief Sets an iterator to the specified element of the bptree
+ *
+ * @param[in] it Iterator
+ * @param[in] data Element to be found
+ * @retval 0 If the element is not in the bptree
+ * @retval 1 If the element was found
+ */
+int arc_bptree_position(arc_bptree_iterator_t it, const void * data);
+/**
+ * @brief Removes the iterator position from the bptree
+ *
+ * The iterator is moved to the element following the removed one.
+ *
+ * @param[in] it Iterator
+ */
+void arc_bptree_erase(arc_bptree_iterator_t it);
+/**
+ * @brief Sets the iterator to the next element in the bptree
+ *
+ * @param[in] it Iterator
+ * @retval 0 If the element after the end of the bptree has been reached
+ * @retval 1 If the current element is in the bptree
+ */
+int arc_bptree_next(arc_bptree_iterator_t it);
+/**
+ * @brief Sets the iterator to the previous element in the bptree
+ *
+ * @param[in] it Iterator
+ * @retval 0 If the element before the beginning of the bptree has been reached
+ * @retval 1 If the current element is in the bptree
+ */
+int arc_bptree_previous(arc_bptree_iterator_t it);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARC_BPTREE_H_ */
+
+/** @} */
@@ -31,6 +31,7 @@
 #define ARC_BSTREE_H_
 
 #include <stdlib.h>
+#include <arc/memory/allocator.h>
 #include <arc/type/function.h>
 
 #ifdef __cplusplus
@@ -54,6 +55,33 @@ typedef struct arc_tree_iterator * arc_bstree_iterator_t;
  * @retval NULL if memory cannot be allocated
  */
 arc_bstree_t arc_bstree_create(size_t data_size, arc_cmp_fn_t cmp_fn);
+/**
+ * @brief Creates a new bstree whose nodes are allocated with the given
+ * allocator
+ *
+ * @param[in] data_size Size of the data element
+ * @param[in] cmp_fn Comparison function for the data type
+ * @param[in] allocator Allocator for the nodes, NULL for the default one
+ * @return New empty bstree
+ * @retval NULL if memory cannot be allocated
+ */
+arc_bstree_t
+arc_bstree_create_with_allocator(size_t data_size,
+                                 arc_cmp_fn_t cmp_fn,
+                                 const struct arc_allocator *allocator);
+/**
+ * @brief Creates a new bstree whose nodes are allocated from its own pool
+ *
+ * The nodes are carved out of large chunks which are kept until the bstree is
+ * destroyed, so inserting and removing elements rarely calls malloc and the
+ * nodes are stored close to each other.
+ *
+ * @param[in] data_size Size of the data element
+ * @param[in] cmp_fn Comparison function for the data type
+ * @return New empty bstree
+ * @retval NULL if memory cannot be allocated
+ */
+arc_bstree_t arc_bstree_create_pooled(size_t data_size, arc_cmp_fn_t cmp_fn);
 /**
  * @brief Destroys the memory associated to a bstree
  *
@@ -79,6 +107,22 @@ int arc_bstree_insert(arc_bstree_t bstree, const void * data);
  * @retval 1 If the element was found
  */
 void *arc_bstree_retrieve(arc_bstree_t bstree, const void * data);
+/**
+ * @brief Finds several elements in the bstree at once
+ *
+ * The lookups are interleaved so that the memory accesses of the different
+ * searches overlap, which is faster than calling arc_bstree_retrieve on every
+ * key when the tree doesn't fit in the cache.
+ *
+ * @param[in] bstree Binary search tree to perform the operation on
+ * @param[in] keys Array of n contiguous data elements to be found
+ * @param[in] n Number of elements to be found
+ * @param[out] results Array of n pointers, filled with the element found for
+ *                     every key or NULL if it's not in the bstree
+ * @return Number of elements found
+ */
+size_t arc_bstree_retrieve_batch(arc_bstree_t bstree, const void * keys,
+                                 size_t n, void **results);
 /**
  * @brief Returns whether the bstree is empty or not
  *
@@ -180,6 +224,55 @@ void * arc_bstree_data(arc_bstree_iterator_t it);
  * @retval 1 If the bstree is empty
  */
 int arc_bstree_position(arc_bstree_iterator_t it, const void * data);
+/**
+ * @brief Sets an iterator to the first element which is not less than the
+ * given one
+ *
+ * @param[in] it Iterator
+ * @param[in] data Data element to compare with
+ * @retval 0 If every element is less, the iterator is set after the end
+ * @retval 1 If the current element is in the bstree
+ */
+int arc_bstree_lower_bound(arc_bstree_iterator_t it, const void * data);
+/**
+ * @brief Sets an iterator to the first element which is greater than the
+ * given one
+ *
+ * @param[in] it Iterator
+ * @param[in] data Data element to compare with
+ * @retval 0 If no element is greater, the iterator is set after the end
+ * @retval 1 If the current element is in the bstree
+ */
+int arc_bstree_upper_bound(arc_bstree_iterator_t it, const void * data);
+/**
+ * @brief Sets an iterator to the first element of the range [first, last)
+ *
+ * Together with arc_bstree_range_next it visits the elements of the range
+ * without looking at the rest:
+ *
+ * @code
+ * for (found = arc_bstree_range(it, &first, &last); found;
+ *      found = arc_bstree_range_next(it, &last))
+ * @endcode
+ *
+ * @param[in] it Iterator
+ * @param[in] first Smallest element of the range
+ * @param[in] last Element after the range, it is not part of it
+ * @retval 0 If the range is empty
+ * @retval 1 If the current element is in the range
+ */
+int arc_bstree_range(arc_bstree_iterator_t it, const void * first,
+                     const void * last);
+/**
+ * @brief Sets the iterator to the next node if it is still in the range
+ * (see arc_bstree_range)
+ *
+ * @param[in] it Iterator
+ * @param[in] last Element after the range, it is not part of it
+ * @retval 0 If the end of the range has been reached
+ * @retval 1 If the current element is in the range
+ */
+int arc_bstree_range_next(arc_bstree_iterator_t it, const void * last);
 /**
  * @brief Removes the iterator position from the bstree
  *
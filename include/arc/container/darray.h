@@ -31,6 +31,8 @@
 #define ARC_DARRAY_H_
 
 #include <stdlib.h>
+#include <arc/memory/allocator.h>
+#include <arc/type/function.h>
 
 #ifdef __cplusplus
 extern "C"{
@@ -57,6 +59,48 @@ typedef struct arc_darray_iterator * arc_darray_iterator_t;
  * @retval NULL if memory cannot be allocated
  */
 arc_darray_t arc_darray_create(size_t data_size);
+/**
+ * @brief Creates a new darray whose data is allocated with the given allocator
+ *
+ * @param[in] data_size Size of the data element
+ * @param[in] allocator Allocator for the data array, NULL for the default one
+ * @return New empty darray
+ * @retval NULL if memory cannot be allocated
+ */
+arc_darray_t
+arc_darray_create_with_allocator(size_t data_size,
+                                 const struct arc_allocator *allocator);
+/**
+ * @brief Creates a new darray with a given initial capacity and growth
+ *
+ * When the darray is full the capacity is multiplied by growth_factor, a
+ * factor closer to 1 wastes less memory at the cost of more reallocations.
+ *
+ * @param[in] data_size Size of the data element
+ * @param[in] capacity Number of elements allocated initially, at least 1
+ * @param[in] growth_factor Growth of the capacity, values not greater than 1
+ * select the default factor
+ * @return New empty darray
+ * @retval NULL if memory cannot be allocated
+ */
+arc_darray_t arc_darray_create_with_capacity(size_t data_size, size_t capacity,
+                                             double growth_factor);
+/**
+ * @brief Creates a new darray for a very large number of elements
+ *
+ * The data is kept in its own memory mapping (see arc_mmap_allocator), so
+ * growing the darray doesn't copy the elements already in it. The elements
+ * are only moved when they wrap around the end of the block.
+ *
+ * @param[in] data_size Size of the data element
+ * @param[in] capacity Number of elements allocated initially, the address
+ * space is taken but the pages are only backed by memory once written
+ * @param[in] huge_pages Non zero to advise the use of transparent huge pages
+ * @return New empty darray
+ * @retval NULL if memory cannot be allocated
+ */
+arc_darray_t arc_darray_create_large(size_t data_size, size_t capacity,
+                                     int huge_pages);
 /**
  * @brief Destroys the memory associated to a darray
  *
@@ -71,9 +115,23 @@ void arc_darray_destroy(arc_darray_t darray);
  * @return Data pointer of the first element
  */
 void * arc_darray_at(arc_darray_t darray, unsigned long idx);
+/**
+ * @brief Makes the elements of the darray contiguous in memory
+ *
+ * The darray is a circular buffer, after inserting or removing elements at the
+ * front they might wrap around the end of the allocated block. This function
+ * rotates the block if needed so the elements can be accessed as a plain
+ * array.
+ *
+ * @param[in] darray Dynamic Array to perform the operation on
+ * @return Data pointer of the first element, the rest follow it
+ */
+void * arc_darray_linearize(arc_darray_t darray);
 /**
  * @brief Adds a new element to the front of the darray
  *
+ * It takes constant time, the darray keeps room at both ends of the block.
+ *
  * @param[in] darray Dynamic Array to perform the operation on
  * @param[in] data Data associated to the new element
  * @retval ARC_OUT_OF_MEMORY If memory could not be allocated
@@ -101,6 +159,172 @@ int arc_darray_push_back(arc_darray_t darray, void * data);
  * @param[in] darray Dynamic Array to perform the operation on
  */
 void arc_darray_pop_back(arc_darray_t darray);
+/**
+ * @brief Inserts count elements before the position idx
+ *
+ * The darray grows at most once and the elements already in it are moved
+ * only once, instead of once per inserted element.
+ *
+ * @param[in] darray Dynamic Array to perform the operation on
+ * @param[in] idx Position of the first new element, up to the size
+ * @param[in] data Array with the data of the new elements
+ * @param[in] count Number of elements to insert
+ * @retval ARC_SUCCESS If the elements were inserted successfully
+ * @retval ARC_OUT_OF_MEMORY If memory could not be allocated
+ * @retval ARC_ERROR If idx is beyond the end of the darray
+ */
+int arc_darray_insert_range(arc_darray_t darray, unsigned long idx,
+                            const void * data, size_t count);
+/**
+ * @brief Adds count elements to the end of the darray
+ *
+ * @param[in] darray Dynamic Array to perform the operation on
+ * @param[in] data Array with the data of the new elements
+ * @param[in] count Number of elements to add
+ * @retval ARC_SUCCESS If the elements were added successfully
+ * @retval ARC_OUT_OF_MEMORY If memory could not be allocated
+ */
+int arc_darray_append_range(arc_darray_t darray, const void * data,
+                            size_t count);
+/**
+ * @brief Removes count elements starting at position idx
+ *
+ * The range is clipped to the end of the darray.
+ *
+ * @param[in] darray Dynamic Array to perform the operation on
+ * @param[in] idx Position of the first element to remove
+ * @param[in] count Number of elements to remove
+ */
+void arc_darray_erase_range(arc_darray_t darray, unsigned long idx,
+                            size_t count);
+/**
+ * @brief Sorts the elements of the darray (see arc_sort)
+ *
+ * @param[in] darray Dynamic Array to perform the operation on
+ * @param[in] cmp_fn Comparison function
+ */
+void arc_darray_sort(arc_darray_t darray, arc_cmp_fn_t cmp_fn);
+/**
+ * @brief Sorts the elements of the darray by their keys (see arc_radix_sort)
+ *
+ * @param[in] darray Dynamic Array to perform the operation on
+ * @param[in] key_fn Key extraction function
+ * @retval ARC_SUCCESS If the darray was sorted
+ * @retval ARC_OUT_OF_MEMORY If memory could not be allocated
+ */
+int arc_darray_radix_sort(arc_darray_t darray, arc_key_fn_t key_fn);
+/**
+ * @brief Sorts the elements of the darray with several threads (see
+ * arc_parallel_sort)
+ *
+ * Darrays with fewer than twice ARC_PARALLEL_SORT_MIN_CHUNK elements are
+ * sorted with arc_darray_sort without starting any thread.
+ *
+ * @param[in] darray Dynamic Array to perform the operation on
+ * @param[in] cmp_fn Comparison function
+ * @param[in] num_threads Number of threads, 0 for one per online processor
+ * @retval ARC_SUCCESS If the darray was sorted
+ * @retval ARC_OUT_OF_MEMORY If memory or the threads could not be allocated
+ */
+int arc_darray_parallel_sort(arc_darray_t darray, arc_cmp_fn_t cmp_fn,
+                             unsigned num_threads);
+/**
+ * @brief Returns the position of the first element which is not less than
+ * the key
+ *
+ * The darray must be sorted by the same comparison function.
+ *
+ * @param[in] darray Dynamic Array to perform the operation on
+ * @param[in] key Data to compare the elements with
+ * @param[in] cmp_fn Comparison function, the key is its second argument
+ * @return Position of the element, the size of the darray if there is none
+ */
+unsigned long arc_darray_lower_bound(arc_darray_t darray, const void * key,
+                                     arc_cmp_fn_t cmp_fn);
+/**
+ * @brief Returns the position of the first element which is greater than the
+ * key
+ *
+ * The darray must be sorted by the same comparison function.
+ *
+ * @param[in] darray Dynamic Array to perform the operation on
+ * @param[in] key Data to compare the elements with
+ * @param[in] cmp_fn Comparison function, the key is its second argument
+ * @return Position of the element, the size of the darray if there is none
+ */
+unsigned long arc_darray_upper_bound(arc_darray_t darray, const void * key,
+                                     arc_cmp_fn_t cmp_fn);
+/**
+ * @brief Returns the range of elements which are equal to the key
+ *
+ * The darray must be sorted by the same comparison function.
+ *
+ * @param[in] darray Dynamic Array to perform the operation on
+ * @param[in] key Data to compare the elements with
+ * @param[in] cmp_fn Comparison function, the key is its second argument
+ * @param[out] first Position of the first equal element (lower bound)
+ * @param[out] last Position after the last equal element (upper bound)
+ */
+void arc_darray_equal_range(arc_darray_t darray, const void * key,
+                            arc_cmp_fn_t cmp_fn, unsigned long * first,
+                            unsigned long * last);
+/**
+ * @brief arc_darray_lower_bound for a darray of ints sorted in ascending
+ * order
+ *
+ * The elements are compared directly and the search has no data dependent
+ * branches, the elements of the next steps are prefetched instead.
+ *
+ * @param[in] darray Dynamic Array to perform the operation on
+ * @param[in] key Value to compare the elements with
+ * @return Position of the element, the size of the darray if there is none
+ */
+unsigned long arc_darray_lower_bound_int(arc_darray_t darray, int key);
+/**
+ * @brief arc_darray_upper_bound for a darray of ints sorted in ascending
+ * order (see arc_darray_lower_bound_int)
+ *
+ * @param[in] darray Dynamic Array to perform the operation on
+ * @param[in] key Value to compare the elements with
+ * @return Position of the element, the size of the darray if there is none
+ */
+unsigned long arc_darray_upper_bound_int(arc_darray_t darray, int key);
+/**
+ * @brief arc_darray_lower_bound for a darray of longs sorted in ascending
+ * order (see arc_darray_lower_bound_int)
+ *
+ * @param[in] darray Dynamic Array to perform the operation on
+ * @param[in] key Value to compare the elements with
+ * @return Position of the element, the size of the darray if there is none
+ */
+unsigned long arc_darray_lower_bound_long(arc_darray_t darray, long key);
+/**
+ * @brief arc_darray_upper_bound for a darray of longs sorted in ascending
+ * order (see arc_darray_lower_bound_int)
+ *
+ * @param[in] darray Dynamic Array to perform the operation on
+ * @param[in] key Value to compare the elements with
+ * @return Position of the element, the size of the darray if there is none
+ */
+unsigned long arc_darray_upper_bound_long(arc_darray_t darray, long key);
+/**
+ * @brief arc_darray_lower_bound for a darray of doubles sorted in ascending
+ * order (see arc_darray_lower_bound_int), it must not contain NaN
+ *
+ * @param[in] darray Dynamic Array to perform the operation on
+ * @param[in] key Value to compare the elements with
+ * @return Position of the element, the size of the darray if there is none
+ */
+unsigned long arc_darray_lower_bound_double(arc_darray_t darray, double key);
+/**
+ * @brief arc_darray_upper_bound for a darray of doubles sorted in ascending
+ * order (see arc_darray_lower_bound_int), it must not contain NaN
+ *
+ * @param[in] darray Dynamic Array to perform the operation on
+ * @param[in] key Value to compare the elements with
+ * @return Position of the element, the size of the darray if there is none
+ */
+unsigned long arc_darray_upper_bound_double(arc_darray_t darray, double key);
 /**
  * @brief Returns the data of the initial element of the darray
  *
@@ -130,9 +354,43 @@ int arc_darray_empty(arc_darray_t darray);
  * @return Size of the darray
  */
 size_t arc_darray_size(arc_darray_t darray);
+/**
+ * @brief Returns the number of elements that fit without reallocating
+ *
+ * @param[in] darray Dynamic Array to perform the operation on
+ * @return Capacity of the darray
+ */
+size_t arc_darray_capacity(arc_darray_t darray);
+/**
+ * @brief Makes room for at least capacity elements
+ *
+ * Loaders which know the final size in advance can allocate the memory once
+ * instead of growing the darray step by step.
+ *
+ * @param[in] darray Dynamic Array to perform the operation on
+ * @param[in] capacity Minimum number of elements
+ * @retval ARC_SUCCESS If the memory is available
+ * @retval ARC_OUT_OF_MEMORY If memory could not be allocated, the darray is
+ * left untouched
+ */
+int arc_darray_reserve(arc_darray_t darray, size_t capacity);
+/**
+ * @brief Releases the memory which is not used by the elements
+ *
+ * The elements are made contiguous at the beginning of the block and the
+ * block is reallocated to their size (one element for an empty darray).
+ *
+ * @param[in] darray Dynamic Array to perform the operation on
+ * @retval ARC_SUCCESS If the memory was released
+ * @retval ARC_OUT_OF_MEMORY If the block could not be reallocated, the
+ * elements are kept in the old block
+ */
+int arc_darray_shrink_to_fit(arc_darray_t darray);
 /**
  * @brief Clears the contents of the darray
  *
+ * The memory is kept for reuse, use arc_darray_shrink_to_fit to release it.
+ *
  * @param[in] darray Dynamic Array to perform the operation on
  */
 void arc_darray_clear(arc_darray_t darray);
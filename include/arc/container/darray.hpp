@@ -0,0 +1,330 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @addtogroup DArray
+ * @{
+ *
+ * @brief C++ dynamic array
+ *
+ * arc::darray<T> keeps its elements in the same struct arc_darray used by the
+ * C container, but the elements are constructed in place and moved when the
+ * array grows instead of being copied byte by byte, so it can hold types with
+ * non trivial constructors. Trivially copyable elements still grow with
+ * realloc.
+ *
+ * As the rest of the library it doesn't throw, the functions which allocate
+ * memory return ARC_SUCCESS or ARC_OUT_OF_MEMORY.
+ */
+
+#ifndef ARC_DARRAY_HPP_
+#define ARC_DARRAY_HPP_
+
+#if __cplusplus < 201103L
+# error "arc/container/darray.hpp requires C++11"
+#endif
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <arc/common/defines.h>
+#include <arc/memory/allocator.h>
+
+extern "C" {
+#include <arc/container/darray_def.h>
+}
+
+namespace arc {
+
+/**
+ * @brief Dynamic array of elements of type T
+ */
+template <typename T>
+class darray
+{
+public:
+    typedef T value_type;
+    typedef T * iterator;
+    typedef const T * const_iterator;
+
+    /**
+     * @brief Creates an empty darray, no memory is allocated until the first
+     * insertion
+     *
+     * @param[in] allocator Allocator for the elements, NULL for the default one
+     */
+    explicit darray(const struct arc_allocator *allocator = NULL)
+    {
+        m_darray.size = 0;
+        m_darray.head = 0;
+        m_darray.allocated_size = 0;
+        m_darray.data_size = sizeof(T);
+        m_darray.growth_factor = GROWTH_FACTOR;
+        m_darray.data = NULL;
+        m_darray.allocator = (allocator != NULL ? *allocator :
+                                                  arc_default_allocator);
+    }
+
+    darray(darray &&other) : m_darray(other.m_darray)
+    {
+        other.m_darray.size = 0;
+        other.m_darray.allocated_size = 0;
+        other.m_darray.data = NULL;
+    }
+
+    darray &operator=(darray &&other)
+    {
+        if (this != &other)
+        {
+            release();
+            m_darray = other.m_darray;
+            other.m_darray.size = 0;
+            other.m_darray.allocated_size = 0;
+            other.m_darray.data = NULL;
+        }
+
+        return *this;
+    }
+
+    darray(const darray &) = delete;
+    darray &operator=(const darray &) = delete;
+
+    ~darray()
+    {
+        release();
+    }
+
+    /**
+     * @brief Makes room for at least capacity elements
+     *
+     * @retval ARC_SUCCESS If the memory is available
+     * @retval ARC_OUT_OF_MEMORY If memory could not be allocated
+     */
+    int reserve(size_t capacity)
+    {
+        if (capacity <= m_darray.allocated_size)
+        {
+            return ARC_SUCCESS;
+        }
+
+        return grow(capacity);
+    }
+
+    /**
+     * @brief Constructs a new element at the end of the darray
+     *
+     * @retval ARC_SUCCESS If the element was inserted successfully
+     * @retval ARC_OUT_OF_MEMORY If memory could not be allocated
+     */
+    template <typename... Args>
+    int emplace_back(Args&&... args)
+    {
+        if (m_darray.size == m_darray.allocated_size)
+        {
+            return grow_emplace_back(std::forward<Args>(args)...);
+        }
+
+        new (data() + m_darray.size) T(std::forward<Args>(args)...);
+        m_darray.size++;
+
+        return ARC_SUCCESS;
+    }
+
+    int push_back(const T &value)
+    {
+        return emplace_back(value);
+    }
+
+    int push_back(T &&value)
+    {
+        return emplace_back(std::move(value));
+    }
+
+    void pop_back()
+    {
+        if (m_darray.size > 0)
+        {
+            m_darray.size--;
+            data()[m_darray.size].~T();
+        }
+    }
+
+    /**
+     * @brief Destroys all the elements, the memory is kept for reuse
+     */
+    void clear()
+    {
+        destroy_elements();
+        m_darray.size = 0;
+    }
+
+    T &operator[](size_t idx) { return data()[idx]; }
+    const T &operator[](size_t idx) const { return data()[idx]; }
+
+    T &front() { return data()[0]; }
+    T &back() { return data()[m_darray.size - 1]; }
+
+    T *data() { return static_cast<T *>(m_darray.data); }
+    const T *data() const { return static_cast<const T *>(m_darray.data); }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + m_darray.size; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + m_darray.size; }
+
+    size_t size() const { return m_darray.size; }
+    size_t capacity() const { return m_darray.allocated_size; }
+    bool empty() const { return m_darray.size == 0; }
+
+private:
+    void destroy_elements()
+    {
+        if (!std::is_trivially_destructible<T>::value)
+        {
+            size_t i;
+
+            for (i = 0; i < m_darray.size; i++)
+            {
+                data()[i].~T();
+            }
+        }
+    }
+
+    void release()
+    {
+        destroy_elements();
+
+        if (m_darray.data != NULL)
+        {
+            ARC_FREE(&m_darray.allocator, m_darray.data);
+        }
+
+        m_darray.size = 0;
+        m_darray.allocated_size = 0;
+        m_darray.data = NULL;
+    }
+
+    int grow(size_t capacity)
+    {
+        void *ptr;
+
+        if (capacity > SIZE_MAX / sizeof(T))
+        {
+            return ARC_OUT_OF_MEMORY;
+        }
+
+        if (std::is_trivially_copyable<T>::value)
+        {
+            ptr = ARC_REALLOC(&m_darray.allocator, m_darray.data,
+                              capacity * sizeof(T));
+
+            if (ptr == NULL)
+            {
+                return ARC_OUT_OF_MEMORY;
+            }
+
+            m_darray.data = ptr;
+            m_darray.allocated_size = capacity;
+        }
+        else
+        {
+            ptr = ARC_ALLOC(&m_darray.allocator, capacity * sizeof(T));
+
+            if (ptr == NULL)
+            {
+                return ARC_OUT_OF_MEMORY;
+            }
+
+            relocate(ptr, capacity);
+        }
+
+        return ARC_SUCCESS;
+    }
+
+    /* Moves the elements to a new block of capacity elements and releases
+       the old one */
+    void relocate(void *ptr, size_t capacity)
+    {
+        size_t i;
+        T *elems = static_cast<T *>(ptr);
+
+        for (i = 0; i < m_darray.size; i++)
+        {
+            new (elems + i) T(std::move(data()[i]));
+            data()[i].~T();
+        }
+
+        if (m_darray.data != NULL)
+        {
+            ARC_FREE(&m_darray.allocator, m_darray.data);
+        }
+
+        m_darray.data = ptr;
+        m_darray.allocated_size = capacity;
+    }
+
+    /* Appends to a full darray. The arguments may refer to one of its
+       elements, so the new element is built before the old block is
+       released */
+    template <typename... Args>
+    int grow_emplace_back(Args&&... args)
+    {
+        size_t capacity = m_darray.allocated_size;
+
+        if (capacity == 0)
+        {
+            capacity = INITIAL_BLOCK_SIZE;
+        }
+        else if (capacity > SIZE_MAX / GROWTH_FACTOR / sizeof(T))
+        {
+            return ARC_OUT_OF_MEMORY;
+        }
+        else
+        {
+            capacity *= GROWTH_FACTOR;
+        }
+
+        if (std::is_trivially_copyable<T>::value)
+        {
+            T value(std::forward<Args>(args)...);
+
+            if (grow(capacity) != ARC_SUCCESS)
+            {
+                return ARC_OUT_OF_MEMORY;
+            }
+
+            new (data() + m_darray.size) T(std::move(value));
+        }
+        else
+        {
+            void *ptr = ARC_ALLOC(&m_darray.allocator, capacity * sizeof(T));
+
+            if (ptr == NULL)
+            {
+                return ARC_OUT_OF_MEMORY;
+            }
+
+            new (static_cast<T *>(ptr) + m_darray.size)
+                T(std::forward<Args>(args)...);
+            relocate(ptr, capacity);
+        }
+
+        m_darray.size++;
+
+        return ARC_SUCCESS;
+    }
+
+    struct arc_darray m_darray;
+};
+
+} /* namespace arc */
+
+#endif /* ARC_DARRAY_HPP_ */
+
+/** @} */
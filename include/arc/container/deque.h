@@ -31,6 +31,8 @@
 #define ARC_DEQUE_H_
 
 #include <stdlib.h>
+#include <arc/memory/allocator.h>
+#include <arc/type/function.h>
 
 #ifdef __cplusplus
 extern "C"{
@@ -57,6 +59,18 @@ typedef struct arc_deque_iterator * arc_deque_iterator_t;
  * @retval NULL if memory cannot be allocated
  */
 arc_deque_t arc_deque_create(size_t data_size);
+/**
+ * @brief Creates a new deque whose blocks are allocated with the given
+ * allocator
+ *
+ * @param[in] data_size Size of the data element
+ * @param[in] allocator Allocator for the blocks, NULL for the default one
+ * @return New empty deque
+ * @retval NULL if memory cannot be allocated
+ */
+arc_deque_t
+arc_deque_create_with_allocator(size_t data_size,
+                                const struct arc_allocator *allocator);
 /**
  * @brief Destroys the memory associated to a deque
  *
@@ -101,6 +115,67 @@ int arc_deque_push_back(arc_deque_t deque, void * data);
  * @param[in] deque Deque to perform the operation on
  */
 void arc_deque_pop_back(arc_deque_t deque);
+/**
+ * @brief Inserts count elements before the position idx
+ *
+ * The shorter side of the deque is moved once to make room for all the new
+ * elements, instead of once per inserted element.
+ *
+ * @param[in] deque Deque to perform the operation on
+ * @param[in] idx Position of the first new element, up to the size
+ * @param[in] data Array with the data of the new elements
+ * @param[in] count Number of elements to insert
+ * @retval ARC_SUCCESS If the elements were inserted successfully
+ * @retval ARC_OUT_OF_MEMORY If memory could not be allocated
+ * @retval ARC_ERROR If idx is beyond the end of the deque
+ */
+int arc_deque_insert_range(arc_deque_t deque, unsigned long idx,
+                           const void * data, size_t count);
+/**
+ * @brief Adds count elements to the end of the deque
+ *
+ * @param[in] deque Deque to perform the operation on
+ * @param[in] data Array with the data of the new elements
+ * @param[in] count Number of elements to add
+ * @retval ARC_SUCCESS If the elements were added successfully
+ * @retval ARC_OUT_OF_MEMORY If memory could not be allocated
+ */
+int arc_deque_append_range(arc_deque_t deque, const void * data,
+                           size_t count);
+/**
+ * @brief Removes count elements starting at position idx
+ *
+ * The range is clipped to the end of the deque.
+ *
+ * @param[in] deque Deque to perform the operation on
+ * @param[in] idx Position of the first element to remove
+ * @param[in] count Number of elements to remove
+ */
+void arc_deque_erase_range(arc_deque_t deque, unsigned long idx,
+                           size_t count);
+/**
+ * @brief Sorts the elements of the deque (see arc_sort)
+ *
+ * The elements are copied block by block to a contiguous array, sorted there
+ * and copied back to the blocks.
+ *
+ * @param[in] deque Deque to perform the operation on
+ * @param[in] cmp_fn Comparison function
+ * @retval ARC_SUCCESS If the deque was sorted
+ * @retval ARC_OUT_OF_MEMORY If memory could not be allocated, the deque is
+ * left untouched
+ */
+int arc_deque_sort(arc_deque_t deque, arc_cmp_fn_t cmp_fn);
+/**
+ * @brief Sorts the elements of the deque by their keys (see arc_radix_sort)
+ *
+ * @param[in] deque Deque to perform the operation on
+ * @param[in] key_fn Key extraction function
+ * @retval ARC_SUCCESS If the deque was sorted
+ * @retval ARC_OUT_OF_MEMORY If memory could not be allocated, the deque is
+ * left untouched
+ */
+int arc_deque_radix_sort(arc_deque_t deque, arc_key_fn_t key_fn);
 /**
  * @brief Returns the data of the initial element of the deque
  *
@@ -0,0 +1,354 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @addtogroup Deque
+ * @{
+ *
+ * @brief C++ double ended queue
+ *
+ * arc::deque<T> uses the same block layout as the C container (struct
+ * arc_deque). Elements are constructed in place and, since blocks are never
+ * moved, they stay at the same address until they are removed.
+ *
+ * As the rest of the library it doesn't throw, the functions which allocate
+ * memory return ARC_SUCCESS or ARC_OUT_OF_MEMORY.
+ */
+
+#ifndef ARC_DEQUE_HPP_
+#define ARC_DEQUE_HPP_
+
+#if __cplusplus < 201103L
+# error "arc/container/deque.hpp requires C++11"
+#endif
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <arc/common/defines.h>
+#include <arc/memory/allocator.h>
+#include <arc/container/deque.h>
+
+extern "C" {
+#include <arc/container/deque_def.h>
+}
+
+namespace arc {
+
+/**
+ * @brief Double ended queue of elements of type T
+ */
+template <typename T>
+class deque
+{
+public:
+    typedef T value_type;
+
+    /**
+     * @brief Iterator through the elements in order
+     */
+    class iterator
+    {
+    public:
+        iterator(deque *container, size_t idx)
+            : m_container(container), m_idx(idx) {}
+
+        T &operator*() const { return *m_container->slot(m_idx); }
+        T *operator->() const { return m_container->slot(m_idx); }
+        iterator &operator++() { m_idx++; return *this; }
+        iterator &operator--() { m_idx--; return *this; }
+        bool operator==(const iterator &other) const
+        {
+            return m_idx == other.m_idx;
+        }
+        bool operator!=(const iterator &other) const
+        {
+            return m_idx != other.m_idx;
+        }
+
+    private:
+        deque *m_container;
+        size_t m_idx;
+    };
+
+    /**
+     * @brief Creates an empty deque
+     *
+     * If the initial memory cannot be allocated every insertion returns
+     * ARC_OUT_OF_MEMORY.
+     *
+     * @param[in] allocator Allocator for the blocks, NULL for the default one
+     */
+    explicit deque(const struct arc_allocator *allocator = NULL)
+    {
+        if (arc_deque_init_with_allocator(&m_deque, sizeof(T),
+                                          allocator) != ARC_SUCCESS)
+        {
+            m_deque.data = NULL;
+        }
+    }
+
+    /**
+     * @brief Takes the blocks of other, which can only be destroyed or
+     * assigned to afterwards
+     */
+    deque(deque &&other) : m_deque(other.m_deque)
+    {
+        other.m_deque.size = 0;
+        other.m_deque.data = NULL;
+    }
+
+    deque &operator=(deque &&other)
+    {
+        if (this != &other)
+        {
+            release();
+            m_deque = other.m_deque;
+            other.m_deque.size = 0;
+            other.m_deque.data = NULL;
+        }
+
+        return *this;
+    }
+
+    deque(const deque &) = delete;
+    deque &operator=(const deque &) = delete;
+
+    ~deque()
+    {
+        release();
+    }
+
+    /**
+     * @brief Constructs a new element at the end of the deque
+     *
+     * @retval ARC_SUCCESS If the element was inserted successfully
+     * @retval ARC_OUT_OF_MEMORY If memory could not be allocated
+     */
+    template <typename... Args>
+    int emplace_back(Args&&... args)
+    {
+        unsigned long num, idx;
+
+        if (m_deque.data == NULL)
+        {
+            return ARC_OUT_OF_MEMORY;
+        }
+
+        /* The end never reaches the last slot of the pointer array */
+        if (m_deque.end_block_num == m_deque.num_blocks - 1 &&
+            m_deque.end_block_idx + 2 >= m_deque.block_size)
+        {
+            if (arc_deque_realloc(&m_deque) != ARC_SUCCESS)
+            {
+                return ARC_OUT_OF_MEMORY;
+            }
+        }
+
+        num = m_deque.end_block_num;
+        idx = m_deque.end_block_idx + 1;
+
+        if (idx == m_deque.block_size)
+        {
+            idx = 0;
+            num++;
+        }
+
+        if (!allocate_block(num))
+        {
+            return ARC_OUT_OF_MEMORY;
+        }
+
+        new (static_cast<T *>(m_deque.data[num]) + idx)
+            T(std::forward<Args>(args)...);
+
+        m_deque.end_block_num = num;
+        m_deque.end_block_idx = idx;
+        m_deque.size++;
+
+        return ARC_SUCCESS;
+    }
+
+    /**
+     * @brief Constructs a new element at the beginning of the deque
+     *
+     * @retval ARC_SUCCESS If the element was inserted successfully
+     * @retval ARC_OUT_OF_MEMORY If memory could not be allocated
+     */
+    template <typename... Args>
+    int emplace_front(Args&&... args)
+    {
+        unsigned long num, idx;
+
+        if (m_deque.data == NULL)
+        {
+            return ARC_OUT_OF_MEMORY;
+        }
+
+        /* The start never reaches the first slot of the pointer array */
+        if (m_deque.start_block_num == 0 && m_deque.start_block_idx <= 1)
+        {
+            if (arc_deque_realloc(&m_deque) != ARC_SUCCESS)
+            {
+                return ARC_OUT_OF_MEMORY;
+            }
+        }
+
+        num = m_deque.start_block_num;
+        idx = m_deque.start_block_idx;
+
+        if (idx == 0)
+        {
+            num--;
+            idx = m_deque.block_size - 1;
+        }
+        else
+        {
+            idx--;
+        }
+
+        if (!allocate_block(num))
+        {
+            return ARC_OUT_OF_MEMORY;
+        }
+
+        new (static_cast<T *>(m_deque.data[num]) + idx)
+            T(std::forward<Args>(args)...);
+
+        m_deque.start_block_num = num;
+        m_deque.start_block_idx = idx;
+        m_deque.size++;
+
+        return ARC_SUCCESS;
+    }
+
+    int push_back(const T &value) { return emplace_back(value); }
+    int push_back(T &&value) { return emplace_back(std::move(value)); }
+    int push_front(const T &value) { return emplace_front(value); }
+    int push_front(T &&value) { return emplace_front(std::move(value)); }
+
+    void pop_front()
+    {
+        if (m_deque.size > 0)
+        {
+            slot(0)->~T();
+
+            m_deque.start_block_idx++;
+
+            if (m_deque.start_block_idx == m_deque.block_size)
+            {
+                m_deque.start_block_num++;
+                m_deque.start_block_idx = 0;
+            }
+
+            m_deque.size--;
+        }
+    }
+
+    void pop_back()
+    {
+        if (m_deque.size > 0)
+        {
+            slot(m_deque.size - 1)->~T();
+
+            if (m_deque.end_block_idx == 0)
+            {
+                m_deque.end_block_idx = m_deque.block_size - 1;
+                m_deque.end_block_num--;
+            }
+            else
+            {
+                m_deque.end_block_idx--;
+            }
+
+            m_deque.size--;
+        }
+    }
+
+    /**
+     * @brief Destroys all the elements, the blocks are kept for reuse
+     */
+    void clear()
+    {
+        if (m_deque.data != NULL)
+        {
+            destroy_elements();
+            arc_deque_clear(&m_deque);
+        }
+    }
+
+    T &operator[](size_t idx) { return *slot(idx); }
+    T &front() { return *slot(0); }
+    T &back() { return *slot(m_deque.size - 1); }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, m_deque.size); }
+
+    size_t size() const { return m_deque.size; }
+    bool empty() const { return m_deque.size == 0; }
+
+private:
+    T *slot(size_t idx)
+    {
+        unsigned long num = m_deque.start_block_num + idx / m_deque.block_size;
+        unsigned long pos = m_deque.start_block_idx + idx % m_deque.block_size;
+
+        if (pos >= m_deque.block_size)
+        {
+            pos -= m_deque.block_size;
+            num++;
+        }
+
+        return static_cast<T *>(m_deque.data[num]) + pos;
+    }
+
+    bool allocate_block(unsigned long num)
+    {
+        if (m_deque.data[num] == NULL)
+        {
+            m_deque.data[num] = ARC_ALLOC(&m_deque.allocator,
+                                          m_deque.block_size * sizeof(T));
+        }
+
+        return m_deque.data[num] != NULL;
+    }
+
+    void destroy_elements()
+    {
+        if (!std::is_trivially_destructible<T>::value)
+        {
+            size_t i;
+
+            for (i = 0; i < m_deque.size; i++)
+            {
+                slot(i)->~T();
+            }
+        }
+    }
+
+    void release()
+    {
+        if (m_deque.data != NULL)
+        {
+            destroy_elements();
+            arc_deque_fini(&m_deque);
+            m_deque.data = NULL;
+        }
+
+        m_deque.size = 0;
+    }
+
+    struct arc_deque m_deque;
+};
+
+} /* namespace arc */
+
+#endif /* ARC_DEQUE_HPP_ */
+
+/** @} */
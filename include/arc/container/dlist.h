@@ -30,6 +30,7 @@
 #define ARC_DLIST_H_
 
 #include <stdlib.h>
+#include <arc/memory/allocator.h>
 
 #ifdef __cplusplus
 extern "C"{
@@ -56,6 +57,30 @@ typedef struct arc_dlist_iterator * arc_dlist_iterator_t;
  * @retval NULL if memory cannot be allocated
  */
 arc_dlist_t arc_dlist_create(size_t data_size);
+/**
+ * @brief Creates a new list whose nodes are allocated with the given
+ * allocator
+ *
+ * @param[in] data_size Size of the data element
+ * @param[in] allocator Allocator for the nodes, NULL for the default one
+ * @return New empty list
+ * @retval NULL if memory cannot be allocated
+ */
+arc_dlist_t
+arc_dlist_create_with_allocator(size_t data_size,
+                                const struct arc_allocator *allocator);
+/**
+ * @brief Creates a new dlist whose nodes are allocated from its own pool
+ *
+ * The nodes are carved out of large chunks which are kept until the dlist is
+ * destroyed, so inserting and removing elements rarely calls malloc and the
+ * nodes are stored close to each other.
+ *
+ * @param[in] data_size Size of the data element
+ * @return New empty dlist
+ * @retval NULL if memory cannot be allocated
+ */
+arc_dlist_t arc_dlist_create_pooled(size_t data_size);
 /**
  * @brief Destroys the memory associated to a list
  *
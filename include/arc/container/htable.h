@@ -16,7 +16,16 @@
  *
  * @brief Hash Table
  *
- * Implementation of a static hash table.
+ * Implementation of a hash table with two interchangeable backends: separate
+ * chaining, where every bucket is an AVL tree, and open addressing, where the
+ * elements are stored inline in a single contiguous slot array and collisions
+ * are resolved through linear probing. Both backends share the same interface,
+ * only the creation function differs.
+ *
+ * The table grows automatically whenever the maximum load factor is exceeded.
+ * The elements are not moved all at once, every following operation migrates
+ * a bounded number of buckets to the new bucket array, so no single call pays
+ * for the whole rehash.
  *
  * For more information and examples check the documentation
  * (\ref page_dhtable).
@@ -30,6 +39,7 @@
 #include <stdlib.h>
 #include <arc/type/hash.h>
 #include <arc/type/function.h>
+#include <arc/memory/allocator.h>
 
 #ifdef __cplusplus
 extern "C"{
@@ -45,7 +55,9 @@ typedef struct arc_htable * arc_htable_t;
 /**
  * @brief Creates a new htable
  *
- * @param[in] num_buckets Number of buckets in the hash table
+ * The table uses separate chaining with a maximum load factor of 1.
+ *
+ * @param[in] num_buckets Initial number of buckets in the hash table
  * @param[in] key_size Size of the key
  * @param[in] data_size Size of the data element
  * @param[in] hash_fn Hash function for the key type
@@ -56,6 +68,120 @@ arc_htable_t arc_htable_create(size_t num_buckets,
                                size_t data_size,
                                arc_cmp_fn_t cmp_fn,
                                arc_hash_fn_t hash_fn);
+/**
+ * @brief Creates a new htable whose nodes are allocated from a shared pool
+ *
+ * The table uses separate chaining and the nodes of every bucket are carved
+ * out of a single pool owned by the table, so clearing or destroying the
+ * table releases all of them at once instead of one by one.
+ *
+ * @param[in] num_buckets Initial number of buckets in the hash table
+ * @param[in] data_size Size of the data element
+ * @param[in] cmp_fn Comparison function for the data type
+ * @param[in] hash_fn Hash function for the data type
+ * @return New empty htable
+ * @retval NULL if memory cannot be allocated
+ */
+arc_htable_t arc_htable_create_pooled(size_t num_buckets,
+                                      size_t data_size,
+                                      arc_cmp_fn_t cmp_fn,
+                                      arc_hash_fn_t hash_fn);
+/**
+ * @brief Creates a new htable using open addressing
+ *
+ * The elements are stored inline in a contiguous slot array, so an insertion
+ * doesn't allocate memory unless the table has to grow and a lookup usually
+ * touches a single cache line. The number of slots is rounded up to the next
+ * power of two, the default maximum load factor is 0.75.
+ *
+ * @param[in] num_buckets Initial number of slots in the hash table
+ * @param[in] data_size Size of the data element
+ * @param[in] cmp_fn Comparison function for the data type
+ * @param[in] hash_fn Hash function for the data type
+ * @return New empty htable
+ * @retval NULL if memory cannot be allocated
+ */
+arc_htable_t arc_htable_create_open(size_t num_buckets,
+                                    size_t data_size,
+                                    arc_cmp_fn_t cmp_fn,
+                                    arc_hash_fn_t hash_fn);
+/**
+ * @brief Creates a new htable whose buckets and nodes are allocated with the
+ * given allocator
+ *
+ * @see arc_htable_create
+ *
+ * @param[in] num_buckets Initial number of buckets in the hash table
+ * @param[in] data_size Size of the data element
+ * @param[in] cmp_fn Comparison function for the data type
+ * @param[in] hash_fn Hash function for the data type
+ * @param[in] allocator Allocator for the table, NULL for the default one
+ * @return New empty htable
+ * @retval NULL if memory cannot be allocated
+ */
+arc_htable_t
+arc_htable_create_with_allocator(size_t num_buckets,
+                                 size_t data_size,
+                                 arc_cmp_fn_t cmp_fn,
+                                 arc_hash_fn_t hash_fn,
+                                 const struct arc_allocator *allocator);
+/**
+ * @brief Creates a new htable using open addressing whose slot array is
+ * allocated with the given allocator
+ *
+ * @see arc_htable_create_open
+ *
+ * @param[in] num_buckets Initial number of slots in the hash table
+ * @param[in] data_size Size of the data element
+ * @param[in] cmp_fn Comparison function for the data type
+ * @param[in] hash_fn Hash function for the data type
+ * @param[in] allocator Allocator for the table, NULL for the default one
+ * @return New empty htable
+ * @retval NULL if memory cannot be allocated
+ */
+arc_htable_t
+arc_htable_create_open_with_allocator(size_t num_buckets,
+                                      size_t data_size,
+                                      arc_cmp_fn_t cmp_fn,
+                                      arc_hash_fn_t hash_fn,
+                                      const struct arc_allocator *allocator);
+/**
+ * @brief Creates a new htable with a randomly seeded hash function
+ *
+ * Every table gets its own random seed, so the distribution of the keys
+ * among the buckets can't be predicted from outside. This should be used
+ * whenever the keys come from an untrusted source, otherwise keys crafted to
+ * collide under a fixed hash function degrade every operation.
+ *
+ * @param[in] num_buckets Initial number of buckets in the hash table
+ * @param[in] data_size Size of the data element
+ * @param[in] cmp_fn Comparison function for the data type
+ * @param[in] hash_fn Seeded hash function for the data type
+ * @return New empty htable
+ * @retval NULL if memory cannot be allocated
+ */
+arc_htable_t arc_htable_create_seeded(size_t num_buckets,
+                                      size_t data_size,
+                                      arc_cmp_fn_t cmp_fn,
+                                      arc_hash_seeded_fn_t hash_fn);
+/**
+ * @brief Creates a new htable using open addressing and a randomly seeded
+ * hash function
+ *
+ * @see arc_htable_create_open
+ * @see arc_htable_create_seeded
+ *
+ * @param[in] num_buckets Initial number of slots in the hash table
+ * @param[in] data_size Size of the data element
+ * @param[in] cmp_fn Comparison function for the data type
+ * @param[in] hash_fn Seeded hash function for the data type
+ * @return New empty htable
+ * @retval NULL if memory cannot be allocated
+ */
+arc_htable_t arc_htable_create_open_seeded(size_t num_buckets,
+                                           size_t data_size,
+                                           arc_cmp_fn_t cmp_fn,
+                                           arc_hash_seeded_fn_t hash_fn);
 /**
  * @brief Destroys the memory associated to a htable
  *
@@ -83,6 +209,22 @@ int arc_htable_insert(arc_htable_t htable, void *data);
  * @retval NULL If the element was not found
  */
 void *arc_htable_retrieve(arc_htable_t htable, void *data);
+/**
+ * @brief Retrieves several elements from the hash table at once
+ *
+ * All the keys of a group are hashed and their buckets prefetched before
+ * any of them is looked up, so the memory latency of the lookups overlaps
+ * instead of being paid serially as with repeated arc_htable_retrieve calls.
+ *
+ * @param[in] htable Hash table to perform the operation on
+ * @param[in] keys Array of n contiguous data elements to be found
+ * @param[in] n Number of elements to be found
+ * @param[out] results Array of n pointers, filled with the element found for
+ *                     every key or NULL if it's not in the htable
+ * @return Number of elements found
+ */
+size_t arc_htable_retrieve_batch(arc_htable_t htable, const void *keys,
+                                 size_t n, void **results);
 /**
  * @brief Returns whether the htable is empty or not
  *
@@ -111,9 +253,27 @@ void arc_htable_clear(arc_htable_t htable);
  * @param[in] key Key of the data element to be removed
  */
 void arc_htable_remove(arc_htable_t htable, void *data);
+/**
+ * @brief Sets the maximum load factor of the htable
+ *
+ * The load factor is the number of elements divided by the number of buckets,
+ * for open addressing the deleted slots are also taken into account. Once the
+ * next insertion would exceed the maximum, the number of buckets is doubled.
+ *
+ * @param[in] htable Hash table to perform the operation on
+ * @param[in] max_load_factor New maximum load factor
+ * @retval ARC_SUCCESS If the load factor was set successfully
+ * @retval ARC_ERROR If the load factor is not positive or, for open
+ *                   addressing, bigger than 0.95
+ */
+int arc_htable_set_max_load_factor(arc_htable_t htable,
+                                   double max_load_factor);
 /**
  * @brief Reestructures the table to contain the specified number of buckets
  *
+ * Unlike automatic growth the rehash is completed before returning. The number
+ * of buckets is raised if it's not enough to honour the maximum load factor.
+ *
  * @param[in] htable Hash table to perform the operation on
  * @param[in] num_buckets Number of buckets in the hash table
  * @retval ARC_SUCCESS If the rehashing was completed successfully
@@ -31,6 +31,7 @@
 #define ARC_QUEUE_H_
 
 #include <stdlib.h>
+#include <arc/memory/allocator.h>
 
 #ifdef __cplusplus
 extern "C"{
@@ -57,6 +58,30 @@ typedef struct arc_queue * arc_queue_t;
  * @retval NULL if memory cannot be allocated
  */
 arc_queue_t arc_queue_create(size_t data_size);
+/**
+ * @brief Creates a new queue whose nodes are allocated with the given
+ * allocator
+ *
+ * @param[in] data_size Size of the data element
+ * @param[in] allocator Allocator for the nodes, NULL for the default one
+ * @return New empty queue
+ * @retval NULL if memory cannot be allocated
+ */
+arc_queue_t
+arc_queue_create_with_allocator(size_t data_size,
+                                const struct arc_allocator *allocator);
+/**
+ * @brief Creates a new queue whose nodes are allocated from its own pool
+ *
+ * The nodes are carved out of large chunks which are kept until the queue is
+ * destroyed, so inserting and removing elements rarely calls malloc and the
+ * nodes are stored close to each other.
+ *
+ * @param[in] data_size Size of the data element
+ * @return New empty queue
+ * @retval NULL if memory cannot be allocated
+ */
+arc_queue_t arc_queue_create_pooled(size_t data_size);
 /**
  * @brief Destroys the memory associated to a queue
  *
@@ -0,0 +1,124 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @addtogroup SSet
+ * @{
+ *
+ * @author Anil M. Mahtani Mirchandani
+ * @date September, 2015
+ * @ingroup Container
+ *
+ * @brief Static Set
+ *
+ * Read only set built once from sorted data. The elements are stored in a
+ * single array in Eytzinger (breadth first) order: the children of the
+ * element at position k are at 2k and 2k + 1. The first levels of the search
+ * share a few cache lines, and since the descendants of an element four levels
+ * below are contiguous they are prefetched while the search goes down, so a
+ * lookup costs far fewer cache misses than in a sorted array or a tree.
+ *
+ * When the comparison function is arc_cmp_int, arc_cmp_long or arc_cmp_double
+ * and the element has the size of that type, the elements are compared
+ * directly.
+ *
+ * @see https://en.wikipedia.org/wiki/Binary_heap
+ */
+
+#ifndef ARC_SSET_H_
+#define ARC_SSET_H_
+
+#include <stdlib.h>
+#include <arc/type/function.h>
+#include <arc/container/darray.h>
+#include <arc/container/avltree.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @typedef arc_sset_t
+ * @brief Static set definition
+ */
+typedef struct arc_sset * arc_sset_t;
+
+/**
+ * @brief Creates a new sset from a sorted array
+ *
+ * @param[in] data_size Size of the data element
+ * @param[in] cmp_fn Comparison function for the data type, NULL to compare
+ *                   the bytes of the elements with memcmp
+ * @param[in] data Array of elements sorted by cmp_fn without duplicates
+ * @param[in] num Number of elements of the array
+ * @return New sset holding a copy of the elements
+ * @retval NULL if memory cannot be allocated
+ */
+arc_sset_t arc_sset_create(size_t data_size, arc_cmp_fn_t cmp_fn,
+                           const void * data, size_t num);
+/**
+ * @brief Creates a new sset from a sorted darray
+ *
+ * @param[in] darray Dynamic array sorted by cmp_fn without duplicates
+ * @param[in] cmp_fn Comparison function for the data type, NULL to compare
+ *                   the bytes of the elements with memcmp
+ * @return New sset holding a copy of the elements
+ * @retval NULL if memory cannot be allocated
+ */
+arc_sset_t arc_sset_create_from_darray(arc_darray_t darray,
+                                       arc_cmp_fn_t cmp_fn);
+/**
+ * @brief Creates a new sset with the elements of a tree
+ *
+ * The tree is walked in order, so it works for bstrees too. The sset uses the
+ * comparison function of the tree.
+ *
+ * @param[in] tree Tree to copy the elements from
+ * @return New sset holding a copy of the elements
+ * @retval NULL if memory cannot be allocated
+ */
+arc_sset_t arc_sset_create_from_avltree(arc_avltree_t tree);
+/**
+ * @brief Destroys the memory associated to an sset
+ *
+ * @param[in] sset Static set to perform the operation on
+ */
+void arc_sset_destroy(arc_sset_t sset);
+/**
+ * @brief Returns the number of elements of the sset
+ *
+ * @param[in] sset Static set to perform the operation on
+ * @return Size of the sset
+ */
+size_t arc_sset_size(arc_sset_t sset);
+/**
+ * @brief Finds an element in the sset
+ *
+ * @param[in] sset Static set to perform the operation on
+ * @param[in] data Data element to be found
+ * @return Data pointer of the element
+ * @retval NULL If the element was not found
+ */
+void * arc_sset_retrieve(arc_sset_t sset, const void * data);
+/**
+ * @brief Finds the smallest element which is not less than the key
+ *
+ * @param[in] sset Static set to perform the operation on
+ * @param[in] data Data element to compare with
+ * @return Data pointer of the element
+ * @retval NULL If every element is less than the key
+ */
+void * arc_sset_lower_bound(arc_sset_t sset, const void * data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARC_SSET_H_ */
+
+/** @} */
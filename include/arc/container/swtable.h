@@ -0,0 +1,152 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @addtogroup SWTable
+ * @{
+ *
+ * @author Anil M. Mahtani Mirchandani
+ * @date August, 2015
+ * @ingroup Container
+ *
+ * @brief Swiss Table
+ *
+ * Open addressing hash table in which every slot has an associated control
+ * byte, stored in a separate array, holding either the slot state (empty or
+ * deleted) or 7 bits of the hash of the element in the slot. Lookups compare
+ * the control bytes of a group of 16 slots at once (using SSE2 when available)
+ * and only the slots whose hash bits match are compared with the comparison
+ * function, hence most failed lookups are resolved without touching the
+ * elements at all.
+ *
+ * The table can be used as a set or, when the comparison and hash functions
+ * only take into account part of the element (the key), as a map.
+ *
+ * @see https://abseil.io/about/design/swisstables
+ */
+
+#ifndef ARC_SWTABLE_H_
+#define ARC_SWTABLE_H_
+
+#include <stdlib.h>
+#include <arc/type/hash.h>
+#include <arc/type/function.h>
+#include <arc/memory/allocator.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @typedef arc_swtable_t
+ * @brief Swiss table definition
+ */
+typedef struct arc_swtable * arc_swtable_t;
+
+/**
+ * @brief Creates a new swtable
+ *
+ * @param[in] capacity Initial number of elements the table can hold
+ * @param[in] data_size Size of the data element
+ * @param[in] cmp_fn Comparison function for the data type
+ * @param[in] hash_fn Hash function for the data type
+ * @return New empty swtable
+ * @retval NULL if memory cannot be allocated
+ */
+arc_swtable_t arc_swtable_create(size_t capacity,
+                                 size_t data_size,
+                                 arc_cmp_fn_t cmp_fn,
+                                 arc_hash_fn_t hash_fn);
+/**
+ * @brief Creates a new swtable whose control and slot arrays are allocated
+ * with the given allocator
+ *
+ * @param[in] capacity Initial number of elements the table can hold
+ * @param[in] data_size Size of the data element
+ * @param[in] cmp_fn Comparison function for the data type
+ * @param[in] hash_fn Hash function for the data type
+ * @param[in] allocator Allocator for the table, NULL for the default one
+ * @return New empty swtable
+ * @retval NULL if memory cannot be allocated
+ */
+arc_swtable_t
+arc_swtable_create_with_allocator(size_t capacity,
+                                  size_t data_size,
+                                  arc_cmp_fn_t cmp_fn,
+                                  arc_hash_fn_t hash_fn,
+                                  const struct arc_allocator *allocator);
+/**
+ * @brief Destroys the memory associated to a swtable
+ *
+ * @param[in] swtable Swiss table to perform the operation on
+ */
+void arc_swtable_destroy(arc_swtable_t swtable);
+/**
+ * @brief Inserts an element into the swtable
+ *
+ * @param[in] swtable Swiss table to perform the operation on
+ * @param[in] data Data element to be inserted
+ * @retval ARC_SUCCESS If the element was inserted successfully
+ * @retval ARC_DUPLICATE If the element is already in the swtable
+ * @retval ARC_OUT_OF_MEMORY If memory could not be allocated
+ */
+int arc_swtable_insert(arc_swtable_t swtable, const void *data);
+/**
+ * @brief Retrieves an element from the swtable
+ *
+ * @param[in] swtable Swiss table to perform the operation on
+ * @param[in] data Data element to be found
+ * @return Data element stored in the table
+ * @retval NULL If the element was not found
+ */
+void *arc_swtable_retrieve(arc_swtable_t swtable, const void *data);
+/**
+ * @brief Removes an element from the swtable
+ *
+ * @param[in] swtable Swiss table to perform the operation on
+ * @param[in] data Data element to be removed
+ */
+void arc_swtable_remove(arc_swtable_t swtable, const void *data);
+/**
+ * @brief Returns whether the swtable is empty or not
+ *
+ * @param[in] swtable Swiss table to perform the operation on
+ * @retval 0 If the swtable is not empty
+ * @retval 1 If the swtable is empty
+ */
+int arc_swtable_empty(arc_swtable_t swtable);
+/**
+ * @brief Returns the size of the swtable
+ *
+ * @param[in] swtable Swiss table to perform the operation on
+ * @return Size of the swtable
+ */
+size_t arc_swtable_size(arc_swtable_t swtable);
+/**
+ * @brief Clears the contents of the swtable
+ *
+ * @param[in] swtable Swiss table to perform the operation on
+ */
+void arc_swtable_clear(arc_swtable_t swtable);
+/**
+ * @brief Reestructures the table to hold at least the given number of elements
+ *
+ * @param[in] swtable Swiss table to perform the operation on
+ * @param[in] capacity Number of elements the table should be able to hold
+ * @retval ARC_SUCCESS If the rehashing was completed successfully
+ * @retval ARC_OUT_OF_MEMORY If memory could not be allocated
+ */
+int arc_swtable_rehash(arc_swtable_t swtable, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARC_SWTABLE_H_ */
+
+/** @} */
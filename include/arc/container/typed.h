@@ -0,0 +1,364 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @addtogroup Typed
+ * @{
+ *
+ * @author Anil M. Mahtani Mirchandani
+ * @date December, 2015
+ * @ingroup Container
+ *
+ * @brief Type specialized containers
+ *
+ * The generic containers handle their elements as opaque blocks of data_size
+ * bytes, so every insertion copies them with memcpy and every comparison is an
+ * indirect call through the comparison function. The macros in this file
+ * generate a set of functions for a concrete element type on top of the same
+ * containers, where elements are copied by assignment and the comparison is
+ * expanded in place, so the compiler can inline the whole operation.
+ *
+ * The generated containers are regular arc containers, everything which is
+ * not specialized (iterators, clear, ...) can be done with the generic API:
+ *
+ * @code
+ * #define int_cmp(a, b) ARC_TYPED_CMP(a, b)
+ *
+ * ARC_DEFINE_DARRAY(int_vec, int)
+ * ARC_DEFINE_AVLTREE(int_set, int, int_cmp)
+ *
+ * int_set_t set = int_set_create();
+ * int_set_insert(set, 42);
+ * it = arc_avltree_iterator_create(set);
+ * @endcode
+ */
+
+#ifndef ARC_TYPED_H_
+#define ARC_TYPED_H_
+
+#include <stdlib.h>
+#include <arc/common/defines.h>
+#include <arc/container/darray.h>
+#include <arc/container/avltree.h>
+#include <arc/container/darray_def.h>
+#include <arc/container/tree_def.h>
+#include <arc/container/avltree_def.h>
+
+/**
+ * @brief Three way comparison of two arithmetic values
+ *
+ * Evaluates to a negative value, 0 or a positive value if a is smaller, equal
+ * or bigger than b, without the overflow of the usual a - b.
+ */
+#define ARC_TYPED_CMP(a, b) (((a) > (b)) - ((a) < (b)))
+
+/**
+ * @brief Generates a dynamic array of elements of the given type
+ *
+ * The following type and functions are defined, the darray can be used with
+ * the generic arc_darray functions as well:
+ *
+ * - name_t: Handle of the container (struct arc_darray *)
+ * - name_t name_create(void)
+ * - void name_destroy(name_t darray)
+ * - int name_push_back(name_t darray, type value)
+ * - void name_pop_back(name_t darray)
+ * - type *name_at(name_t darray, size_t idx)
+ * - type *name_front(name_t darray)
+ * - type *name_back(name_t darray)
+ * - type *name_data(name_t darray), makes the elements contiguous first
+ * - size_t name_size(name_t darray)
+ * - int name_empty(name_t darray)
+ * - void name_clear(name_t darray)
+ *
+ * @param[in] name Prefix of the generated type and functions
+ * @param[in] type Type of the elements
+ */
+#define ARC_DEFINE_DARRAY(name, type)                                          \
+typedef struct arc_darray * name##_t;                                          \
+                                                                               \
+static ARC_INLINE name##_t name##_create(void)                                 \
+{                                                                              \
+    return arc_darray_create(sizeof(type));                                    \
+}                                                                              \
+                                                                               \
+static ARC_INLINE void name##_destroy(name##_t darray)                         \
+{                                                                              \
+    arc_darray_destroy(darray);                                                \
+}                                                                              \
+                                                                               \
+/* The elements start at the head and wrap around the end of the block */      \
+static ARC_INLINE type *name##_slot(name##_t darray, size_t idx)               \
+{                                                                              \
+    size_t pos = darray->head + idx;                                           \
+                                                                               \
+    if (pos >= darray->allocated_size)                                         \
+    {                                                                          \
+        pos -= darray->allocated_size;                                         \
+    }                                                                          \
+                                                                               \
+    return (type *)darray->data + pos;                                         \
+}                                                                              \
+                                                                               \
+static ARC_INLINE int name##_push_back(name##_t darray, type value)            \
+{                                                                              \
+    /* Only growing the array goes through the generic code */                 \
+    if (darray->size < darray->allocated_size)                                 \
+    {                                                                          \
+        *name##_slot(darray, darray->size) = value;                            \
+        darray->size++;                                                        \
+        return ARC_SUCCESS;                                                    \
+    }                                                                          \
+                                                                               \
+    return arc_darray_push_back(darray, &value);                               \
+}                                                                              \
+                                                                               \
+static ARC_INLINE void name##_pop_back(name##_t darray)                        \
+{                                                                              \
+    if (darray->size > 0)                                                      \
+    {                                                                          \
+        darray->size--;                                                        \
+    }                                                                          \
+                                                                               \
+    if (darray->size == 0)                                                     \
+    {                                                                          \
+        darray->head = 0;                                                      \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+static ARC_INLINE type *name##_at(name##_t darray, size_t idx)                 \
+{                                                                              \
+    return name##_slot(darray, idx);                                           \
+}                                                                              \
+                                                                               \
+static ARC_INLINE type *name##_front(name##_t darray)                          \
+{                                                                              \
+    return (darray->size == 0 ? NULL : name##_slot(darray, 0));                \
+}                                                                              \
+                                                                               \
+static ARC_INLINE type *name##_back(name##_t darray)                           \
+{                                                                              \
+    return (darray->size == 0 ? NULL :                                         \
+                                name##_slot(darray, darray->size - 1));        \
+}                                                                              \
+                                                                               \
+static ARC_INLINE type *name##_data(name##_t darray)                           \
+{                                                                              \
+    return (type *)arc_darray_linearize(darray);                               \
+}                                                                              \
+                                                                               \
+static ARC_INLINE size_t name##_size(name##_t darray)                          \
+{                                                                              \
+    return darray->size;                                                       \
+}                                                                              \
+                                                                               \
+static ARC_INLINE int name##_empty(name##_t darray)                            \
+{                                                                              \
+    return darray->size == 0;                                                  \
+}                                                                              \
+                                                                               \
+static ARC_INLINE void name##_clear(name##_t darray)                           \
+{                                                                              \
+    darray->size = 0;                                                          \
+    darray->head = 0;                                                          \
+}
+
+/**
+ * @brief Generates an avltree of elements of the given type
+ *
+ * The nodes store the element with its natural alignment and the comparison
+ * is expanded inline, the rebalancing and the node removal are shared with
+ * the generic avltree. The following type and functions are defined, the
+ * avltree can be used with the generic arc_avltree functions as well
+ * (iterators, clear, ...):
+ *
+ * - name_t: Handle of the container (struct arc_tree *)
+ * - int name_init(struct arc_tree *tree)
+ * - name_t name_create(void)
+ * - name_t name_create_pooled(void)
+ * - void name_destroy(name_t tree)
+ * - int name_insert(name_t tree, type value)
+ * - type *name_retrieve(name_t tree, type value)
+ * - void name_remove(name_t tree, type value)
+ * - size_t name_size(name_t tree)
+ * - int name_empty(name_t tree)
+ * - void name_clear(name_t tree)
+ *
+ * @param[in] name Prefix of the generated type and functions
+ * @param[in] type Type of the elements
+ * @param[in] cmp Function or macro taking two values of the type, returns a
+ *                negative value, 0 or a positive value if the first one is
+ *                smaller, equal or bigger than the second one
+ */
+#define ARC_DEFINE_AVLTREE(name, type, cmp)                                    \
+typedef struct arc_tree * name##_t;                                            \
+                                                                               \
+/* Same layout as struct arc_avltree_node up to the data */                    \
+struct name##_node                                                             \
+{                                                                              \
+    struct name##_node * parent;                                               \
+    struct name##_node * left;                                                 \
+    struct name##_node * right;                                                \
+    int balance_factor;                                                        \
+    size_t count;                                                              \
+    type data;                                                                 \
+};                                                                             \
+                                                                               \
+/* Used by the generic functions (iterator position, ...) */                   \
+static ARC_INLINE int name##_cmp_fn(const void *a, const void *b)              \
+{                                                                              \
+    int result = cmp(*(const type *)a, *(const type *)b);                      \
+    return (result > 0) - (result < 0);                                        \
+}                                                                              \
+                                                                               \
+static ARC_INLINE int name##_init(struct arc_tree *tree)                       \
+{                                                                              \
+    return arc_avltree_init_with_layout(tree, sizeof(type),                    \
+                                        ARC_OFFSETOF(struct name##_node,       \
+                                                     data),                    \
+                                        sizeof(struct name##_node),            \
+                                        &name##_cmp_fn, NULL);                 \
+}                                                                              \
+                                                                               \
+static ARC_INLINE name##_t name##_create(void)                                 \
+{                                                                              \
+    struct arc_tree *tree = (struct arc_tree *)                                \
+                            malloc(sizeof(struct arc_tree));                   \
+                                                                               \
+    if (tree == NULL)                                                          \
+    {                                                                          \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    if (name##_init(tree) != ARC_SUCCESS)                                      \
+    {                                                                          \
+        free(tree);                                                            \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    return tree;                                                               \
+}                                                                              \
+                                                                               \
+static ARC_INLINE name##_t name##_create_pooled(void)                          \
+{                                                                              \
+    struct arc_tree *tree = name##_create();                                   \
+                                                                               \
+    if (tree != NULL && arc_tree_init_pool(tree) != ARC_SUCCESS)               \
+    {                                                                          \
+        arc_avltree_destroy(tree);                                             \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    return tree;                                                               \
+}                                                                              \
+                                                                               \
+static ARC_INLINE void name##_destroy(name##_t tree)                           \
+{                                                                              \
+    arc_avltree_destroy(tree);                                                 \
+}                                                                              \
+                                                                               \
+static ARC_INLINE struct name##_node *name##_find(name##_t tree,               \
+                                                 type value)                   \
+{                                                                              \
+    struct name##_node *node = (struct name##_node *)tree->root;               \
+                                                                               \
+    while (node != NULL)                                                       \
+    {                                                                          \
+        int result = cmp(node->data, value);                                   \
+                                                                               \
+        if (result < 0)                                                        \
+        {                                                                      \
+            node = node->right;                                                \
+        }                                                                      \
+        else if (result > 0)                                                   \
+        {                                                                      \
+            node = node->left;                                                 \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            return node;                                                       \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    return NULL;                                                               \
+}                                                                              \
+                                                                               \
+static ARC_INLINE int name##_insert(name##_t tree, type value)                 \
+{                                                                              \
+    struct name##_node *parent = NULL;                                         \
+    struct name##_node *node = (struct name##_node *)tree->root;               \
+    struct name##_node **node_ref = (struct name##_node **)&tree->root;        \
+                                                                               \
+    while (node != NULL)                                                       \
+    {                                                                          \
+        int result = cmp(node->data, value);                                   \
+                                                                               \
+        if (result == 0)                                                       \
+        {                                                                      \
+            return ARC_DUPLICATE;                                              \
+        }                                                                      \
+                                                                               \
+        parent = node;                                                         \
+        node_ref = (result < 0 ? &node->right : &node->left);                  \
+        node = *node_ref;                                                      \
+    }                                                                          \
+                                                                               \
+    node = (struct name##_node *)ARC_ALLOC(&tree->allocator,                   \
+                                           tree->node_size);                   \
+                                                                               \
+    if (node == NULL)                                                          \
+    {                                                                          \
+        return ARC_OUT_OF_MEMORY;                                              \
+    }                                                                          \
+                                                                               \
+    node->parent = parent;                                                     \
+    node->left = NULL;                                                         \
+    node->right = NULL;                                                        \
+    node->balance_factor = 0;                                                  \
+    node->data = value;                                                        \
+    *node_ref = node;                                                          \
+                                                                               \
+    arc_avltree_insert_fixup(tree, (struct arc_tree_snode *)node);             \
+                                                                               \
+    return ARC_SUCCESS;                                                        \
+}                                                                              \
+                                                                               \
+static ARC_INLINE type *name##_retrieve(name##_t tree, type value)             \
+{                                                                              \
+    struct name##_node *node = name##_find(tree, value);                       \
+    return (node == NULL ? NULL : &node->data);                                \
+}                                                                              \
+                                                                               \
+static ARC_INLINE void name##_remove(name##_t tree, type value)                \
+{                                                                              \
+    struct name##_node *node = name##_find(tree, value);                       \
+                                                                               \
+    if (node != NULL)                                                          \
+    {                                                                          \
+        (*tree->remove_fn)(tree, (struct arc_tree_snode *)node);               \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+static ARC_INLINE size_t name##_size(name##_t tree)                            \
+{                                                                              \
+    return tree->size;                                                         \
+}                                                                              \
+                                                                               \
+static ARC_INLINE int name##_empty(name##_t tree)                              \
+{                                                                              \
+    return tree->size == 0;                                                    \
+}                                                                              \
+                                                                               \
+static ARC_INLINE void name##_clear(name##_t tree)                             \
+{                                                                              \
+    arc_avltree_clear(tree);                                                   \
+}
+
+#endif /* ARC_TYPED_H_ */
+
+/** @} */
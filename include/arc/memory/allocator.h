@@ -0,0 +1,98 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @addtogroup Allocator
+ * @{
+ *
+ * @author Anil M. Mahtani Mirchandani
+ * @date September, 2015
+ * @ingroup Memory
+ *
+ * @brief Allocator interface
+ *
+ * Every container allocates the memory for its elements (nodes, blocks or
+ * buckets) through an allocator, which can be given on creation through the
+ * *_create_with_allocator functions. The container handles and iterators are
+ * always allocated with malloc. The allocator is copied into the container,
+ * but the memory pointed to by its context must outlive the container.
+ */
+#ifndef ARC_ALLOCATOR_H_
+#define ARC_ALLOCATOR_H_
+
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @typedef arc_alloc_fn_t
+ * @brief Allocates size bytes, returns NULL if memory cannot be allocated
+ */
+typedef void * (*arc_alloc_fn_t)(void *ctx, size_t size);
+/**
+ * @typedef arc_free_fn_t
+ * @brief Releases a block returned by the allocator, ptr is never NULL
+ */
+typedef void (*arc_free_fn_t)(void *ctx, void *ptr);
+/**
+ * @typedef arc_realloc_fn_t
+ * @brief Resizes a block returned by the allocator, ptr might be NULL
+ */
+typedef void * (*arc_realloc_fn_t)(void *ctx, void *ptr, size_t size);
+
+/**
+ * @struct arc_allocator
+ * @brief Allocator definition
+ */
+struct arc_allocator
+{
+    arc_alloc_fn_t alloc_fn;
+    arc_free_fn_t free_fn;
+    arc_realloc_fn_t realloc_fn;
+    void *ctx; /**< Passed as first argument to every function */
+};
+
+/**
+ * @brief Allocator based on malloc, free and realloc, used by default
+ */
+extern const struct arc_allocator arc_default_allocator;
+/**
+ * @brief Allocator which gives every block its own anonymous memory mapping
+ *
+ * Meant for very large blocks, such as the data of a darray with millions of
+ * elements, since each block takes at least one page. Resizing a block with
+ * mremap extends the mapping in place or moves its pages, so the contents are
+ * never copied (on systems without mremap they are).
+ */
+extern const struct arc_allocator arc_mmap_allocator;
+/**
+ * @brief Same as arc_mmap_allocator, but the mappings are advised to use
+ * transparent huge pages, which reduces the page faults and TLB misses
+ * when going through the block
+ */
+extern const struct arc_allocator arc_mmap_huge_allocator;
+
+/** @brief Allocates size bytes with the given allocator */
+#define ARC_ALLOC(allocator, size) \
+    ((*(allocator)->alloc_fn)((allocator)->ctx, (size)))
+/** @brief Releases ptr with the given allocator */
+#define ARC_FREE(allocator, ptr) \
+    ((*(allocator)->free_fn)((allocator)->ctx, (ptr)))
+/** @brief Resizes ptr to size bytes with the given allocator */
+#define ARC_REALLOC(allocator, ptr, size) \
+    ((*(allocator)->realloc_fn)((allocator)->ctx, (ptr), (size)))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARC_ALLOCATOR_H_ */
+
+/** @} */
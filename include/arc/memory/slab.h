@@ -0,0 +1,121 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @addtogroup Slab
+ * @{
+ *
+ * @author Anil M. Mahtani Mirchandani
+ * @date September, 2015
+ * @ingroup Memory
+ *
+ * @brief Fixed size object allocator
+ *
+ * The slab carves objects of a single size out of large chunks of memory.
+ * Released objects are kept in an intrusive free list and reused by the next
+ * allocations, so allocating and releasing an object is a pointer pop and
+ * push. The chunks are only returned to the system when the slab is
+ * destroyed. Objects allocated consecutively are placed next to each other,
+ * which improves the locality of linked structures built from them.
+ *
+ * Every object is aligned to the strictest alignment among pointers, longs
+ * and doubles.
+ */
+#ifndef ARC_SLAB_H_
+#define ARC_SLAB_H_
+
+#include <stdlib.h>
+#include <arc/memory/allocator.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @typedef arc_slab_t
+ * @brief Slab definition
+ */
+typedef struct arc_slab * arc_slab_t;
+
+/**
+ * @brief Creates a new slab
+ *
+ * @param[in] object_size Size of every object allocated from the slab
+ * @return New empty slab
+ * @retval NULL if memory cannot be allocated
+ */
+arc_slab_t arc_slab_create(size_t object_size);
+/**
+ * @brief Destroys the slab and every object allocated from it
+ *
+ * @param[in] slab Slab to perform the operation on
+ */
+void arc_slab_destroy(arc_slab_t slab);
+/**
+ * @brief Allocates an object from the slab
+ *
+ * @param[in] slab Slab to perform the operation on
+ * @return Uninitialised object
+ * @retval NULL if memory cannot be allocated
+ */
+void * arc_slab_alloc(arc_slab_t slab);
+/**
+ * @brief Allocates several objects from the slab, next to each other
+ *
+ * They are taken from the unused tail of the latest chunk if they fit in it,
+ * otherwise from a new chunk of the exact size. Every object can be returned
+ * to the slab on its own.
+ *
+ * @param[in] slab Slab to perform the operation on
+ * @param[in] num Number of objects, it must not be 0
+ * @return First object, the rest follow it every object size bytes
+ * @retval NULL if memory cannot be allocated or the size of the array
+ * overflows
+ */
+void * arc_slab_alloc_array(arc_slab_t slab, size_t num);
+/**
+ * @brief Returns the size of the objects including their padding
+ *
+ * @param[in] slab Slab to perform the operation on
+ * @return Distance between consecutive objects
+ */
+size_t arc_slab_object_size(arc_slab_t slab);
+/**
+ * @brief Returns an object to the slab
+ *
+ * @param[in] slab Slab to perform the operation on
+ * @param[in] ptr Object previously allocated from the same slab
+ */
+void arc_slab_free(arc_slab_t slab, void *ptr);
+/**
+ * @brief Releases every object allocated from the slab at once
+ *
+ * Only the latest chunk is kept, the following allocations are carved out of
+ * it again.
+ *
+ * @param[in] slab Slab to perform the operation on
+ */
+void arc_slab_clear(arc_slab_t slab);
+/**
+ * @brief Fills an allocator that allocates its memory from the slab
+ *
+ * Requests bigger than the object size of the slab fail and realloc only
+ * succeeds if the new size still fits in an object.
+ *
+ * @param[in] slab Slab to perform the operation on
+ * @param[out] allocator Allocator to be filled
+ */
+void arc_slab_get_allocator(arc_slab_t slab, struct arc_allocator *allocator);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARC_SLAB_H_ */
+
+/** @} */
@@ -0,0 +1,112 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @addtogroup Pool
+ * @{
+ *
+ * @author Anil M. Mahtani Mirchandani
+ * @date September, 2015
+ * @ingroup Thread
+ *
+ * @brief Thread pool
+ *
+ * A fixed number of POSIX threads run the tasks submitted to the pool in
+ * the order they were submitted. The tasks are kept in a queue which grows
+ * as needed.
+ *
+ * Divide and conquer algorithms can use the pool as a fork-join facility:
+ * arc_pool_fork_join runs two functions in parallel and can be nested from
+ * the tasks themselves.
+ */
+#ifndef ARC_POOL_H_
+#define ARC_POOL_H_
+
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @typedef arc_pool_t
+ * @brief Thread pool definition
+ */
+typedef struct arc_pool * arc_pool_t;
+/**
+ * @typedef arc_task_fn_t
+ * @brief Function run by the pool with the argument given on submission
+ */
+typedef void (*arc_task_fn_t)(void *);
+
+/**
+ * @brief Creates a new pool and starts its threads
+ *
+ * @param[in] num_threads Number of threads, 0 for one per online processor
+ * @return New pool
+ * @retval NULL if memory or the threads cannot be allocated
+ */
+arc_pool_t arc_pool_create(unsigned num_threads);
+/**
+ * @brief Waits for the submitted tasks, stops the threads and destroys the
+ * pool
+ *
+ * @param[in] pool Pool to perform the operation on
+ */
+void arc_pool_destroy(arc_pool_t pool);
+/**
+ * @brief Returns the number of threads of the pool
+ *
+ * @param[in] pool Pool to perform the operation on
+ * @return Number of threads
+ */
+unsigned arc_pool_num_threads(arc_pool_t pool);
+/**
+ * @brief Queues a task to be run by one of the threads
+ *
+ * @param[in] pool Pool to perform the operation on
+ * @param[in] fn Function to run
+ * @param[in] arg Argument passed to the function
+ * @retval ARC_SUCCESS If the task was queued
+ * @retval ARC_OUT_OF_MEMORY If memory could not be allocated
+ */
+int arc_pool_submit(arc_pool_t pool, arc_task_fn_t fn, void * arg);
+/**
+ * @brief Runs two functions, in parallel if a thread of the pool is free,
+ * and returns once both have finished
+ *
+ * The first function is run by the caller and the second one is queued. If
+ * no thread has taken it by the time the first one finishes, the caller runs
+ * it as well. Otherwise the caller runs other queued tasks while waiting, so
+ * it can be called from a task of the same pool, at any depth.
+ *
+ * @param[in] pool Pool to perform the operation on, NULL to run both
+ *                 functions one after the other
+ * @param[in] fn1 First function
+ * @param[in] arg1 Argument passed to the first function
+ * @param[in] fn2 Second function
+ * @param[in] arg2 Argument passed to the second function
+ */
+void arc_pool_fork_join(arc_pool_t pool, arc_task_fn_t fn1, void * arg1,
+                        arc_task_fn_t fn2, void * arg2);
+/**
+ * @brief Waits until every task submitted to the pool has finished
+ *
+ * It must not be called from a task of the same pool.
+ *
+ * @param[in] pool Pool to perform the operation on
+ */
+void arc_pool_wait(arc_pool_t pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARC_POOL_H_ */
+
+/** @} */
@@ -40,6 +40,26 @@ int arc_cmp_ulong(const void * a, const void * b);
 int arc_cmp_float(const void * a, const void * b);
 int arc_cmp_double(const void * a, const void * b);
 
+/**
+ * @typedef arc_key_fn_t
+ * @brief Key extraction function
+ *
+ * Maps an element to an unsigned key which keeps the order of the elements,
+ * used by the radix sort.
+ */
+typedef unsigned long (*arc_key_fn_t)(const void *);
+
+unsigned long arc_key_int(const void * a);
+unsigned long arc_key_uint(const void * a);
+unsigned long arc_key_long(const void * a);
+unsigned long arc_key_ulong(const void * a);
+unsigned long arc_key_float(const void * a);
+/**
+ * @brief Key of a double, it only keeps the order exactly if unsigned long
+ * has 64 bits
+ */
+unsigned long arc_key_double(const void * a);
+
 #ifdef __cplusplus
 }
 #endif
@@ -34,6 +34,14 @@ typedef unsigned long arc_hkey_t;
  * @brief Hash function type definition
  */
 typedef arc_hkey_t (*arc_hash_fn_t)(const void *, size_t);
+/**
+ * @typedef arc_hash_seeded_fn_t
+ * @brief Seeded hash function type definition
+ *
+ * The seed selects one hash function out of a family, keys crafted to collide
+ * under one seed are not expected to collide under another one.
+ */
+typedef arc_hkey_t (*arc_hash_seeded_fn_t)(const void *, size_t, arc_hkey_t);
 
 /**
  * @brief Computes a hash value for a block of memory
@@ -48,6 +56,86 @@ typedef arc_hkey_t (*arc_hash_fn_t)(const void *, size_t);
  */
 arc_hkey_t arc_hash_pearson(const void *data, size_t data_size);
 arc_hkey_t arc_hash_djb2(const void *data, size_t data_size);
+/**
+ * @brief Computes a hash value for a block of memory
+ *
+ * Word at a time hash with strong avalanche following the wyhash design,
+ * keys of up to 16 bytes are hashed with a single wide multiplication. On
+ * platforms without a 64 bit arc_hkey_t it falls back to murmur3.
+ * @see https://github.com/wangyi-fudan/wyhash
+ *
+ * @param[in] data Data block from which to compute the hash value
+ * @param[in] data_size Size of the data element
+ * @return Hash value for the block of data
+ */
+arc_hkey_t arc_hash_wy(const void *data, size_t data_size);
+/**
+ * @brief Computes a hash value for a 4 byte key
+ *
+ * @param[in] data Key from which to compute the hash value
+ * @param[in] data_size Ignored, the key is always 4 bytes long
+ * @return Hash value for the key
+ */
+arc_hkey_t arc_hash_int32(const void *data, size_t data_size);
+/**
+ * @brief Computes a hash value for an 8 byte key
+ *
+ * @param[in] data Key from which to compute the hash value
+ * @param[in] data_size Ignored, the key is always 8 bytes long
+ * @return Hash value for the key
+ */
+arc_hkey_t arc_hash_int64(const void *data, size_t data_size);
+/**
+ * @brief Scrambles an integer key so that every input bit affects every
+ * output bit
+ *
+ * @param[in] key Key to be mixed
+ * @return Mixed key
+ */
+arc_hkey_t arc_hash_mix_int(arc_hkey_t key);
+/**
+ * @brief Seeded version of arc_hash_wy
+ *
+ * @param[in] data Data block from which to compute the hash value
+ * @param[in] data_size Size of the data element
+ * @param[in] seed Seed of the hash function
+ * @return Hash value for the block of data
+ */
+arc_hkey_t arc_hash_wy_seeded(const void *data, size_t data_size,
+                              arc_hkey_t seed);
+/**
+ * @brief Seeded version of arc_hash_int32
+ *
+ * @param[in] data Key from which to compute the hash value
+ * @param[in] data_size Ignored, the key is always 4 bytes long
+ * @param[in] seed Seed of the hash function
+ * @return Hash value for the key
+ */
+arc_hkey_t arc_hash_int32_seeded(const void *data, size_t data_size,
+                                 arc_hkey_t seed);
+/**
+ * @brief Seeded version of arc_hash_int64
+ *
+ * @param[in] data Key from which to compute the hash value
+ * @param[in] data_size Ignored, the key is always 8 bytes long
+ * @param[in] seed Seed of the hash function
+ * @return Hash value for the key
+ */
+arc_hkey_t arc_hash_int64_seeded(const void *data, size_t data_size,
+                                 arc_hkey_t seed);
+/**
+ * @brief Returns a random seed for a seeded hash function
+ *
+ * The entropy is read from /dev/urandom once per process, if it's not
+ * available it is derived from the current time and the address space
+ * layout. Every call mixes it with the salt and a counter, so the calls
+ * of a process get unrelated seeds. It can be called from several threads.
+ *
+ * @param[in] salt Address mixed into the seed, such as the one of the table
+ *                 using it, it might be NULL
+ * @return Random seed
+ */
+arc_hkey_t arc_hash_random_seed(const void *salt);
 
 #ifdef __cplusplus
 }
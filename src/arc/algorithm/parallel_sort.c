@@ -0,0 +1,355 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @file parallel_sort.c
+ * @author Anil M. Mahtani Mirchandani
+ * @date September, 2015
+ *
+ * @brief Parallel sample sort of plain arrays
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <arc/common/defines.h>
+#include <arc/type/function.h>
+#include <arc/thread/pool.h>
+#include <arc/algorithm/sort.h>
+
+struct arc_psort_run
+{
+    const char * cur;
+    const char * end;
+};
+
+struct arc_psort
+{
+    char * base;
+    char * buffer;
+    size_t num;
+    size_t size;
+    arc_cmp_fn_t cmp_fn;
+    size_t num_chunks;
+    /* Element of each chunk where each part starts, num_chunks + 1 per chunk */
+    size_t * bounds;
+    /* Position of each part in the sorted array */
+    size_t * offsets;
+    /* num_chunks runs for each part */
+    struct arc_psort_run * runs;
+};
+
+struct arc_psort_task
+{
+    struct arc_psort * sort;
+    size_t index;
+};
+
+/******************************************************************************/
+
+static size_t arc_psort_chunk_start(const struct arc_psort * sort, size_t chunk)
+{
+    size_t q = sort->num / sort->num_chunks;
+    size_t r = sort->num % sort->num_chunks;
+
+    return chunk * q + (chunk < r ? chunk : r);
+}
+
+/******************************************************************************/
+
+static void arc_psort_sort_chunk(void * arg)
+{
+    struct arc_psort_task * task = arg;
+    struct arc_psort * sort = task->sort;
+    size_t first = arc_psort_chunk_start(sort, task->index);
+    size_t last = arc_psort_chunk_start(sort, task->index + 1);
+
+    arc_sort(sort->base + first * sort->size, last - first,
+             sort->size, sort->cmp_fn);
+}
+
+/******************************************************************************/
+
+/* Compares the bytes of the elements when there is no comparison function,
+   as arc_sort does */
+static int arc_psort_compare(const struct arc_psort * sort,
+                             const void * a, const void * b)
+{
+    if (sort->cmp_fn == NULL)
+    {
+        return memcmp(a, b, sort->size);
+    }
+
+    return (*sort->cmp_fn)(a, b);
+}
+
+/******************************************************************************/
+
+/* Restores the heap property of the runs from the given root, the run with
+   the smallest current element goes first */
+static void arc_psort_sift_down(const struct arc_psort * sort,
+                                struct arc_psort_run * runs, size_t root,
+                                size_t num)
+{
+    struct arc_psort_run run = runs[root];
+    size_t child;
+
+    while ((child = 2 * root + 1) < num)
+    {
+        if (child + 1 < num &&
+            arc_psort_compare(sort, runs[child + 1].cur, runs[child].cur) < 0)
+        {
+            child++;
+        }
+
+        if (arc_psort_compare(sort, runs[child].cur, run.cur) >= 0)
+        {
+            break;
+        }
+
+        runs[root] = runs[child];
+        root = child;
+    }
+
+    runs[root] = run;
+}
+
+/******************************************************************************/
+
+/* Merges the piece of every chunk that belongs to a part into the buffer */
+static void arc_psort_merge_part(void * arg)
+{
+    struct arc_psort_task * task = arg;
+    struct arc_psort * sort = task->sort;
+    struct arc_psort_run * runs = sort->runs + task->index * sort->num_chunks;
+    size_t size = sort->size;
+    char * out = sort->buffer + sort->offsets[task->index] * size;
+    size_t num_runs = 0;
+    size_t i;
+
+    for (i = 0; i < sort->num_chunks; i++)
+    {
+        const size_t * bounds = sort->bounds + i * (sort->num_chunks + 1);
+        char * chunk = sort->base + arc_psort_chunk_start(sort, i) * size;
+
+        if (bounds[task->index] < bounds[task->index + 1])
+        {
+            runs[num_runs].cur = chunk + bounds[task->index] * size;
+            runs[num_runs].end = chunk + bounds[task->index + 1] * size;
+            num_runs++;
+        }
+    }
+
+    for (i = num_runs / 2; i > 0; i--)
+    {
+        arc_psort_sift_down(sort, runs, i - 1, num_runs);
+    }
+
+    while (num_runs > 1)
+    {
+        memcpy(out, runs[0].cur, size);
+        out += size;
+        runs[0].cur += size;
+
+        if (runs[0].cur == runs[0].end)
+        {
+            runs[0] = runs[--num_runs];
+        }
+
+        arc_psort_sift_down(sort, runs, 0, num_runs);
+    }
+
+    if (num_runs == 1)
+    {
+        memcpy(out, runs[0].cur, (size_t)(runs[0].end - runs[0].cur));
+    }
+}
+
+/******************************************************************************/
+
+static void arc_psort_copy_part(void * arg)
+{
+    struct arc_psort_task * task = arg;
+    struct arc_psort * sort = task->sort;
+    size_t first = sort->offsets[task->index];
+    size_t last = sort->offsets[task->index + 1];
+
+    memcpy(sort->base + first * sort->size, sort->buffer + first * sort->size,
+           (last - first) * sort->size);
+}
+
+/******************************************************************************/
+
+/* Runs one task per chunk and waits for all of them, a task which cannot be
+   queued is run by the caller */
+static void arc_psort_run_tasks(struct arc_pool * pool,
+                                struct arc_psort_task * tasks, size_t num,
+                                arc_task_fn_t fn)
+{
+    size_t i;
+
+    for (i = 0; i < num; i++)
+    {
+        if (arc_pool_submit(pool, fn, &tasks[i]) != ARC_SUCCESS)
+        {
+            (*fn)(&tasks[i]);
+        }
+    }
+
+    arc_pool_wait(pool);
+}
+
+/******************************************************************************/
+
+/* First element of a sorted range which is not less than the key */
+static size_t arc_psort_lower_bound(const struct arc_psort * sort,
+                                    const char * a, size_t num,
+                                    const void * key)
+{
+    size_t first = 0;
+
+    while (num > 0)
+    {
+        size_t half = num / 2;
+
+        if (arc_psort_compare(sort, a + (first + half) * sort->size, key) < 0)
+        {
+            first += half + 1;
+            num -= half + 1;
+        }
+        else
+        {
+            num = half;
+        }
+    }
+
+    return first;
+}
+
+/******************************************************************************/
+
+/* Picks num_chunks - 1 splitters from evenly spaced samples of the sorted
+   chunks and finds where each of them falls in every chunk */
+static void arc_psort_partition(struct arc_psort * sort, char * samples)
+{
+    size_t k = sort->num_chunks;
+    size_t size = sort->size;
+    size_t i, j;
+
+    for (i = 0; i < k; i++)
+    {
+        size_t first = arc_psort_chunk_start(sort, i);
+        size_t len = arc_psort_chunk_start(sort, i + 1) - first;
+
+        for (j = 0; j < k; j++)
+        {
+            memcpy(samples + (i * k + j) * size,
+                   sort->base + (first + (j + 1) * len / (k + 1)) * size,
+                   size);
+        }
+    }
+
+    arc_sort(samples, k * k, size, sort->cmp_fn);
+
+    for (i = 0; i < k; i++)
+    {
+        size_t first = arc_psort_chunk_start(sort, i);
+        size_t len = arc_psort_chunk_start(sort, i + 1) - first;
+        size_t * bounds = sort->bounds + i * (k + 1);
+
+        bounds[0] = 0;
+        bounds[k] = len;
+
+        for (j = 1; j < k; j++)
+        {
+            bounds[j] = arc_psort_lower_bound(sort, sort->base + first * size,
+                                              len, samples + j * k * size);
+        }
+    }
+
+    for (j = 0; j <= k; j++)
+    {
+        sort->offsets[j] = 0;
+
+        for (i = 0; i < k; i++)
+        {
+            sort->offsets[j] += sort->bounds[i * (k + 1) + j];
+        }
+    }
+}
+
+/******************************************************************************/
+
+int arc_parallel_sort(void * base, size_t num, size_t size,
+                      arc_cmp_fn_t cmp_fn, arc_pool_t pool)
+{
+    struct arc_psort sort;
+    struct arc_psort_task * tasks;
+    char * samples;
+    size_t k = arc_pool_num_threads(pool);
+    size_t i;
+
+    if (k > num / ARC_PARALLEL_SORT_MIN_CHUNK)
+    {
+        k = num / ARC_PARALLEL_SORT_MIN_CHUNK;
+    }
+
+    if (k < 2)
+    {
+        arc_sort(base, num, size, cmp_fn);
+        return ARC_SUCCESS;
+    }
+
+    sort.base = base;
+    sort.num = num;
+    sort.size = size;
+    sort.cmp_fn = cmp_fn;
+    sort.num_chunks = k;
+
+    sort.buffer = malloc(num * size);
+    sort.bounds = malloc(k * (k + 1) * sizeof(size_t));
+    sort.offsets = malloc((k + 1) * sizeof(size_t));
+    sort.runs = malloc(k * k * sizeof(struct arc_psort_run));
+    tasks = malloc(k * sizeof(struct arc_psort_task));
+    samples = malloc(k * k * size);
+
+    if (sort.buffer == NULL || sort.bounds == NULL || sort.offsets == NULL ||
+        sort.runs == NULL || tasks == NULL || samples == NULL)
+    {
+        free(samples);
+        free(tasks);
+        free(sort.runs);
+        free(sort.offsets);
+        free(sort.bounds);
+        free(sort.buffer);
+        return ARC_OUT_OF_MEMORY;
+    }
+
+    for (i = 0; i < k; i++)
+    {
+        tasks[i].sort = &sort;
+        tasks[i].index = i;
+    }
+
+    arc_psort_run_tasks(pool, tasks, k, &arc_psort_sort_chunk);
+
+    arc_psort_partition(&sort, samples);
+
+    /* Part i of every chunk is merged into part i of the buffer */
+    arc_psort_run_tasks(pool, tasks, k, &arc_psort_merge_part);
+    arc_psort_run_tasks(pool, tasks, k, &arc_psort_copy_part);
+
+    free(samples);
+    free(tasks);
+    free(sort.runs);
+    free(sort.offsets);
+    free(sort.bounds);
+    free(sort.buffer);
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
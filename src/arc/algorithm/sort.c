@@ -0,0 +1,533 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @file sort.c
+ * @author Anil M. Mahtani Mirchandani
+ * @date September, 2015
+ *
+ * @brief Sorting of plain arrays
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <arc/common/defines.h>
+#include <arc/type/function.h>
+#include <arc/algorithm/sort.h>
+
+/* Partitions up to this size are left to the insertion sort */
+#define ARC_SORT_THRESHOLD 16
+
+#define ARC_RADIX_BUCKETS 256
+
+/* Introsort for a type which can be compared with < */
+#define ARC_SORT_DEFINE(name, type)                                            \
+static void name##_insertion(type * a, size_t num)                             \
+{                                                                              \
+    size_t i, j;                                                               \
+                                                                               \
+    for (i = 1; i < num; i++)                                                  \
+    {                                                                          \
+        type value = a[i];                                                     \
+                                                                               \
+        for (j = i; j > 0 && value < a[j - 1]; j--)                            \
+        {                                                                      \
+            a[j] = a[j - 1];                                                   \
+        }                                                                      \
+                                                                               \
+        a[j] = value;                                                          \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+static void name##_sift_down(type * a, size_t root, size_t num)                \
+{                                                                              \
+    type value = a[root];                                                      \
+    size_t child = 2 * root + 1;                                               \
+                                                                               \
+    while (child < num)                                                        \
+    {                                                                          \
+        if (child + 1 < num && a[child] < a[child + 1])                        \
+        {                                                                      \
+            child++;                                                           \
+        }                                                                      \
+                                                                               \
+        if (!(value < a[child]))                                               \
+        {                                                                      \
+            break;                                                             \
+        }                                                                      \
+                                                                               \
+        a[root] = a[child];                                                    \
+        root = child;                                                          \
+        child = 2 * root + 1;                                                  \
+    }                                                                          \
+                                                                               \
+    a[root] = value;                                                           \
+}                                                                              \
+                                                                               \
+static void name##_heapsort(type * a, size_t num)                              \
+{                                                                              \
+    size_t i;                                                                  \
+                                                                               \
+    for (i = num / 2; i > 0; i--)                                              \
+    {                                                                          \
+        name##_sift_down(a, i - 1, num);                                       \
+    }                                                                          \
+                                                                               \
+    for (i = num - 1; i > 0; i--)                                              \
+    {                                                                          \
+        type tmp = a[0];                                                       \
+        a[0] = a[i];                                                           \
+        a[i] = tmp;                                                            \
+        name##_sift_down(a, 0, i);                                             \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+static void name##_introsort(type * a, size_t num, size_t depth)               \
+{                                                                              \
+    while (num > ARC_SORT_THRESHOLD)                                           \
+    {                                                                          \
+        size_t i = 0, j = num, mid = num / 2;                                  \
+        type pivot, tmp;                                                       \
+                                                                               \
+        if (depth == 0)                                                        \
+        {                                                                      \
+            name##_heapsort(a, num);                                           \
+            return;                                                            \
+        }                                                                      \
+                                                                               \
+        depth--;                                                               \
+                                                                               \
+        /* Median of three, the last element stops the forward scan */         \
+        if (a[mid] < a[0])                                                     \
+        {                                                                      \
+            tmp = a[mid]; a[mid] = a[0]; a[0] = tmp;                           \
+        }                                                                      \
+                                                                               \
+        if (a[num - 1] < a[mid])                                               \
+        {                                                                      \
+            tmp = a[mid]; a[mid] = a[num - 1]; a[num - 1] = tmp;               \
+                                                                               \
+            if (a[mid] < a[0])                                                 \
+            {                                                                  \
+                tmp = a[mid]; a[mid] = a[0]; a[0] = tmp;                       \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        pivot = a[mid];                                                        \
+        a[mid] = a[0];                                                         \
+        a[0] = pivot;                                                          \
+                                                                               \
+        for (;;)                                                               \
+        {                                                                      \
+            do { i++; } while (a[i] < pivot);                                  \
+            do { j--; } while (pivot < a[j]);                                  \
+                                                                               \
+            if (i >= j)                                                        \
+            {                                                                  \
+                break;                                                         \
+            }                                                                  \
+                                                                               \
+            tmp = a[i]; a[i] = a[j]; a[j] = tmp;                               \
+        }                                                                      \
+                                                                               \
+        a[0] = a[j];                                                           \
+        a[j] = pivot;                                                          \
+                                                                               \
+        /* Recurse into the smaller side, iterate over the larger one */       \
+        if (j < num - j - 1)                                                   \
+        {                                                                      \
+            name##_introsort(a, j, depth);                                     \
+            a += j + 1;                                                        \
+            num -= j + 1;                                                      \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            name##_introsort(a + j + 1, num - j - 1, depth);                   \
+            num = j;                                                           \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    name##_insertion(a, num);                                                  \
+}
+
+ARC_SORT_DEFINE(arc_sort_int, int)
+ARC_SORT_DEFINE(arc_sort_uint, unsigned)
+ARC_SORT_DEFINE(arc_sort_long, long)
+ARC_SORT_DEFINE(arc_sort_ulong, unsigned long)
+ARC_SORT_DEFINE(arc_sort_float, float)
+ARC_SORT_DEFINE(arc_sort_double, double)
+
+/******************************************************************************/
+
+static void arc_sort_swap(char * a, char * b, size_t size)
+{
+    char tmp[64];
+
+    /* Constant sizes let the compiler turn the copies into moves */
+    if (size == sizeof(int))
+    {
+        memcpy(tmp, a, sizeof(int));
+        memcpy(a, b, sizeof(int));
+        memcpy(b, tmp, sizeof(int));
+        return;
+    }
+
+    if (size == sizeof(double))
+    {
+        memcpy(tmp, a, sizeof(double));
+        memcpy(a, b, sizeof(double));
+        memcpy(b, tmp, sizeof(double));
+        return;
+    }
+
+    while (size > 0)
+    {
+        size_t n = (size < sizeof(tmp) ? size : sizeof(tmp));
+
+        memcpy(tmp, a, n);
+        memcpy(a, b, n);
+        memcpy(b, tmp, n);
+
+        a += n;
+        b += n;
+        size -= n;
+    }
+}
+
+/******************************************************************************/
+
+/* Compares the bytes of the elements when there is no comparison function */
+static int arc_sort_compare(const void * a, const void * b, size_t size,
+                            arc_cmp_fn_t cmp_fn)
+{
+    if (cmp_fn == NULL)
+    {
+        return memcmp(a, b, size);
+    }
+
+    return (*cmp_fn)(a, b);
+}
+
+/******************************************************************************/
+
+static void arc_sort_generic_insertion(char * a, size_t num, size_t size,
+                                       arc_cmp_fn_t cmp_fn)
+{
+    size_t i, j;
+
+    for (i = 1; i < num; i++)
+    {
+        for (j = i; j > 0 && arc_sort_compare(a + j * size,
+                                              a + (j - 1) * size,
+                                              size, cmp_fn) < 0; j--)
+        {
+            arc_sort_swap(a + j * size, a + (j - 1) * size, size);
+        }
+    }
+}
+
+/******************************************************************************/
+
+static void arc_sort_generic_sift_down(char * a, size_t root, size_t num,
+                                       size_t size, arc_cmp_fn_t cmp_fn)
+{
+    size_t child = 2 * root + 1;
+
+    while (child < num)
+    {
+        if (child + 1 < num &&
+            arc_sort_compare(a + child * size, a + (child + 1) * size,
+                             size, cmp_fn) < 0)
+        {
+            child++;
+        }
+
+        if (arc_sort_compare(a + root * size, a + child * size,
+                             size, cmp_fn) >= 0)
+        {
+            break;
+        }
+
+        arc_sort_swap(a + root * size, a + child * size, size);
+        root = child;
+        child = 2 * root + 1;
+    }
+}
+
+/******************************************************************************/
+
+static void arc_sort_generic_heapsort(char * a, size_t num, size_t size,
+                                      arc_cmp_fn_t cmp_fn)
+{
+    size_t i;
+
+    for (i = num / 2; i > 0; i--)
+    {
+        arc_sort_generic_sift_down(a, i - 1, num, size, cmp_fn);
+    }
+
+    for (i = num - 1; i > 0; i--)
+    {
+        arc_sort_swap(a, a + i * size, size);
+        arc_sort_generic_sift_down(a, 0, i, size, cmp_fn);
+    }
+}
+
+/******************************************************************************/
+
+/* Same as the typed introsort, the pivot stays in the first position while
+   the rest of the elements are partitioned */
+static void arc_sort_generic(char * a, size_t num, size_t size,
+                             arc_cmp_fn_t cmp_fn, size_t depth)
+{
+    while (num > ARC_SORT_THRESHOLD)
+    {
+        size_t i = 0, j = num;
+        char * mid = a + (num / 2) * size;
+        char * last = a + (num - 1) * size;
+
+        if (depth == 0)
+        {
+            arc_sort_generic_heapsort(a, num, size, cmp_fn);
+            return;
+        }
+
+        depth--;
+
+        if (arc_sort_compare(mid, a, size, cmp_fn) < 0)
+        {
+            arc_sort_swap(mid, a, size);
+        }
+
+        if (arc_sort_compare(last, mid, size, cmp_fn) < 0)
+        {
+            arc_sort_swap(last, mid, size);
+
+            if (arc_sort_compare(mid, a, size, cmp_fn) < 0)
+            {
+                arc_sort_swap(mid, a, size);
+            }
+        }
+
+        arc_sort_swap(a, mid, size);
+
+        for (;;)
+        {
+            do { i++; } while (arc_sort_compare(a + i * size, a,
+                                                size, cmp_fn) < 0);
+            do { j--; } while (arc_sort_compare(a, a + j * size,
+                                                size, cmp_fn) < 0);
+
+            if (i >= j)
+            {
+                break;
+            }
+
+            arc_sort_swap(a + i * size, a + j * size, size);
+        }
+
+        arc_sort_swap(a, a + j * size, size);
+
+        if (j < num - j - 1)
+        {
+            arc_sort_generic(a, j, size, cmp_fn, depth);
+            a += (j + 1) * size;
+            num -= j + 1;
+        }
+        else
+        {
+            arc_sort_generic(a + (j + 1) * size, num - j - 1, size, cmp_fn,
+                             depth);
+            num = j;
+        }
+    }
+
+    arc_sort_generic_insertion(a, num, size, cmp_fn);
+}
+
+/******************************************************************************/
+
+void arc_sort(void * base, size_t num, size_t size, arc_cmp_fn_t cmp_fn)
+{
+    size_t depth = 0, n;
+
+    /* Quicksort gives up after 2 * log2(num) levels */
+    for (n = num; n > 1; n /= 2)
+    {
+        depth += 2;
+    }
+
+    if (cmp_fn == &arc_cmp_int && size == sizeof(int))
+    {
+        arc_sort_int_introsort(base, num, depth);
+    }
+    else if (cmp_fn == &arc_cmp_uint && size == sizeof(unsigned))
+    {
+        arc_sort_uint_introsort(base, num, depth);
+    }
+    else if (cmp_fn == &arc_cmp_long && size == sizeof(long))
+    {
+        arc_sort_long_introsort(base, num, depth);
+    }
+    else if (cmp_fn == &arc_cmp_ulong && size == sizeof(unsigned long))
+    {
+        arc_sort_ulong_introsort(base, num, depth);
+    }
+    else if (cmp_fn == &arc_cmp_float && size == sizeof(float))
+    {
+        arc_sort_float_introsort(base, num, depth);
+    }
+    else if (cmp_fn == &arc_cmp_double && size == sizeof(double))
+    {
+        arc_sort_double_introsort(base, num, depth);
+    }
+    else
+    {
+        arc_sort_generic(base, num, size, cmp_fn, depth);
+    }
+}
+
+/******************************************************************************/
+
+/* Moves the elements and their keys to their bucket for the given shift,
+   the usual element sizes are copied with a constant size */
+static void arc_radix_scatter(const unsigned long * keys,
+                              unsigned long * dst_keys,
+                              const char * src, char * dst,
+                              size_t num, size_t size,
+                              size_t * offsets, unsigned shift)
+{
+    size_t i;
+
+    if (size == sizeof(unsigned))
+    {
+        for (i = 0; i < num; i++)
+        {
+            size_t pos = offsets[(keys[i] >> shift) & 0xFF]++;
+
+            dst_keys[pos] = keys[i];
+            memcpy(dst + pos * sizeof(unsigned), src + i * sizeof(unsigned),
+                   sizeof(unsigned));
+        }
+    }
+    else if (size == sizeof(unsigned long))
+    {
+        for (i = 0; i < num; i++)
+        {
+            size_t pos = offsets[(keys[i] >> shift) & 0xFF]++;
+
+            dst_keys[pos] = keys[i];
+            memcpy(dst + pos * sizeof(unsigned long),
+                   src + i * sizeof(unsigned long), sizeof(unsigned long));
+        }
+    }
+    else
+    {
+        for (i = 0; i < num; i++)
+        {
+            size_t pos = offsets[(keys[i] >> shift) & 0xFF]++;
+
+            dst_keys[pos] = keys[i];
+            memcpy(dst + pos * size, src + i * size, size);
+        }
+    }
+}
+
+/******************************************************************************/
+
+int arc_radix_sort(void * base, size_t num, size_t size, arc_key_fn_t key_fn)
+{
+    size_t * counts;
+    unsigned long * keys, * key_buffer;
+    char * data = base, * buffer;
+    size_t i, pass;
+
+    if (num < 2)
+    {
+        return ARC_SUCCESS;
+    }
+
+    /* The keys of the doubles only keep their order with 64 bit longs */
+    if (key_fn == &arc_key_double && sizeof(unsigned long) < sizeof(double))
+    {
+        arc_sort(base, num, size, &arc_cmp_double);
+        return ARC_SUCCESS;
+    }
+
+    counts = calloc(sizeof(unsigned long) * ARC_RADIX_BUCKETS, sizeof(size_t));
+    keys = malloc(2 * num * sizeof(unsigned long));
+    buffer = malloc(num * size);
+
+    if (counts == NULL || keys == NULL || buffer == NULL)
+    {
+        free(counts);
+        free(keys);
+        free(buffer);
+        return ARC_OUT_OF_MEMORY;
+    }
+
+    key_buffer = keys + num;
+
+    /* The keys are extracted and counted for every byte at once */
+    for (i = 0; i < num; i++)
+    {
+        unsigned long key = (*key_fn)(data + i * size);
+
+        keys[i] = key;
+
+        for (pass = 0; pass < sizeof(unsigned long); pass++)
+        {
+            counts[pass * ARC_RADIX_BUCKETS + ((key >> (pass * 8)) & 0xFF)]++;
+        }
+    }
+
+    for (pass = 0; pass < sizeof(unsigned long); pass++)
+    {
+        size_t * offsets = counts + pass * ARC_RADIX_BUCKETS;
+        unsigned shift = (unsigned)(pass * 8);
+        size_t bucket, offset = 0;
+        unsigned long * tmp_keys;
+        char * tmp;
+
+        /* Every key has the same byte, the order wouldn't change */
+        if (offsets[(keys[0] >> shift) & 0xFF] == num)
+        {
+            continue;
+        }
+
+        for (bucket = 0; bucket < ARC_RADIX_BUCKETS; bucket++)
+        {
+            size_t count = offsets[bucket];
+
+            offsets[bucket] = offset;
+            offset += count;
+        }
+
+        tmp = (data == base ? buffer : (char *)base);
+
+        arc_radix_scatter(keys, key_buffer, data, tmp, num, size, offsets,
+                          shift);
+
+        tmp_keys = keys;
+        keys = key_buffer;
+        key_buffer = tmp_keys;
+        data = tmp;
+    }
+
+    if (data != base)
+    {
+        memcpy(base, data, num * size);
+    }
+
+    free(counts);
+    free(keys < key_buffer ? keys : key_buffer);
+    free(buffer);
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
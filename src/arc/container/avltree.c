@@ -15,6 +15,10 @@
 #include <arc/common/defines.h>
 #include <arc/container/tree_def.h>
 #include <arc/container/avltree_def.h>
+#include <arc/thread/pool.h>
+
+/* Below this many nodes the parallel operations go on in the calling thread */
+#define ARC_AVLTREE_PARALLEL_MIN 4096
 
 /******************************************************************************/
 
@@ -27,22 +31,62 @@ static int arc_avltree_insert_internal(struct arc_tree *tree, const void * data)
 
 /******************************************************************************/
 
-int arc_avltree_init(struct arc_tree *tree, 
-                           size_t data_size,
-                           arc_cmp_fn_t cmp_fn)
+int arc_avltree_init(struct arc_tree *tree,
+                     size_t data_size,
+                     arc_cmp_fn_t cmp_fn)
+{
+    return arc_avltree_init_with_allocator(tree, data_size, cmp_fn, NULL);
+}
+
+/******************************************************************************/
+
+int arc_avltree_init_with_allocator(struct arc_tree *tree,
+                                    size_t data_size,
+                                    arc_cmp_fn_t cmp_fn,
+                                    const struct arc_allocator *allocator)
 {
     size_t data_offset = ARC_OFFSETOF(struct arc_avltree_node, data);
     size_t node_size = sizeof(struct arc_avltree_node) - data_offset;
     node_size = (node_size > data_size ? 0 : data_size - node_size) +
                 sizeof(struct arc_avltree_node);
 
+    return arc_avltree_init_with_layout(tree, data_size, data_offset,
+                                        node_size, cmp_fn, allocator);
+}
+
+/******************************************************************************/
+
+int arc_avltree_init_with_layout(struct arc_tree *tree,
+                                 size_t data_size,
+                                 size_t data_offset,
+                                 size_t node_size,
+                                 arc_cmp_fn_t cmp_fn,
+                                 const struct arc_allocator *allocator)
+{
     return arc_tree_init(tree,
                          data_size,
                          data_offset,
                          node_size, 
                          &arc_avltree_insert_internal,
                          &arc_avltree_remove_internal,
-                         cmp_fn);
+                         cmp_fn,
+                         allocator);
+}
+
+/******************************************************************************/
+
+int arc_avltree_init_pooled(struct arc_tree *tree,
+                            size_t data_size,
+                            arc_cmp_fn_t cmp_fn)
+{
+    int retval = arc_avltree_init(tree, data_size, cmp_fn);
+
+    if (retval != ARC_SUCCESS)
+    {
+        return retval;
+    }
+
+    return arc_tree_init_pool(tree);
 }
 
 /******************************************************************************/
@@ -55,6 +99,16 @@ void arc_avltree_fini(struct arc_tree *tree)
 /******************************************************************************/
 
 struct arc_tree * arc_avltree_create(size_t data_size, arc_cmp_fn_t cmp_fn)
+{
+    return arc_avltree_create_with_allocator(data_size, cmp_fn, NULL);
+}
+
+/******************************************************************************/
+
+struct arc_tree *
+arc_avltree_create_with_allocator(size_t data_size,
+                                  arc_cmp_fn_t cmp_fn,
+                                  const struct arc_allocator *allocator)
 {
     size_t data_offset = ARC_OFFSETOF(struct arc_avltree_node, data);
     size_t node_size = sizeof(struct arc_avltree_node) - data_offset;
@@ -66,7 +120,29 @@ struct arc_tree * arc_avltree_create(size_t data_size, arc_cmp_fn_t cmp_fn)
                                                  node_size, 
                                                  &arc_avltree_insert_internal,
                                                  &arc_avltree_remove_internal,
-                                                 cmp_fn);
+                                                 cmp_fn,
+                                                 allocator);
+}
+
+/******************************************************************************/
+
+struct arc_tree * arc_avltree_create_pooled(size_t data_size,
+                                            arc_cmp_fn_t cmp_fn)
+{
+    struct arc_tree * tree = malloc(sizeof(struct arc_tree));
+
+    if (tree == NULL)
+    {
+        return NULL;
+    }
+
+    if (arc_avltree_init_pooled(tree, data_size, cmp_fn) != ARC_SUCCESS)
+    {
+        free(tree);
+        return NULL;
+    }
+
+    return tree;
 }
 
 /******************************************************************************/
@@ -76,6 +152,22 @@ void arc_avltree_destroy(struct arc_tree *avltree)
     arc_tree_destroy((struct arc_tree *)avltree);
 }
 
+/******************************************************************************/
+
+static size_t arc_avltree_count(struct arc_avltree_node *node)
+{
+    return (node == NULL ? 0 : node->count);
+}
+
+/******************************************************************************/
+
+/* Recomputes the size of the subtree from the sizes of its children */
+static void arc_avltree_update_count(struct arc_avltree_node *node)
+{
+    node->count = 1 + arc_avltree_count(node->left) +
+                  arc_avltree_count(node->right);
+}
+
 /******************************************************************************/
 /**
  *
@@ -105,6 +197,9 @@ static void arc_avltree_rotate_left(struct arc_avltree_node *node,
         child->balance_factor = -1;
     }
 
+    arc_avltree_update_count(node);
+    arc_avltree_update_count(child);
+
     *node_ref = child;
 }
 
@@ -150,6 +245,10 @@ static void arc_avltree_rotate_right_left(struct arc_avltree_node *node,
 
     grandchild->balance_factor = 0;
 
+    arc_avltree_update_count(node);
+    arc_avltree_update_count(child);
+    arc_avltree_update_count(grandchild);
+
     *node_ref = grandchild;
 }
 
@@ -182,6 +281,9 @@ static void arc_avltree_rotate_right(struct arc_avltree_node *node,
         child->balance_factor = 1;
     }
 
+    arc_avltree_update_count(node);
+    arc_avltree_update_count(child);
+
     *node_ref = child;
 }
 
@@ -227,6 +329,10 @@ static void arc_avltree_rotate_left_right(struct arc_avltree_node *node,
 
     grandchild->balance_factor = 0;
 
+    arc_avltree_update_count(node);
+    arc_avltree_update_count(child);
+    arc_avltree_update_count(grandchild);
+
     *node_ref = grandchild;
 }
 
@@ -268,6 +374,49 @@ static void arc_avltree_rotate(struct arc_avltree_node *node,
 
 /******************************************************************************/
 
+void arc_avltree_insert_fixup(struct arc_tree *tree,
+                              struct arc_tree_snode *snode)
+{
+    struct arc_avltree_node *node = (struct arc_avltree_node *)snode;
+    struct arc_avltree_node *parent = node->parent;
+    struct arc_avltree_node *ancestor;
+    struct arc_avltree_node **node_ref;
+
+    tree->size++;
+
+    /* Every subtree on the way to the root has one node more */
+    node->count = 1;
+
+    for (ancestor = parent; ancestor != NULL; ancestor = ancestor->parent)
+    {
+        ancestor->count++;
+    }
+
+    /* Backtrack and update balance factors */
+    while (parent != NULL)
+    {
+        int factor = (parent->right == node ? 1 : -1);
+        if (abs(parent->balance_factor + factor) == 2)
+        {
+            node_ref = (struct arc_avltree_node **)
+                        arc_tree_node_ref(tree,
+                                          (struct arc_tree_snode *)parent);
+            arc_avltree_rotate(parent, node_ref);
+            break;
+        }
+        parent->balance_factor += factor;
+
+        if (parent->balance_factor == 0)
+        {
+            break;
+        }
+        node = parent;
+        parent = parent->parent;
+    }
+}
+
+/******************************************************************************/
+
 static int arc_avltree_insert_internal(struct arc_tree *tree, const void * data)
 {
     struct arc_tree *avltree = (struct arc_tree *)tree;
@@ -278,20 +427,21 @@ static int arc_avltree_insert_internal(struct arc_tree *tree, const void * data)
     while (node != NULL)
     {
         int cmp_result;
+        void *node_data = (char *)node + avltree->data_offset;
        
         if (avltree->cmp_fn == NULL) {
-            cmp_result = memcmp(node->data, data, avltree->data_size);
+            cmp_result = memcmp(node_data, data, avltree->data_size);
         } else {
-            cmp_result = (*avltree->cmp_fn)(node->data, data);
+            cmp_result = (*avltree->cmp_fn)(node_data, data);
         }
 
-        if (cmp_result == -1)
+        if (cmp_result < 0)
         {
             parent = node;
             node_ref = &(node->right);
             node = node->right;
         }
-        else if (cmp_result == 1)
+        else if (cmp_result > 0)
         {
             parent = node;
             node_ref = &(node->left);
@@ -303,7 +453,7 @@ static int arc_avltree_insert_internal(struct arc_tree *tree, const void * data)
         }
     }
 
-    node = malloc(avltree->node_size);
+    node = ARC_ALLOC(&avltree->allocator, avltree->node_size);
 
     if (node == NULL)
     {
@@ -314,32 +464,11 @@ static int arc_avltree_insert_internal(struct arc_tree *tree, const void * data)
     node->left   = NULL;
     node->right  = NULL;
     node->balance_factor = 0;
-    avltree->size++;
 
-    memcpy(node->data, data, avltree->data_size);
+    memcpy((char *)node + avltree->data_offset, data, avltree->data_size);
     *node_ref = node;
 
-    /* Backtrack and update balance factors */
-    while (parent != NULL)
-    {
-        int factor = (parent->right == node ? 1 : -1);
-        if (abs(parent->balance_factor + factor) == 2)
-        {
-            node_ref = (struct arc_avltree_node **)
-                        arc_tree_node_ref(avltree,
-                                          (struct arc_tree_snode *)parent);
-            arc_avltree_rotate(parent, node_ref);
-            break;
-        }
-        parent->balance_factor += factor;
-
-        if (parent->balance_factor == 0)
-        {
-            break;
-        }
-        node = parent;
-        parent = parent->parent;
-    }
+    arc_avltree_insert_fixup(avltree, (struct arc_tree_snode *)node);
 
     return ARC_SUCCESS;
 }
@@ -359,162 +488,1389 @@ void *arc_avltree_retrieve(struct arc_tree *avltree, const void * data)
 }
 
 /******************************************************************************/
-/**
- * @brief Removes a node from the avltree
- *
- * @param[in] avltree Binary search tree to perform the operation on
- * @param[in] data node node to be removed
- */
-static void arc_avltree_remove_internal(struct arc_tree *tree,
-                                        struct arc_tree_snode *snode)
+
+size_t arc_avltree_retrieve_batch(struct arc_tree *avltree, const void * keys,
+                                  size_t n, void **results)
 {
-    int factor;
-    struct arc_tree *avltree = (struct arc_tree *)tree;
-    struct arc_avltree_node *node = (struct arc_avltree_node *)snode;
-    struct arc_avltree_node *parent, *child, *successor, **node_ref;
+    return arc_tree_retrieve_batch((struct arc_tree *)avltree,
+                                   keys, n, results);
+}
 
-    node_ref = (struct arc_avltree_node **)arc_tree_node_ref(avltree, snode);
+/******************************************************************************/
 
-    successor = (struct arc_avltree_node *)
-                arc_tree_successor((struct arc_tree_snode *)node);
+static struct arc_avltree_node * arc_avltree_select_node(struct arc_tree *tree,
+                                                         size_t k)
+{
+    struct arc_avltree_node *node = (struct arc_avltree_node *)tree->root;
 
-    if (successor == NULL)
+    while (node != NULL)
     {
-        parent = node->parent;
-        if (parent != NULL)
+        size_t left = arc_avltree_count(node->left);
+
+        if (k < left)
         {
-            factor = (parent->left == node ? 1 : -1);
+            node = node->left;
         }
-    }
-    else
-    {
-        parent = successor->parent;
-
-        successor->parent = node->parent;
-
-        if (parent == node)
+        else if (k > left)
         {
-            factor = (parent->left == successor ? 1 : -1);
-            successor->balance_factor = parent->balance_factor;
-            parent = successor;
-
-            if(node->right == successor && node->left != NULL)
-            {
-                successor->left = node->left;
-                successor->left->parent = successor;
-            }
+            k -= left + 1;
+            node = node->right;
         }
         else
         {
-            if (parent != NULL)
-            {
-                parent->left = successor->right;
+            break;
+        }
+    }
 
-                if (parent->left != NULL)
-                    {
-                    parent->left->parent = parent;
-                }
-            }
+    return node;
+}
 
-            factor = 1;
-            successor->balance_factor = node->balance_factor;
-            successor->left = node->left;
-            
-            if (successor->left != NULL)
-            {
-                successor->left->parent = successor;
-            }
+/******************************************************************************/
 
-            /* We know for a fact that the right is not NULL */
-            successor->right = node->right;
-            successor->right->parent = successor;
-        }
+void *arc_avltree_select(struct arc_tree *avltree, size_t k)
+{
+    struct arc_avltree_node *node = arc_avltree_select_node(avltree, k);
+
+    return (node == NULL ? NULL : (char *)node + avltree->data_offset);
+}
+
+/******************************************************************************/
+
+int arc_avltree_position_select(struct arc_tree_iterator * it, size_t k)
+{
+    struct arc_avltree_node *node = arc_avltree_select_node(it->container, k);
+
+    if (node == NULL)
+    {
+        arc_tree_after_end(it);
+        return 0;
     }
 
-    *node_ref = successor;
+    it->node_ptr = node;
 
-    while (parent != NULL)
+    return 1;
+}
+
+/******************************************************************************/
+
+size_t arc_avltree_rank(struct arc_tree *avltree, const void * data)
+{
+    struct arc_avltree_node *node = (struct arc_avltree_node *)avltree->root;
+    size_t rank = 0;
+
+    while (node != NULL)
     {
-        if (abs(parent->balance_factor + factor) == 2)
-        {
-            node_ref = (struct arc_avltree_node **)
-                       arc_tree_node_ref(avltree,
-                                         (struct arc_tree_snode *)parent);
-            arc_avltree_rotate(parent, node_ref);
-            parent = *node_ref;
+        int cmp_result;
+        void *node_data = (char *)node + avltree->data_offset;
+
+        if (avltree->cmp_fn == NULL) {
+            cmp_result = memcmp(node_data, data, avltree->data_size);
+        } else {
+            cmp_result = (*avltree->cmp_fn)(node_data, data);
         }
-        else
+
+        if (cmp_result < 0)
         {
-            parent->balance_factor += factor;
+            rank += arc_avltree_count(node->left) + 1;
+            node = node->right;
         }
-
-        if (abs(parent->balance_factor) == 1)
+        else if (cmp_result > 0)
         {
-            break;
+            node = node->left;
         }
-
-        child = parent;
-        parent = parent->parent;
-
-        if (parent == NULL) 
+        else
         {
+            rank += arc_avltree_count(node->left);
             break;
         }
-
-        factor = (parent->right == child ? -1 : 1);
     }
 
-    free(node);
-    avltree->size--;
+    return rank;
 }
 
-
 /******************************************************************************/
 
-void arc_avltree_remove(struct arc_tree *avltree, const void * data)
+static int arc_avltree_compare(struct arc_tree *tree,
+                               const void * a, const void * b)
 {
-    arc_tree_remove((struct arc_tree *)avltree, data);
+    if (tree->cmp_fn == NULL)
+    {
+        return memcmp(a, b, tree->data_size);
+    }
+
+    return (*tree->cmp_fn)(a, b);
 }
 
 /******************************************************************************/
 
-int arc_avltree_empty(struct arc_tree * avltree)
+/* Checks that the elements are in increasing order, strictly or not */
+static int arc_avltree_sorted(struct arc_tree *tree, const char * data,
+                              size_t n, int strict)
 {
-    return arc_tree_empty((struct arc_tree *)avltree);
-}
+    size_t i;
 
-/******************************************************************************/
+    for (i = 1; i < n; i++)
+    {
+        int cmp_result = arc_avltree_compare(tree, data + (i - 1) *
+                                             tree->data_size,
+                                             data + i * tree->data_size);
 
-size_t arc_avltree_size(struct arc_tree * avltree)
-{
-    return arc_tree_size((struct arc_tree *)avltree);
+        if (cmp_result > 0 || (strict && cmp_result == 0))
+        {
+            return 0;
+        }
+    }
+
+    return 1;
 }
 
 /******************************************************************************/
 
-void arc_avltree_clear(struct arc_tree *avltree)
+/* Height of the subtree built by arc_avltree_link from num nodes */
+static int arc_avltree_link_height(size_t num)
 {
-    arc_tree_clear((struct arc_tree *)avltree);
-}
+    int height = 0;
 
-/******************************************************************************/
+    while (num > 0)
+    {
+        height++;
+        num >>= 1;
+    }
 
-int arc_avltree_iterator_init(struct arc_tree_iterator *it,
-                              struct arc_tree *tree)
-{
-    return arc_tree_iterator_init(it, tree);
+    return height;
 }
 
 /******************************************************************************/
 
-void arc_avltree_iterator_fini(struct arc_tree_iterator *it)
+/* Links the nodes, given in order, into a perfectly balanced subtree. The
+   left half never has more nodes than the right one, so their heights differ
+   at most by one and every balance factor is known without rotations */
+static struct arc_avltree_node *
+arc_avltree_link(struct arc_avltree_node **nodes, size_t num,
+                 struct arc_avltree_node *parent)
 {
-    arc_tree_iterator_fini(it);
+    struct arc_avltree_node *root;
+    size_t left = (num - 1) / 2;
+    size_t right = num / 2;
+
+    if (num == 0)
+    {
+        return NULL;
+    }
+
+    root = nodes[left];
+    root->parent = parent;
+    root->left = arc_avltree_link(nodes, left, root);
+    root->right = arc_avltree_link(nodes + left + 1, right, root);
+    root->balance_factor = arc_avltree_link_height(right) -
+                           arc_avltree_link_height(left);
+    root->count = num;
+
+    return root;
 }
 
 /******************************************************************************/
 
-struct arc_tree_iterator * arc_avltree_iterator_create(struct arc_tree *tree)
+/* Merges the sorted elements with the ones of the tree, skipping those that
+   are already in it, and relinks every node into a balanced tree */
+static int arc_avltree_merge_sorted(struct arc_tree *tree, const char * data,
+                                    size_t n)
+{
+    struct arc_tree_iterator it;
+    struct arc_avltree_node **nodes;
+    void **fresh; /* New nodes in order */
+    size_t *picks; /* Element of every new node */
+    char *block = NULL;
+    size_t size = tree->data_size;
+    size_t num_nodes = 0;
+    size_t num_new = 0;
+    size_t i = 0, j;
+    int more = (tree->root != NULL);
+
+    if (n == 0)
+    {
+        return ARC_SUCCESS;
+    }
+
+    nodes = malloc((tree->size + n) * sizeof(struct arc_avltree_node *));
+    fresh = malloc(n * sizeof(void *));
+    picks = malloc(n * sizeof(size_t));
+
+    if (nodes == NULL || fresh == NULL || picks == NULL)
+    {
+        free(nodes);
+        free(fresh);
+        free(picks);
+        return ARC_OUT_OF_MEMORY;
+    }
+
+    arc_tree_iterator_init(&it, tree);
+
+    if (more)
+    {
+        arc_tree_begin(&it);
+    }
+
+    /* The new elements are left as NULL in the merged order */
+    while (more || i < n)
+    {
+        const char *elem = data + i * size;
+        int cmp_result;
+
+        if (!more)
+        {
+            cmp_result = 1;
+        }
+        else if (i == n)
+        {
+            cmp_result = -1;
+        }
+        else
+        {
+            cmp_result = arc_avltree_compare(tree, arc_tree_data(&it), elem);
+        }
+
+        if (cmp_result < 0)
+        {
+            nodes[num_nodes++] = it.node_ptr;
+            more = arc_tree_next(&it);
+            continue;
+        }
+
+        if (cmp_result > 0 &&
+            (i == 0 || arc_avltree_compare(tree, elem - size, elem) != 0))
+        {
+            nodes[num_nodes++] = NULL;
+            picks[num_new++] = i;
+        }
+
+        i++;
+    }
+
+    arc_tree_iterator_fini(&it);
+
+    if (tree->pool != NULL && num_new > 0)
+    {
+        block = arc_slab_alloc_array(tree->pool, num_new);
+
+        if (block == NULL)
+        {
+            free(nodes);
+            free(fresh);
+            free(picks);
+            return ARC_OUT_OF_MEMORY;
+        }
+    }
+
+    for (j = 0; j < num_new; j++)
+    {
+        if (block != NULL)
+        {
+            fresh[j] = block + j * arc_slab_object_size(tree->pool);
+        }
+        else if ((fresh[j] = ARC_ALLOC(&tree->allocator,
+                                       tree->node_size)) == NULL)
+        {
+            while (j > 0)
+            {
+                ARC_FREE(&tree->allocator, fresh[--j]);
+            }
+
+            free(nodes);
+            free(fresh);
+            free(picks);
+            return ARC_OUT_OF_MEMORY;
+        }
+
+        memcpy((char *)fresh[j] + tree->data_offset,
+               data + picks[j] * size, size);
+    }
+
+    for (i = 0, j = 0; i < num_nodes; i++)
+    {
+        if (nodes[i] == NULL)
+        {
+            nodes[i] = fresh[j++];
+        }
+    }
+
+    tree->root = (struct arc_tree_snode *)arc_avltree_link(nodes, num_nodes,
+                                                           NULL);
+    tree->size = num_nodes;
+
+    free(nodes);
+    free(fresh);
+    free(picks);
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+int arc_avltree_build_sorted(struct arc_tree *avltree, const void * data,
+                             size_t n)
+{
+    if (avltree->size != 0 || !arc_avltree_sorted(avltree, data, n, 1))
+    {
+        return ARC_ERROR;
+    }
+
+    return arc_avltree_merge_sorted(avltree, data, n);
+}
+
+/******************************************************************************/
+
+int arc_avltree_insert_sorted(struct arc_tree *avltree, const void * data,
+                              size_t n)
+{
+    if (!arc_avltree_sorted(avltree, data, n, 0))
+    {
+        return ARC_ERROR;
+    }
+
+    return arc_avltree_merge_sorted(avltree, data, n);
+}
+
+/******************************************************************************/
+
+/* Subtree handled by the join based operations, the height of every piece is
+   tracked along the way since the nodes only keep their balance factor */
+struct arc_avltree_subtree
+{
+    struct arc_avltree_node *root;
+    int height;
+};
+
+/******************************************************************************/
+
+static int arc_avltree_height(struct arc_avltree_node *node)
+{
+    int height = 0;
+
+    /* The path through the taller child is the longest one */
+    while (node != NULL)
+    {
+        height++;
+        node = (node->balance_factor < 0 ? node->left : node->right);
+    }
+
+    return height;
+}
+
+/******************************************************************************/
+
+/* Splits a subtree into its root and its two children */
+static void arc_avltree_expose(struct arc_avltree_subtree *tree,
+                               struct arc_avltree_subtree *left,
+                               struct arc_avltree_subtree *right)
+{
+    int factor = tree->root->balance_factor;
+
+    left->root = tree->root->left;
+    left->height = tree->height - 1 - (factor > 0 ? factor : 0);
+    right->root = tree->root->right;
+    right->height = tree->height - 1 + (factor < 0 ? factor : 0);
+}
+
+/******************************************************************************/
+
+/* Makes the node the root of both subtrees, whose heights may differ by two
+   right before a rotation */
+static void arc_avltree_make(struct arc_avltree_subtree *result,
+                             struct arc_avltree_subtree *left,
+                             struct arc_avltree_node *node,
+                             struct arc_avltree_subtree *right)
+{
+    node->left = left->root;
+    node->right = right->root;
+    node->balance_factor = right->height - left->height;
+    node->count = 1 + arc_avltree_count(left->root) +
+                  arc_avltree_count(right->root);
+
+    if (left->root != NULL)
+    {
+        left->root->parent = node;
+    }
+
+    if (right->root != NULL)
+    {
+        right->root->parent = node;
+    }
+
+    result->root = node;
+    result->height = 1 + (left->height > right->height ?
+                          left->height : right->height);
+}
+
+/******************************************************************************/
+
+static void arc_avltree_join_rotate_left(struct arc_avltree_subtree *tree)
+{
+    struct arc_avltree_subtree a, y, b, c, x;
+    struct arc_avltree_node *root = tree->root;
+
+    arc_avltree_expose(tree, &a, &y);
+    arc_avltree_expose(&y, &b, &c);
+
+    arc_avltree_make(&x, &a, root, &b);
+    arc_avltree_make(tree, &x, y.root, &c);
+}
+
+/******************************************************************************/
+
+static void arc_avltree_join_rotate_right(struct arc_avltree_subtree *tree)
+{
+    struct arc_avltree_subtree y, c, a, b, x;
+    struct arc_avltree_node *root = tree->root;
+
+    arc_avltree_expose(tree, &y, &c);
+    arc_avltree_expose(&y, &a, &b);
+
+    arc_avltree_make(&x, &b, root, &c);
+    arc_avltree_make(tree, &a, y.root, &x);
+}
+
+/******************************************************************************/
+
+/* Joins when the left subtree is taller, the node and the right subtree go
+   down its right spine until the heights match */
+static void arc_avltree_join_right(struct arc_avltree_subtree *result,
+                                   struct arc_avltree_subtree *left,
+                                   struct arc_avltree_node *node,
+                                   struct arc_avltree_subtree *right)
+{
+    struct arc_avltree_subtree l, c, t;
+
+    arc_avltree_expose(left, &l, &c);
+
+    if (c.height <= right->height + 1)
+    {
+        arc_avltree_make(&t, &c, node, right);
+
+        if (t.height > l.height + 1)
+        {
+            arc_avltree_join_rotate_right(&t);
+            arc_avltree_make(result, &l, left->root, &t);
+            arc_avltree_join_rotate_left(result);
+            return;
+        }
+    }
+    else
+    {
+        arc_avltree_join_right(&t, &c, node, right);
+    }
+
+    arc_avltree_make(result, &l, left->root, &t);
+
+    if (t.height > l.height + 1)
+    {
+        arc_avltree_join_rotate_left(result);
+    }
+}
+
+/******************************************************************************/
+
+static void arc_avltree_join_left(struct arc_avltree_subtree *result,
+                                  struct arc_avltree_subtree *left,
+                                  struct arc_avltree_node *node,
+                                  struct arc_avltree_subtree *right)
+{
+    struct arc_avltree_subtree c, r, t;
+
+    arc_avltree_expose(right, &c, &r);
+
+    if (c.height <= left->height + 1)
+    {
+        arc_avltree_make(&t, left, node, &c);
+
+        if (t.height > r.height + 1)
+        {
+            arc_avltree_join_rotate_left(&t);
+            arc_avltree_make(result, &t, right->root, &r);
+            arc_avltree_join_rotate_right(result);
+            return;
+        }
+    }
+    else
+    {
+        arc_avltree_join_left(&t, left, node, &c);
+    }
+
+    arc_avltree_make(result, &t, right->root, &r);
+
+    if (t.height > r.height + 1)
+    {
+        arc_avltree_join_rotate_right(result);
+    }
+}
+
+/******************************************************************************/
+
+/* Joins two subtrees and a node, every element of the left subtree is less
+   than the node and every element of the right one is greater. It takes time
+   proportional to the difference of their heights */
+static void arc_avltree_join_nodes(struct arc_avltree_subtree *result,
+                                   struct arc_avltree_subtree *left,
+                                   struct arc_avltree_node *node,
+                                   struct arc_avltree_subtree *right)
+{
+    if (left->height > right->height + 1)
+    {
+        arc_avltree_join_right(result, left, node, right);
+    }
+    else if (right->height > left->height + 1)
+    {
+        arc_avltree_join_left(result, left, node, right);
+    }
+    else
+    {
+        arc_avltree_make(result, left, node, right);
+    }
+}
+
+/******************************************************************************/
+
+/* Detaches the greatest node of a non empty subtree */
+static struct arc_avltree_node *
+arc_avltree_split_last(struct arc_avltree_subtree *tree)
+{
+    struct arc_avltree_subtree l, r;
+    struct arc_avltree_node *root = tree->root;
+    struct arc_avltree_node *last;
+
+    arc_avltree_expose(tree, &l, &r);
+
+    if (r.root == NULL)
+    {
+        *tree = l;
+        return root;
+    }
+
+    last = arc_avltree_split_last(&r);
+    arc_avltree_join_nodes(tree, &l, root, &r);
+
+    return last;
+}
+
+/******************************************************************************/
+
+/* Joins two subtrees, every element of the left one is less than every
+   element of the right one */
+static void arc_avltree_join_subtrees(struct arc_avltree_subtree *result,
+                                      struct arc_avltree_subtree *left,
+                                      struct arc_avltree_subtree *right)
+{
+    struct arc_avltree_node *node;
+
+    if (left->root == NULL)
+    {
+        *result = *right;
+        return;
+    }
+
+    if (right->root == NULL)
+    {
+        *result = *left;
+        return;
+    }
+
+    node = arc_avltree_split_last(left);
+    arc_avltree_join_nodes(result, left, node, right);
+}
+
+/******************************************************************************/
+
+/* Splits a subtree into the elements less and greater than the key, the node
+   equal to the key is returned, or NULL if there's none */
+static struct arc_avltree_node *
+arc_avltree_split_nodes(struct arc_tree *tree,
+                        struct arc_avltree_subtree *subtree, const void * key,
+                        struct arc_avltree_subtree *less,
+                        struct arc_avltree_subtree *greater)
+{
+    struct arc_avltree_subtree l, r, part;
+    struct arc_avltree_node *root = subtree->root;
+    struct arc_avltree_node *found;
+    int cmp_result;
+
+    if (root == NULL)
+    {
+        less->root = greater->root = NULL;
+        less->height = greater->height = 0;
+        return NULL;
+    }
+
+    arc_avltree_expose(subtree, &l, &r);
+    cmp_result = arc_avltree_compare(tree, (char *)root + tree->data_offset,
+                                     key);
+
+    if (cmp_result == 0)
+    {
+        *less = l;
+        *greater = r;
+        return root;
+    }
+
+    if (cmp_result > 0)
+    {
+        found = arc_avltree_split_nodes(tree, &l, key, less, &part);
+        arc_avltree_join_nodes(greater, &part, root, &r);
+    }
+    else
+    {
+        found = arc_avltree_split_nodes(tree, &r, key, &part, greater);
+        arc_avltree_join_nodes(less, &l, root, &part);
+    }
+
+    return found;
+}
+
+/******************************************************************************/
+
+static void arc_avltree_free_nodes(struct arc_tree *tree,
+                                   struct arc_avltree_node *node)
+{
+    if (node != NULL)
+    {
+        arc_avltree_free_nodes(tree, node->left);
+        arc_avltree_free_nodes(tree, node->right);
+        ARC_FREE(&tree->allocator, node);
+    }
+}
+
+/******************************************************************************/
+
+/* Moves the nodes of other into the subtree, the nodes of other which are
+   equal to one of the subtree are released */
+static void arc_avltree_union_nodes(struct arc_tree *tree,
+                                    struct arc_avltree_subtree *subtree,
+                                    struct arc_avltree_subtree *other)
+{
+    struct arc_avltree_subtree l1, r1, l2, r2;
+    struct arc_avltree_node *found;
+    struct arc_avltree_node *root = other->root;
+
+    if (root == NULL)
+    {
+        return;
+    }
+
+    if (subtree->root == NULL)
+    {
+        *subtree = *other;
+        return;
+    }
+
+    arc_avltree_expose(other, &l2, &r2);
+    found = arc_avltree_split_nodes(tree, subtree,
+                                    (char *)root + tree->data_offset,
+                                    &l1, &r1);
+
+    arc_avltree_union_nodes(tree, &l1, &l2);
+    arc_avltree_union_nodes(tree, &r1, &r2);
+
+    if (found != NULL)
+    {
+        ARC_FREE(&tree->allocator, root);
+        root = found;
+    }
+
+    arc_avltree_join_nodes(subtree, &l1, root, &r1);
+}
+
+/******************************************************************************/
+
+/* Keeps the nodes of the subtree which are equal (or, with keep set to 0,
+   not equal) to one of other, the rest are released. Other is left as is */
+static void arc_avltree_filter_nodes(struct arc_tree *tree,
+                                     struct arc_avltree_subtree *subtree,
+                                     struct arc_avltree_node *other,
+                                     int keep)
+{
+    struct arc_avltree_subtree l1, r1;
+    struct arc_avltree_node *found;
+
+    if (subtree->root == NULL)
+    {
+        return;
+    }
+
+    if (other == NULL)
+    {
+        if (keep)
+        {
+            arc_avltree_free_nodes(tree, subtree->root);
+            subtree->root = NULL;
+            subtree->height = 0;
+        }
+
+        return;
+    }
+
+    found = arc_avltree_split_nodes(tree, subtree,
+                                    (char *)other + tree->data_offset,
+                                    &l1, &r1);
+
+    arc_avltree_filter_nodes(tree, &l1, other->left, keep);
+    arc_avltree_filter_nodes(tree, &r1, other->right, keep);
+
+    if (found != NULL && keep)
+    {
+        arc_avltree_join_nodes(subtree, &l1, found, &r1);
+        return;
+    }
+
+    if (found != NULL)
+    {
+        ARC_FREE(&tree->allocator, found);
+    }
+
+    arc_avltree_join_subtrees(subtree, &l1, &r1);
+}
+
+/******************************************************************************/
+
+/* Loads the subtree of the whole tree */
+static void arc_avltree_subtree_init(struct arc_tree *tree,
+                                     struct arc_avltree_subtree *subtree)
+{
+    subtree->root = (struct arc_avltree_node *)tree->root;
+    subtree->height = arc_avltree_height(subtree->root);
+}
+
+/******************************************************************************/
+
+/* Makes the subtree the whole tree */
+static void arc_avltree_subtree_store(struct arc_tree *tree,
+                                      struct arc_avltree_subtree *subtree)
+{
+    if (subtree->root != NULL)
+    {
+        subtree->root->parent = NULL;
+    }
+
+    tree->root = (struct arc_tree_snode *)subtree->root;
+    tree->size = arc_avltree_count(subtree->root);
+}
+
+/******************************************************************************/
+
+/* Checks that both trees hold the same kind of elements, and with nodes set
+   to 1, that their nodes can be moved from one to the other */
+static int arc_avltree_compatible(struct arc_tree *a, struct arc_tree *b,
+                                  int nodes)
+{
+    if (a == b || a->insert_fn != b->insert_fn ||
+        a->data_size != b->data_size || a->data_offset != b->data_offset ||
+        a->cmp_fn != b->cmp_fn)
+    {
+        return 0;
+    }
+
+    /* A pooled tree has an allocator of its own */
+    return !nodes || (a->node_size == b->node_size &&
+                      a->allocator.alloc_fn == b->allocator.alloc_fn &&
+                      a->allocator.free_fn == b->allocator.free_fn &&
+                      a->allocator.ctx == b->allocator.ctx);
+}
+
+/******************************************************************************/
+
+int arc_avltree_join(struct arc_tree *left, struct arc_tree *right)
+{
+    struct arc_avltree_subtree l, r, result;
+
+    if (!arc_avltree_compatible(left, right, 1))
+    {
+        return ARC_ERROR;
+    }
+
+    if (left->root != NULL && right->root != NULL &&
+        arc_avltree_compare(left,
+                            (char *)arc_tree_max(left->root) +
+                            left->data_offset,
+                            (char *)arc_tree_min(right->root) +
+                            right->data_offset) >= 0)
+    {
+        return ARC_ERROR;
+    }
+
+    arc_avltree_subtree_init(left, &l);
+    arc_avltree_subtree_init(right, &r);
+    arc_avltree_join_subtrees(&result, &l, &r);
+
+    arc_avltree_subtree_store(left, &result);
+    right->root = NULL;
+    right->size = 0;
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+int arc_avltree_split(struct arc_tree *avltree, const void * key,
+                      struct arc_tree *left, struct arc_tree *right)
+{
+    struct arc_avltree_subtree subtree, less, greater;
+    struct arc_avltree_node *found;
+
+    if (!arc_avltree_compatible(avltree, left, 1) ||
+        !arc_avltree_compatible(avltree, right, 1) ||
+        left == right || left->root != NULL || right->root != NULL)
+    {
+        return ARC_ERROR;
+    }
+
+    arc_avltree_subtree_init(avltree, &subtree);
+    found = arc_avltree_split_nodes(avltree, &subtree, key, &less, &greater);
+
+    arc_avltree_subtree_store(left, &less);
+    arc_avltree_subtree_store(right, &greater);
+
+    /* The element equal to the key stays */
+    subtree.root = found;
+    subtree.height = (found != NULL);
+
+    if (found != NULL)
+    {
+        found->left = found->right = NULL;
+        found->balance_factor = 0;
+        found->count = 1;
+    }
+
+    arc_avltree_subtree_store(avltree, &subtree);
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+int arc_avltree_union(struct arc_tree *avltree, struct arc_tree *other)
+{
+    struct arc_avltree_subtree subtree, nodes;
+
+    if (!arc_avltree_compatible(avltree, other, 1))
+    {
+        return ARC_ERROR;
+    }
+
+    arc_avltree_subtree_init(avltree, &subtree);
+    arc_avltree_subtree_init(other, &nodes);
+    arc_avltree_union_nodes(avltree, &subtree, &nodes);
+
+    arc_avltree_subtree_store(avltree, &subtree);
+    other->root = NULL;
+    other->size = 0;
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+int arc_avltree_intersection(struct arc_tree *avltree, struct arc_tree *other)
+{
+    struct arc_avltree_subtree subtree;
+
+    if (!arc_avltree_compatible(avltree, other, 0))
+    {
+        return ARC_ERROR;
+    }
+
+    arc_avltree_subtree_init(avltree, &subtree);
+    arc_avltree_filter_nodes(avltree, &subtree,
+                             (struct arc_avltree_node *)other->root, 1);
+    arc_avltree_subtree_store(avltree, &subtree);
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+int arc_avltree_difference(struct arc_tree *avltree, struct arc_tree *other)
+{
+    struct arc_avltree_subtree subtree;
+
+    if (!arc_avltree_compatible(avltree, other, 0))
+    {
+        return ARC_ERROR;
+    }
+
+    arc_avltree_subtree_init(avltree, &subtree);
+    arc_avltree_filter_nodes(avltree, &subtree,
+                             (struct arc_avltree_node *)other->root, 0);
+    arc_avltree_subtree_store(avltree, &subtree);
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+/* Union, intersection or difference of a piece of both trees */
+struct arc_avltree_set_task
+{
+    struct arc_tree *tree;
+    struct arc_pool *pool;
+    struct arc_avltree_subtree subtree;
+    struct arc_avltree_subtree other;
+    int keep; /* Same as in arc_avltree_filter_nodes */
+};
+
+/******************************************************************************/
+
+/* Parallel version of arc_avltree_union_nodes, both halves are merged at the
+   same time while they're big enough */
+static void arc_avltree_parallel_union_task(void * arg)
+{
+    struct arc_avltree_set_task *task = arg;
+    struct arc_avltree_set_task left, right;
+    struct arc_avltree_node *root = task->other.root;
+    struct arc_avltree_node *found;
+
+    if (root == NULL || task->subtree.root == NULL ||
+        arc_avltree_count(root) + arc_avltree_count(task->subtree.root) <
+        ARC_AVLTREE_PARALLEL_MIN)
+    {
+        arc_avltree_union_nodes(task->tree, &task->subtree, &task->other);
+        return;
+    }
+
+    left = right = *task;
+
+    arc_avltree_expose(&task->other, &left.other, &right.other);
+    found = arc_avltree_split_nodes(task->tree, &task->subtree,
+                                    (char *)root + task->tree->data_offset,
+                                    &left.subtree, &right.subtree);
+
+    arc_pool_fork_join(task->pool,
+                       &arc_avltree_parallel_union_task, &left,
+                       &arc_avltree_parallel_union_task, &right);
+
+    if (found != NULL)
+    {
+        ARC_FREE(&task->tree->allocator, root);
+        root = found;
+    }
+
+    arc_avltree_join_nodes(&task->subtree, &left.subtree, root,
+                           &right.subtree);
+}
+
+/******************************************************************************/
+
+/* Parallel version of arc_avltree_filter_nodes */
+static void arc_avltree_parallel_filter_task(void * arg)
+{
+    struct arc_avltree_set_task *task = arg;
+    struct arc_avltree_set_task left, right;
+    struct arc_avltree_node *other = task->other.root;
+    struct arc_avltree_node *found;
+
+    if (other == NULL || task->subtree.root == NULL ||
+        arc_avltree_count(other) + arc_avltree_count(task->subtree.root) <
+        ARC_AVLTREE_PARALLEL_MIN)
+    {
+        arc_avltree_filter_nodes(task->tree, &task->subtree, other,
+                                 task->keep);
+        return;
+    }
+
+    left = right = *task;
+    left.other.root = other->left;
+    right.other.root = other->right;
+
+    found = arc_avltree_split_nodes(task->tree, &task->subtree,
+                                    (char *)other + task->tree->data_offset,
+                                    &left.subtree, &right.subtree);
+
+    arc_pool_fork_join(task->pool,
+                       &arc_avltree_parallel_filter_task, &left,
+                       &arc_avltree_parallel_filter_task, &right);
+
+    if (found != NULL && task->keep)
+    {
+        arc_avltree_join_nodes(&task->subtree, &left.subtree, found,
+                               &right.subtree);
+        return;
+    }
+
+    if (found != NULL)
+    {
+        ARC_FREE(&task->tree->allocator, found);
+    }
+
+    arc_avltree_join_subtrees(&task->subtree, &left.subtree, &right.subtree);
+}
+
+/******************************************************************************/
+
+static int arc_avltree_parallel_filter(struct arc_tree *avltree,
+                                       struct arc_tree *other,
+                                       struct arc_pool *pool, int keep)
+{
+    struct arc_avltree_set_task task;
+
+    if (!arc_avltree_compatible(avltree, other, 0))
+    {
+        return ARC_ERROR;
+    }
+
+    /* The nodes of a pool are released by the caller only */
+    task.tree = avltree;
+    task.pool = (avltree->pool != NULL ? NULL : pool);
+    task.other.root = (struct arc_avltree_node *)other->root;
+    task.other.height = 0;
+    task.keep = keep;
+
+    arc_avltree_subtree_init(avltree, &task.subtree);
+    arc_avltree_parallel_filter_task(&task);
+    arc_avltree_subtree_store(avltree, &task.subtree);
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+int arc_avltree_parallel_union(struct arc_tree *avltree,
+                               struct arc_tree *other, arc_pool_t pool)
+{
+    struct arc_avltree_set_task task;
+
+    if (!arc_avltree_compatible(avltree, other, 1))
+    {
+        return ARC_ERROR;
+    }
+
+    task.tree = avltree;
+    task.pool = pool;
+    task.keep = 0;
+
+    arc_avltree_subtree_init(avltree, &task.subtree);
+    arc_avltree_subtree_init(other, &task.other);
+    arc_avltree_parallel_union_task(&task);
+
+    arc_avltree_subtree_store(avltree, &task.subtree);
+    other->root = NULL;
+    other->size = 0;
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+int arc_avltree_parallel_intersection(struct arc_tree *avltree,
+                                      struct arc_tree *other,
+                                      arc_pool_t pool)
+{
+    return arc_avltree_parallel_filter(avltree, other, pool, 1);
+}
+
+/******************************************************************************/
+
+int arc_avltree_parallel_difference(struct arc_tree *avltree,
+                                    struct arc_tree *other, arc_pool_t pool)
+{
+    return arc_avltree_parallel_filter(avltree, other, pool, 0);
+}
+
+/******************************************************************************/
+
+/* Builds the perfectly balanced subtree of a range of sorted elements, the
+   same one arc_avltree_link would build */
+struct arc_avltree_build_task
+{
+    struct arc_tree *tree;
+    struct arc_pool *pool;
+    const char *data;
+    char *block; /* Nodes of a pooled tree, NULL to allocate them */
+    size_t first;
+    size_t num;
+    struct arc_avltree_node *root; /* NULL if memory ran out */
+};
+
+/******************************************************************************/
+
+static void arc_avltree_parallel_build_task(void * arg)
+{
+    struct arc_avltree_build_task *task = arg;
+    struct arc_avltree_build_task left, right;
+    struct arc_tree *tree = task->tree;
+    struct arc_avltree_node *node;
+    size_t mid = task->first + (task->num - 1) / 2;
+
+    task->root = NULL;
+
+    if (task->num == 0)
+    {
+        return;
+    }
+
+    if (task->block != NULL)
+    {
+        void *ptr = task->block + mid * arc_slab_object_size(tree->pool);
+        node = ptr;
+    }
+    else if ((node = ARC_ALLOC(&tree->allocator, tree->node_size)) == NULL)
+    {
+        return;
+    }
+
+    left = right = *task;
+    left.num = (task->num - 1) / 2;
+    right.first = mid + 1;
+    right.num = task->num / 2;
+
+    /* Small subtrees are built by the calling thread */
+    arc_pool_fork_join(task->num < ARC_AVLTREE_PARALLEL_MIN ? NULL :
+                       task->pool,
+                       &arc_avltree_parallel_build_task, &left,
+                       &arc_avltree_parallel_build_task, &right);
+
+    if ((left.num > 0 && left.root == NULL) ||
+        (right.num > 0 && right.root == NULL))
+    {
+        arc_avltree_free_nodes(tree, left.root);
+        arc_avltree_free_nodes(tree, right.root);
+        ARC_FREE(&tree->allocator, node);
+        return;
+    }
+
+    memcpy((char *)node + tree->data_offset, task->data + mid * tree->data_size,
+           tree->data_size);
+
+    node->left = left.root;
+    node->right = right.root;
+    node->balance_factor = arc_avltree_link_height(right.num) -
+                           arc_avltree_link_height(left.num);
+    node->count = task->num;
+
+    if (left.root != NULL)
+    {
+        left.root->parent = node;
+    }
+
+    if (right.root != NULL)
+    {
+        right.root->parent = node;
+    }
+
+    task->root = node;
+}
+
+/******************************************************************************/
+
+int arc_avltree_parallel_build_sorted(struct arc_tree *avltree,
+                                      const void * data, size_t n,
+                                      arc_pool_t pool)
+{
+    struct arc_avltree_build_task task;
+    struct arc_avltree_subtree subtree;
+
+    if (avltree->size != 0 || !arc_avltree_sorted(avltree, data, n, 1))
+    {
+        return ARC_ERROR;
+    }
+
+    if (n == 0)
+    {
+        return ARC_SUCCESS;
+    }
+
+    task.tree = avltree;
+    task.pool = pool;
+    task.data = data;
+    task.block = NULL;
+    task.first = 0;
+    task.num = n;
+
+    if (avltree->pool != NULL &&
+        (task.block = arc_slab_alloc_array(avltree->pool, n)) == NULL)
+    {
+        return ARC_OUT_OF_MEMORY;
+    }
+
+    arc_avltree_parallel_build_task(&task);
+
+    if (task.root == NULL)
+    {
+        return ARC_OUT_OF_MEMORY;
+    }
+
+    subtree.root = task.root;
+    subtree.height = arc_avltree_link_height(n);
+    arc_avltree_subtree_store(avltree, &subtree);
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+ * @brief Removes a node from the avltree
+ *
+ * @param[in] avltree Binary search tree to perform the operation on
+ * @param[in] data node node to be removed
+ */
+static void arc_avltree_remove_internal(struct arc_tree *tree,
+                                        struct arc_tree_snode *snode)
+{
+    int factor;
+    struct arc_tree *avltree = (struct arc_tree *)tree;
+    struct arc_avltree_node *node = (struct arc_avltree_node *)snode;
+    struct arc_avltree_node *parent, *child, *successor, **node_ref;
+
+    node_ref = (struct arc_avltree_node **)arc_tree_node_ref(avltree, snode);
+
+    successor = (struct arc_avltree_node *)
+                arc_tree_successor((struct arc_tree_snode *)node);
+
+    if (successor == NULL)
+    {
+        parent = node->parent;
+        if (parent != NULL)
+        {
+            factor = (parent->left == node ? 1 : -1);
+        }
+    }
+    else
+    {
+        parent = successor->parent;
+
+        successor->parent = node->parent;
+
+        if (parent == node)
+        {
+            factor = (parent->left == successor ? 1 : -1);
+            successor->balance_factor = parent->balance_factor;
+            parent = successor;
+
+            if(node->right == successor && node->left != NULL)
+            {
+                successor->left = node->left;
+                successor->left->parent = successor;
+            }
+        }
+        else
+        {
+            if (parent != NULL)
+            {
+                parent->left = successor->right;
+
+                if (parent->left != NULL)
+                    {
+                    parent->left->parent = parent;
+                }
+            }
+
+            factor = 1;
+            successor->balance_factor = node->balance_factor;
+            successor->left = node->left;
+            
+            if (successor->left != NULL)
+            {
+                successor->left->parent = successor;
+            }
+
+            /* We know for a fact that the right is not NULL */
+            successor->right = node->right;
+            successor->right->parent = successor;
+        }
+    }
+
+    *node_ref = successor;
+
+    /* The successor takes the place of the node, every subtree from where it
+       was taken up to the root has one node less */
+    if (successor != NULL)
+    {
+        successor->count = node->count;
+    }
+
+    for (child = parent; child != NULL; child = child->parent)
+    {
+        child->count--;
+    }
+
+    while (parent != NULL)
+    {
+        if (abs(parent->balance_factor + factor) == 2)
+        {
+            node_ref = (struct arc_avltree_node **)
+                       arc_tree_node_ref(avltree,
+                                         (struct arc_tree_snode *)parent);
+            arc_avltree_rotate(parent, node_ref);
+            parent = *node_ref;
+        }
+        else
+        {
+            parent->balance_factor += factor;
+        }
+
+        if (abs(parent->balance_factor) == 1)
+        {
+            break;
+        }
+
+        child = parent;
+        parent = parent->parent;
+
+        if (parent == NULL) 
+        {
+            break;
+        }
+
+        factor = (parent->right == child ? -1 : 1);
+    }
+
+    ARC_FREE(&avltree->allocator, node);
+    avltree->size--;
+}
+
+
+/******************************************************************************/
+
+void arc_avltree_remove(struct arc_tree *avltree, const void * data)
+{
+    arc_tree_remove((struct arc_tree *)avltree, data);
+}
+
+/******************************************************************************/
+
+int arc_avltree_empty(struct arc_tree * avltree)
+{
+    return arc_tree_empty((struct arc_tree *)avltree);
+}
+
+/******************************************************************************/
+
+size_t arc_avltree_size(struct arc_tree * avltree)
+{
+    return arc_tree_size((struct arc_tree *)avltree);
+}
+
+/******************************************************************************/
+
+void arc_avltree_clear(struct arc_tree *avltree)
+{
+    arc_tree_clear((struct arc_tree *)avltree);
+}
+
+/******************************************************************************/
+
+int arc_avltree_iterator_init(struct arc_tree_iterator *it,
+                              struct arc_tree *tree)
+{
+    return arc_tree_iterator_init(it, tree);
+}
+
+/******************************************************************************/
+
+void arc_avltree_iterator_fini(struct arc_tree_iterator *it)
+{
+    arc_tree_iterator_fini(it);
+}
+
+/******************************************************************************/
+
+struct arc_tree_iterator * arc_avltree_iterator_create(struct arc_tree *tree)
 {
     return arc_tree_iterator_create(tree);
 }
@@ -582,6 +1938,35 @@ int arc_avltree_position(struct arc_tree_iterator * it, const void * data)
     return arc_tree_position(it, data);
 }
 
+/******************************************************************************/
+
+int arc_avltree_lower_bound(struct arc_tree_iterator * it, const void * data)
+{
+    return arc_tree_lower_bound(it, data);
+}
+
+/******************************************************************************/
+
+int arc_avltree_upper_bound(struct arc_tree_iterator * it, const void * data)
+{
+    return arc_tree_upper_bound(it, data);
+}
+
+/******************************************************************************/
+
+int arc_avltree_range(struct arc_tree_iterator * it, const void * first,
+                      const void * last)
+{
+    return arc_tree_range(it, first, last);
+}
+
+/******************************************************************************/
+
+int arc_avltree_range_next(struct arc_tree_iterator * it, const void * last)
+{
+    return arc_tree_range_next(it, last);
+}
+
 /******************************************************************************/
 void arc_avltree_erase(struct arc_tree_iterator * it)
 {
@@ -19,6 +19,7 @@ struct arc_avltree_node
     struct arc_avltree_node * left;
     struct arc_avltree_node * right;
     int balance_factor;
+    size_t count; /**< Nodes in the subtree, as wide as the tree size */
     char data[1];
 };
 
@@ -26,7 +27,40 @@ int arc_avltree_init(struct arc_tree *tree,
                      size_t data_size,
                      arc_cmp_fn_t cmp_fn);
 
+int arc_avltree_init_with_allocator(struct arc_tree *tree,
+                                    size_t data_size,
+                                    arc_cmp_fn_t cmp_fn,
+                                    const struct arc_allocator *allocator);
+
+/**
+ * @brief Initializes an avltree whose nodes have a custom layout
+ *
+ * The node has to start with the same fields as struct arc_avltree_node, but
+ * the data can be placed at any offset, which allows typed nodes that keep
+ * the natural alignment of their element (see arc/container/typed.h).
+ */
+int arc_avltree_init_with_layout(struct arc_tree *tree,
+                                 size_t data_size,
+                                 size_t data_offset,
+                                 size_t node_size,
+                                 arc_cmp_fn_t cmp_fn,
+                                 const struct arc_allocator *allocator);
+
+int arc_avltree_init_pooled(struct arc_tree *tree,
+                            size_t data_size,
+                            arc_cmp_fn_t cmp_fn);
+
 void arc_avltree_fini(struct arc_tree *tree);
+
+/**
+ * @brief Rebalances the avltree after a leaf has been linked into it
+ *
+ * The node must have been hooked to its parent, with no children and a zero
+ * balance factor. The size of the tree is updated as well.
+ */
+void arc_avltree_insert_fixup(struct arc_tree *tree,
+                              struct arc_tree_snode *node);
+
 int arc_avltree_iterator_init(struct arc_tree_iterator *it,
                               struct arc_tree *tree);
 void arc_avltree_iterator_fini(struct arc_tree_iterator *it);
@@ -0,0 +1,1033 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @file bptree.c
+ * @author Anil M. Mahtani Mirchandani
+ * @date December, 2015
+ *
+ * @brief BPTree
+ *
+ * @see https://en.wikipedia.org/wiki/B%2B_tree
+ */
+
+#include <string.h>
+#include <arc/common/defines.h>
+#include <arc/container/bptree.h>
+#include <arc/container/bptree_def.h>
+
+/******************************************************************************/
+
+#define ARC_BPTREE_CHILDREN(node) ((struct arc_bptree_node **)((node) + 1))
+
+#define ARC_BPTREE_KEYS(tree, node) \
+    ((char *)(node) + ((node)->leaf ? sizeof(struct arc_bptree_node) \
+                                    : (tree)->keys_offset))
+
+#define ARC_BPTREE_KEY(tree, node, i) \
+    (ARC_BPTREE_KEYS(tree, node) + (i) * (tree)->data_size)
+
+/******************************************************************************/
+
+int arc_bptree_init(struct arc_bptree *tree,
+                    size_t data_size,
+                    arc_cmp_fn_t cmp_fn)
+{
+    return arc_bptree_init_with_allocator(tree, data_size, cmp_fn, NULL);
+}
+
+/******************************************************************************/
+
+int arc_bptree_init_with_allocator(struct arc_bptree *tree,
+                                   size_t data_size,
+                                   arc_cmp_fn_t cmp_fn,
+                                   const struct arc_allocator *allocator)
+{
+    size_t header_size = sizeof(struct arc_bptree_node);
+    size_t pointer_size = sizeof(struct arc_bptree_node *);
+
+    tree->root = NULL;
+    tree->first = NULL;
+    tree->last = NULL;
+    tree->size = 0;
+    tree->data_size = data_size;
+    tree->cmp_fn = cmp_fn;
+    tree->allocator = (allocator != NULL ? *allocator : arc_default_allocator);
+
+    /* An inner node with n keys has n + 1 children */
+    tree->leaf_capacity = (ARC_BPTREE_NODE_SIZE - header_size) / data_size;
+    tree->inner_capacity = (ARC_BPTREE_NODE_SIZE - header_size - pointer_size) /
+                           (data_size + pointer_size);
+
+    if (tree->leaf_capacity < ARC_BPTREE_MIN_CAPACITY)
+    {
+        tree->leaf_capacity = ARC_BPTREE_MIN_CAPACITY;
+    }
+
+    if (tree->inner_capacity < ARC_BPTREE_MIN_CAPACITY)
+    {
+        tree->inner_capacity = ARC_BPTREE_MIN_CAPACITY;
+    }
+
+    tree->keys_offset = header_size + (tree->inner_capacity + 1) * pointer_size;
+
+    tree->buffer = ARC_ALLOC(&tree->allocator, 2 * data_size);
+
+    if (tree->buffer == NULL)
+    {
+        return ARC_OUT_OF_MEMORY;
+    }
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+void arc_bptree_fini(struct arc_bptree *tree)
+{
+    arc_bptree_clear(tree);
+    ARC_FREE(&tree->allocator, tree->buffer);
+}
+
+/******************************************************************************/
+
+struct arc_bptree * arc_bptree_create(size_t data_size, arc_cmp_fn_t cmp_fn)
+{
+    return arc_bptree_create_with_allocator(data_size, cmp_fn, NULL);
+}
+
+/******************************************************************************/
+
+struct arc_bptree *
+arc_bptree_create_with_allocator(size_t data_size,
+                                 arc_cmp_fn_t cmp_fn,
+                                 const struct arc_allocator *allocator)
+{
+    struct arc_bptree * tree = malloc(sizeof(struct arc_bptree));
+
+    if (tree == NULL)
+    {
+        return NULL;
+    }
+
+    if (arc_bptree_init_with_allocator(tree, data_size,
+                                       cmp_fn, allocator) != ARC_SUCCESS)
+    {
+        free(tree);
+        return NULL;
+    }
+
+    return tree;
+}
+
+/******************************************************************************/
+
+void arc_bptree_destroy(struct arc_bptree *tree)
+{
+    arc_bptree_fini(tree);
+    free(tree);
+}
+
+/******************************************************************************/
+
+static int arc_bptree_compare(struct arc_bptree *tree,
+                              const void *a, const void *b)
+{
+    if (tree->cmp_fn == NULL)
+    {
+        return memcmp(a, b, tree->data_size);
+    }
+
+    return (*tree->cmp_fn)(a, b);
+}
+
+/******************************************************************************/
+/**
+ * @brief Returns the index of the first element of a node not smaller than
+ * the given one
+ */
+static size_t arc_bptree_lower_bound(struct arc_bptree *tree,
+                                     struct arc_bptree_node *node,
+                                     const void *data)
+{
+    size_t low = 0;
+    size_t high = node->num_keys;
+    char *keys = ARC_BPTREE_KEYS(tree, node);
+
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+
+        if (arc_bptree_compare(tree, keys + mid * tree->data_size, data) < 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+/******************************************************************************/
+/**
+ * @brief Returns the index of the child of an inner node which holds the
+ * given element, that is the number of keys not bigger than it
+ */
+static size_t arc_bptree_child_index(struct arc_bptree *tree,
+                                     struct arc_bptree_node *node,
+                                     const void *data)
+{
+    size_t low = 0;
+    size_t high = node->num_keys;
+    char *keys = ARC_BPTREE_KEYS(tree, node);
+
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+
+        if (arc_bptree_compare(tree, keys + mid * tree->data_size, data) <= 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+/******************************************************************************/
+/**
+ * @brief Finds the leaf which holds the given element
+ *
+ * If path is not NULL the inner nodes visited and the index of the child
+ * taken in each of them are stored in path and path_idx.
+ */
+static struct arc_bptree_node *
+arc_bptree_find_leaf(struct arc_bptree *tree, const void *data,
+                     struct arc_bptree_node **path, size_t *path_idx,
+                     size_t *depth)
+{
+    struct arc_bptree_node *node = tree->root;
+    size_t level = 0;
+
+    while (!node->leaf)
+    {
+        size_t idx = arc_bptree_child_index(tree, node, data);
+
+        if (path != NULL)
+        {
+            path[level] = node;
+            path_idx[level] = idx;
+        }
+
+        level++;
+        node = ARC_BPTREE_CHILDREN(node)[idx];
+    }
+
+    if (depth != NULL)
+    {
+        *depth = level;
+    }
+
+    return node;
+}
+
+/******************************************************************************/
+
+static struct arc_bptree_node *arc_bptree_node_alloc(struct arc_bptree *tree,
+                                                     int leaf)
+{
+    struct arc_bptree_node *node;
+    size_t size = (leaf ?
+                   sizeof(struct arc_bptree_node) +
+                       tree->leaf_capacity * tree->data_size :
+                   tree->keys_offset + tree->inner_capacity * tree->data_size);
+
+    node = ARC_ALLOC(&tree->allocator, size);
+
+    if (node == NULL)
+    {
+        return NULL;
+    }
+
+    node->num_keys = 0;
+    node->leaf = leaf;
+    node->prev = NULL;
+    node->next = NULL;
+
+    return node;
+}
+
+/******************************************************************************/
+
+static void arc_bptree_leaf_insert(struct arc_bptree *tree,
+                                   struct arc_bptree_node *leaf,
+                                   size_t idx, const void *data)
+{
+    char *key = ARC_BPTREE_KEY(tree, leaf, idx);
+
+    memmove(key + tree->data_size, key,
+            (leaf->num_keys - idx) * tree->data_size);
+    memcpy(key, data, tree->data_size);
+
+    leaf->num_keys++;
+}
+
+/******************************************************************************/
+/**
+ * @brief Inserts a key and the child at its right into an inner node
+ */
+static void arc_bptree_inner_insert(struct arc_bptree *tree,
+                                    struct arc_bptree_node *node,
+                                    size_t idx, const void *key,
+                                    struct arc_bptree_node *child)
+{
+    char *key_ptr = ARC_BPTREE_KEY(tree, node, idx);
+    struct arc_bptree_node **children = ARC_BPTREE_CHILDREN(node);
+
+    memmove(key_ptr + tree->data_size, key_ptr,
+            (node->num_keys - idx) * tree->data_size);
+    memcpy(key_ptr, key, tree->data_size);
+
+    memmove(&children[idx + 2], &children[idx + 1],
+            (node->num_keys - idx) * sizeof(struct arc_bptree_node *));
+    children[idx + 1] = child;
+
+    node->num_keys++;
+}
+
+/******************************************************************************/
+/**
+ * @brief Splits a full inner node while inserting a key into it
+ *
+ * The upper half of the node is moved to right and the middle key, which
+ * separates both halves, is copied to median.
+ */
+static void arc_bptree_inner_split(struct arc_bptree *tree,
+                                   struct arc_bptree_node *node,
+                                   struct arc_bptree_node *right,
+                                   size_t idx, const void *key,
+                                   struct arc_bptree_node *child,
+                                   void *median)
+{
+    size_t num_keys = node->num_keys;
+    size_t mid = num_keys / 2;
+
+    memcpy(median, ARC_BPTREE_KEY(tree, node, mid), tree->data_size);
+
+    right->num_keys = num_keys - mid - 1;
+    memcpy(ARC_BPTREE_KEYS(tree, right), ARC_BPTREE_KEY(tree, node, mid + 1),
+           right->num_keys * tree->data_size);
+    memcpy(ARC_BPTREE_CHILDREN(right), ARC_BPTREE_CHILDREN(node) + mid + 1,
+           (right->num_keys + 1) * sizeof(struct arc_bptree_node *));
+
+    node->num_keys = mid;
+
+    if (idx <= mid)
+    {
+        arc_bptree_inner_insert(tree, node, idx, key, child);
+    }
+    else
+    {
+        arc_bptree_inner_insert(tree, right, idx - mid - 1, key, child);
+    }
+}
+
+/******************************************************************************/
+/**
+ * @brief Inserts an element into a full leaf
+ *
+ * The leaf is split in two and the first element of the new leaf is inserted
+ * into the parent, which is split as well if it's full, and so on up to the
+ * root. All the nodes needed are allocated beforehand so the tree is never
+ * left half split if memory runs out.
+ */
+static int arc_bptree_insert_split(struct arc_bptree *tree,
+                                   struct arc_bptree_node **path,
+                                   size_t *path_idx, size_t depth,
+                                   struct arc_bptree_node *leaf,
+                                   size_t idx, const void *data)
+{
+    struct arc_bptree_node *spare[ARC_BPTREE_MAX_HEIGHT + 1];
+    struct arc_bptree_node *left = leaf, *right;
+    size_t i, mid, num_spare = 1, level = depth;
+    char *key = tree->buffer;
+    char *median = key + tree->data_size;
+
+    while (level > 0 && path[level - 1]->num_keys == tree->inner_capacity)
+    {
+        num_spare++;
+        level--;
+    }
+
+    /* The root is split so a new root is needed */
+    if (level == 0)
+    {
+        num_spare++;
+    }
+
+    for (i = 0; i < num_spare; i++)
+    {
+        spare[i] = arc_bptree_node_alloc(tree, i == 0);
+
+        if (spare[i] == NULL)
+        {
+            while (i-- > 0)
+            {
+                ARC_FREE(&tree->allocator, spare[i]);
+            }
+
+            return ARC_OUT_OF_MEMORY;
+        }
+    }
+
+    /* Split the leaf and link the new one after it */
+    right = spare[0];
+    mid = leaf->num_keys / 2;
+
+    right->num_keys = leaf->num_keys - mid;
+    memcpy(ARC_BPTREE_KEYS(tree, right), ARC_BPTREE_KEY(tree, leaf, mid),
+           right->num_keys * tree->data_size);
+    leaf->num_keys = mid;
+
+    right->prev = leaf;
+    right->next = leaf->next;
+
+    if (leaf->next != NULL)
+    {
+        leaf->next->prev = right;
+    }
+    else
+    {
+        tree->last = right;
+    }
+
+    leaf->next = right;
+
+    if (idx <= mid)
+    {
+        arc_bptree_leaf_insert(tree, leaf, idx, data);
+    }
+    else
+    {
+        arc_bptree_leaf_insert(tree, right, idx - mid, data);
+    }
+
+    memcpy(key, ARC_BPTREE_KEYS(tree, right), tree->data_size);
+
+    /* Insert the separator into the ancestors */
+    for (i = 1; depth > 0; depth--)
+    {
+        struct arc_bptree_node *parent = path[depth - 1];
+        char *tmp;
+
+        if (parent->num_keys < tree->inner_capacity)
+        {
+            arc_bptree_inner_insert(tree, parent, path_idx[depth - 1],
+                                    key, right);
+            return ARC_SUCCESS;
+        }
+
+        arc_bptree_inner_split(tree, parent, spare[i], path_idx[depth - 1],
+                               key, right, median);
+
+        left = parent;
+        right = spare[i++];
+
+        tmp = key;
+        key = median;
+        median = tmp;
+    }
+
+    /* The old root and its new sibling become children of a new root */
+    tree->root = spare[i];
+    tree->root->num_keys = 1;
+    memcpy(ARC_BPTREE_KEYS(tree, tree->root), key, tree->data_size);
+    ARC_BPTREE_CHILDREN(tree->root)[0] = left;
+    ARC_BPTREE_CHILDREN(tree->root)[1] = right;
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+int arc_bptree_insert(struct arc_bptree *tree, const void *data)
+{
+    struct arc_bptree_node *path[ARC_BPTREE_MAX_HEIGHT];
+    size_t path_idx[ARC_BPTREE_MAX_HEIGHT];
+    struct arc_bptree_node *leaf;
+    size_t idx, depth;
+
+    if (tree->root == NULL)
+    {
+        leaf = arc_bptree_node_alloc(tree, 1);
+
+        if (leaf == NULL)
+        {
+            return ARC_OUT_OF_MEMORY;
+        }
+
+        arc_bptree_leaf_insert(tree, leaf, 0, data);
+
+        tree->root = leaf;
+        tree->first = leaf;
+        tree->last = leaf;
+        tree->size = 1;
+
+        return ARC_SUCCESS;
+    }
+
+    leaf = arc_bptree_find_leaf(tree, data, path, path_idx, &depth);
+    idx = arc_bptree_lower_bound(tree, leaf, data);
+
+    if (idx < leaf->num_keys &&
+        arc_bptree_compare(tree, ARC_BPTREE_KEY(tree, leaf, idx), data) == 0)
+    {
+        return ARC_DUPLICATE;
+    }
+
+    if (leaf->num_keys < tree->leaf_capacity)
+    {
+        arc_bptree_leaf_insert(tree, leaf, idx, data);
+    }
+    else
+    {
+        int retval = arc_bptree_insert_split(tree, path, path_idx, depth,
+                                             leaf, idx, data);
+
+        if (retval != ARC_SUCCESS)
+        {
+            return retval;
+        }
+    }
+
+    tree->size++;
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+void * arc_bptree_retrieve(struct arc_bptree *tree, const void *data)
+{
+    struct arc_bptree_node *leaf;
+    size_t idx;
+
+    if (tree->root == NULL)
+    {
+        return NULL;
+    }
+
+    leaf = arc_bptree_find_leaf(tree, data, NULL, NULL, NULL);
+    idx = arc_bptree_lower_bound(tree, leaf, data);
+
+    if (idx < leaf->num_keys &&
+        arc_bptree_compare(tree, ARC_BPTREE_KEY(tree, leaf, idx), data) == 0)
+    {
+        return ARC_BPTREE_KEY(tree, leaf, idx);
+    }
+
+    return NULL;
+}
+
+/******************************************************************************/
+/**
+ * @brief Moves the last element of left to the front of node, its right
+ * sibling
+ */
+static void arc_bptree_borrow_left(struct arc_bptree *tree,
+                                   struct arc_bptree_node *parent,
+                                   size_t idx,
+                                   struct arc_bptree_node *left,
+                                   struct arc_bptree_node *node)
+{
+    char *separator = ARC_BPTREE_KEY(tree, parent, idx - 1);
+    char *keys = ARC_BPTREE_KEYS(tree, node);
+
+    memmove(keys + tree->data_size, keys, node->num_keys * tree->data_size);
+
+    if (node->leaf)
+    {
+        memcpy(keys, ARC_BPTREE_KEY(tree, left, left->num_keys - 1),
+               tree->data_size);
+        memcpy(separator, keys, tree->data_size);
+    }
+    else
+    {
+        struct arc_bptree_node **children = ARC_BPTREE_CHILDREN(node);
+
+        memmove(&children[1], &children[0],
+                (node->num_keys + 1) * sizeof(struct arc_bptree_node *));
+        children[0] = ARC_BPTREE_CHILDREN(left)[left->num_keys];
+
+        memcpy(keys, separator, tree->data_size);
+        memcpy(separator, ARC_BPTREE_KEY(tree, left, left->num_keys - 1),
+               tree->data_size);
+    }
+
+    left->num_keys--;
+    node->num_keys++;
+}
+
+/******************************************************************************/
+/**
+ * @brief Moves the first element of right to the back of node, its left
+ * sibling
+ */
+static void arc_bptree_borrow_right(struct arc_bptree *tree,
+                                    struct arc_bptree_node *parent,
+                                    size_t idx,
+                                    struct arc_bptree_node *node,
+                                    struct arc_bptree_node *right)
+{
+    char *separator = ARC_BPTREE_KEY(tree, parent, idx);
+    char *keys = ARC_BPTREE_KEYS(tree, right);
+
+    if (node->leaf)
+    {
+        memcpy(ARC_BPTREE_KEY(tree, node, node->num_keys), keys,
+               tree->data_size);
+        memmove(keys, keys + tree->data_size,
+                (right->num_keys - 1) * tree->data_size);
+        memcpy(separator, keys, tree->data_size);
+    }
+    else
+    {
+        struct arc_bptree_node **children = ARC_BPTREE_CHILDREN(right);
+
+        memcpy(ARC_BPTREE_KEY(tree, node, node->num_keys), separator,
+               tree->data_size);
+        ARC_BPTREE_CHILDREN(node)[node->num_keys + 1] = children[0];
+
+        memcpy(separator, keys, tree->data_size);
+        memmove(keys, keys + tree->data_size,
+                (right->num_keys - 1) * tree->data_size);
+        memmove(&children[0], &children[1],
+                right->num_keys * sizeof(struct arc_bptree_node *));
+    }
+
+    right->num_keys--;
+    node->num_keys++;
+}
+
+/******************************************************************************/
+/**
+ * @brief Merges right into left, its left sibling, and removes the separator
+ * between both from the parent
+ */
+static void arc_bptree_merge(struct arc_bptree *tree,
+                             struct arc_bptree_node *parent,
+                             size_t idx,
+                             struct arc_bptree_node *left,
+                             struct arc_bptree_node *right)
+{
+    struct arc_bptree_node **parent_children = ARC_BPTREE_CHILDREN(parent);
+    char *separator = ARC_BPTREE_KEY(tree, parent, idx);
+
+    if (left->leaf)
+    {
+        memcpy(ARC_BPTREE_KEY(tree, left, left->num_keys),
+               ARC_BPTREE_KEYS(tree, right),
+               right->num_keys * tree->data_size);
+        left->num_keys += right->num_keys;
+
+        left->next = right->next;
+
+        if (right->next != NULL)
+        {
+            right->next->prev = left;
+        }
+        else
+        {
+            tree->last = left;
+        }
+    }
+    else
+    {
+        /* The separator comes down between the keys of both nodes */
+        memcpy(ARC_BPTREE_KEY(tree, left, left->num_keys), separator,
+               tree->data_size);
+        memcpy(ARC_BPTREE_KEY(tree, left, left->num_keys + 1),
+               ARC_BPTREE_KEYS(tree, right),
+               right->num_keys * tree->data_size);
+        memcpy(ARC_BPTREE_CHILDREN(left) + left->num_keys + 1,
+               ARC_BPTREE_CHILDREN(right),
+               (right->num_keys + 1) * sizeof(struct arc_bptree_node *));
+        left->num_keys += right->num_keys + 1;
+    }
+
+    memmove(separator, separator + tree->data_size,
+            (parent->num_keys - idx - 1) * tree->data_size);
+    memmove(&parent_children[idx + 1], &parent_children[idx + 2],
+            (parent->num_keys - idx - 1) * sizeof(struct arc_bptree_node *));
+    parent->num_keys--;
+
+    ARC_FREE(&tree->allocator, right);
+}
+
+/******************************************************************************/
+/**
+ * @brief Restores the minimum occupancy of the nodes after a removal
+ *
+ * A node with too few elements borrows one from a sibling, if both siblings
+ * are at the minimum it's merged with one of them instead, which removes a
+ * key from the parent and might leave it with too few keys as well.
+ */
+static void arc_bptree_rebalance(struct arc_bptree *tree,
+                                 struct arc_bptree_node **path,
+                                 size_t *path_idx, size_t depth,
+                                 struct arc_bptree_node *node)
+{
+    for (; depth > 0; depth--)
+    {
+        struct arc_bptree_node *parent = path[depth - 1];
+        struct arc_bptree_node **children = ARC_BPTREE_CHILDREN(parent);
+        size_t idx = path_idx[depth - 1];
+        size_t min_keys = (node->leaf ? tree->leaf_capacity :
+                                        tree->inner_capacity) / 2;
+
+        if (node->num_keys >= min_keys)
+        {
+            return;
+        }
+
+        if (idx > 0 && children[idx - 1]->num_keys > min_keys)
+        {
+            arc_bptree_borrow_left(tree, parent, idx, children[idx - 1], node);
+            return;
+        }
+
+        if (idx < parent->num_keys && children[idx + 1]->num_keys > min_keys)
+        {
+            arc_bptree_borrow_right(tree, parent, idx, node, children[idx + 1]);
+            return;
+        }
+
+        if (idx > 0)
+        {
+            arc_bptree_merge(tree, parent, idx - 1, children[idx - 1], node);
+        }
+        else
+        {
+            arc_bptree_merge(tree, parent, idx, node, children[idx + 1]);
+        }
+
+        node = parent;
+    }
+
+    /* The root shrinks once it runs out of keys */
+    if (node->num_keys == 0)
+    {
+        if (node->leaf)
+        {
+            tree->root = NULL;
+            tree->first = NULL;
+            tree->last = NULL;
+        }
+        else
+        {
+            tree->root = ARC_BPTREE_CHILDREN(node)[0];
+        }
+
+        ARC_FREE(&tree->allocator, node);
+    }
+}
+
+/******************************************************************************/
+
+void arc_bptree_remove(struct arc_bptree *tree, const void *data)
+{
+    struct arc_bptree_node *path[ARC_BPTREE_MAX_HEIGHT];
+    size_t path_idx[ARC_BPTREE_MAX_HEIGHT];
+    struct arc_bptree_node *leaf;
+    size_t idx, depth;
+    char *key;
+
+    if (tree->root == NULL)
+    {
+        return;
+    }
+
+    leaf = arc_bptree_find_leaf(tree, data, path, path_idx, &depth);
+    idx = arc_bptree_lower_bound(tree, leaf, data);
+    key = ARC_BPTREE_KEY(tree, leaf, idx);
+
+    if (idx == leaf->num_keys || arc_bptree_compare(tree, key, data) != 0)
+    {
+        return;
+    }
+
+    memmove(key, key + tree->data_size,
+            (leaf->num_keys - idx - 1) * tree->data_size);
+    leaf->num_keys--;
+    tree->size--;
+
+    arc_bptree_rebalance(tree, path, path_idx, depth, leaf);
+}
+
+/******************************************************************************/
+
+int arc_bptree_empty(struct arc_bptree *tree)
+{
+    return (tree->size == 0);
+}
+
+/******************************************************************************/
+
+size_t arc_bptree_size(struct arc_bptree *tree)
+{
+    return tree->size;
+}
+
+/******************************************************************************/
+
+static void arc_bptree_free_node(struct arc_bptree *tree,
+                                 struct arc_bptree_node *node)
+{
+    if (!node->leaf)
+    {
+        size_t i;
+
+        for (i = 0; i <= node->num_keys; i++)
+        {
+            arc_bptree_free_node(tree, ARC_BPTREE_CHILDREN(node)[i]);
+        }
+    }
+
+    ARC_FREE(&tree->allocator, node);
+}
+
+/******************************************************************************/
+
+void arc_bptree_clear(struct arc_bptree *tree)
+{
+    if (tree->root != NULL)
+    {
+        arc_bptree_free_node(tree, tree->root);
+    }
+
+    tree->root = NULL;
+    tree->first = NULL;
+    tree->last = NULL;
+    tree->size = 0;
+}
+
+/******************************************************************************/
+
+int arc_bptree_iterator_init(struct arc_bptree_iterator *it,
+                             struct arc_bptree *tree)
+{
+    it->tree = tree;
+    it->node = NULL;
+    it->idx = ARC_BPTREE_BEFORE_BEGIN;
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+void arc_bptree_iterator_fini(struct arc_bptree_iterator *it)
+{
+    it->tree = NULL;
+    it->node = NULL;
+}
+
+/******************************************************************************/
+
+struct arc_bptree_iterator *arc_bptree_iterator_create(struct arc_bptree *tree)
+{
+    struct arc_bptree_iterator *it = malloc(sizeof(struct arc_bptree_iterator));
+
+    if (it == NULL)
+    {
+        return NULL;
+    }
+
+    arc_bptree_iterator_init(it, tree);
+
+    return it;
+}
+
+/******************************************************************************/
+
+void arc_bptree_iterator_destroy(struct arc_bptree_iterator *it)
+{
+    arc_bptree_iterator_fini(it);
+    free(it);
+}
+
+/******************************************************************************/
+
+void arc_bptree_before_begin(struct arc_bptree_iterator *it)
+{
+    it->node = NULL;
+    it->idx = ARC_BPTREE_BEFORE_BEGIN;
+}
+
+/******************************************************************************/
+
+void arc_bptree_begin(struct arc_bptree_iterator *it)
+{
+    it->node = it->tree->first;
+    it->idx = (it->node != NULL ? 0 : ARC_BPTREE_AFTER_END);
+}
+
+/******************************************************************************/
+
+void arc_bptree_end(struct arc_bptree_iterator *it)
+{
+    it->node = it->tree->last;
+    it->idx = (it->node != NULL ? it->node->num_keys - 1
+                                : ARC_BPTREE_BEFORE_BEGIN);
+}
+
+/******************************************************************************/
+
+void arc_bptree_after_end(struct arc_bptree_iterator *it)
+{
+    it->node = NULL;
+    it->idx = ARC_BPTREE_AFTER_END;
+}
+
+/******************************************************************************/
+
+int arc_bptree_next(struct arc_bptree_iterator *it)
+{
+    if (it->node == NULL)
+    {
+        if (it->idx == ARC_BPTREE_BEFORE_BEGIN)
+        {
+            arc_bptree_begin(it);
+            return (it->node != NULL);
+        }
+
+        return 0;
+    }
+
+    if (++it->idx < it->node->num_keys)
+    {
+        return 1;
+    }
+
+    it->node = it->node->next;
+    it->idx = 0;
+
+    if (it->node == NULL)
+    {
+        it->idx = ARC_BPTREE_AFTER_END;
+        return 0;
+    }
+
+    return 1;
+}
+
+/******************************************************************************/
+
+int arc_bptree_previous(struct arc_bptree_iterator *it)
+{
+    if (it->node == NULL)
+    {
+        if (it->idx == ARC_BPTREE_AFTER_END)
+        {
+            arc_bptree_end(it);
+            return (it->node != NULL);
+        }
+
+        return 0;
+    }
+
+    if (it->idx > 0)
+    {
+        it->idx--;
+        return 1;
+    }
+
+    it->node = it->node->prev;
+
+    if (it->node == NULL)
+    {
+        it->idx = ARC_BPTREE_BEFORE_BEGIN;
+        return 0;
+    }
+
+    it->idx = it->node->num_keys - 1;
+
+    return 1;
+}
+
+/******************************************************************************/
+
+void * arc_bptree_data(struct arc_bptree_iterator *it)
+{
+    return ARC_BPTREE_KEY(it->tree, it->node, it->idx);
+}
+
+/******************************************************************************/
+/**
+ * @brief Sets the iterator to the first element not smaller than data
+ */
+static void arc_bptree_seek(struct arc_bptree_iterator *it, const void *data)
+{
+    struct arc_bptree *tree = it->tree;
+
+    if (tree->root == NULL)
+    {
+        arc_bptree_after_end(it);
+        return;
+    }
+
+    it->node = arc_bptree_find_leaf(tree, data, NULL, NULL, NULL);
+    it->idx = arc_bptree_lower_bound(tree, it->node, data);
+
+    if (it->idx == it->node->num_keys)
+    {
+        it->node = it->node->next;
+        it->idx = (it->node != NULL ? 0 : ARC_BPTREE_AFTER_END);
+    }
+}
+
+/******************************************************************************/
+
+int arc_bptree_position(struct arc_bptree_iterator *it, const void *data)
+{
+    arc_bptree_seek(it, data);
+
+    if (it->node == NULL ||
+        arc_bptree_compare(it->tree, arc_bptree_data(it), data) != 0)
+    {
+        arc_bptree_after_end(it);
+        return 0;
+    }
+
+    return 1;
+}
+
+/******************************************************************************/
+
+void arc_bptree_erase(struct arc_bptree_iterator *it)
+{
+    struct arc_bptree *tree = it->tree;
+
+    if (it->node == NULL)
+    {
+        return;
+    }
+
+    /* The element is moved around by the removal, so a copy is used to find
+       the following one afterwards */
+    memcpy(tree->buffer, arc_bptree_data(it), tree->data_size);
+
+    arc_bptree_remove(tree, tree->buffer);
+    arc_bptree_seek(it, tree->buffer);
+}
@@ -0,0 +1,92 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @file bptree_def.h
+ * @author Anil M. Mahtani Mirchandani
+ * @date December, 2015
+ *
+ * @brief BPTree
+ *
+ * @see https://en.wikipedia.org/wiki/B%2B_tree
+ */
+#ifndef ARC_BPTREE_DEF_H_
+#define ARC_BPTREE_DEF_H_
+
+#include <stdlib.h>
+#include <arc/type/function.h>
+#include <arc/memory/allocator.h>
+#include <arc/container/bptree.h>
+
+/* Approximate size in bytes of every node, the number of elements per node is
+   derived from it */
+#define ARC_BPTREE_NODE_SIZE 512
+/* Minimum number of elements per node, whatever the element size */
+#define ARC_BPTREE_MIN_CAPACITY 4
+/* Maximum height of the tree, every inner node has at least two children */
+#define ARC_BPTREE_MAX_HEIGHT (sizeof(size_t) * 8)
+
+/* Node header. A leaf stores its elements right after the header, an inner
+   node stores the children pointers first and then the separator keys, the
+   child i holds the elements smaller than the key i */
+struct arc_bptree_node
+{
+    size_t num_keys;
+    int leaf;
+    struct arc_bptree_node *prev; /**< Previous leaf (leaves only) */
+    struct arc_bptree_node *next; /**< Next leaf (leaves only) */
+};
+
+/* Container definition */
+struct arc_bptree
+{
+    struct arc_bptree_node *root;
+    struct arc_bptree_node *first; /**< Leftmost leaf */
+    struct arc_bptree_node *last; /**< Rightmost leaf */
+    size_t size;
+    size_t data_size;
+    size_t leaf_capacity; /**< Maximum number of elements of a leaf */
+    size_t inner_capacity; /**< Maximum number of keys of an inner node */
+    size_t keys_offset; /**< Offset of the keys in an inner node */
+    arc_cmp_fn_t cmp_fn;
+    void *buffer; /**< Scratch space for two elements */
+    struct arc_allocator allocator; /**< Used for the nodes */
+};
+
+/* Iterator positions outside of the elements */
+#define ARC_BPTREE_BEFORE_BEGIN 0
+#define ARC_BPTREE_AFTER_END 1
+
+/**
+ * @struct arc_bptree_iterator
+ * @brief Iterator definition
+ */
+struct arc_bptree_iterator
+{
+    struct arc_bptree *tree;
+    struct arc_bptree_node *node; /**< NULL outside of the elements */
+    size_t idx; /**< Element index, or position if the node is NULL */
+};
+
+int arc_bptree_init(struct arc_bptree *tree,
+                    size_t data_size,
+                    arc_cmp_fn_t cmp_fn);
+
+int arc_bptree_init_with_allocator(struct arc_bptree *tree,
+                                   size_t data_size,
+                                   arc_cmp_fn_t cmp_fn,
+                                   const struct arc_allocator *allocator);
+
+void arc_bptree_fini(struct arc_bptree *tree);
+
+int arc_bptree_iterator_init(struct arc_bptree_iterator *it,
+                             struct arc_bptree *tree);
+
+void arc_bptree_iterator_fini(struct arc_bptree_iterator *it);
+
+#endif
@@ -28,8 +28,18 @@ static int arc_bstree_insert_internal(struct arc_tree *tree, const void * data);
 /******************************************************************************/
 
 int arc_bstree_init(struct arc_tree *tree,
-                          size_t data_size,
-                          arc_cmp_fn_t cmp_fn)
+                    size_t data_size,
+                    arc_cmp_fn_t cmp_fn)
+{
+    return arc_bstree_init_with_allocator(tree, data_size, cmp_fn, NULL);
+}
+
+/******************************************************************************/
+
+int arc_bstree_init_with_allocator(struct arc_tree *tree,
+                                   size_t data_size,
+                                   arc_cmp_fn_t cmp_fn,
+                                   const struct arc_allocator *allocator)
 {
     size_t data_offset = ARC_OFFSETOF(struct arc_bstree_node, data);
     size_t node_size = sizeof(struct arc_bstree_node) - data_offset;
@@ -42,7 +52,24 @@ int arc_bstree_init(struct arc_tree *tree,
                          node_size, 
                          &arc_bstree_insert_internal,
                          &arc_bstree_remove_internal,
-                         cmp_fn);
+                         cmp_fn,
+                         allocator);
+}
+
+/******************************************************************************/
+
+int arc_bstree_init_pooled(struct arc_tree *tree,
+                           size_t data_size,
+                           arc_cmp_fn_t cmp_fn)
+{
+    int retval = arc_bstree_init(tree, data_size, cmp_fn);
+
+    if (retval != ARC_SUCCESS)
+    {
+        return retval;
+    }
+
+    return arc_tree_init_pool(tree);
 }
 
 /******************************************************************************/
@@ -55,6 +82,16 @@ void arc_bstree_fini(struct arc_tree *tree)
 /******************************************************************************/
 
 struct arc_tree * arc_bstree_create(size_t data_size, arc_cmp_fn_t cmp_fn)
+{
+    return arc_bstree_create_with_allocator(data_size, cmp_fn, NULL);
+}
+
+/******************************************************************************/
+
+struct arc_tree *
+arc_bstree_create_with_allocator(size_t data_size,
+                                 arc_cmp_fn_t cmp_fn,
+                                 const struct arc_allocator *allocator)
 {
     size_t data_offset = ARC_OFFSETOF(struct arc_bstree_node, data);
     size_t node_size = sizeof(struct arc_bstree_node) - data_offset;
@@ -66,9 +103,31 @@ struct arc_tree * arc_bstree_create(size_t data_size, arc_cmp_fn_t cmp_fn)
                                               node_size, 
                                               &arc_bstree_insert_internal,
                                               &arc_bstree_remove_internal,
-                                              cmp_fn);
+                                              cmp_fn,
+                                              allocator);
+    }
+
+/******************************************************************************/
+
+struct arc_tree * arc_bstree_create_pooled(size_t data_size,
+                                           arc_cmp_fn_t cmp_fn)
+{
+    struct arc_tree * tree = malloc(sizeof(struct arc_tree));
+
+    if (tree == NULL)
+    {
+        return NULL;
+    }
+
+    if (arc_bstree_init_pooled(tree, data_size, cmp_fn) != ARC_SUCCESS)
+    {
+        free(tree);
+        return NULL;
     }
 
+    return tree;
+}
+
 /******************************************************************************/
 
 void arc_bstree_destroy(struct arc_tree *bstree)
@@ -95,13 +154,13 @@ static int arc_bstree_insert_internal(struct arc_tree *tree, const void * data)
             cmp_result = (*bstree->cmp_fn)(node->data, data);
         }
 
-        if (cmp_result == -1)
+        if (cmp_result < 0)
         {
             parent = node;
             node_ref = &(node->right);
             node = node->right;
         }
-        else if (cmp_result == 1)
+        else if (cmp_result > 0)
         {
             parent = node;
             node_ref = &(node->left);
@@ -113,7 +172,7 @@ static int arc_bstree_insert_internal(struct arc_tree *tree, const void * data)
         }
     }
 
-    node = malloc(bstree->node_size);
+    node = ARC_ALLOC(&bstree->allocator, bstree->node_size);
 
     if (node == NULL)
     {
@@ -146,6 +205,14 @@ void *arc_bstree_retrieve(struct arc_tree *bstree, const void * data)
     return arc_tree_retrieve((struct arc_tree *)bstree, data);
 }
 
+/******************************************************************************/
+
+size_t arc_bstree_retrieve_batch(struct arc_tree *bstree, const void * keys,
+                                 size_t n, void **results)
+{
+    return arc_tree_retrieve_batch((struct arc_tree *)bstree, keys, n, results);
+}
+
 /******************************************************************************/
 /**
  * @brief Removes a node from the bstree
@@ -205,7 +272,7 @@ static void arc_bstree_remove_internal(struct arc_tree *tree,
     }
 
     *node_ref = successor;
-    free(node);
+    ARC_FREE(&bstree->allocator, node);
     bstree->size--;
 }
 
@@ -436,6 +503,35 @@ int arc_bstree_position(struct arc_tree_iterator * it, const void * data)
     return arc_tree_position(it, data);
 }
 
+/******************************************************************************/
+
+int arc_bstree_lower_bound(struct arc_tree_iterator * it, const void * data)
+{
+    return arc_tree_lower_bound(it, data);
+}
+
+/******************************************************************************/
+
+int arc_bstree_upper_bound(struct arc_tree_iterator * it, const void * data)
+{
+    return arc_tree_upper_bound(it, data);
+}
+
+/******************************************************************************/
+
+int arc_bstree_range(struct arc_tree_iterator * it, const void * first,
+                     const void * last)
+{
+    return arc_tree_range(it, first, last);
+}
+
+/******************************************************************************/
+
+int arc_bstree_range_next(struct arc_tree_iterator * it, const void * last)
+{
+    return arc_tree_range_next(it, last);
+}
+
 /******************************************************************************/
 void arc_bstree_erase(struct arc_tree_iterator * it)
 {
@@ -25,6 +25,15 @@ int arc_bstree_init(struct arc_tree *tree,
                     size_t data_size,
                     arc_cmp_fn_t cmp_fn);
 
+int arc_bstree_init_with_allocator(struct arc_tree *tree,
+                                   size_t data_size,
+                                   arc_cmp_fn_t cmp_fn,
+                                   const struct arc_allocator *allocator);
+
+int arc_bstree_init_pooled(struct arc_tree *tree,
+                           size_t data_size,
+                           arc_cmp_fn_t cmp_fn);
+
 
 void arc_bstree_fini(struct arc_tree *tree);
 int arc_bstree_iterator_init(struct arc_tree_iterator *it,
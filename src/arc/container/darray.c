@@ -13,16 +13,41 @@
 #include <arc/container/darray.h>
 #include <arc/container/darray_def.h>
 #include <arc/common/defines.h>
+#include <arc/algorithm/sort.h>
 
 /******************************************************************************/
 
 int arc_darray_init(struct arc_darray *darray, size_t data_size)
 {
+    return arc_darray_init_with_allocator(darray, data_size, NULL);
+}
+
+/******************************************************************************/
+
+int arc_darray_init_with_allocator(struct arc_darray *darray, size_t data_size,
+                                   const struct arc_allocator *allocator)
+{
+    return arc_darray_init_with_capacity(darray, data_size, INITIAL_BLOCK_SIZE,
+                                         GROWTH_FACTOR, allocator);
+}
+
+/******************************************************************************/
+
+int arc_darray_init_with_capacity(struct arc_darray *darray, size_t data_size,
+                                  size_t capacity, double growth_factor,
+                                  const struct arc_allocator *allocator)
+{
+    darray->allocator = (allocator != NULL ? *allocator
+                                           : arc_default_allocator);
     darray->size = 0;
+    darray->head = 0;
     darray->data_size = data_size;
-    darray->allocated_size = INITIAL_BLOCK_SIZE;
+    darray->allocated_size = (capacity > 0 ? capacity : 1);
+    darray->growth_factor = (growth_factor > 1.0 ? growth_factor
+                                                 : GROWTH_FACTOR);
 
-    darray->data = malloc(INITIAL_BLOCK_SIZE*darray->data_size);
+    darray->data = ARC_ALLOC(&darray->allocator,
+                             darray->allocated_size*darray->data_size);
 
     if (darray->data == NULL)
     {
@@ -36,21 +61,79 @@ int arc_darray_init(struct arc_darray *darray, size_t data_size)
 
 void arc_darray_fini(struct arc_darray *darray)
 {
-    free(darray->data);
+    ARC_FREE(&darray->allocator, darray->data);
 }
 
 /******************************************************************************/
 
 struct arc_darray * arc_darray_create(size_t data_size)
+{
+    return arc_darray_create_with_allocator(data_size, NULL);
+}
+
+/******************************************************************************/
+
+struct arc_darray *
+arc_darray_create_with_allocator(size_t data_size,
+                                 const struct arc_allocator *allocator)
+{
+    struct arc_darray * darray = malloc(sizeof(struct arc_darray));
+
+    if (darray == NULL)
+    {
+        return NULL;
+    }
+
+    if (arc_darray_init_with_allocator(darray, data_size,
+                                       allocator) != ARC_SUCCESS)
+    {
+        free(darray);
+        return NULL;
+    }
+
+    return darray;
+}
+
+/******************************************************************************/
+
+struct arc_darray *
+arc_darray_create_with_capacity(size_t data_size, size_t capacity,
+                                double growth_factor)
+{
+    struct arc_darray * darray = malloc(sizeof(struct arc_darray));
+
+    if (darray == NULL)
+    {
+        return NULL;
+    }
+
+    if (arc_darray_init_with_capacity(darray, data_size, capacity,
+                                      growth_factor, NULL) != ARC_SUCCESS)
+    {
+        free(darray);
+        return NULL;
+    }
+
+    return darray;
+}
+
+/******************************************************************************/
+
+struct arc_darray *
+arc_darray_create_large(size_t data_size, size_t capacity, int huge_pages)
 {
     struct arc_darray * darray = malloc(sizeof(struct arc_darray));
+    const struct arc_allocator * allocator = (huge_pages ?
+                                              &arc_mmap_huge_allocator :
+                                              &arc_mmap_allocator);
 
     if (darray == NULL)
     {
         return NULL;
     }
 
-    if (arc_darray_init(darray, data_size) != ARC_SUCCESS)
+    if (arc_darray_init_with_capacity(darray, data_size, capacity,
+                                      GROWTH_FACTOR, allocator) != ARC_SUCCESS)
     {
         free(darray);
         return NULL;
@@ -69,35 +152,255 @@ void arc_darray_destroy(struct arc_darray * darray)
 
 /******************************************************************************/
 
+/* Returns the address of the element at position idx, the elements start at
+   the head of the block and wrap around its end */
+static char * arc_darray_slot(struct arc_darray * darray, size_t idx)
+{
+    size_t pos = darray->head + idx;
+
+    if (pos >= darray->allocated_size)
+    {
+        pos -= darray->allocated_size;
+    }
+
+    return (char *)darray->data + pos * darray->data_size;
+}
+
+/******************************************************************************/
+
+static void arc_darray_reverse(char * begin, char * end)
+{
+    while (begin < end)
+    {
+        char tmp;
+
+        end--;
+        tmp = *begin;
+        *begin = *end;
+        *end = tmp;
+        begin++;
+    }
+}
+
+/******************************************************************************/
+
+void * arc_darray_linearize(struct arc_darray * darray)
+{
+    if (darray->head + darray->size > darray->allocated_size)
+    {
+        /* The first part runs from the head to the end of the block and the
+           second one from the beginning of the block to the gap, only the
+           elements are moved */
+        char * data = darray->data;
+        size_t first = (darray->allocated_size - darray->head) *
+                       darray->data_size;
+        size_t second = (darray->head + darray->size -
+                         darray->allocated_size) * darray->data_size;
+        size_t gap = (darray->allocated_size - darray->size) *
+                     darray->data_size;
+        char * tmp;
+
+        if (second <= gap)
+        {
+            /* Slide the first part into the gap and append the second */
+            memmove(data + gap, data + gap + second, first);
+            memcpy(data + gap + first, data, second);
+            darray->head = gap / darray->data_size;
+        }
+        else if (first <= gap)
+        {
+            /* Slide the second part over the gap and prepend the first */
+            memmove(data + first, data, second);
+            memcpy(data, data + gap + second, first);
+            darray->head = 0;
+        }
+        else if ((tmp = ARC_ALLOC(&darray->allocator,
+                                  first < second ? first : second)) != NULL)
+        {
+            /* Set the smaller part aside while the other one is moved */
+            if (first < second)
+            {
+                memcpy(tmp, data + gap + second, first);
+                memmove(data + first, data, second);
+                memcpy(data, tmp, first);
+            }
+            else
+            {
+                memcpy(tmp, data, second);
+                memmove(data, data + gap + second, first);
+                memcpy(data + first, tmp, second);
+            }
+
+            ARC_FREE(&darray->allocator, tmp);
+            darray->head = 0;
+        }
+        else
+        {
+            /* Rotate the whole block in place */
+            size_t total = darray->allocated_size * darray->data_size;
+            size_t head = darray->head * darray->data_size;
+
+            arc_darray_reverse(data, data + head);
+            arc_darray_reverse(data + head, data + total);
+            arc_darray_reverse(data, data + total);
+
+            darray->head = 0;
+        }
+    }
+
+    return (char *)darray->data + darray->head * darray->data_size;
+}
+
+/******************************************************************************/
+
+/* Enlarges the block to new_size elements, keeping the wrapped layout */
+static int arc_darray_resize(struct arc_darray * darray, size_t new_size)
+{
+    size_t data_size = darray->data_size;
+    size_t old_size = darray->allocated_size;
+    char * ptr = ARC_REALLOC(&darray->allocator, darray->data,
+                             new_size * data_size);
+
+    if (ptr == NULL)
+    {
+        return ARC_OUT_OF_MEMORY;
+    }
+
+    if (darray->head + darray->size > old_size)
+    {
+        size_t wrapped = darray->head + darray->size - old_size;
+
+        if (wrapped <= new_size - old_size)
+        {
+            /* The elements at the beginning of the block go after the old
+               end, right where they would have been without wrapping */
+            memcpy(ptr + old_size * data_size, ptr, wrapped * data_size);
+        }
+        else
+        {
+            /* Otherwise the elements from the head are moved to the end */
+            size_t moved = old_size - darray->head;
+
+            memmove(ptr + (new_size - moved) * data_size,
+                    ptr + darray->head * data_size, moved * data_size);
+            darray->head = new_size - moved;
+        }
+    }
+
+    darray->data = ptr;
+    darray->allocated_size = new_size;
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+static int arc_darray_grow(struct arc_darray * darray)
+{
+    size_t old_size = darray->allocated_size;
+    size_t new_size = (size_t)((double)old_size * darray->growth_factor);
+
+    /* Small factors could round down to the current size */
+    if (new_size <= old_size)
+    {
+        new_size = old_size + 1;
+    }
+
+    return arc_darray_resize(darray, new_size);
+}
+
+/******************************************************************************/
+
+int arc_darray_reserve(struct arc_darray * darray, size_t capacity)
+{
+    if (capacity <= darray->allocated_size)
+    {
+        return ARC_SUCCESS;
+    }
+
+    return arc_darray_resize(darray, capacity);
+}
+
+/******************************************************************************/
+
+int arc_darray_shrink_to_fit(struct arc_darray * darray)
+{
+    size_t capacity = (darray->size > 0 ? darray->size : 1);
+    char * ptr;
+
+    if (capacity == darray->allocated_size)
+    {
+        return ARC_SUCCESS;
+    }
+
+    /* Move the elements to the beginning so that the tail can be released */
+    ptr = arc_darray_linearize(darray);
+
+    if (darray->head != 0)
+    {
+        memmove(darray->data, ptr, darray->size * darray->data_size);
+        darray->head = 0;
+    }
+
+    ptr = ARC_REALLOC(&darray->allocator, darray->data,
+                      capacity * darray->data_size);
+
+    if (ptr == NULL)
+    {
+        /* The old block is still valid, it's just larger than needed */
+        return ARC_OUT_OF_MEMORY;
+    }
+
+    darray->data = ptr;
+    darray->allocated_size = capacity;
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
 static int arc_darray_insert_node_before(struct arc_darray * darray,
                                          unsigned long current, void * data)
 {
-    unsigned long data_to_move = darray->size - current;
-    unsigned long data_size = darray->data_size;
-
     if (darray->size == darray->allocated_size)
     {
-        size_t new_size = darray->allocated_size * GROWTH_FACTOR;
-        void * ptr = realloc(darray->data, 
-                             new_size * darray->data_size);
-
-        if (ptr == NULL)
+        if (arc_darray_grow(darray) != ARC_SUCCESS)
         {
             return ARC_OUT_OF_MEMORY;
         }
-
-        darray->data = ptr;
-        darray->allocated_size *= GROWTH_FACTOR;
     }
 
-    if (data_to_move > 0)
+    if (current == 0)
     {
-        memmove((char *)darray->data + data_size * (current + 1),
-                (char *)darray->data + data_size * current,
-                (size_t)(data_to_move * data_size));
+        darray->head = (darray->head == 0 ? darray->allocated_size :
+                                            darray->head) - 1;
+    }
+    else if (current < darray->size)
+    {
+        size_t data_size = darray->data_size;
+        char * first;
+
+        arc_darray_linearize(darray);
+
+        first = (char *)darray->data + darray->head * data_size;
+
+        /* Move the shorter side, as long as there is room for it */
+        if (darray->head > 0 &&
+            (current < darray->size / 2 ||
+             darray->head + darray->size == darray->allocated_size))
+        {
+            memmove(first - data_size, first, current * data_size);
+            darray->head--;
+        }
+        else
+        {
+            memmove(first + (current + 1) * data_size,
+                    first + current * data_size,
+                    (darray->size - current) * data_size);
+        }
     }
 
-    memcpy((char *)darray->data + current * data_size, data, darray->data_size);
+    memcpy(arc_darray_slot(darray, current), data, darray->data_size);
 
     darray->size += 1;
 
@@ -109,20 +412,41 @@ static int arc_darray_insert_node_before(struct arc_darray * darray,
 static void arc_darray_erase_node(struct arc_darray * darray, 
                                   unsigned long current)
 {
-    if (darray->size > 0)
+    if (current >= darray->size)
+    {
+        return;
+    }
+
+    if (current == 0)
+    {
+        darray->head = (darray->head + 1 == darray->allocated_size ?
+                        0 : darray->head + 1);
+    }
+    else if (current < darray->size - 1)
     {
-        unsigned long data_to_move = darray->size - (current  + 1);
+        size_t data_size = darray->data_size;
+        char * first = arc_darray_linearize(darray);
 
-        if (data_to_move > 0)
+        /* Close the gap moving the shorter side */
+        if (current < darray->size / 2)
         {
-            unsigned long data_size = darray->data_size;
-
-            memmove((char *)darray->data + data_size * current,
-                    (char *)darray->data + data_size * (current + 1),
-                    (size_t)(data_to_move * data_size));
+            memmove(first + data_size, first, current * data_size);
+            darray->head++;
+        }
+        else
+        {
+            memmove(first + current * data_size,
+                    first + (current + 1) * data_size,
+                    (darray->size - current - 1) * data_size);
         }
+    }
+
+    darray->size -= 1;
 
-        darray->size -= 1;
+    /* An empty darray starts over from the beginning of the block */
+    if (darray->size == 0)
+    {
+        darray->head = 0;
     }
 }
 
@@ -130,7 +454,7 @@ static void arc_darray_erase_node(struct arc_darray * darray,
 
 void * arc_darray_at(struct arc_darray * darray, unsigned long idx)
 {
-    return (void *)((char *)darray->data + darray->data_size*idx);
+    return arc_darray_slot(darray, idx);
 }
 
 /******************************************************************************/
@@ -163,6 +487,390 @@ void arc_darray_pop_back(struct arc_darray * darray)
 
 /******************************************************************************/
 
+/* Copies count elements to the slots starting at position idx, which might
+   wrap around the end of the block */
+static void arc_darray_copy_in(struct arc_darray * darray, size_t idx,
+                               const void * data, size_t count)
+{
+    size_t pos = darray->head + idx;
+    size_t first;
+
+    if (pos >= darray->allocated_size)
+    {
+        pos -= darray->allocated_size;
+    }
+
+    first = darray->allocated_size - pos;
+
+    if (first > count)
+    {
+        first = count;
+    }
+
+    memcpy((char *)darray->data + pos * darray->data_size, data,
+           first * darray->data_size);
+    memcpy(darray->data, (const char *)data + first * darray->data_size,
+           (count - first) * darray->data_size);
+}
+
+/******************************************************************************/
+
+int arc_darray_insert_range(struct arc_darray * darray, unsigned long idx,
+                            const void * data, size_t count)
+{
+    size_t data_size = darray->data_size;
+
+    if (idx > darray->size)
+    {
+        return ARC_ERROR;
+    }
+
+    if (darray->size + count > darray->allocated_size)
+    {
+        /* Grow once, to the usual size if that is enough */
+        size_t new_size = (size_t)((double)darray->allocated_size *
+                                   darray->growth_factor);
+
+        if (new_size < darray->size + count)
+        {
+            new_size = darray->size + count;
+        }
+
+        if (arc_darray_resize(darray, new_size) != ARC_SUCCESS)
+        {
+            return ARC_OUT_OF_MEMORY;
+        }
+    }
+
+    if (idx == 0)
+    {
+        darray->head = (darray->head >= count ? darray->head :
+                        darray->head + darray->allocated_size) - count;
+    }
+    else if (idx < darray->size)
+    {
+        char * first = arc_darray_linearize(darray);
+        size_t head = darray->head;
+
+        /* Move the shorter side when there is room for it, otherwise make
+           room at both ends of the elements */
+        if (head >= count &&
+            (idx < darray->size / 2 ||
+             head + darray->size + count > darray->allocated_size))
+        {
+            head -= count;
+        }
+        else if (head + darray->size + count > darray->allocated_size)
+        {
+            head = darray->allocated_size - darray->size - count;
+        }
+
+        if (head != darray->head)
+        {
+            memmove((char *)darray->data + head * data_size, first,
+                    idx * data_size);
+        }
+
+        if (head + count != darray->head)
+        {
+            memmove((char *)darray->data + (head + idx + count) * data_size,
+                    first + idx * data_size, (darray->size - idx) * data_size);
+        }
+
+        darray->head = head;
+    }
+
+    arc_darray_copy_in(darray, idx, data, count);
+
+    darray->size += count;
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+int arc_darray_append_range(struct arc_darray * darray, const void * data,
+                            size_t count)
+{
+    return arc_darray_insert_range(darray, darray->size, data, count);
+}
+
+/******************************************************************************/
+
+void arc_darray_erase_range(struct arc_darray * darray, unsigned long idx,
+                            size_t count)
+{
+    size_t data_size = darray->data_size;
+
+    if (idx >= darray->size)
+    {
+        return;
+    }
+
+    if (count > darray->size - idx)
+    {
+        count = darray->size - idx;
+    }
+
+    if (idx == 0)
+    {
+        darray->head += count;
+
+        if (darray->head >= darray->allocated_size)
+        {
+            darray->head -= darray->allocated_size;
+        }
+    }
+    else if (idx + count < darray->size)
+    {
+        char * first = arc_darray_linearize(darray);
+
+        /* Close the gap moving the shorter side */
+        if (idx < darray->size - idx - count)
+        {
+            memmove(first + count * data_size, first, idx * data_size);
+            darray->head += count;
+        }
+        else
+        {
+            memmove(first + idx * data_size, first + (idx + count) * data_size,
+                    (darray->size - idx - count) * data_size);
+        }
+    }
+
+    darray->size -= count;
+
+    if (darray->size == 0)
+    {
+        darray->head = 0;
+    }
+}
+
+/******************************************************************************/
+
+void arc_darray_sort(struct arc_darray * darray, arc_cmp_fn_t cmp_fn)
+{
+    arc_sort(arc_darray_linearize(darray), darray->size, darray->data_size,
+             cmp_fn);
+}
+
+/******************************************************************************/
+
+int arc_darray_radix_sort(struct arc_darray * darray, arc_key_fn_t key_fn)
+{
+    return arc_radix_sort(arc_darray_linearize(darray), darray->size,
+                          darray->data_size, key_fn);
+}
+
+/******************************************************************************/
+
+int arc_darray_parallel_sort(struct arc_darray * darray, arc_cmp_fn_t cmp_fn,
+                             unsigned num_threads)
+{
+    arc_pool_t pool;
+    int retval;
+
+    /* Too small to be split, do not pay for starting the threads */
+    if (num_threads == 1 || darray->size < ARC_PARALLEL_SORT_MIN_CHUNK * 2)
+    {
+        arc_darray_sort(darray, cmp_fn);
+        return ARC_SUCCESS;
+    }
+
+    pool = arc_pool_create(num_threads);
+
+    if (pool == NULL)
+    {
+        return ARC_OUT_OF_MEMORY;
+    }
+
+    retval = arc_parallel_sort(arc_darray_linearize(darray), darray->size,
+                               darray->data_size, cmp_fn, pool);
+
+    arc_pool_destroy(pool);
+
+    return retval;
+}
+
+/******************************************************************************/
+
+/* First element of a plain sorted array for which cmp_fn(element, key) is not
+   less than the bias: 0 gives the lower bound and 1 the upper bound */
+static size_t arc_darray_search(const char * a, size_t num, size_t size,
+                                const void * key, arc_cmp_fn_t cmp_fn,
+                                int bias)
+{
+    size_t first = 0;
+
+    while (num > 0)
+    {
+        size_t half = num / 2;
+
+        if ((*cmp_fn)(a + (first + half) * size, key) < bias)
+        {
+            first += half + 1;
+            num -= half + 1;
+        }
+        else
+        {
+            num = half;
+        }
+    }
+
+    return first;
+}
+
+/******************************************************************************/
+
+/* The elements which wrap around the end of the block are all after the
+   ones at the end of it, the first of them tells in which piece to search */
+static unsigned long arc_darray_bound(struct arc_darray * darray,
+                                      const void * key, arc_cmp_fn_t cmp_fn,
+                                      int bias)
+{
+    const char * data = darray->data;
+    size_t first_size = darray->allocated_size - darray->head;
+
+    size_t found;
+
+    if (darray->size > first_size && (*cmp_fn)(data, key) < bias)
+    {
+        found = arc_darray_search(data, darray->size - first_size,
+                                  darray->data_size, key, cmp_fn, bias);
+        return (unsigned long)(first_size + found);
+    }
+
+    found = arc_darray_search(data + darray->head * darray->data_size,
+                              (darray->size < first_size ?
+                               darray->size : first_size),
+                              darray->data_size, key, cmp_fn, bias);
+
+    return (unsigned long)found;
+}
+
+/******************************************************************************/
+
+unsigned long arc_darray_lower_bound(struct arc_darray * darray,
+                                     const void * key, arc_cmp_fn_t cmp_fn)
+{
+    return arc_darray_bound(darray, key, cmp_fn, 0);
+}
+
+/******************************************************************************/
+
+unsigned long arc_darray_upper_bound(struct arc_darray * darray,
+                                     const void * key, arc_cmp_fn_t cmp_fn)
+{
+    return arc_darray_bound(darray, key, cmp_fn, 1);
+}
+
+/******************************************************************************/
+
+void arc_darray_equal_range(struct arc_darray * darray, const void * key,
+                            arc_cmp_fn_t cmp_fn, unsigned long * first,
+                            unsigned long * last)
+{
+    *first = arc_darray_bound(darray, key, cmp_fn, 0);
+    *last = arc_darray_bound(darray, key, cmp_fn, 1);
+}
+
+/******************************************************************************/
+
+/* Branchless lower and upper bounds over a plain array of a type which can be
+   compared with <, and the same over the one or two pieces of a darray */
+#define ARC_DARRAY_BOUND_DEFINE(type)                                          \
+static size_t arc_darray_##type##_lower(const type * a, size_t num, type key)  \
+{                                                                              \
+    const type * base = a;                                                     \
+                                                                               \
+    if (num == 0)                                                              \
+    {                                                                          \
+        return 0;                                                              \
+    }                                                                          \
+                                                                               \
+    while (num > 1)                                                            \
+    {                                                                          \
+        size_t half = num / 2;                                                 \
+                                                                               \
+        ARC_PREFETCH(base + half / 2);                                         \
+        ARC_PREFETCH(base + half + half / 2);                                  \
+        base = (base[half] < key ? base + half : base);                        \
+        num -= half;                                                           \
+    }                                                                          \
+                                                                               \
+    return (size_t)(base - a) + (size_t)(*base < key);                         \
+}                                                                              \
+                                                                               \
+static size_t arc_darray_##type##_upper(const type * a, size_t num, type key)  \
+{                                                                              \
+    const type * base = a;                                                     \
+                                                                               \
+    if (num == 0)                                                              \
+    {                                                                          \
+        return 0;                                                              \
+    }                                                                          \
+                                                                               \
+    while (num > 1)                                                            \
+    {                                                                          \
+        size_t half = num / 2;                                                 \
+                                                                               \
+        ARC_PREFETCH(base + half / 2);                                         \
+        ARC_PREFETCH(base + half + half / 2);                                  \
+        base = (key < base[half] ? base : base + half);                        \
+        num -= half;                                                           \
+    }                                                                          \
+                                                                               \
+    return (size_t)(base - a) + (size_t)!(key < *base);                        \
+}                                                                              \
+                                                                               \
+unsigned long arc_darray_lower_bound_##type(struct arc_darray * darray,        \
+                                            type key)                          \
+{                                                                              \
+    const type * data = darray->data;                                          \
+    size_t first_size = darray->allocated_size - darray->head;                 \
+    size_t found;                                                              \
+                                                                               \
+    if (darray->size > first_size && *data < key)                              \
+    {                                                                          \
+        found = arc_darray_##type##_lower(data, darray->size - first_size,     \
+                                       key);                                   \
+        return (unsigned long)(first_size + found);                            \
+    }                                                                          \
+                                                                               \
+    found = arc_darray_##type##_lower(data + darray->head,                     \
+                                   (darray->size < first_size ?                \
+                                    darray->size : first_size), key);          \
+                                                                               \
+    return (unsigned long)found;                                               \
+}                                                                              \
+                                                                               \
+unsigned long arc_darray_upper_bound_##type(struct arc_darray * darray,        \
+                                            type key)                          \
+{                                                                              \
+    const type * data = darray->data;                                          \
+    size_t first_size = darray->allocated_size - darray->head;                 \
+    size_t found;                                                              \
+                                                                               \
+    if (darray->size > first_size && !(key < *data))                           \
+    {                                                                          \
+        found = arc_darray_##type##_upper(data, darray->size - first_size,     \
+                                       key);                                   \
+        return (unsigned long)(first_size + found);                            \
+    }                                                                          \
+                                                                               \
+    found = arc_darray_##type##_upper(data + darray->head,                     \
+                                   (darray->size < first_size ?                \
+                                    darray->size : first_size), key);          \
+                                                                               \
+    return (unsigned long)found;                                               \
+}
+
+ARC_DARRAY_BOUND_DEFINE(int)
+ARC_DARRAY_BOUND_DEFINE(long)
+ARC_DARRAY_BOUND_DEFINE(double)
+
+/******************************************************************************/
+
 void * arc_darray_front(struct arc_darray * darray)
 {
     if (darray->size == 0)
@@ -170,7 +878,7 @@ void * arc_darray_front(struct arc_darray * darray)
         return NULL;
     }
 
-    return darray->data;
+    return arc_darray_slot(darray, 0);
 }
 
 /******************************************************************************/
@@ -182,7 +890,7 @@ void * arc_darray_back(struct arc_darray * darray)
         return NULL;
     }
 
-    return (char *)darray->data + darray->data_size * (darray->size - 1);
+    return arc_darray_slot(darray, darray->size - 1);
 }
 
 /******************************************************************************/
@@ -201,9 +909,17 @@ size_t arc_darray_size(struct arc_darray * darray)
 
 /******************************************************************************/
 
+size_t arc_darray_capacity(struct arc_darray * darray)
+{
+    return darray->allocated_size;
+}
+
+/******************************************************************************/
+
 void arc_darray_clear(struct arc_darray * darray)
 {
     darray->size = 0;
+    darray->head = 0;
 }
 
 /******************************************************************************/
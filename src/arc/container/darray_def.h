@@ -10,6 +10,7 @@
 #define ARC_DARRAY_DEF_H_
 
 #include <stdlib.h>
+#include <arc/memory/allocator.h>
 
 #define INITIAL_BLOCK_SIZE 32
 #define GROWTH_FACTOR 2
@@ -18,9 +19,12 @@
 struct arc_darray
 {
     size_t size;
+    size_t head; /**< Position of the first element in the block */
     size_t allocated_size;
     size_t data_size;
+    double growth_factor; /**< The block is multiplied by it when full */
     void * data;
+    struct arc_allocator allocator; /**< Used for the data array */
 };
 /**
  * @struct arc_darray_iterator
@@ -33,6 +37,11 @@ struct arc_darray_iterator
 };
 
 int arc_darray_init(struct arc_darray *darray, size_t data_size);
+int arc_darray_init_with_allocator(struct arc_darray *darray, size_t data_size,
+                                   const struct arc_allocator *allocator);
+int arc_darray_init_with_capacity(struct arc_darray *darray, size_t data_size,
+                                  size_t capacity, double growth_factor,
+                                  const struct arc_allocator *allocator);
 void arc_darray_fini(struct arc_darray *darray);
 int arc_darray_iterator_init(struct arc_darray_iterator *it,
                             struct arc_darray *list);
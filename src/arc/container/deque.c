@@ -12,14 +12,24 @@
 #include <strings.h>
 #include <arc/container/deque.h>
 #include <arc/common/defines.h>
+#include <arc/algorithm/sort.h>
 
 #include <arc/container/deque_def.h>
 
 /******************************************************************************/
 
 int arc_deque_init(struct arc_deque *deque, size_t data_size)
+{
+    return arc_deque_init_with_allocator(deque, data_size, NULL);
+}
+
+/******************************************************************************/
+
+int arc_deque_init_with_allocator(struct arc_deque *deque, size_t data_size,
+                                  const struct arc_allocator *allocator)
 {
     /* Initialise the deque */
+    deque->allocator = (allocator != NULL ? *allocator : arc_default_allocator);
     deque->size = 0;
     deque->data_size = data_size;
     deque->block_size = (data_size < BLOCK_SIZE ? BLOCK_SIZE / data_size :
@@ -30,7 +40,8 @@ int arc_deque_init(struct arc_deque *deque, size_t data_size)
     deque->end_block_num = INITIAL_NUM_BLOCKS / 2;
     deque->end_block_idx = deque->start_block_idx - 1;
 
-    deque->data = malloc(INITIAL_NUM_BLOCKS*sizeof(void *));
+    deque->data = ARC_ALLOC(&deque->allocator,
+                            INITIAL_NUM_BLOCKS*sizeof(void *));
 
     if (deque->data == NULL)
     {
@@ -50,15 +61,27 @@ void arc_deque_fini(struct arc_deque *deque)
 
     for (i = 0; i < deque->num_blocks; i++)
     {
-        free (deque->data[i]);
+        if (deque->data[i] != NULL)
+        {
+            ARC_FREE(&deque->allocator, deque->data[i]);
+        }
     }
 
-    free(deque->data);
+    ARC_FREE(&deque->allocator, deque->data);
 }
 
 /******************************************************************************/
 
 struct arc_deque * arc_deque_create(size_t data_size)
+{
+    return arc_deque_create_with_allocator(data_size, NULL);
+}
+
+/******************************************************************************/
+
+struct arc_deque *
+arc_deque_create_with_allocator(size_t data_size,
+                                const struct arc_allocator *allocator)
 {
     struct arc_deque * deque = malloc(sizeof(struct arc_deque));
 
@@ -67,7 +90,8 @@ struct arc_deque * arc_deque_create(size_t data_size)
         return NULL;
     }
 
-    if (arc_deque_init(deque, data_size) != ARC_SUCCESS)
+    if (arc_deque_init_with_allocator(deque, data_size,
+                                      allocator) != ARC_SUCCESS)
     {
         free(deque);
         return NULL;
@@ -86,11 +110,12 @@ void arc_deque_destroy(struct arc_deque * deque)
 
 /******************************************************************************/
 
-static int arc_deque_realloc(struct arc_deque * deque)
+int arc_deque_realloc(struct arc_deque * deque)
 {
     unsigned long num_blocks_delta = deque->num_blocks/2;
     unsigned long new_num_blocks = num_blocks_delta*2 + deque->num_blocks;
-    void * new_data = malloc(sizeof(void *)*new_num_blocks);
+    void * new_data = ARC_ALLOC(&deque->allocator,
+                                sizeof(void *)*new_num_blocks);
 
     if (new_data == NULL)
     {
@@ -110,7 +135,7 @@ static int arc_deque_realloc(struct arc_deque * deque)
     deque->start_block_num += num_blocks_delta;
     deque->end_block_num += num_blocks_delta;
 
-    free(deque->data);
+    ARC_FREE(&deque->allocator, deque->data);
 
     deque->data = new_data;
     deque->num_blocks = new_num_blocks;
@@ -173,7 +198,8 @@ static int arc_deque_move_left(struct arc_deque * deque,
 
         if (deque->data[block - 1] == NULL)
         {
-            deque->data[block - 1] = malloc(deque->block_size*deque->data_size);
+            deque->data[block - 1] = ARC_ALLOC(&deque->allocator,
+                    deque->block_size*deque->data_size);
         }
 
         new_data_pos = (char *)deque->data[block - 1] +
@@ -259,7 +285,8 @@ static int arc_deque_move_right(struct arc_deque * deque,
 
         if (deque->data[block + 1] == NULL)
         {
-            deque->data[block + 1] = malloc(deque->block_size*deque->data_size);
+            deque->data[block + 1] = ARC_ALLOC(&deque->allocator,
+                    deque->block_size*deque->data_size);
         }
 
         new_data_pos = (char *)deque->data[block + 1];
@@ -346,7 +373,8 @@ static int arc_deque_insert_node_before_left(struct arc_deque * deque,
 
     if (deque->data[block_num] == NULL)
     {
-        deque->data[block_num] = malloc(deque->block_size*deque->data_size);
+        deque->data[block_num] = ARC_ALLOC(&deque->allocator,
+                    deque->block_size*deque->data_size);
     }
 
     data_pos = ((char *)deque->data[block_num] + block_idx*deque->data_size);
@@ -394,7 +422,8 @@ static int arc_deque_insert_node_before_right(struct arc_deque * deque,
 
     if (deque->data[block_num] == NULL)
     {
-        deque->data[block_num] = malloc(deque->block_size*deque->data_size);
+        deque->data[block_num] = ARC_ALLOC(&deque->allocator,
+                    deque->block_size*deque->data_size);
     }
 
     data_pos = ((char *)deque->data[block_num] + block_idx*deque->data_size);
@@ -609,6 +638,329 @@ void arc_deque_pop_back(struct arc_deque * deque)
     }
 }
 
+/******************************************************************************/
+/* The range functions address the elements by their linear position, the
+   block number times the block size plus the index inside the block */
+static char * arc_deque_lin_slot(struct arc_deque * deque, unsigned long lin)
+{
+    return (char *)deque->data[lin / deque->block_size] +
+           (lin % deque->block_size) * deque->data_size;
+}
+
+/******************************************************************************/
+
+static void arc_deque_set_bounds(struct arc_deque * deque, unsigned long start)
+{
+    unsigned long end = start + deque->size - 1;
+
+    deque->start_block_num = start / deque->block_size;
+    deque->start_block_idx = start % deque->block_size;
+    deque->end_block_num = end / deque->block_size;
+    deque->end_block_idx = end % deque->block_size;
+}
+
+/******************************************************************************/
+
+/* Allocates the missing blocks for the linear positions [first, last) */
+static int arc_deque_alloc_blocks(struct arc_deque * deque,
+                                  unsigned long first, unsigned long last)
+{
+    unsigned long num;
+
+    for (num = first / deque->block_size;
+         num <= (last - 1) / deque->block_size; num++)
+    {
+        if (deque->data[num] == NULL)
+        {
+            deque->data[num] = ARC_ALLOC(&deque->allocator,
+                                         deque->block_size * deque->data_size);
+
+            if (deque->data[num] == NULL)
+            {
+                return ARC_OUT_OF_MEMORY;
+            }
+        }
+    }
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+/* Moves count elements from the linear position src to dst, one memmove per
+   piece of the ranges that lies in a single block of both of them */
+static void arc_deque_move_range(struct arc_deque * deque, unsigned long dst,
+                                 unsigned long src, unsigned long count)
+{
+    unsigned long block_size = deque->block_size;
+
+    if (dst < src)
+    {
+        while (count > 0)
+        {
+            unsigned long n = block_size - src % block_size;
+            unsigned long m = block_size - dst % block_size;
+
+            n = (m < n ? m : n);
+            n = (count < n ? count : n);
+
+            memmove(arc_deque_lin_slot(deque, dst),
+                    arc_deque_lin_slot(deque, src), n * deque->data_size);
+
+            src += n;
+            dst += n;
+            count -= n;
+        }
+    }
+    else if (dst > src)
+    {
+        /* Backwards, so the elements are not overwritten before moving */
+        src += count;
+        dst += count;
+
+        while (count > 0)
+        {
+            unsigned long n = (src - 1) % block_size + 1;
+            unsigned long m = (dst - 1) % block_size + 1;
+
+            n = (m < n ? m : n);
+            n = (count < n ? count : n);
+
+            src -= n;
+            dst -= n;
+            count -= n;
+
+            memmove(arc_deque_lin_slot(deque, dst),
+                    arc_deque_lin_slot(deque, src), n * deque->data_size);
+        }
+    }
+}
+
+/******************************************************************************/
+
+/* Copies count elements from a plain array to the deque, starting at the
+   linear position lin, block by block */
+static void arc_deque_copy_in(struct arc_deque * deque, unsigned long lin,
+                              const void * data, unsigned long count)
+{
+    const char * src = data;
+
+    while (count > 0)
+    {
+        unsigned long n = deque->block_size - lin % deque->block_size;
+
+        n = (count < n ? count : n);
+
+        memcpy(arc_deque_lin_slot(deque, lin), src, n * deque->data_size);
+
+        src += n * deque->data_size;
+        lin += n;
+        count -= n;
+    }
+}
+
+/******************************************************************************/
+
+static void arc_deque_copy_out(struct arc_deque * deque, unsigned long lin,
+                               void * data, unsigned long count)
+{
+    char * dst = data;
+
+    while (count > 0)
+    {
+        unsigned long n = deque->block_size - lin % deque->block_size;
+
+        n = (count < n ? count : n);
+
+        memcpy(dst, arc_deque_lin_slot(deque, lin), n * deque->data_size);
+
+        dst += n * deque->data_size;
+        lin += n;
+        count -= n;
+    }
+}
+
+/******************************************************************************/
+
+int arc_deque_insert_range(struct arc_deque * deque, unsigned long idx,
+                           const void * data, size_t count)
+{
+    unsigned long start;
+
+    if (idx > deque->size)
+    {
+        return ARC_ERROR;
+    }
+
+    if (count == 0)
+    {
+        return ARC_SUCCESS;
+    }
+
+    start = deque->start_block_num * deque->block_size +
+            deque->start_block_idx;
+
+    if (idx < deque->size - idx)
+    {
+        /* The elements before idx are moved towards the front, the start
+           never reaches the first position of the pointer array */
+        while (start <= count)
+        {
+            if (arc_deque_realloc(deque) != ARC_SUCCESS)
+            {
+                return ARC_OUT_OF_MEMORY;
+            }
+
+            start = deque->start_block_num * deque->block_size +
+                    deque->start_block_idx;
+        }
+
+        if (arc_deque_alloc_blocks(deque, start - count, start) != ARC_SUCCESS)
+        {
+            return ARC_OUT_OF_MEMORY;
+        }
+
+        arc_deque_move_range(deque, start - count, start, idx);
+        start -= count;
+    }
+    else
+    {
+        /* The elements from idx on are moved towards the back, the end never
+           reaches the last position of the pointer array */
+        while (start + deque->size + count >=
+               deque->num_blocks * deque->block_size)
+        {
+            if (arc_deque_realloc(deque) != ARC_SUCCESS)
+            {
+                return ARC_OUT_OF_MEMORY;
+            }
+
+            start = deque->start_block_num * deque->block_size +
+                    deque->start_block_idx;
+        }
+
+        if (arc_deque_alloc_blocks(deque, start + deque->size,
+                                   start + deque->size + count) != ARC_SUCCESS)
+        {
+            return ARC_OUT_OF_MEMORY;
+        }
+
+        arc_deque_move_range(deque, start + idx + count, start + idx,
+                             deque->size - idx);
+    }
+
+    deque->size += count;
+    arc_deque_set_bounds(deque, start);
+
+    arc_deque_copy_in(deque, start + idx, data, count);
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+int arc_deque_append_range(struct arc_deque * deque, const void * data,
+                           size_t count)
+{
+    return arc_deque_insert_range(deque, deque->size, data, count);
+}
+
+/******************************************************************************/
+
+void arc_deque_erase_range(struct arc_deque * deque, unsigned long idx,
+                           size_t count)
+{
+    unsigned long start;
+
+    if (idx >= deque->size)
+    {
+        return;
+    }
+
+    if (count > deque->size - idx)
+    {
+        count = deque->size - idx;
+    }
+
+    start = deque->start_block_num * deque->block_size +
+            deque->start_block_idx;
+
+    /* Close the gap moving the shorter side */
+    if (idx < deque->size - idx - count)
+    {
+        arc_deque_move_range(deque, start + count, start, idx);
+        start += count;
+    }
+    else
+    {
+        arc_deque_move_range(deque, start + idx, start + idx + count,
+                             deque->size - idx - count);
+    }
+
+    deque->size -= count;
+    arc_deque_set_bounds(deque, start);
+}
+
+/******************************************************************************/
+
+/* Sorts the elements in a contiguous copy, with the radix sort if key_fn is
+   given or arc_sort otherwise */
+static int arc_deque_sort_copy(struct arc_deque * deque, arc_cmp_fn_t cmp_fn,
+                               arc_key_fn_t key_fn)
+{
+    unsigned long start = deque->start_block_num * deque->block_size +
+                          deque->start_block_idx;
+    void * array;
+
+    if (deque->size < 2)
+    {
+        return ARC_SUCCESS;
+    }
+
+    array = ARC_ALLOC(&deque->allocator, deque->size * deque->data_size);
+
+    if (array == NULL)
+    {
+        return ARC_OUT_OF_MEMORY;
+    }
+
+    arc_deque_copy_out(deque, start, array, deque->size);
+
+    if (key_fn != NULL)
+    {
+        if (arc_radix_sort(array, deque->size, deque->data_size,
+                           key_fn) != ARC_SUCCESS)
+        {
+            ARC_FREE(&deque->allocator, array);
+            return ARC_OUT_OF_MEMORY;
+        }
+    }
+    else
+    {
+        arc_sort(array, deque->size, deque->data_size, cmp_fn);
+    }
+
+    arc_deque_copy_in(deque, start, array, deque->size);
+
+    ARC_FREE(&deque->allocator, array);
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+int arc_deque_sort(struct arc_deque * deque, arc_cmp_fn_t cmp_fn)
+{
+    return arc_deque_sort_copy(deque, cmp_fn, NULL);
+}
+
+/******************************************************************************/
+
+int arc_deque_radix_sort(struct arc_deque * deque, arc_key_fn_t key_fn)
+{
+    return arc_deque_sort_copy(deque, NULL, key_fn);
+}
+
 /******************************************************************************/
 
 void * arc_deque_front(struct arc_deque * deque)
@@ -10,6 +10,7 @@
 #define ARC_DEQUE_DEF_H_
 
 #include <stdlib.h>
+#include <arc/memory/allocator.h>
 
 #define BLOCK_SIZE 512
 #define INITIAL_NUM_BLOCKS 8
@@ -29,6 +30,7 @@ struct arc_deque
     unsigned long end_block_idx; /**< Data end block index */
     size_t data_size; /**< Size of the data to be inserted */
     void ** data; /**< Pointer array, stores a pointer to each block */
+    struct arc_allocator allocator; /**< Used for the blocks and the array */
 };
 /**
  * @struct arc_deque_iterator
@@ -42,7 +44,15 @@ struct arc_deque_iterator
 };
 
 int arc_deque_init(struct arc_deque *deque, size_t data_size);
+int arc_deque_init_with_allocator(struct arc_deque *deque, size_t data_size,
+                                  const struct arc_allocator *allocator);
 void arc_deque_fini(struct arc_deque *deque);
+/**
+ * @brief Grows the block pointer array by half of its size at each end
+ *
+ * The blocks themselves are not moved, only the pointers to them.
+ */
+int arc_deque_realloc(struct arc_deque *deque);
 int arc_deque_iterator_init(struct arc_deque_iterator *it,
                             struct arc_deque *list);
 void arc_deque_iterator_fini(struct arc_deque_iterator *it);
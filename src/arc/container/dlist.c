@@ -15,6 +15,14 @@
 /******************************************************************************/
 
 int arc_dlist_init(struct arc_dlist *list, size_t data_size)
+{
+    return arc_dlist_init_with_allocator(list, data_size, NULL);
+}
+
+/******************************************************************************/
+
+int arc_dlist_init_with_allocator(struct arc_dlist *list, size_t data_size,
+                                  const struct arc_allocator *allocator)
 {
     size_t aligned_size;
     /* The aligned size is the current size of the data block including the 
@@ -29,6 +37,8 @@ int arc_dlist_init(struct arc_dlist *list, size_t data_size)
     list->size = 0;
     list->data_size = data_size;
     list->node_size = aligned_size + sizeof(struct arc_dlist_node);
+    list->allocator = (allocator != NULL ? *allocator : arc_default_allocator);
+    list->pool = NULL;
     
     /* Initialise the first "NULL" node : it doesn't hold memory for data
        this node is refered to as the "before_begin" node */
@@ -46,14 +56,51 @@ int arc_dlist_init(struct arc_dlist *list, size_t data_size)
 
 /******************************************************************************/
 
+int arc_dlist_init_pooled(struct arc_dlist *list, size_t data_size)
+{
+    int retval = arc_dlist_init(list, data_size);
+
+    if (retval != ARC_SUCCESS)
+    {
+        return retval;
+    }
+
+    list->pool = arc_slab_create(list->node_size);
+
+    if (list->pool == NULL)
+    {
+        return ARC_OUT_OF_MEMORY;
+    }
+
+    arc_slab_get_allocator(list->pool, &list->allocator);
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
 void arc_dlist_fini(struct arc_dlist *list)
 {
     arc_dlist_clear(list);
+
+    if (list->pool != NULL)
+    {
+        arc_slab_destroy(list->pool);
+    }
 }
 
 /******************************************************************************/
 
 struct arc_dlist * arc_dlist_create(size_t data_size)
+{
+    return arc_dlist_create_with_allocator(data_size, NULL);
+}
+
+/******************************************************************************/
+
+struct arc_dlist *
+arc_dlist_create_with_allocator(size_t data_size,
+                                const struct arc_allocator *allocator)
 {
     struct arc_dlist * list = malloc(sizeof(struct arc_dlist));
 
@@ -62,7 +109,27 @@ struct arc_dlist * arc_dlist_create(size_t data_size)
         return NULL;
     }
 
-    arc_dlist_init(list, data_size);
+    arc_dlist_init_with_allocator(list, data_size, allocator);
+
+    return list;
+}
+
+/******************************************************************************/
+
+struct arc_dlist * arc_dlist_create_pooled(size_t data_size)
+{
+    struct arc_dlist * list = malloc(sizeof(struct arc_dlist));
+
+    if (list == NULL)
+    {
+        return NULL;
+    }
+
+    if (arc_dlist_init_pooled(list, data_size) != ARC_SUCCESS)
+    {
+        free(list);
+        return NULL;
+    }
 
     return list;
 }
@@ -89,7 +156,7 @@ int arc_dlist_insert_node_before(struct arc_dlist * list,
         return ARC_ERROR;
     }
 
-    node = malloc(list->node_size);
+    node = ARC_ALLOC(&list->allocator, list->node_size);
 
     if (node == NULL)
     {
@@ -138,7 +205,7 @@ void arc_dlist_erase_node(struct arc_dlist * list,
 
         list->size--;
 
-        free(current);
+        ARC_FREE(&list->allocator, current);
     }
 }
 
@@ -11,6 +11,8 @@
 #define ARC_DLIST_DEF_H_
 
 #include <stdlib.h>
+#include <arc/memory/allocator.h>
+#include <arc/memory/slab.h>
 
 /* Sentinel node definition */
 struct arc_dlist_snode
@@ -35,6 +37,8 @@ struct arc_dlist
     size_t size;
     size_t data_size;
     size_t node_size;
+    struct arc_allocator allocator; /**< Used for the nodes */
+    struct arc_slab *pool; /**< Node pool owned by the container or NULL */
 };
 /**
  * @struct arc_dlist_iterator
@@ -47,6 +51,9 @@ struct arc_dlist_iterator
 };
 
 int arc_dlist_init(struct arc_dlist *list, size_t data_size);
+int arc_dlist_init_with_allocator(struct arc_dlist *list, size_t data_size,
+                                  const struct arc_allocator *allocator);
+int arc_dlist_init_pooled(struct arc_dlist *list, size_t data_size);
 void arc_dlist_fini(struct arc_dlist *list);
 int arc_dlist_iterator_init(struct arc_dlist_iterator *it,
                             struct arc_dlist *list);
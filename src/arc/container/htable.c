@@ -17,6 +17,7 @@
  */
 
 #include <math.h>
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 #include <arc/common/defines.h>
@@ -62,55 +63,826 @@
 
 /******************************************************************************/
 
+#if ULONG_MAX > 0xFFFFFFFFUL
+# define ARC_HTABLE_GOLDEN_RATIO 0x9E3779B97F4A7C15UL
+#else
+# define ARC_HTABLE_GOLDEN_RATIO 0x9E3779B9UL
+#endif
+
+#define ARC_HTABLE_HKEY_BITS (sizeof(arc_hkey_t) * CHAR_BIT)
+
+/******************************************************************************/
+
+static int arc_htable_equal(struct arc_htable *htable,
+                            const void *a, const void *b)
+{
+    if (htable->cmp_fn == NULL)
+    {
+        return memcmp(a, b, htable->data_size) == 0;
+    }
+
+    return (*htable->cmp_fn)(a, b) == 0;
+}
+
+/******************************************************************************/
+
+static arc_hkey_t arc_htable_hash(struct arc_htable *htable, const void *data)
+{
+    if (htable->seeded_hash_fn != NULL)
+    {
+        return (*htable->seeded_hash_fn)(data, htable->data_size,
+                                         htable->seed);
+    }
+
+    return (*htable->hash_fn)(data, htable->data_size);
+}
+
+/******************************************************************************/
+/*                          Separate chaining backend                         */
+/******************************************************************************/
+
+static int arc_htable_chained_init(struct arc_htable *htable,
+                                   struct arc_htable_buckets *table,
+                                   size_t num_buckets)
+{
+    size_t i;
+    struct arc_tree *buckets;
+    struct arc_allocator node_allocator = htable->allocator;
+
+    if (num_buckets == 0)
+    {
+        num_buckets = 1;
+    }
+
+    if (htable->pool != NULL)
+    {
+        arc_slab_get_allocator(htable->pool, &node_allocator);
+    }
+
+    buckets = ARC_ALLOC(&htable->allocator,
+                        sizeof(struct arc_tree) * num_buckets);
+
+    if (buckets == NULL)
+    {
+        return ARC_OUT_OF_MEMORY;
+    }
+
+    for (i = 0; i < num_buckets; i++)
+    {
+        int retval = arc_avltree_init_with_allocator(&buckets[i],
+                                                     htable->data_size,
+                                                     htable->cmp_fn,
+                                                     &node_allocator);
+
+        if (retval != ARC_SUCCESS)
+        {
+            size_t j;
+
+            for (j = 0; j < i; j++)
+            {
+                arc_avltree_fini(&buckets[j]);
+            }
+
+            ARC_FREE(&htable->allocator, buckets);
+
+            return retval;
+        }
+    }
+
+    table->data = buckets;
+    table->num_buckets = num_buckets;
+    table->num_deleted = 0;
+    table->shift = 0;
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+static void arc_htable_chained_clear(struct arc_htable *htable,
+                                     struct arc_htable_buckets *table)
+{
+    size_t i;
+    struct arc_tree *buckets = table->data;
+
+    /* Pooled nodes are released all at once along with the pool */
+    if (htable->pool != NULL)
+    {
+        for (i = 0; i < table->num_buckets; i++)
+        {
+            buckets[i].root = NULL;
+            buckets[i].size = 0;
+        }
+
+        return;
+    }
+
+    for (i = 0; i < table->num_buckets; i++)
+    {
+        arc_avltree_clear(&buckets[i]);
+    }
+}
+
+/******************************************************************************/
+
+static void arc_htable_chained_fini(struct arc_htable *htable,
+                                    struct arc_htable_buckets *table)
+{
+    arc_htable_chained_clear(htable, table);
+    ARC_FREE(&htable->allocator, table->data);
+}
+
+/******************************************************************************/
+
+static int arc_htable_chained_insert(struct arc_htable *htable,
+                                     struct arc_htable_buckets *table,
+                                     arc_hkey_t hash, const void *data)
+{
+    struct arc_tree *buckets = table->data;
+
+    ARC_UNUSED(htable);
+
+    return arc_avltree_insert(&buckets[hash % table->num_buckets], data);
+}
+
+/******************************************************************************/
+
+static void * arc_htable_chained_retrieve(struct arc_htable *htable,
+                                          struct arc_htable_buckets *table,
+                                          arc_hkey_t hash, const void *data)
+{
+    struct arc_tree *buckets = table->data;
+
+    ARC_UNUSED(htable);
+
+    return arc_avltree_retrieve(&buckets[hash % table->num_buckets], data);
+}
+
+/******************************************************************************/
+
+static int arc_htable_chained_remove(struct arc_htable *htable,
+                                     struct arc_htable_buckets *table,
+                                     arc_hkey_t hash, const void *data)
+{
+    struct arc_tree *bucket;
+    size_t size;
+
+    ARC_UNUSED(htable);
+
+    bucket = (struct arc_tree *)table->data + hash % table->num_buckets;
+    size = arc_avltree_size(bucket);
+
+    arc_avltree_remove(bucket, data);
+
+    return (arc_avltree_size(bucket) != size ? ARC_SUCCESS : ARC_ERROR);
+}
+
+/******************************************************************************/
+
+static int arc_htable_chained_migrate(struct arc_htable *htable, size_t idx)
+{
+    struct arc_tree *bucket = (struct arc_tree *)htable->old_buckets.data + idx;
+
+    /* Elements are moved one by one from the root, so that the table is left
+       in a consistent state if memory runs out in the middle */
+    while (bucket->root != NULL)
+    {
+        void *data = (char *)bucket->root + bucket->data_offset;
+        arc_hkey_t hash = arc_htable_hash(htable, data);
+        int retval;
+
+        retval = arc_htable_chained_insert(htable, &htable->buckets,
+                                           hash, data);
+
+        if (retval != ARC_SUCCESS && retval != ARC_DUPLICATE)
+        {
+            return retval;
+        }
+
+        (*bucket->remove_fn)(bucket, bucket->root);
+    }
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+static void arc_htable_chained_prefetch(struct arc_htable *htable,
+                                        struct arc_htable_buckets *table,
+                                        arc_hkey_t hash)
+{
+    struct arc_tree *buckets = table->data;
+
+    ARC_UNUSED(htable);
+
+    ARC_PREFETCH(&buckets[hash % table->num_buckets]);
+}
+
+/******************************************************************************/
+
+static const struct arc_htable_ops arc_htable_chained_ops = {
+    &arc_htable_chained_init,
+    &arc_htable_chained_fini,
+    &arc_htable_chained_insert,
+    &arc_htable_chained_retrieve,
+    &arc_htable_chained_remove,
+    &arc_htable_chained_clear,
+    &arc_htable_chained_migrate,
+    &arc_htable_chained_prefetch
+};
+
+/******************************************************************************/
+/*                          Open addressing backend                           */
+/******************************************************************************/
+/* The slots are stored in a single contiguous array and collisions are
+   resolved through linear probing. The number of slots is always a power of
+   two, the initial slot of an element is computed through fibonacci hashing,
+   which takes the upper bits of the hash multiplied by the golden ratio so that
+   poor user hash functions (e.g. identity) are still spread evenly. */
+
+#define ARC_HTABLE_SLOT(htable, slots, idx) \
+    ((struct arc_htable_slot *)((char *)(slots) + (idx) * (htable)->slot_size))
+
+/******************************************************************************/
+
+static size_t arc_htable_open_index(struct arc_htable_buckets *table,
+                                    arc_hkey_t hash)
+{
+    return (size_t)((hash * ARC_HTABLE_GOLDEN_RATIO) >> table->shift);
+}
+
+/******************************************************************************/
+
+static int arc_htable_open_init(struct arc_htable *htable,
+                                struct arc_htable_buckets *table,
+                                size_t num_buckets)
+{
+    size_t num_slots = ARC_HTABLE_MIN_SLOTS;
+    unsigned bits = 3;
+    void *slots;
+
+    while (num_slots < num_buckets)
+    {
+        num_slots <<= 1;
+        bits++;
+    }
+
+    slots = ARC_ALLOC(&htable->allocator, num_slots * htable->slot_size);
+
+    if (slots == NULL)
+    {
+        return ARC_OUT_OF_MEMORY;
+    }
+
+    /* The empty state is zero so the slots can be cleared at once */
+    memset(slots, 0, num_slots * htable->slot_size);
+
+    table->data = slots;
+    table->num_buckets = num_slots;
+    table->num_deleted = 0;
+    table->shift = (unsigned)ARC_HTABLE_HKEY_BITS - bits;
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+static void arc_htable_open_fini(struct arc_htable *htable,
+                                 struct arc_htable_buckets *table)
+{
+    ARC_FREE(&htable->allocator, table->data);
+}
+
+/******************************************************************************/
+
+static void arc_htable_open_clear(struct arc_htable *htable,
+                                  struct arc_htable_buckets *table)
+{
+    size_t i;
+
+    for (i = 0; i < table->num_buckets; i++)
+    {
+        ARC_HTABLE_SLOT(htable, table->data, i)->state = ARC_HTABLE_SLOT_EMPTY;
+    }
+
+    table->num_deleted = 0;
+}
+
+/******************************************************************************/
+
+static int arc_htable_open_insert(struct arc_htable *htable,
+                                  struct arc_htable_buckets *table,
+                                  arc_hkey_t hash, const void *data)
+{
+    struct arc_htable_slot *slot, *deleted = NULL;
+    size_t mask = table->num_buckets - 1;
+    size_t idx = arc_htable_open_index(table, hash);
+
+    slot = ARC_HTABLE_SLOT(htable, table->data, idx);
+
+    /* The load factor is always below one, so an empty slot will be found */
+    while (slot->state != ARC_HTABLE_SLOT_EMPTY)
+    {
+        if (slot->state == ARC_HTABLE_SLOT_DELETED)
+        {
+            if (deleted == NULL)
+            {
+                deleted = slot;
+            }
+        }
+        else if (slot->hash == hash && arc_htable_equal(htable, slot->data, data))
+        {
+            return ARC_DUPLICATE;
+        }
+
+        idx = (idx + 1) & mask;
+        slot = ARC_HTABLE_SLOT(htable, table->data, idx);
+    }
+
+    if (deleted != NULL)
+    {
+        slot = deleted;
+        table->num_deleted--;
+    }
+
+    slot->hash = hash;
+    slot->state = ARC_HTABLE_SLOT_FULL;
+    memcpy(slot->data, data, htable->data_size);
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+static struct arc_htable_slot * arc_htable_open_find(struct arc_htable *htable,
+                                            struct arc_htable_buckets *table,
+                                            arc_hkey_t hash,
+                                            const void *data)
+{
+    size_t mask = table->num_buckets - 1;
+    size_t idx = arc_htable_open_index(table, hash);
+    struct arc_htable_slot *slot = ARC_HTABLE_SLOT(htable, table->data, idx);
+
+    while (slot->state != ARC_HTABLE_SLOT_EMPTY)
+    {
+        if (slot->state == ARC_HTABLE_SLOT_FULL && slot->hash == hash &&
+            arc_htable_equal(htable, slot->data, data))
+        {
+            return slot;
+        }
+
+        idx = (idx + 1) & mask;
+        slot = ARC_HTABLE_SLOT(htable, table->data, idx);
+    }
+
+    return NULL;
+}
+
+/******************************************************************************/
+
+static void * arc_htable_open_retrieve(struct arc_htable *htable,
+                                       struct arc_htable_buckets *table,
+                                       arc_hkey_t hash, const void *data)
+{
+    struct arc_htable_slot *slot;
+
+    slot = arc_htable_open_find(htable, table, hash, data);
+
+    return (slot == NULL ? NULL : slot->data);
+}
+
+/******************************************************************************/
+
+static int arc_htable_open_remove(struct arc_htable *htable,
+                                  struct arc_htable_buckets *table,
+                                  arc_hkey_t hash, const void *data)
+{
+    struct arc_htable_slot *slot, *next;
+    size_t idx;
+
+    slot = arc_htable_open_find(htable, table, hash, data);
+
+    if (slot == NULL)
+    {
+        return ARC_ERROR;
+    }
+
+    /* If the next slot is empty no probe sequence goes through this slot, so
+       it can be emptied instead of leaving a deleted marker behind */
+    idx = (size_t)((char *)slot - (char *)table->data) / htable->slot_size;
+    idx = (idx + 1) & (table->num_buckets - 1);
+    next = ARC_HTABLE_SLOT(htable, table->data, idx);
+
+    if (next->state == ARC_HTABLE_SLOT_EMPTY)
+    {
+        slot->state = ARC_HTABLE_SLOT_EMPTY;
+    }
+    else
+    {
+        slot->state = ARC_HTABLE_SLOT_DELETED;
+        table->num_deleted++;
+    }
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+static int arc_htable_open_migrate(struct arc_htable *htable, size_t idx)
+{
+    struct arc_htable_buckets *table = &htable->buckets;
+    struct arc_htable_slot *slot, *dst;
+    size_t mask, dst_idx;
+
+    slot = ARC_HTABLE_SLOT(htable, htable->old_buckets.data, idx);
+
+    if (slot->state != ARC_HTABLE_SLOT_FULL)
+    {
+        return ARC_SUCCESS;
+    }
+
+    /* The element is not in the new array, so it's enough to find an empty or
+       deleted slot there */
+    mask = table->num_buckets - 1;
+    dst_idx = arc_htable_open_index(table, slot->hash);
+    dst = ARC_HTABLE_SLOT(htable, table->data, dst_idx);
+
+    while (dst->state == ARC_HTABLE_SLOT_FULL)
+    {
+        dst_idx = (dst_idx + 1) & mask;
+        dst = ARC_HTABLE_SLOT(htable, table->data, dst_idx);
+    }
+
+    if (dst->state == ARC_HTABLE_SLOT_DELETED)
+    {
+        table->num_deleted--;
+    }
+
+    memcpy(dst, slot, htable->slot_size);
+
+    /* The old slot keeps a deleted marker so that the probe sequences of the
+       elements that are still to be migrated are not broken */
+    slot->state = ARC_HTABLE_SLOT_DELETED;
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+static void arc_htable_open_prefetch(struct arc_htable *htable,
+                                     struct arc_htable_buckets *table,
+                                     arc_hkey_t hash)
+{
+    size_t idx = arc_htable_open_index(table, hash);
+
+    ARC_PREFETCH(ARC_HTABLE_SLOT(htable, table->data, idx));
+}
+
+/******************************************************************************/
+
+static const struct arc_htable_ops arc_htable_open_ops = {
+    &arc_htable_open_init,
+    &arc_htable_open_fini,
+    &arc_htable_open_insert,
+    &arc_htable_open_retrieve,
+    &arc_htable_open_remove,
+    &arc_htable_open_clear,
+    &arc_htable_open_migrate,
+    &arc_htable_open_prefetch
+};
+
+/******************************************************************************/
+/*                              Incremental rehash                            */
+/******************************************************************************/
+/* When the load factor goes over the maximum a new bucket array is allocated
+   and the old one is kept around. Every following operation migrates a bounded
+   number of old buckets into the new array, lookups check both arrays until
+   the migration is finished and the old array is released. */
+
+static int arc_htable_rehashing(struct arc_htable *htable)
+{
+    return htable->old_buckets.data != NULL;
+}
+
+/******************************************************************************/
+
+static int arc_htable_migrate(struct arc_htable *htable, size_t num_buckets)
+{
+    size_t end = htable->migrate_idx + num_buckets;
+
+    if (end > htable->old_buckets.num_buckets)
+    {
+        end = htable->old_buckets.num_buckets;
+    }
+
+    while (htable->migrate_idx < end)
+    {
+        int retval = (*htable->ops->migrate_fn)(htable, htable->migrate_idx);
+
+        if (retval != ARC_SUCCESS)
+        {
+            return retval;
+        }
+
+        htable->migrate_idx++;
+    }
+
+    if (htable->migrate_idx == htable->old_buckets.num_buckets)
+    {
+        (*htable->ops->fini_fn)(htable, &htable->old_buckets);
+        htable->old_buckets.data = NULL;
+        htable->old_buckets.num_buckets = 0;
+        htable->migrate_idx = 0;
+    }
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+static int arc_htable_migrate_step(struct arc_htable *htable)
+{
+    if (!arc_htable_rehashing(htable))
+    {
+        return ARC_SUCCESS;
+    }
+
+    return arc_htable_migrate(htable, ARC_HTABLE_MIGRATE_STEP);
+}
+
+/******************************************************************************/
+
+static int arc_htable_finish_rehash(struct arc_htable *htable)
+{
+    if (!arc_htable_rehashing(htable))
+    {
+        return ARC_SUCCESS;
+    }
+
+    return arc_htable_migrate(htable, htable->old_buckets.num_buckets);
+}
+
+/******************************************************************************/
+
+static int arc_htable_start_rehash(struct arc_htable *htable,
+                                   size_t num_buckets)
+{
+    struct arc_htable_buckets table;
+    int retval;
+
+    retval = arc_htable_finish_rehash(htable);
+
+    if (retval != ARC_SUCCESS)
+    {
+        return retval;
+    }
+
+    retval = (*htable->ops->init_fn)(htable, &table, num_buckets);
+
+    if (retval != ARC_SUCCESS)
+    {
+        return retval;
+    }
+
+    htable->old_buckets = htable->buckets;
+    htable->buckets = table;
+    htable->migrate_idx = 0;
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+static int arc_htable_overloaded(struct arc_htable *htable, size_t size)
+{
+    double load = (double)(size + htable->buckets.num_deleted);
+
+    return load > htable->max_load_factor *
+                  (double)htable->buckets.num_buckets;
+}
+
+/******************************************************************************/
+/**
+ * @brief Grows the table if the next insertion would exceed the load factor
+ */
+static int arc_htable_grow(struct arc_htable *htable)
+{
+    size_t num_buckets;
+
+    if (!arc_htable_overloaded(htable, htable->size + 1))
+    {
+        return ARC_SUCCESS;
+    }
+
+    /* Finish any pending migration first, the new array might be enough */
+    if (arc_htable_rehashing(htable))
+    {
+        int retval = arc_htable_finish_rehash(htable);
+
+        if (retval != ARC_SUCCESS)
+        {
+            return retval;
+        }
+
+        if (!arc_htable_overloaded(htable, htable->size + 1))
+        {
+            return ARC_SUCCESS;
+        }
+    }
+
+    /* The array is not doubled if most of the load comes from deleted slots,
+       it's just rebuilt to get rid of them */
+    num_buckets = htable->buckets.num_buckets;
+
+    if ((double)(htable->size + 1) * 2 > htable->max_load_factor *
+                                         (double)num_buckets)
+    {
+        num_buckets *= 2;
+    }
+
+    return arc_htable_start_rehash(htable, num_buckets);
+}
+
+/******************************************************************************/
+/*                              Generic interface                             */
+/******************************************************************************/
+
+static int arc_htable_init_ops(struct arc_htable *htable,
+                               const struct arc_htable_ops *ops,
+                               size_t num_buckets,
+                               size_t data_size,
+                               arc_cmp_fn_t cmp_fn,
+                               arc_hash_fn_t hash_fn,
+                               const struct arc_allocator *allocator)
+{
+    size_t slot_size;
+
+    /* Slots are rounded up so that the header and the data of every slot
+       are aligned */
+    slot_size = ARC_OFFSETOF(struct arc_htable_slot, data) + data_size;
+    slot_size = (slot_size + sizeof(union arc_slab_align) - 1) /
+                sizeof(union arc_slab_align) * sizeof(union arc_slab_align);
+
+    htable->data_size = data_size;
+    htable->size = 0;
+    htable->slot_size = slot_size;
+    htable->migrate_idx = 0;
+    htable->cmp_fn = cmp_fn;
+    htable->hash_fn = hash_fn;
+    htable->seeded_hash_fn = NULL;
+    htable->seed = 0;
+    htable->ops = ops;
+    htable->pool = NULL;
+    htable->allocator = (allocator != NULL ? *allocator
+                                           : arc_default_allocator);
+
+    htable->old_buckets.data = NULL;
+    htable->old_buckets.num_buckets = 0;
+    htable->old_buckets.num_deleted = 0;
+    htable->old_buckets.shift = 0;
+
+    return (*ops->init_fn)(htable, &htable->buckets, num_buckets);
+}
+
+/******************************************************************************/
+
 int arc_htable_init(struct arc_htable *htable,
                           size_t num_buckets,
                           size_t data_size,
                           arc_cmp_fn_t cmp_fn,
                           arc_hash_fn_t hash_fn)
+{
+    return arc_htable_init_with_allocator(htable, num_buckets, data_size,
+                                          cmp_fn, hash_fn, NULL);
+}
+
+/******************************************************************************/
+
+int arc_htable_init_with_allocator(struct arc_htable *htable,
+                                   size_t num_buckets,
+                                   size_t data_size,
+                                   arc_cmp_fn_t cmp_fn,
+                                   arc_hash_fn_t hash_fn,
+                                   const struct arc_allocator *allocator)
+{
+    htable->max_load_factor = ARC_HTABLE_CHAINED_LOAD_FACTOR;
+
+    return arc_htable_init_ops(htable, &arc_htable_chained_ops, num_buckets,
+                               data_size, cmp_fn, hash_fn, allocator);
+}
+
+/******************************************************************************/
+
+int arc_htable_init_pooled(struct arc_htable *htable,
+                           size_t num_buckets,
+                           size_t data_size,
+                           arc_cmp_fn_t cmp_fn,
+                           arc_hash_fn_t hash_fn)
 {
     size_t i;
+    struct arc_tree *buckets;
+    int retval = arc_htable_init(htable, num_buckets,
+                                 data_size, cmp_fn, hash_fn);
 
-    htable->buckets = malloc(sizeof(struct arc_tree) * num_buckets);
+    if (retval != ARC_SUCCESS)
+    {
+        return retval;
+    }
 
-    if (htable->buckets == NULL)
+    buckets = htable->buckets.data;
+    htable->pool = arc_slab_create(buckets[0].node_size);
+
+    if (htable->pool == NULL)
     {
+        arc_htable_fini(htable);
         return ARC_OUT_OF_MEMORY;
     }
 
-    htable->num_buckets = num_buckets;
-    htable->data_size = data_size;
-    htable->size = 0;
-    htable->cmp_fn = cmp_fn;
-    htable->hash_fn = hash_fn;
-
-    for (i = 0; i < num_buckets; i++)
+    /* The buckets are still empty so they can switch allocators */
+    for (i = 0; i < htable->buckets.num_buckets; i++)
     {
-        int retval = arc_avltree_init(&htable->buckets[i], data_size, cmp_fn);
+        arc_slab_get_allocator(htable->pool, &buckets[i].allocator);
+    }
 
-        if (retval != ARC_SUCCESS)
-        {
-            size_t j;
+    return ARC_SUCCESS;
+}
 
-            for (j = 0; j < i; j++)
-            {
-                arc_avltree_fini(&htable->buckets[i]);
-            }
+/******************************************************************************/
+
+int arc_htable_init_open(struct arc_htable *htable,
+                         size_t num_buckets,
+                         size_t data_size,
+                         arc_cmp_fn_t cmp_fn,
+                         arc_hash_fn_t hash_fn)
+{
+    return arc_htable_init_open_with_allocator(htable, num_buckets, data_size,
+                                               cmp_fn, hash_fn, NULL);
+}
 
-            free(htable->buckets);
+/******************************************************************************/
 
-            return retval;
-        }
-    }
+int arc_htable_init_open_with_allocator(struct arc_htable *htable,
+                                        size_t num_buckets,
+                                        size_t data_size,
+                                        arc_cmp_fn_t cmp_fn,
+                                        arc_hash_fn_t hash_fn,
+                                        const struct arc_allocator *allocator)
+{
+    htable->max_load_factor = ARC_HTABLE_OPEN_LOAD_FACTOR;
 
-    return ARC_SUCCESS;
+    return arc_htable_init_ops(htable, &arc_htable_open_ops, num_buckets,
+                               data_size, cmp_fn, hash_fn, allocator);
+}
+
+/******************************************************************************/
+
+int arc_htable_init_seeded(struct arc_htable *htable,
+                           size_t num_buckets,
+                           size_t data_size,
+                           arc_cmp_fn_t cmp_fn,
+                           arc_hash_seeded_fn_t hash_fn)
+{
+    int retval = arc_htable_init(htable, num_buckets,
+                                 data_size, cmp_fn, NULL);
+
+    htable->seeded_hash_fn = hash_fn;
+    htable->seed = arc_hash_random_seed(htable);
+
+    return retval;
+}
+
+/******************************************************************************/
+
+int arc_htable_init_open_seeded(struct arc_htable *htable,
+                                size_t num_buckets,
+                                size_t data_size,
+                                arc_cmp_fn_t cmp_fn,
+                                arc_hash_seeded_fn_t hash_fn)
+{
+    int retval = arc_htable_init_open(htable, num_buckets,
+                                      data_size, cmp_fn, NULL);
+
+    htable->seeded_hash_fn = hash_fn;
+    htable->seed = arc_hash_random_seed(htable);
+
+    return retval;
 }
 
 /******************************************************************************/
 
 void arc_htable_fini(struct arc_htable *htable)
 {
-    arc_htable_clear(htable);
-    free(htable->buckets);
+    if (arc_htable_rehashing(htable))
+    {
+        (*htable->ops->fini_fn)(htable, &htable->old_buckets);
+    }
+
+    (*htable->ops->fini_fn)(htable, &htable->buckets);
+
+    if (htable->pool != NULL)
+    {
+        arc_slab_destroy(htable->pool);
+    }
 }
 
 /******************************************************************************/
@@ -119,6 +891,130 @@ struct arc_htable * arc_htable_create(size_t num_buckets,
                                       size_t data_size,
                                       arc_cmp_fn_t cmp_fn,
                                       arc_hash_fn_t hash_fn)
+{
+    return arc_htable_create_with_allocator(num_buckets, data_size,
+                                            cmp_fn, hash_fn, NULL);
+}
+
+/******************************************************************************/
+
+struct arc_htable *
+arc_htable_create_with_allocator(size_t num_buckets,
+                                 size_t data_size,
+                                 arc_cmp_fn_t cmp_fn,
+                                 arc_hash_fn_t hash_fn,
+                                 const struct arc_allocator *allocator)
+{
+    struct arc_htable * htable = malloc(sizeof(struct arc_htable));
+
+    if (htable == NULL)
+    {
+        return htable;
+    }
+
+    if (arc_htable_init_with_allocator(htable, num_buckets, data_size,
+                                       cmp_fn, hash_fn,
+                                       allocator) != ARC_SUCCESS)
+    {
+        free(htable);
+        return NULL;
+    }
+
+    return htable;
+}
+
+/******************************************************************************/
+
+struct arc_htable * arc_htable_create_pooled(size_t num_buckets,
+                                             size_t data_size,
+                                             arc_cmp_fn_t cmp_fn,
+                                             arc_hash_fn_t hash_fn)
+{
+    struct arc_htable * htable = malloc(sizeof(struct arc_htable));
+
+    if (htable == NULL)
+    {
+        return htable;
+    }
+
+    if (arc_htable_init_pooled(htable, num_buckets,
+                               data_size, cmp_fn, hash_fn) != ARC_SUCCESS)
+    {
+        free(htable);
+        return NULL;
+    }
+
+    return htable;
+}
+
+/******************************************************************************/
+
+struct arc_htable * arc_htable_create_open(size_t num_buckets,
+                                           size_t data_size,
+                                           arc_cmp_fn_t cmp_fn,
+                                           arc_hash_fn_t hash_fn)
+{
+    return arc_htable_create_open_with_allocator(num_buckets, data_size,
+                                                 cmp_fn, hash_fn, NULL);
+}
+
+/******************************************************************************/
+
+struct arc_htable *
+arc_htable_create_open_with_allocator(size_t num_buckets,
+                                      size_t data_size,
+                                      arc_cmp_fn_t cmp_fn,
+                                      arc_hash_fn_t hash_fn,
+                                      const struct arc_allocator *allocator)
+{
+    struct arc_htable * htable = malloc(sizeof(struct arc_htable));
+
+    if (htable == NULL)
+    {
+        return htable;
+    }
+
+    if (arc_htable_init_open_with_allocator(htable, num_buckets, data_size,
+                                            cmp_fn, hash_fn,
+                                            allocator) != ARC_SUCCESS)
+    {
+        free(htable);
+        return NULL;
+    }
+
+    return htable;
+}
+
+/******************************************************************************/
+
+struct arc_htable * arc_htable_create_seeded(size_t num_buckets,
+                                             size_t data_size,
+                                             arc_cmp_fn_t cmp_fn,
+                                             arc_hash_seeded_fn_t hash_fn)
+{
+    struct arc_htable * htable = malloc(sizeof(struct arc_htable));
+
+    if (htable == NULL)
+    {
+        return htable;
+    }
+
+    if (arc_htable_init_seeded(htable, num_buckets,
+                               data_size, cmp_fn, hash_fn) != ARC_SUCCESS)
+    {
+        free(htable);
+        return NULL;
+    }
+
+    return htable;
+}
+
+/******************************************************************************/
+
+struct arc_htable * arc_htable_create_open_seeded(size_t num_buckets,
+                                                  size_t data_size,
+                                                  arc_cmp_fn_t cmp_fn,
+                                                  arc_hash_seeded_fn_t hash_fn)
 {
     struct arc_htable * htable = malloc(sizeof(struct arc_htable));
 
@@ -127,8 +1023,8 @@ struct arc_htable * arc_htable_create(size_t num_buckets,
         return htable;
     }
 
-    if (arc_htable_init(htable, num_buckets, 
-                              data_size, cmp_fn, hash_fn) != ARC_SUCCESS)
+    if (arc_htable_init_open_seeded(htable, num_buckets,
+                                    data_size, cmp_fn, hash_fn) != ARC_SUCCESS)
     {
         free(htable);
         return NULL;
@@ -147,13 +1043,57 @@ void arc_htable_destroy(struct arc_htable * htable)
 
 /******************************************************************************/
 
+int arc_htable_set_max_load_factor(struct arc_htable *htable,
+                                   double max_load_factor)
+{
+    if (max_load_factor <= 0.0 ||
+        (htable->ops == &arc_htable_open_ops &&
+         max_load_factor > ARC_HTABLE_OPEN_MAX_LOAD_FACTOR))
+    {
+        return ARC_ERROR;
+    }
+
+    htable->max_load_factor = max_load_factor;
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
 int arc_htable_insert(struct arc_htable *htable, void *data)
 {
     int retval;
     arc_hkey_t hvalue;
-    hvalue = htable->hash_fn(data, htable->data_size) % htable->num_buckets;
 
-    retval = arc_avltree_insert(&htable->buckets[hvalue], data);
+    retval = arc_htable_migrate_step(htable);
+
+    if (retval != ARC_SUCCESS) { return retval; }
+
+    hvalue = arc_htable_hash(htable, data);
+
+    if (arc_htable_rehashing(htable) &&
+        (*htable->ops->retrieve_fn)(htable, &htable->old_buckets,
+                                    hvalue, data) != NULL)
+    {
+        return ARC_DUPLICATE;
+    }
+
+    /* A duplicate must not make the table grow, the lookup is only needed
+       when the insertion would reach the load factor */
+    if (arc_htable_overloaded(htable, htable->size + 1))
+    {
+        if ((*htable->ops->retrieve_fn)(htable, &htable->buckets,
+                                        hvalue, data) != NULL)
+        {
+            return ARC_DUPLICATE;
+        }
+
+        retval = arc_htable_grow(htable);
+
+        if (retval != ARC_SUCCESS) { return retval; }
+    }
+
+    retval = (*htable->ops->insert_fn)(htable, &htable->buckets, hvalue, data);
 
     if (retval != ARC_SUCCESS) { return retval; }
 
@@ -167,10 +1107,80 @@ int arc_htable_insert(struct arc_htable *htable, void *data)
 void * arc_htable_retrieve(struct arc_htable * htable, void *data)
 {
     arc_hkey_t hvalue;
+    void *result;
+
+    arc_htable_migrate_step(htable);
+
+    hvalue = arc_htable_hash(htable, data);
+
+    result = (*htable->ops->retrieve_fn)(htable, &htable->buckets,
+                                         hvalue, data);
+
+    if (result == NULL && arc_htable_rehashing(htable))
+    {
+        result = (*htable->ops->retrieve_fn)(htable, &htable->old_buckets,
+                                             hvalue, data);
+    }
+
+    return result;
+}
 
-    hvalue = htable->hash_fn(data, htable->data_size) % htable->num_buckets;
+/******************************************************************************/
+
+size_t arc_htable_retrieve_batch(struct arc_htable *htable, const void *keys,
+                                 size_t n, void **results)
+{
+    size_t i, base, found = 0;
+    arc_hkey_t hvalues[ARC_HTABLE_BATCH_SIZE];
+
+    arc_htable_migrate_step(htable);
+
+    /* All the keys of a group are hashed and their buckets prefetched before
+       any of them is resolved, so the cache misses overlap */
+    for (base = 0; base < n; base += ARC_HTABLE_BATCH_SIZE)
+    {
+        size_t count = n - base;
+
+        if (count > ARC_HTABLE_BATCH_SIZE)
+        {
+            count = ARC_HTABLE_BATCH_SIZE;
+        }
+
+        for (i = 0; i < count; i++)
+        {
+            const void *key = (const char *)keys +
+                              (base + i) * htable->data_size;
+
+            hvalues[i] = arc_htable_hash(htable, key);
+            (*htable->ops->prefetch_fn)(htable, &htable->buckets, hvalues[i]);
+        }
+
+        for (i = 0; i < count; i++)
+        {
+            const void *key = (const char *)keys +
+                              (base + i) * htable->data_size;
+            void *result;
+
+            result = (*htable->ops->retrieve_fn)(htable, &htable->buckets,
+                                                 hvalues[i], key);
 
-    return arc_avltree_retrieve(&htable->buckets[hvalue], data);
+            if (result == NULL && arc_htable_rehashing(htable))
+            {
+                result = (*htable->ops->retrieve_fn)(htable,
+                                                     &htable->old_buckets,
+                                                     hvalues[i], key);
+            }
+
+            if (result != NULL)
+            {
+                found++;
+            }
+
+            results[base + i] = result;
+        }
+    }
+
+    return found;
 }
 
 /******************************************************************************/
@@ -191,13 +1201,21 @@ size_t arc_htable_size(struct arc_htable * htable)
 
 void arc_htable_clear(struct arc_htable * htable)
 {
-    size_t i;
-
-    for (i = 0; i < htable->num_buckets; i++)
+    if (arc_htable_rehashing(htable))
     {
-        arc_avltree_clear(&htable->buckets[i]);
+        (*htable->ops->fini_fn)(htable, &htable->old_buckets);
+        htable->old_buckets.data = NULL;
+        htable->old_buckets.num_buckets = 0;
+        htable->migrate_idx = 0;
     }
+
+    (*htable->ops->clear_fn)(htable, &htable->buckets);
     htable->size = 0;
+
+    if (htable->pool != NULL)
+    {
+        arc_slab_clear(htable->pool);
+    }
 }
 
 /******************************************************************************/
@@ -205,63 +1223,48 @@ void arc_htable_clear(struct arc_htable * htable)
 void arc_htable_remove(struct arc_htable * htable, void *data)
 {
     arc_hkey_t hvalue;
+    int retval;
 
-    hvalue = htable->hash_fn(data, htable->data_size) % htable->num_buckets;
-
-    arc_avltree_remove(&htable->buckets[hvalue], data);
-
-    htable->size--;
-}
-
-/******************************************************************************/
-
-/*int arc_htable_rehash(struct arc_htable * htable, size_t num_buckets)*/
-/*{*/
-    /*size_t i;*/
-    /*struct arc_slist *buckets = malloc(sizeof(struct arc_slist) * num_buckets);*/
-
-    /*if (buckets == NULL)*/
-    /*{*/
-        /*return ARC_OUT_OF_MEMORY;*/
-    /*}*/
+    arc_htable_migrate_step(htable);
 
-    /*for (i = 0; i < num_buckets; i++)*/
-    /*{*/
-        /*arc_slist_init(&buckets[i], sizeof(struct arc_htable_node));*/
-    /*}*/
+    hvalue = arc_htable_hash(htable, data);
 
-    /*for (i = 0; i < htable->num_buckets; i++)*/
-    /*{*/
-        /*arc_hkey_t hvalue ;*/
+    retval = (*htable->ops->remove_fn)(htable, &htable->buckets, hvalue, data);
 
-        /*if (arc_slist_size(&htable->buckets[i]) > 0)*/
-        /*{*/
-            /*struct arc_iterator it;*/
-            /*arc_iterator_init(&it, &htable->buckets[i]);*/
+    if (retval != ARC_SUCCESS && arc_htable_rehashing(htable))
+    {
+        retval = (*htable->ops->remove_fn)(htable, &htable->old_buckets,
+                                           hvalue, data);
+    }
 
-            /*arc_slist_before_begin(&it);*/
+    if (retval == ARC_SUCCESS)
+    {
+        htable->size--;
+    }
+}
 
-            /*while(arc_slist_next(&it))*/
-            /*{*/
-                /*void *data = arc_slist_data(&it);*/
+/******************************************************************************/
 
-                /*hvalue = htable->hash_fn(data, htable->data_size) %*/
-                         /*num_buckets;*/
-                /*arc_slist_insert_order(&buckets[hvalue], htable->cmp_fn, data);*/
-/*[>                arc_slist_push_front(&buckets[hvalue], node); <]*/
-            /*}*/
+int arc_htable_rehash(struct arc_htable * htable, size_t num_buckets)
+{
+    int retval;
+    double min_buckets = (double)htable->size / htable->max_load_factor;
 
-            /*arc_iterator_fini(&it);*/
-        /*}*/
+    /* Never go over the maximum load factor, whatever the backend. For open
+       addressing it also ensures that there are more slots than elements */
+    if ((double)num_buckets < min_buckets)
+    {
+        num_buckets = (size_t)min_buckets + 1;
+    }
 
-        /*arc_slist_fini(&htable->buckets[i]);*/
-    /*}*/
+    retval = arc_htable_start_rehash(htable, num_buckets);
 
-    /*free(htable->buckets);*/
-    /*htable->buckets = buckets;*/
-    /*htable->num_buckets = num_buckets;*/
+    if (retval != ARC_SUCCESS)
+    {
+        return retval;
+    }
 
-    /*return ARC_SUCCESS;*/
-/*}*/
+    return arc_htable_finish_rehash(htable);
+}
 
 /******************************************************************************/
@@ -22,15 +22,106 @@
 #include <arc/type/function.h>
 #include <arc/container/htable.h>
 #include <arc/container/avltree_def.h>
+#include <arc/memory/allocator.h>
+#include <arc/memory/slab.h>
+#include <arc/memory/slab_def.h>
 
-struct arc_htable
+/* Minimum number of slots of an open addressing table, it has to be a power of
+   two as the slot index is computed with a mask */
+#define ARC_HTABLE_MIN_SLOTS 8
+
+/* Default maximum load factors, for open addressing the deleted slots are also
+   taken into account */
+#define ARC_HTABLE_CHAINED_LOAD_FACTOR 1.0
+#define ARC_HTABLE_OPEN_LOAD_FACTOR 0.75
+/* Upper bound of the load factor for open addressing */
+#define ARC_HTABLE_OPEN_MAX_LOAD_FACTOR 0.95
+
+/* Number of buckets migrated from the old bucket array on every operation
+   while an incremental rehash is in progress */
+#define ARC_HTABLE_MIGRATE_STEP 8
+
+/* Number of keys hashed and prefetched ahead by the batched retrieval */
+#define ARC_HTABLE_BATCH_SIZE 16
+
+/* Slot states of the open addressing backend */
+#define ARC_HTABLE_SLOT_EMPTY   0
+#define ARC_HTABLE_SLOT_FULL    1
+#define ARC_HTABLE_SLOT_DELETED 2
+
+/* Bucket array, while an incremental rehash is in progress the table keeps
+   both the old and the new one */
+struct arc_htable_buckets
 {
+    void *data;
     size_t num_buckets;
+    size_t num_deleted; /**< Number of deleted slots (open addressing) */
+    unsigned shift; /**< Shift applied to the mixed hash (open addressing) */
+};
+
+struct arc_htable;
+
+typedef int (*arc_htable_init_fn_t)(struct arc_htable *,
+                                    struct arc_htable_buckets *, size_t);
+typedef void (*arc_htable_fini_fn_t)(struct arc_htable *,
+                                     struct arc_htable_buckets *);
+typedef int (*arc_htable_insert_fn_t)(struct arc_htable *,
+                                      struct arc_htable_buckets *,
+                                      arc_hkey_t, const void *);
+typedef void * (*arc_htable_retrieve_fn_t)(struct arc_htable *,
+                                           struct arc_htable_buckets *,
+                                           arc_hkey_t, const void *);
+typedef int (*arc_htable_remove_fn_t)(struct arc_htable *,
+                                      struct arc_htable_buckets *,
+                                      arc_hkey_t, const void *);
+typedef void (*arc_htable_clear_fn_t)(struct arc_htable *,
+                                      struct arc_htable_buckets *);
+typedef int (*arc_htable_migrate_fn_t)(struct arc_htable *, size_t);
+typedef void (*arc_htable_prefetch_fn_t)(struct arc_htable *,
+                                         struct arc_htable_buckets *,
+                                         arc_hkey_t);
+
+/* Backend definition, each backend provides its own bucket management */
+struct arc_htable_ops
+{
+    arc_htable_init_fn_t init_fn;
+    arc_htable_fini_fn_t fini_fn;
+    arc_htable_insert_fn_t insert_fn;
+    arc_htable_retrieve_fn_t retrieve_fn;
+    arc_htable_remove_fn_t remove_fn;
+    arc_htable_clear_fn_t clear_fn;
+    arc_htable_migrate_fn_t migrate_fn; /**< Moves an old bucket to the new array */
+    arc_htable_prefetch_fn_t prefetch_fn; /**< Prefetches the bucket of a hash */
+};
+
+/* Container definition, the buckets are an array of avltrees when using
+   separate chaining or an array of slots when using open addressing */
+struct arc_htable
+{
     size_t data_size;
     size_t size;
+    size_t slot_size; /**< Size of an open addressing slot */
+    size_t migrate_idx; /**< Next old bucket to be migrated */
+    double max_load_factor;
     arc_cmp_fn_t cmp_fn;
     arc_hash_fn_t hash_fn;
-    struct arc_tree *buckets;
+    arc_hash_seeded_fn_t seeded_hash_fn; /**< Used instead of hash_fn if set */
+    arc_hkey_t seed;
+    struct arc_htable_buckets buckets;
+    struct arc_htable_buckets old_buckets; /**< data is NULL unless rehashing */
+    const struct arc_htable_ops *ops;
+    struct arc_allocator allocator; /**< Used for the buckets and the nodes */
+    struct arc_slab *pool; /**< Node pool of the buckets (chaining) or NULL */
+};
+
+/* Open addressing slot, the data array is a placeholder for the user memory,
+   which is stored inline right after the slot header. Its type keeps the
+   data aligned like a slab object */
+struct arc_htable_slot
+{
+    arc_hkey_t hash;
+    int state;
+    union arc_slab_align data[1];
 };
 
 struct arc_htable_node
@@ -45,6 +136,44 @@ int arc_htable_init(struct arc_htable *htable,
                           arc_cmp_fn_t cmp_fn,
                           arc_hash_fn_t hash_fn);
 
+int arc_htable_init_with_allocator(struct arc_htable *htable,
+                                   size_t num_buckets,
+                                   size_t data_size,
+                                   arc_cmp_fn_t cmp_fn,
+                                   arc_hash_fn_t hash_fn,
+                                   const struct arc_allocator *allocator);
+
+int arc_htable_init_pooled(struct arc_htable *htable,
+                           size_t num_buckets,
+                           size_t data_size,
+                           arc_cmp_fn_t cmp_fn,
+                           arc_hash_fn_t hash_fn);
+
+int arc_htable_init_open(struct arc_htable *htable,
+                         size_t num_buckets,
+                         size_t data_size,
+                         arc_cmp_fn_t cmp_fn,
+                         arc_hash_fn_t hash_fn);
+
+int arc_htable_init_open_with_allocator(struct arc_htable *htable,
+                                        size_t num_buckets,
+                                        size_t data_size,
+                                        arc_cmp_fn_t cmp_fn,
+                                        arc_hash_fn_t hash_fn,
+                                        const struct arc_allocator *allocator);
+
+int arc_htable_init_seeded(struct arc_htable *htable,
+                           size_t num_buckets,
+                           size_t data_size,
+                           arc_cmp_fn_t cmp_fn,
+                           arc_hash_seeded_fn_t hash_fn);
+
+int arc_htable_init_open_seeded(struct arc_htable *htable,
+                                size_t num_buckets,
+                                size_t data_size,
+                                arc_cmp_fn_t cmp_fn,
+                                arc_hash_seeded_fn_t hash_fn);
+
 void arc_htable_fini(struct arc_htable *htable);
 
 #endif
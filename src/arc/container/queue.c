@@ -15,6 +15,14 @@
 /******************************************************************************/
 
 int arc_queue_init(struct arc_queue *queue, size_t data_size)
+{
+    return arc_queue_init_with_allocator(queue, data_size, NULL);
+}
+
+/******************************************************************************/
+
+int arc_queue_init_with_allocator(struct arc_queue *queue, size_t data_size,
+                                  const struct arc_allocator *allocator)
 {
     size_t aligned_size;
 
@@ -32,6 +40,31 @@ int arc_queue_init(struct arc_queue *queue, size_t data_size)
     queue->back = NULL;
     queue->data_size = data_size;
     queue->node_size = aligned_size + sizeof(struct arc_queue_node);
+    queue->allocator = (allocator != NULL ? *allocator : arc_default_allocator);
+    queue->pool = NULL;
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+int arc_queue_init_pooled(struct arc_queue *queue, size_t data_size)
+{
+    int retval = arc_queue_init(queue, data_size);
+
+    if (retval != ARC_SUCCESS)
+    {
+        return retval;
+    }
+
+    queue->pool = arc_slab_create(queue->node_size);
+
+    if (queue->pool == NULL)
+    {
+        return ARC_OUT_OF_MEMORY;
+    }
+
+    arc_slab_get_allocator(queue->pool, &queue->allocator);
 
     return ARC_SUCCESS;
 }
@@ -41,13 +74,42 @@ int arc_queue_init(struct arc_queue *queue, size_t data_size)
 void arc_queue_fini(struct arc_queue *queue)
 {
     arc_queue_clear(queue);
+
+    if (queue->pool != NULL)
+    {
+        arc_slab_destroy(queue->pool);
+    }
 }
 
 /******************************************************************************/
 
 struct arc_queue * arc_queue_create(size_t data_size)
 {
+    return arc_queue_create_with_allocator(data_size, NULL);
+}
+
+/******************************************************************************/
+
+struct arc_queue *
+arc_queue_create_with_allocator(size_t data_size,
+                                const struct arc_allocator *allocator)
+{
+    struct arc_queue * queue = malloc(sizeof(struct arc_queue));
+
+    if (queue == NULL)
+    {
+        return NULL;
+    }
+
+    arc_queue_init_with_allocator(queue, data_size, allocator);
+
+    return queue;
+}
 
+/******************************************************************************/
+
+struct arc_queue * arc_queue_create_pooled(size_t data_size)
+{
     struct arc_queue * queue = malloc(sizeof(struct arc_queue));
 
     if (queue == NULL)
@@ -55,7 +117,11 @@ struct arc_queue * arc_queue_create(size_t data_size)
         return NULL;
     }
 
-    arc_queue_init(queue, data_size);
+    if (arc_queue_init_pooled(queue, data_size) != ARC_SUCCESS)
+    {
+        free(queue);
+        return NULL;
+    }
 
     return queue;
 }
@@ -72,7 +138,8 @@ void arc_queue_destroy(struct arc_queue *queue)
 
 int arc_queue_push(struct arc_queue * queue, void * data)
 {
-    struct arc_queue_node * node = malloc(queue->node_size);
+    struct arc_queue_node * node = ARC_ALLOC(&queue->allocator,
+                                             queue->node_size);
 
     if (node == NULL)
     {
@@ -120,7 +187,7 @@ void arc_queue_pop(struct arc_queue * queue)
         
         queue->size--;
 
-        free(node);
+        ARC_FREE(&queue->allocator, node);
     }
 }
 
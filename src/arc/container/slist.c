@@ -15,6 +15,14 @@
 /******************************************************************************/
 
 int arc_slist_init(struct arc_slist *list, size_t data_size)
+{
+    return arc_slist_init_with_allocator(list, data_size, NULL);
+}
+
+/******************************************************************************/
+
+int arc_slist_init_with_allocator(struct arc_slist *list, size_t data_size,
+                                  const struct arc_allocator *allocator)
 {
     size_t aligned_size;
 
@@ -30,6 +38,8 @@ int arc_slist_init(struct arc_slist *list, size_t data_size)
     list->size = 0;
     list->data_size = data_size;
     list->node_size = aligned_size + sizeof(struct arc_slist_node);
+    list->allocator = (allocator != NULL ? *allocator : arc_default_allocator);
+    list->pool = NULL;
     
     /* Initialise the first "NULL" node : it doesn't hold memory for data
        this node is refered to as the "before_begin" node */
@@ -45,14 +55,51 @@ int arc_slist_init(struct arc_slist *list, size_t data_size)
 
 /******************************************************************************/
 
+int arc_slist_init_pooled(struct arc_slist *list, size_t data_size)
+{
+    int retval = arc_slist_init(list, data_size);
+
+    if (retval != ARC_SUCCESS)
+    {
+        return retval;
+    }
+
+    list->pool = arc_slab_create(list->node_size);
+
+    if (list->pool == NULL)
+    {
+        return ARC_OUT_OF_MEMORY;
+    }
+
+    arc_slab_get_allocator(list->pool, &list->allocator);
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
 void arc_slist_fini(struct arc_slist *list)
 {
     arc_slist_clear(list);
+
+    if (list->pool != NULL)
+    {
+        arc_slab_destroy(list->pool);
+    }
 }
 
 /******************************************************************************/
 
 struct arc_slist * arc_slist_create(size_t data_size)
+{
+    return arc_slist_create_with_allocator(data_size, NULL);
+}
+
+/******************************************************************************/
+
+struct arc_slist *
+arc_slist_create_with_allocator(size_t data_size,
+                                const struct arc_allocator *allocator)
 {
     struct arc_slist * list = malloc(sizeof(struct arc_slist));
 
@@ -61,7 +108,27 @@ struct arc_slist * arc_slist_create(size_t data_size)
         return NULL;
     }
 
-    arc_slist_init(list, data_size);
+    arc_slist_init_with_allocator(list, data_size, allocator);
+
+    return list;
+}
+
+/******************************************************************************/
+
+struct arc_slist * arc_slist_create_pooled(size_t data_size)
+{
+    struct arc_slist * list = malloc(sizeof(struct arc_slist));
+
+    if (list == NULL)
+    {
+        return NULL;
+    }
+
+    if (arc_slist_init_pooled(list, data_size) != ARC_SUCCESS)
+    {
+        free(list);
+        return NULL;
+    }
 
     return list;
 }
@@ -87,7 +154,7 @@ int arc_slist_insert_node_after(struct arc_slist * list,
         return ARC_ERROR;
     }
 
-    node = malloc(list->node_size);
+    node = ARC_ALLOC(&list->allocator, list->node_size);
 
     if (node == NULL)
     {
@@ -117,7 +184,7 @@ void arc_slist_erase_node_after(struct arc_slist * list,
 
         list->size--;
 
-        free(node);
+        ARC_FREE(&list->allocator, node);
     }
 }
 
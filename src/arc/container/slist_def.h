@@ -11,6 +11,8 @@
 #define ARC_SLIST_DEF_H_
 
 #include <stdlib.h>
+#include <arc/memory/allocator.h>
+#include <arc/memory/slab.h>
 
 /* Sentinel node definition */
 struct arc_slist_snode
@@ -31,6 +33,8 @@ struct arc_slist
     size_t size;
     size_t data_size;
     size_t node_size;
+    struct arc_allocator allocator; /**< Used for the nodes */
+    struct arc_slab *pool; /**< Node pool owned by the container or NULL */
 };
 /**
  * @struct arc_slist_iterator
@@ -44,6 +48,9 @@ struct arc_slist_iterator
 
 
 int arc_slist_init(struct arc_slist *list, size_t data_size);
+int arc_slist_init_with_allocator(struct arc_slist *list, size_t data_size,
+                                  const struct arc_allocator *allocator);
+int arc_slist_init_pooled(struct arc_slist *list, size_t data_size);
 void arc_slist_fini(struct arc_slist *list);
 int arc_slist_iterator_init(struct arc_slist_iterator *it,
                             struct arc_slist *list);
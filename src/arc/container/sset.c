@@ -0,0 +1,301 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @file sset.c
+ * @author Anil M. Mahtani Mirchandani
+ * @date September, 2015
+ *
+ * @brief Static Set
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <arc/common/defines.h>
+#include <arc/container/sset.h>
+#include <arc/container/sset_def.h>
+#include <arc/container/darray_def.h>
+#include <arc/container/tree_def.h>
+
+/******************************************************************************/
+
+/* The search goes right on every element less than the key, the lower bound
+   is the last element where it went left: drop the trailing right turns and
+   the left one before them */
+static size_t arc_sset_unwind(size_t k)
+{
+    while (k & 1)
+    {
+        k >>= 1;
+    }
+
+    return k >> 1;
+}
+
+/******************************************************************************/
+
+/* A NULL comparison function compares the bytes of the elements */
+static int arc_sset_compare(const struct arc_sset * sset,
+                            const void * a, const void * b)
+{
+    if (sset->cmp_fn == NULL)
+    {
+        return memcmp(a, b, sset->data_size);
+    }
+
+    return (*sset->cmp_fn)(a, b);
+}
+
+/******************************************************************************/
+
+static size_t arc_sset_search(const struct arc_sset * sset, const void * key)
+{
+    const char * data = sset->data;
+    size_t size = sset->data_size;
+    size_t k = 1;
+
+    while (k <= sset->size)
+    {
+        ARC_PREFETCH(data + (k << ARC_SSET_PREFETCH_LEVELS) * size);
+        k = 2 * k + (size_t)(arc_sset_compare(sset, data + k * size, key) < 0);
+    }
+
+    return arc_sset_unwind(k);
+}
+
+/******************************************************************************/
+
+/* Branchless search for a type which can be compared with < */
+#define ARC_SSET_DEFINE(type)                                                  \
+static size_t arc_sset_##type##_search(const struct arc_sset * sset,           \
+                                       const void * key)                       \
+{                                                                              \
+    const type * data = sset->data;                                            \
+    type value = *(const type *)key;                                           \
+    size_t k = 1;                                                              \
+                                                                               \
+    while (k <= sset->size)                                                    \
+    {                                                                          \
+        ARC_PREFETCH(data + (k << ARC_SSET_PREFETCH_LEVELS));                  \
+        k = 2 * k + (size_t)(data[k] < value);                                 \
+    }                                                                          \
+                                                                               \
+    return arc_sset_unwind(k);                                                 \
+}
+
+ARC_SSET_DEFINE(int)
+ARC_SSET_DEFINE(long)
+ARC_SSET_DEFINE(double)
+
+/******************************************************************************/
+
+/* Positions of the Eytzinger array in the order of the elements */
+static size_t arc_sset_first(size_t num)
+{
+    size_t k = 1;
+
+    while (2 * k <= num)
+    {
+        k *= 2;
+    }
+
+    return k;
+}
+
+/******************************************************************************/
+
+static size_t arc_sset_next(size_t k, size_t num)
+{
+    if (2 * k + 1 <= num)
+    {
+        /* Leftmost element of the right subtree */
+        k = 2 * k + 1;
+
+        while (2 * k <= num)
+        {
+            k *= 2;
+        }
+
+        return k;
+    }
+
+    /* Parent of the first ancestor which is a left child */
+    return arc_sset_unwind(k);
+}
+
+/******************************************************************************/
+
+static struct arc_sset * arc_sset_alloc(size_t data_size, arc_cmp_fn_t cmp_fn,
+                                        size_t num)
+{
+    struct arc_sset * sset = malloc(sizeof(struct arc_sset));
+    size_t offset;
+
+    if (sset == NULL)
+    {
+        return NULL;
+    }
+
+    /* Position 0 is not used */
+    sset->block = malloc((num + 1) * data_size + ARC_SSET_ALIGNMENT);
+
+    if (sset->block == NULL)
+    {
+        free(sset);
+        return NULL;
+    }
+
+    offset = ARC_SSET_ALIGNMENT - (size_t)sset->block % ARC_SSET_ALIGNMENT;
+
+    sset->size = num;
+    sset->data_size = data_size;
+    sset->cmp_fn = cmp_fn;
+    sset->data = (char *)sset->block + offset;
+
+    if (cmp_fn == &arc_cmp_int && data_size == sizeof(int))
+    {
+        sset->search_fn = &arc_sset_int_search;
+    }
+    else if (cmp_fn == &arc_cmp_long && data_size == sizeof(long))
+    {
+        sset->search_fn = &arc_sset_long_search;
+    }
+    else if (cmp_fn == &arc_cmp_double && data_size == sizeof(double))
+    {
+        sset->search_fn = &arc_sset_double_search;
+    }
+    else
+    {
+        sset->search_fn = &arc_sset_search;
+    }
+
+    return sset;
+}
+
+/******************************************************************************/
+
+struct arc_sset * arc_sset_create(size_t data_size, arc_cmp_fn_t cmp_fn,
+                                  const void * data, size_t num)
+{
+    struct arc_sset * sset = arc_sset_alloc(data_size, cmp_fn, num);
+    const char * src = data;
+    size_t k;
+
+    if (sset == NULL || num == 0)
+    {
+        return sset;
+    }
+
+    for (k = arc_sset_first(num); k != 0; k = arc_sset_next(k, num))
+    {
+        memcpy((char *)sset->data + k * data_size, src, data_size);
+        src += data_size;
+    }
+
+    return sset;
+}
+
+/******************************************************************************/
+
+struct arc_sset * arc_sset_create_from_darray(struct arc_darray * darray,
+                                              arc_cmp_fn_t cmp_fn)
+{
+    size_t num = darray->size;
+    size_t data_size = darray->data_size;
+    struct arc_sset * sset = arc_sset_alloc(data_size, cmp_fn, num);
+    unsigned long idx = 0;
+    size_t k;
+
+    if (sset == NULL || num == 0)
+    {
+        return sset;
+    }
+
+    for (k = arc_sset_first(num); k != 0; k = arc_sset_next(k, num))
+    {
+        memcpy((char *)sset->data + k * data_size,
+               arc_darray_at(darray, idx++), data_size);
+    }
+
+    return sset;
+}
+
+/******************************************************************************/
+
+struct arc_sset * arc_sset_create_from_avltree(struct arc_tree * tree)
+{
+    size_t num = tree->size;
+    size_t data_size = tree->data_size;
+    struct arc_sset * sset = arc_sset_alloc(data_size, tree->cmp_fn, num);
+    struct arc_tree_iterator it;
+    size_t k;
+
+    if (sset == NULL || num == 0)
+    {
+        return sset;
+    }
+
+    arc_tree_iterator_init(&it, tree);
+    arc_tree_before_begin(&it);
+
+    for (k = arc_sset_first(num); k != 0 && arc_tree_next(&it);
+         k = arc_sset_next(k, num))
+    {
+        memcpy((char *)sset->data + k * data_size, arc_tree_data(&it),
+               data_size);
+    }
+
+    arc_tree_iterator_fini(&it);
+
+    return sset;
+}
+
+/******************************************************************************/
+
+void arc_sset_destroy(struct arc_sset * sset)
+{
+    free(sset->block);
+    free(sset);
+}
+
+/******************************************************************************/
+
+size_t arc_sset_size(struct arc_sset * sset)
+{
+    return sset->size;
+}
+
+/******************************************************************************/
+
+void * arc_sset_retrieve(struct arc_sset * sset, const void * data)
+{
+    size_t k = (*sset->search_fn)(sset, data);
+    char * element = (char *)sset->data + k * sset->data_size;
+
+    if (k == 0 || arc_sset_compare(sset, element, data) != 0)
+    {
+        return NULL;
+    }
+
+    return element;
+}
+
+/******************************************************************************/
+
+void * arc_sset_lower_bound(struct arc_sset * sset, const void * data)
+{
+    size_t k = (*sset->search_fn)(sset, data);
+
+    if (k == 0)
+    {
+        return NULL;
+    }
+
+    return (char *)sset->data + k * sset->data_size;
+}
+
+/******************************************************************************/
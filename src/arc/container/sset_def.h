@@ -0,0 +1,44 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @file sset_def.h
+ * @author Anil M. Mahtani Mirchandani
+ * @date September, 2015
+ *
+ * @brief Static Set
+ */
+#ifndef ARC_SSET_DEF_H_
+#define ARC_SSET_DEF_H_
+
+#include <stdlib.h>
+#include <arc/type/function.h>
+
+/* The array is aligned to a cache line, so the descendants of an element are
+   in a single line when 64 is a multiple of the element size */
+#define ARC_SSET_ALIGNMENT 64
+/* The descendants this many levels below are prefetched */
+#define ARC_SSET_PREFETCH_LEVELS 4
+
+struct arc_sset;
+
+/* Returns the Eytzinger position of the lower bound, 0 if there is none */
+typedef size_t (*arc_sset_search_fn_t)(const struct arc_sset *, const void *);
+
+/* Container definition */
+struct arc_sset
+{
+    size_t size;
+    size_t data_size;
+    arc_cmp_fn_t cmp_fn;
+    arc_sset_search_fn_t search_fn; /**< Typed search if there is one */
+    void * data; /**< Element k is at data + k * data_size, k from 1 to size */
+    void * block; /**< Allocated memory holding the data */
+};
+
+#endif
@@ -15,6 +15,14 @@
 /******************************************************************************/
 
 int arc_stack_init(struct arc_stack *stack, size_t data_size)
+{
+    return arc_stack_init_with_allocator(stack, data_size, NULL);
+}
+
+/******************************************************************************/
+
+int arc_stack_init_with_allocator(struct arc_stack *stack, size_t data_size,
+                                  const struct arc_allocator *allocator)
 {
     size_t aligned_size;
 
@@ -31,6 +39,31 @@ int arc_stack_init(struct arc_stack *stack, size_t data_size)
     stack->top = NULL;
     stack->data_size = data_size;
     stack->node_size = aligned_size + sizeof(struct arc_stack_node);
+    stack->allocator = (allocator != NULL ? *allocator : arc_default_allocator);
+    stack->pool = NULL;
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+int arc_stack_init_pooled(struct arc_stack *stack, size_t data_size)
+{
+    int retval = arc_stack_init(stack, data_size);
+
+    if (retval != ARC_SUCCESS)
+    {
+        return retval;
+    }
+
+    stack->pool = arc_slab_create(stack->node_size);
+
+    if (stack->pool == NULL)
+    {
+        return ARC_OUT_OF_MEMORY;
+    }
+
+    arc_slab_get_allocator(stack->pool, &stack->allocator);
 
     return ARC_SUCCESS;
 }
@@ -40,13 +73,42 @@ int arc_stack_init(struct arc_stack *stack, size_t data_size)
 void arc_stack_fini(struct arc_stack *stack)
 {
     arc_stack_clear(stack);
+
+    if (stack->pool != NULL)
+    {
+        arc_slab_destroy(stack->pool);
+    }
 }
 
 /******************************************************************************/
 
 struct arc_stack * arc_stack_create(size_t data_size)
 {
+    return arc_stack_create_with_allocator(data_size, NULL);
+}
+
+/******************************************************************************/
+
+struct arc_stack *
+arc_stack_create_with_allocator(size_t data_size,
+                                const struct arc_allocator *allocator)
+{
+    struct arc_stack * stack = malloc(sizeof(struct arc_stack));
+
+    if (stack == NULL)
+    {
+        return NULL;
+    }
+
+    arc_stack_init_with_allocator(stack, data_size, allocator);
+
+    return stack;
+}
 
+/******************************************************************************/
+
+struct arc_stack * arc_stack_create_pooled(size_t data_size)
+{
     struct arc_stack * stack = malloc(sizeof(struct arc_stack));
 
     if (stack == NULL)
@@ -54,7 +116,11 @@ struct arc_stack * arc_stack_create(size_t data_size)
         return NULL;
     }
 
-    arc_stack_init(stack, data_size);
+    if (arc_stack_init_pooled(stack, data_size) != ARC_SUCCESS)
+    {
+        free(stack);
+        return NULL;
+    }
 
     return stack;
 }
@@ -71,7 +137,8 @@ void arc_stack_destroy(struct arc_stack * stack)
 
 int arc_stack_push(struct arc_stack * stack, void * data)
 {
-    struct arc_stack_node * node = malloc(stack->node_size);
+    struct arc_stack_node * node = ARC_ALLOC(&stack->allocator,
+                                             stack->node_size);
 
     if (node == NULL)
     {
@@ -100,7 +167,7 @@ void arc_stack_pop(struct arc_stack * stack)
 
         stack->size--;
 
-        free(node);
+        ARC_FREE(&stack->allocator, node);
     }
 }
 
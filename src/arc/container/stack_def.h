@@ -11,6 +11,8 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <arc/memory/allocator.h>
+#include <arc/memory/slab.h>
 
 /* Stack node definition, the data array is a placerholder for the first byte of
    the user memory, which will be allocated as extra space for the node */
@@ -29,9 +31,14 @@ struct arc_stack
     size_t size;
     size_t data_size;
     size_t node_size;
+    struct arc_allocator allocator; /**< Used for the nodes */
+    struct arc_slab *pool; /**< Node pool owned by the container or NULL */
 };
 
 int arc_stack_init(struct arc_stack *stack, size_t data_size);
+int arc_stack_init_with_allocator(struct arc_stack *stack, size_t data_size,
+                                  const struct arc_allocator *allocator);
+int arc_stack_init_pooled(struct arc_stack *stack, size_t data_size);
 void arc_stack_fini(struct arc_stack *stack);
 
 #endif
@@ -0,0 +1,578 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @file swtable.c
+ * @author Anil M. Mahtani Mirchandani
+ * @date August, 2015
+ *
+ * @brief SWTable
+ *
+ * @see https://abseil.io/about/design/swisstables
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <arc/common/defines.h>
+#include <arc/type/function.h>
+#include <arc/container/swtable.h>
+#include <arc/container/swtable_def.h>
+
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+
+/******************************************************************************/
+
+#define ARC_SWTABLE_SLOT(swtable, idx) \
+    ((char *)(swtable)->slots + (idx) * (swtable)->data_size)
+
+/* The table grows when it is 7/8 full */
+#define ARC_SWTABLE_GROWTH(capacity) ((capacity) - (capacity) / 8)
+
+/******************************************************************************/
+
+/* Group bit masks, bit i is set when the i-th control byte of the group
+   satisfies the condition */
+
+#ifdef __SSE2__
+
+static unsigned arc_swtable_match(const unsigned char *group, unsigned char h2)
+{
+    __m128i ctrl = _mm_loadu_si128((const __m128i *)(const void *)group);
+
+    return (unsigned)_mm_movemask_epi8(
+        _mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)h2)));
+}
+
+/******************************************************************************/
+
+static unsigned arc_swtable_match_empty(const unsigned char *group)
+{
+    return arc_swtable_match(group, ARC_SWTABLE_EMPTY);
+}
+
+/******************************************************************************/
+
+static unsigned arc_swtable_match_empty_or_deleted(const unsigned char *group)
+{
+    /* Both special values have the high bit set, full slots do not */
+    __m128i ctrl = _mm_loadu_si128((const __m128i *)(const void *)group);
+
+    return (unsigned)_mm_movemask_epi8(ctrl);
+}
+
+#else
+
+static unsigned arc_swtable_match(const unsigned char *group, unsigned char h2)
+{
+    unsigned i, mask = 0;
+
+    for (i = 0; i < ARC_SWTABLE_GROUP_SIZE; i++)
+    {
+        if (group[i] == h2)
+        {
+            mask |= 1U << i;
+        }
+    }
+
+    return mask;
+}
+
+/******************************************************************************/
+
+static unsigned arc_swtable_match_empty(const unsigned char *group)
+{
+    return arc_swtable_match(group, ARC_SWTABLE_EMPTY);
+}
+
+/******************************************************************************/
+
+static unsigned arc_swtable_match_empty_or_deleted(const unsigned char *group)
+{
+    unsigned i, mask = 0;
+
+    for (i = 0; i < ARC_SWTABLE_GROUP_SIZE; i++)
+    {
+        if (group[i] & 0x80)
+        {
+            mask |= 1U << i;
+        }
+    }
+
+    return mask;
+}
+
+#endif
+
+/******************************************************************************/
+
+/* Trailing and leading zeros of a non empty group mask */
+
+static unsigned arc_swtable_ctz(unsigned mask)
+{
+#ifdef __GNUC__
+    return (unsigned)__builtin_ctz(mask);
+#else
+    unsigned n = 0;
+
+    while (!(mask & 1U))
+    {
+        mask >>= 1;
+        n++;
+    }
+
+    return n;
+#endif
+}
+
+/******************************************************************************/
+
+static unsigned arc_swtable_clz(unsigned mask)
+{
+    unsigned n = 0;
+
+    while (!(mask & (1U << (ARC_SWTABLE_GROUP_SIZE - 1))))
+    {
+        mask <<= 1;
+        n++;
+    }
+
+    return n;
+}
+
+/******************************************************************************/
+
+/* The user hash is mixed so that both the probe start (h1) and the tag (h2)
+   depend on all of its bits */
+static arc_hkey_t arc_swtable_mix(arc_hkey_t h)
+{
+#if ULONG_MAX > 0xFFFFFFFFUL
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDUL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53UL;
+    h ^= h >> 33;
+#else
+    h ^= h >> 16;
+    h *= 0x85EBCA6BUL;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35UL;
+    h ^= h >> 16;
+#endif
+    return h;
+}
+
+/******************************************************************************/
+
+static int arc_swtable_equal(struct arc_swtable *swtable,
+                             const void *a, const void *b)
+{
+    if (swtable->cmp_fn == NULL)
+    {
+        return memcmp(a, b, swtable->data_size) == 0;
+    }
+
+    return (*swtable->cmp_fn)(a, b) == 0;
+}
+
+/******************************************************************************/
+
+static void arc_swtable_set_ctrl(struct arc_swtable *swtable,
+                                 size_t idx, unsigned char value)
+{
+    swtable->ctrl[idx] = value;
+
+    /* Keep the mirrored bytes at the end of the array in sync */
+    if (idx < ARC_SWTABLE_GROUP_SIZE)
+    {
+        swtable->ctrl[swtable->capacity + idx] = value;
+    }
+}
+
+/******************************************************************************/
+
+/* Returns the index of the element or capacity when it is not found */
+static size_t arc_swtable_find(struct arc_swtable *swtable,
+                               arc_hkey_t hash, const void *data)
+{
+    size_t mask = swtable->capacity - 1;
+    size_t pos = (size_t)(hash >> 7) & mask;
+    size_t step = 0;
+    unsigned char h2 = (unsigned char)(hash & 0x7F);
+
+    for (;;)
+    {
+        const unsigned char *group = swtable->ctrl + pos;
+        unsigned match = arc_swtable_match(group, h2);
+
+        while (match)
+        {
+            size_t idx = (pos + arc_swtable_ctz(match)) & mask;
+
+            if (arc_swtable_equal(swtable, ARC_SWTABLE_SLOT(swtable, idx), data))
+            {
+                return idx;
+            }
+
+            match &= match - 1;
+        }
+
+        /* An empty slot ends the probe sequence */
+        if (arc_swtable_match_empty(group))
+        {
+            return swtable->capacity;
+        }
+
+        /* Triangular probing visits every group when the number of groups
+           is a power of two */
+        step += ARC_SWTABLE_GROUP_SIZE;
+        pos = (pos + step) & mask;
+    }
+}
+
+/******************************************************************************/
+
+static size_t arc_swtable_find_first_non_full(struct arc_swtable *swtable,
+                                              arc_hkey_t hash)
+{
+    size_t mask = swtable->capacity - 1;
+    size_t pos = (size_t)(hash >> 7) & mask;
+    size_t step = 0;
+
+    for (;;)
+    {
+        unsigned match =
+            arc_swtable_match_empty_or_deleted(swtable->ctrl + pos);
+
+        if (match)
+        {
+            return (pos + arc_swtable_ctz(match)) & mask;
+        }
+
+        step += ARC_SWTABLE_GROUP_SIZE;
+        pos = (pos + step) & mask;
+    }
+}
+
+/******************************************************************************/
+
+static size_t arc_swtable_capacity_for(size_t size)
+{
+    size_t capacity = ARC_SWTABLE_GROUP_SIZE;
+
+    while (ARC_SWTABLE_GROWTH(capacity) < size)
+    {
+        capacity <<= 1;
+    }
+
+    return capacity;
+}
+
+/******************************************************************************/
+
+static int arc_swtable_alloc(struct arc_swtable *swtable, size_t capacity)
+{
+    unsigned char *ctrl;
+    void *slots = ARC_ALLOC(&swtable->allocator,
+                            capacity * swtable->data_size);
+
+    if (slots == NULL)
+    {
+        return ARC_OUT_OF_MEMORY;
+    }
+
+    ctrl = ARC_ALLOC(&swtable->allocator, capacity + ARC_SWTABLE_GROUP_SIZE);
+
+    if (ctrl == NULL)
+    {
+        ARC_FREE(&swtable->allocator, slots);
+        return ARC_OUT_OF_MEMORY;
+    }
+
+    memset(ctrl, ARC_SWTABLE_EMPTY, capacity + ARC_SWTABLE_GROUP_SIZE);
+
+    swtable->ctrl = ctrl;
+    swtable->slots = slots;
+    swtable->capacity = capacity;
+    swtable->growth_left = ARC_SWTABLE_GROWTH(capacity) - swtable->size;
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+static int arc_swtable_resize(struct arc_swtable *swtable, size_t capacity)
+{
+    size_t i;
+    int retval;
+    unsigned char *old_ctrl = swtable->ctrl;
+    void *old_slots = swtable->slots;
+    size_t old_capacity = swtable->capacity;
+
+    retval = arc_swtable_alloc(swtable, capacity);
+
+    if (retval != ARC_SUCCESS)
+    {
+        return retval;
+    }
+
+    /* The elements are known to be unique so they are placed on the first
+       free slot without any comparison */
+    for (i = 0; i < old_capacity; i++)
+    {
+        if (!(old_ctrl[i] & 0x80))
+        {
+            const void *data = (char *)old_slots + i * swtable->data_size;
+            arc_hkey_t hash = arc_swtable_mix(
+                (*swtable->hash_fn)(data, swtable->data_size));
+            size_t idx = arc_swtable_find_first_non_full(swtable, hash);
+
+            arc_swtable_set_ctrl(swtable, idx, (unsigned char)(hash & 0x7F));
+            memcpy(ARC_SWTABLE_SLOT(swtable, idx), data, swtable->data_size);
+        }
+    }
+
+    ARC_FREE(&swtable->allocator, old_ctrl);
+    ARC_FREE(&swtable->allocator, old_slots);
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+static int arc_swtable_rehash_and_grow(struct arc_swtable *swtable)
+{
+    /* If most of the used slots are tombstones the table is rebuilt with the
+       same capacity, otherwise it doubles its size */
+    if (swtable->size <= swtable->capacity * 25 / 32)
+    {
+        return arc_swtable_resize(swtable, swtable->capacity);
+    }
+
+    return arc_swtable_resize(swtable, swtable->capacity * 2);
+}
+
+/******************************************************************************/
+
+int arc_swtable_init(struct arc_swtable *swtable,
+                     size_t capacity,
+                     size_t data_size,
+                     arc_cmp_fn_t cmp_fn,
+                     arc_hash_fn_t hash_fn)
+{
+    return arc_swtable_init_with_allocator(swtable, capacity, data_size,
+                                           cmp_fn, hash_fn, NULL);
+}
+
+/******************************************************************************/
+
+int arc_swtable_init_with_allocator(struct arc_swtable *swtable,
+                                    size_t capacity,
+                                    size_t data_size,
+                                    arc_cmp_fn_t cmp_fn,
+                                    arc_hash_fn_t hash_fn,
+                                    const struct arc_allocator *allocator)
+{
+    swtable->allocator = (allocator != NULL ? *allocator
+                                            : arc_default_allocator);
+    swtable->size = 0;
+    swtable->data_size = data_size;
+    swtable->cmp_fn = cmp_fn;
+    swtable->hash_fn = hash_fn;
+
+    return arc_swtable_alloc(swtable, arc_swtable_capacity_for(capacity));
+}
+
+/******************************************************************************/
+
+void arc_swtable_fini(struct arc_swtable *swtable)
+{
+    ARC_FREE(&swtable->allocator, swtable->ctrl);
+    ARC_FREE(&swtable->allocator, swtable->slots);
+}
+
+/******************************************************************************/
+
+struct arc_swtable * arc_swtable_create(size_t capacity,
+                                        size_t data_size,
+                                        arc_cmp_fn_t cmp_fn,
+                                        arc_hash_fn_t hash_fn)
+{
+    return arc_swtable_create_with_allocator(capacity, data_size,
+                                             cmp_fn, hash_fn, NULL);
+}
+
+/******************************************************************************/
+
+struct arc_swtable *
+arc_swtable_create_with_allocator(size_t capacity,
+                                  size_t data_size,
+                                  arc_cmp_fn_t cmp_fn,
+                                  arc_hash_fn_t hash_fn,
+                                  const struct arc_allocator *allocator)
+{
+    struct arc_swtable * swtable = malloc(sizeof(struct arc_swtable));
+
+    if (swtable == NULL)
+    {
+        return swtable;
+    }
+
+    if (arc_swtable_init_with_allocator(swtable, capacity, data_size,
+                                        cmp_fn, hash_fn,
+                                        allocator) != ARC_SUCCESS)
+    {
+        free(swtable);
+        return NULL;
+    }
+
+    return swtable;
+}
+
+/******************************************************************************/
+
+void arc_swtable_destroy(struct arc_swtable * swtable)
+{
+    arc_swtable_fini(swtable);
+    free(swtable);
+}
+
+/******************************************************************************/
+
+int arc_swtable_insert(struct arc_swtable *swtable, const void *data)
+{
+    size_t idx;
+    arc_hkey_t hash = arc_swtable_mix(
+        (*swtable->hash_fn)(data, swtable->data_size));
+
+    if (arc_swtable_find(swtable, hash, data) != swtable->capacity)
+    {
+        return ARC_DUPLICATE;
+    }
+
+    idx = arc_swtable_find_first_non_full(swtable, hash);
+
+    /* Reusing a deleted slot does not consume growth */
+    if (swtable->growth_left == 0 &&
+        swtable->ctrl[idx] != ARC_SWTABLE_DELETED)
+    {
+        int retval = arc_swtable_rehash_and_grow(swtable);
+
+        if (retval != ARC_SUCCESS)
+        {
+            return retval;
+        }
+
+        idx = arc_swtable_find_first_non_full(swtable, hash);
+    }
+
+    if (swtable->ctrl[idx] == ARC_SWTABLE_EMPTY)
+    {
+        swtable->growth_left--;
+    }
+
+    arc_swtable_set_ctrl(swtable, idx, (unsigned char)(hash & 0x7F));
+    memcpy(ARC_SWTABLE_SLOT(swtable, idx), data, swtable->data_size);
+    swtable->size++;
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+void * arc_swtable_retrieve(struct arc_swtable *swtable, const void *data)
+{
+    arc_hkey_t hash = arc_swtable_mix(
+        (*swtable->hash_fn)(data, swtable->data_size));
+    size_t idx = arc_swtable_find(swtable, hash, data);
+
+    if (idx == swtable->capacity)
+    {
+        return NULL;
+    }
+
+    return ARC_SWTABLE_SLOT(swtable, idx);
+}
+
+/******************************************************************************/
+
+void arc_swtable_remove(struct arc_swtable *swtable, const void *data)
+{
+    size_t idx, idx_before;
+    unsigned empty_before, empty_after;
+    arc_hkey_t hash = arc_swtable_mix(
+        (*swtable->hash_fn)(data, swtable->data_size));
+
+    idx = arc_swtable_find(swtable, hash, data);
+
+    if (idx == swtable->capacity)
+    {
+        return;
+    }
+
+    swtable->size--;
+
+    /* If no group containing the slot was ever seen full by a probe, the slot
+       can be marked as empty instead of leaving a tombstone behind */
+    idx_before = (idx - ARC_SWTABLE_GROUP_SIZE) & (swtable->capacity - 1);
+    empty_before = arc_swtable_match_empty(swtable->ctrl + idx_before);
+    empty_after = arc_swtable_match_empty(swtable->ctrl + idx);
+
+    if (empty_before && empty_after &&
+        arc_swtable_clz(empty_before) + arc_swtable_ctz(empty_after) <
+        ARC_SWTABLE_GROUP_SIZE)
+    {
+        arc_swtable_set_ctrl(swtable, idx, ARC_SWTABLE_EMPTY);
+        swtable->growth_left++;
+    }
+    else
+    {
+        arc_swtable_set_ctrl(swtable, idx, ARC_SWTABLE_DELETED);
+    }
+}
+
+/******************************************************************************/
+
+int arc_swtable_empty(struct arc_swtable * swtable)
+{
+    return swtable->size == 0;
+}
+
+/******************************************************************************/
+
+size_t arc_swtable_size(struct arc_swtable * swtable)
+{
+    return swtable->size;
+}
+
+/******************************************************************************/
+
+void arc_swtable_clear(struct arc_swtable * swtable)
+{
+    memset(swtable->ctrl, ARC_SWTABLE_EMPTY,
+           swtable->capacity + ARC_SWTABLE_GROUP_SIZE);
+
+    swtable->size = 0;
+    swtable->growth_left = ARC_SWTABLE_GROWTH(swtable->capacity);
+}
+
+/******************************************************************************/
+
+int arc_swtable_rehash(struct arc_swtable * swtable, size_t capacity)
+{
+    if (capacity < swtable->size)
+    {
+        capacity = swtable->size;
+    }
+
+    return arc_swtable_resize(swtable, arc_swtable_capacity_for(capacity));
+}
+
+/******************************************************************************/
@@ -0,0 +1,64 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @file swtable.c
+ * @author Anil M. Mahtani Mirchandani
+ * @date August, 2015
+ *
+ * @brief SWTable
+ *
+ * @see https://abseil.io/about/design/swisstables
+ */
+#ifndef ARC_SWTABLE_DEF_H_
+#define ARC_SWTABLE_DEF_H_
+
+#include <stdlib.h>
+#include <arc/type/function.h>
+#include <arc/container/swtable.h>
+#include <arc/memory/allocator.h>
+
+/* Number of control bytes checked at once */
+#define ARC_SWTABLE_GROUP_SIZE 16
+
+/* Control byte values, a full slot stores the lower 7 bits of the hash */
+#define ARC_SWTABLE_EMPTY   0x80
+#define ARC_SWTABLE_DELETED 0xFE
+
+/* Container definition, the control array has GROUP_SIZE extra bytes at the
+   end which mirror the first ones so that a group can always be loaded from
+   any position without wrapping around */
+struct arc_swtable
+{
+    size_t size;
+    size_t capacity; /**< Number of slots, always a power of two */
+    size_t growth_left; /**< Insertions left until the table has to grow */
+    size_t data_size;
+    arc_cmp_fn_t cmp_fn;
+    arc_hash_fn_t hash_fn;
+    unsigned char *ctrl;
+    void *slots;
+    struct arc_allocator allocator; /**< Used for the control and slot arrays */
+};
+
+int arc_swtable_init(struct arc_swtable *swtable,
+                     size_t capacity,
+                     size_t data_size,
+                     arc_cmp_fn_t cmp_fn,
+                     arc_hash_fn_t hash_fn);
+
+int arc_swtable_init_with_allocator(struct arc_swtable *swtable,
+                                    size_t capacity,
+                                    size_t data_size,
+                                    arc_cmp_fn_t cmp_fn,
+                                    arc_hash_fn_t hash_fn,
+                                    const struct arc_allocator *allocator);
+
+void arc_swtable_fini(struct arc_swtable *swtable);
+
+#endif
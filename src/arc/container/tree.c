@@ -22,7 +22,8 @@ int arc_tree_init(struct arc_tree *tree,
                   size_t node_size, 
                   arc_tree_insert_fn_t insert_fn,
                   arc_tree_remove_fn_t remove_fn,
-                  arc_cmp_fn_t cmp_fn)
+                  arc_cmp_fn_t cmp_fn,
+                  const struct arc_allocator *allocator)
 {
     /* The aligned size is the current size of the data block including the
        space occupied by the alignment */
@@ -34,6 +35,8 @@ int arc_tree_init(struct arc_tree *tree,
     tree->cmp_fn = cmp_fn;
     tree->insert_fn = insert_fn;
     tree->remove_fn = remove_fn;
+    tree->allocator = (allocator != NULL ? *allocator : arc_default_allocator);
+    tree->pool = NULL;
 
     tree->front.parent = NULL;
     tree->front.left = NULL;
@@ -63,11 +66,35 @@ struct arc_tree_snode ** arc_tree_node_ref(struct arc_tree *tree,
 }
 
 
+/******************************************************************************/
+
+int arc_tree_init_pool(struct arc_tree *tree)
+{
+    tree->pool = arc_slab_create(tree->node_size);
+
+    if (tree->pool == NULL)
+    {
+        return ARC_OUT_OF_MEMORY;
+    }
+
+    arc_slab_get_allocator(tree->pool, &tree->allocator);
+
+    return ARC_SUCCESS;
+}
+
 /******************************************************************************/
 
 void arc_tree_fini(struct arc_tree *tree)
 {
-    arc_tree_clear(tree);
+    /* The nodes of a pooled tree go away with the pool */
+    if (tree->pool != NULL)
+    {
+        arc_slab_destroy(tree->pool);
+    }
+    else
+    {
+        arc_tree_clear(tree);
+    }
 }
 
 /******************************************************************************/
@@ -77,7 +104,8 @@ struct arc_tree * arc_tree_create(size_t data_size,
                                   size_t node_size, 
                                   arc_tree_insert_fn_t insert_fn,
                                   arc_tree_remove_fn_t remove_fn,
-                                  arc_cmp_fn_t cmp_fn)
+                                  arc_cmp_fn_t cmp_fn,
+                                  const struct arc_allocator *allocator)
 {
     struct arc_tree * tree = malloc(sizeof(struct arc_tree));
 
@@ -88,7 +116,7 @@ struct arc_tree * arc_tree_create(size_t data_size,
 
     arc_tree_init(tree,
                   data_size, data_offset, node_size,
-                  insert_fn, remove_fn, cmp_fn);
+                  insert_fn, remove_fn, cmp_fn, allocator);
 
     return tree;
 }
@@ -173,6 +201,20 @@ int arc_tree_insert(struct arc_tree *tree, const void * data)
      return (*tree->insert_fn)(tree, data);
 }
 
+/******************************************************************************/
+
+static int arc_tree_compare(struct arc_tree *tree,
+                            struct arc_tree_snode *node, const void * data)
+{
+    void * node_data = (void *)((char *)node + tree->data_offset);
+
+    if (tree->cmp_fn == NULL) {
+        return memcmp(node_data, data, tree->data_size);
+    }
+
+    return (*tree->cmp_fn)(node_data, data);
+}
+
 /******************************************************************************/
 /**
  * @brief Finds and returns a node in the tree
@@ -189,20 +231,13 @@ static struct arc_tree_snode * arc_tree_find_node(struct arc_tree *tree,
 
     while (node != NULL)
     {
-        void * node_data = (void *)((char *)node + tree->data_offset);
-        int cmp_result;
-       
-        if (tree->cmp_fn == NULL) {
-            cmp_result = memcmp(node_data, data, tree->data_size);
-        } else {
-            cmp_result = (*tree->cmp_fn)(node_data, data);
-        }
+        int cmp_result = arc_tree_compare(tree, node, data);
 
-        if (cmp_result == -1)
+        if (cmp_result < 0)
         {
             node = node->right;
         }
-        else if (cmp_result == 1)
+        else if (cmp_result > 0)
         {
             node = node->left;
         }
@@ -223,6 +258,84 @@ void *arc_tree_retrieve(struct arc_tree *tree, const void * data)
     return (node == NULL ? NULL : (void *)((char *)node + tree->data_offset));
 }
 
+/******************************************************************************/
+/**
+ * @brief Looks up several elements at once
+ *
+ * The descents of a group of keys are interleaved one level at a time, and
+ * the next node of every descent is prefetched before the other keys of the
+ * group are compared, so the cache misses of the whole group overlap instead
+ * of being paid one after the other.
+ */
+size_t arc_tree_retrieve_batch(struct arc_tree *tree, const void *keys,
+                               size_t n, void **results)
+{
+    size_t i, base, found = 0;
+    struct arc_tree_snode *nodes[ARC_TREE_BATCH_SIZE];
+
+    for (base = 0; base < n; base += ARC_TREE_BATCH_SIZE)
+    {
+        size_t count = n - base;
+        size_t active;
+
+        if (count > ARC_TREE_BATCH_SIZE)
+        {
+            count = ARC_TREE_BATCH_SIZE;
+        }
+
+        for (i = 0; i < count; i++)
+        {
+            nodes[i] = tree->root;
+            results[base + i] = NULL;
+        }
+
+        active = (tree->root != NULL ? count : 0);
+
+        while (active > 0)
+        {
+            active = 0;
+
+            for (i = 0; i < count; i++)
+            {
+                const void *key;
+                int cmp_result;
+
+                if (nodes[i] == NULL)
+                {
+                    continue;
+                }
+
+                key = (const char *)keys + (base + i) * tree->data_size;
+                cmp_result = arc_tree_compare(tree, nodes[i], key);
+
+                if (cmp_result < 0)
+                {
+                    nodes[i] = nodes[i]->right;
+                }
+                else if (cmp_result > 0)
+                {
+                    nodes[i] = nodes[i]->left;
+                }
+                else
+                {
+                    results[base + i] = (char *)nodes[i] + tree->data_offset;
+                    nodes[i] = NULL;
+                    found++;
+                    continue;
+                }
+
+                if (nodes[i] != NULL)
+                {
+                    ARC_PREFETCH(nodes[i]);
+                    active++;
+                }
+            }
+        }
+    }
+
+    return found;
+}
+
 /******************************************************************************/
 
 void arc_tree_remove(struct arc_tree *tree, const void * data)
@@ -257,9 +370,45 @@ size_t arc_tree_size(struct arc_tree * tree)
 
 void arc_tree_clear(struct arc_tree *tree)
 {
-    while (tree->root != NULL)
+    struct arc_tree_snode *node = tree->root;
+
+    if (tree->pool != NULL)
     {
-        (*tree->remove_fn)(tree, tree->root);
+        arc_slab_clear(tree->pool);
+        node = NULL;
+    }
+
+    /* The nodes are released in post-order without rebalancing, every leaf is
+       unlinked from its parent so that the parent becomes a leaf itself */
+    while (node != NULL)
+    {
+        if (node->left != NULL)
+        {
+            node = node->left;
+        }
+        else if (node->right != NULL)
+        {
+            node = node->right;
+        }
+        else
+        {
+            struct arc_tree_snode *parent = node->parent;
+
+            if (parent != NULL)
+            {
+                if (parent->left == node)
+                {
+                    parent->left = NULL;
+                }
+                else
+                {
+                    parent->right = NULL;
+                }
+            }
+
+            ARC_FREE(&tree->allocator, node);
+            node = parent;
+        }
     }
 
     tree->root = NULL;
@@ -485,6 +634,99 @@ int arc_tree_position(struct arc_tree_iterator * it, const void * data)
     return (node != NULL);
 }
 
+/******************************************************************************/
+
+/* First node whose data is greater than the key, or not less than it if
+   inclusive is set */
+static struct arc_tree_snode * arc_tree_find_bound(struct arc_tree *tree,
+                                                   const void * data,
+                                                   int inclusive)
+{
+    struct arc_tree_snode *node = tree->root;
+    struct arc_tree_snode *bound = NULL;
+
+    while (node != NULL)
+    {
+        int cmp_result = arc_tree_compare(tree, node, data);
+
+        if (cmp_result < 0 || (cmp_result == 0 && !inclusive))
+        {
+            node = node->right;
+        }
+        else
+        {
+            bound = node;
+            node = node->left;
+        }
+    }
+
+    return bound;
+}
+
+/******************************************************************************/
+
+/* Sets the iterator to the node, or after the end if there is none */
+static int arc_tree_position_node(struct arc_tree_iterator * it,
+                                  struct arc_tree_snode * node)
+{
+    if (node == NULL)
+    {
+        arc_tree_after_end(it);
+        return 0;
+    }
+
+    it->node_ptr = node;
+
+    return 1;
+}
+
+/******************************************************************************/
+
+int arc_tree_lower_bound(struct arc_tree_iterator * it, const void * data)
+{
+    struct arc_tree * tree = it->container;
+
+    return arc_tree_position_node(it, arc_tree_find_bound(tree, data, 1));
+}
+
+/******************************************************************************/
+
+int arc_tree_upper_bound(struct arc_tree_iterator * it, const void * data)
+{
+    struct arc_tree * tree = it->container;
+
+    return arc_tree_position_node(it, arc_tree_find_bound(tree, data, 0));
+}
+
+/******************************************************************************/
+
+int arc_tree_range(struct arc_tree_iterator * it, const void * first,
+                   const void * last)
+{
+    struct arc_tree * tree = it->container;
+
+    if (!arc_tree_lower_bound(it, first))
+    {
+        return 0;
+    }
+
+    return arc_tree_compare(tree, it->node_ptr, last) < 0;
+}
+
+/******************************************************************************/
+
+int arc_tree_range_next(struct arc_tree_iterator * it, const void * last)
+{
+    struct arc_tree * tree = it->container;
+
+    if (!arc_tree_next(it))
+    {
+        return 0;
+    }
+
+    return arc_tree_compare(tree, it->node_ptr, last) < 0;
+}
+
 /******************************************************************************/
 void arc_tree_erase(struct arc_tree_iterator * it)
 {
@@ -11,6 +11,11 @@
 
 #include <stdlib.h>
 #include <arc/type/function.h>
+#include <arc/memory/allocator.h>
+#include <arc/memory/slab.h>
+
+/* Number of lookups interleaved by the batched retrieval */
+#define ARC_TREE_BATCH_SIZE 16
 
 /* Sentinel node definition */
 struct arc_tree_snode
@@ -42,6 +47,8 @@ struct arc_tree
     arc_cmp_fn_t cmp_fn;
     arc_tree_insert_fn_t insert_fn;
     arc_tree_remove_fn_t remove_fn;
+    struct arc_allocator allocator; /**< Used for the nodes */
+    struct arc_slab *pool; /**< Node pool owned by the container or NULL */
 };
 /**
  * @struct arc_tree_iterator
@@ -59,8 +66,20 @@ int arc_tree_init(struct arc_tree *tree,
                   size_t node_size, 
                   arc_tree_insert_fn_t insert_fn,
                   arc_tree_remove_fn_t remove_fn,
-                  arc_cmp_fn_t cmp_fn);
+                  arc_cmp_fn_t cmp_fn,
+                  const struct arc_allocator *allocator);
 
+/**
+ * @brief Makes the tree allocate its nodes from its own pool
+ *
+ * It has to be called right after the initialization, while the tree is
+ * still empty.
+ *
+ * @param[in] tree Tree to perform the operation on
+ * @retval ARC_SUCCESS If the pool was created successfully
+ * @retval ARC_OUT_OF_MEMORY If memory could not be allocated
+ */
+int arc_tree_init_pool(struct arc_tree *tree);
 
 void arc_tree_fini(struct arc_tree *tree);
 
@@ -69,7 +88,8 @@ struct arc_tree * arc_tree_create(size_t data_size,
                                   size_t node_size, 
                                   arc_tree_insert_fn_t insert_fn,
                                   arc_tree_remove_fn_t remove_fn,
-                                  arc_cmp_fn_t cmp_fn);
+                                  arc_cmp_fn_t cmp_fn,
+                                  const struct arc_allocator *allocator);
 
 
 void arc_tree_destroy(struct arc_tree *tree);
@@ -96,6 +116,9 @@ int arc_tree_insert(struct arc_tree *tree, const void * data);
 
 void *arc_tree_retrieve(struct arc_tree *tree, const void * data);
 
+size_t arc_tree_retrieve_batch(struct arc_tree *tree, const void *keys,
+                               size_t n, void **results);
+
 void arc_tree_remove(struct arc_tree *tree, const void * data);
 
 int arc_tree_empty(struct arc_tree * tree);
@@ -129,6 +152,15 @@ void * arc_tree_data(struct arc_tree_iterator * it);
 
 int arc_tree_position(struct arc_tree_iterator * it, const void * data);
 
+int arc_tree_lower_bound(struct arc_tree_iterator * it, const void * data);
+
+int arc_tree_upper_bound(struct arc_tree_iterator * it, const void * data);
+
+int arc_tree_range(struct arc_tree_iterator * it, const void * first,
+                   const void * last);
+
+int arc_tree_range_next(struct arc_tree_iterator * it, const void * last);
+
 void arc_tree_erase(struct arc_tree_iterator * it);
 
 #endif
@@ -0,0 +1,51 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @file allocator.c
+ * @author Anil M. Mahtani Mirchandani
+ * @date September, 2015
+ */
+#include <stdlib.h>
+#include <arc/common/defines.h>
+#include <arc/memory/allocator.h>
+
+/******************************************************************************/
+
+static void * arc_default_alloc(void *ctx, size_t size)
+{
+    ARC_UNUSED(ctx);
+    return malloc(size);
+}
+
+/******************************************************************************/
+
+static void arc_default_free(void *ctx, void *ptr)
+{
+    ARC_UNUSED(ctx);
+    free(ptr);
+}
+
+/******************************************************************************/
+
+static void * arc_default_realloc(void *ctx, void *ptr, size_t size)
+{
+    ARC_UNUSED(ctx);
+    return realloc(ptr, size);
+}
+
+/******************************************************************************/
+
+const struct arc_allocator arc_default_allocator = {
+    &arc_default_alloc,
+    &arc_default_free,
+    &arc_default_realloc,
+    NULL
+};
+
+/******************************************************************************/
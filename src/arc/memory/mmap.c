@@ -0,0 +1,166 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @file mmap.c
+ * @author Anil M. Mahtani Mirchandani
+ * @date September, 2015
+ *
+ * @brief Allocators based on anonymous memory mappings
+ */
+/* mremap and the anonymous mappings are extensions */
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <arc/common/defines.h>
+#include <arc/memory/allocator.h>
+
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+# define MAP_ANONYMOUS MAP_ANON
+#endif
+
+/* Every mapping starts with its length, needed to unmap it */
+union arc_mmap_header
+{
+    size_t length;
+    void *p;
+    long l;
+    double d;
+};
+
+static int arc_mmap_huge_pages = 1;
+
+/******************************************************************************/
+
+static size_t arc_mmap_length(size_t size)
+{
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    size_t length = size + sizeof(union arc_mmap_header);
+
+    return (length + page_size - 1) / page_size * page_size;
+}
+
+/******************************************************************************/
+
+static void arc_mmap_advise(void *ctx, void *addr, size_t length)
+{
+#ifdef MADV_HUGEPAGE
+    if (ctx != NULL)
+    {
+        /* It's only a hint, the mapping is valid even if it's refused */
+        madvise(addr, length, MADV_HUGEPAGE);
+    }
+#else
+    ARC_UNUSED(ctx);
+    ARC_UNUSED(addr);
+    ARC_UNUSED(length);
+#endif
+}
+
+/******************************************************************************/
+
+static void * arc_mmap_alloc(void *ctx, size_t size)
+{
+    size_t length = arc_mmap_length(size);
+    union arc_mmap_header *header = mmap(NULL, length,
+                                         PROT_READ | PROT_WRITE,
+                                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (header == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    arc_mmap_advise(ctx, header, length);
+    header->length = length;
+
+    return header + 1;
+}
+
+/******************************************************************************/
+
+static void arc_mmap_free(void *ctx, void *ptr)
+{
+    union arc_mmap_header *header = (union arc_mmap_header *)ptr - 1;
+
+    ARC_UNUSED(ctx);
+    munmap(header, header->length);
+}
+
+/******************************************************************************/
+
+static void * arc_mmap_realloc(void *ctx, void *ptr, size_t size)
+{
+    union arc_mmap_header *header, *new_header;
+    size_t length;
+
+    if (ptr == NULL)
+    {
+        return arc_mmap_alloc(ctx, size);
+    }
+
+    header = (union arc_mmap_header *)ptr - 1;
+    length = arc_mmap_length(size);
+
+    if (length == header->length)
+    {
+        return ptr;
+    }
+
+#ifdef MREMAP_MAYMOVE
+    /* The mapping is extended in place if the address space after it is
+       free, otherwise the pages are moved without copying them */
+    new_header = mremap(header, header->length, length, MREMAP_MAYMOVE);
+
+    if (new_header == MAP_FAILED)
+    {
+        return NULL;
+    }
+#else
+    new_header = arc_mmap_alloc(ctx, size);
+
+    if (new_header == NULL)
+    {
+        return NULL;
+    }
+
+    new_header--;
+    memcpy(new_header + 1, header + 1,
+           (length < header->length ? length : header->length) -
+           sizeof(union arc_mmap_header));
+    munmap(header, header->length);
+#endif
+
+    arc_mmap_advise(ctx, new_header, length);
+    new_header->length = length;
+
+    return new_header + 1;
+}
+
+/******************************************************************************/
+
+const struct arc_allocator arc_mmap_allocator = {
+    &arc_mmap_alloc,
+    &arc_mmap_free,
+    &arc_mmap_realloc,
+    NULL
+};
+
+/******************************************************************************/
+
+const struct arc_allocator arc_mmap_huge_allocator = {
+    &arc_mmap_alloc,
+    &arc_mmap_free,
+    &arc_mmap_realloc,
+    &arc_mmap_huge_pages
+};
+
+/******************************************************************************/
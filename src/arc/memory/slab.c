@@ -0,0 +1,287 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @file slab.c
+ * @author Anil M. Mahtani Mirchandani
+ * @date September, 2015
+ *
+ * @brief Slab
+ */
+#include <limits.h>
+#include <stdlib.h>
+#include <arc/common/defines.h>
+#include <arc/memory/slab.h>
+#include <arc/memory/slab_def.h>
+
+/******************************************************************************/
+
+int arc_slab_init(struct arc_slab *slab, size_t object_size)
+{
+    size_t align = sizeof(union arc_slab_align);
+
+    /* Released objects have to be able to hold the free list link */
+    if (object_size < sizeof(struct arc_slab_free_node))
+    {
+        object_size = sizeof(struct arc_slab_free_node);
+    }
+
+    slab->object_size = (object_size + align - 1) / align * align;
+    slab->chunk_objects = ARC_SLAB_MIN_OBJECTS;
+
+    if (slab->chunk_objects * slab->object_size > ARC_SLAB_MAX_CHUNK_SIZE)
+    {
+        slab->chunk_objects = ARC_SLAB_MAX_CHUNK_SIZE / slab->object_size;
+
+        if (slab->chunk_objects == 0)
+        {
+            slab->chunk_objects = 1;
+        }
+    }
+
+    slab->free_list = NULL;
+    slab->chunks = NULL;
+    slab->next = NULL;
+    slab->end = NULL;
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+void arc_slab_fini(struct arc_slab *slab)
+{
+    union arc_slab_chunk *chunk = slab->chunks;
+
+    while (chunk != NULL)
+    {
+        union arc_slab_chunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+}
+
+/******************************************************************************/
+
+struct arc_slab * arc_slab_create(size_t object_size)
+{
+    struct arc_slab * slab = malloc(sizeof(struct arc_slab));
+
+    if (slab == NULL)
+    {
+        return NULL;
+    }
+
+    if (arc_slab_init(slab, object_size) != ARC_SUCCESS)
+    {
+        free(slab);
+        return NULL;
+    }
+
+    return slab;
+}
+
+/******************************************************************************/
+
+void arc_slab_destroy(struct arc_slab *slab)
+{
+    arc_slab_fini(slab);
+    free(slab);
+}
+
+/******************************************************************************/
+
+static int arc_slab_grow(struct arc_slab *slab)
+{
+    size_t chunk_size = slab->chunk_objects * slab->object_size;
+    union arc_slab_chunk *chunk = malloc(sizeof(union arc_slab_chunk) +
+                                         chunk_size);
+
+    if (chunk == NULL)
+    {
+        return ARC_OUT_OF_MEMORY;
+    }
+
+    chunk->next = slab->chunks;
+    slab->chunks = chunk;
+
+    slab->next = (char *)(chunk + 1);
+    slab->end = slab->next + chunk_size;
+
+    if (chunk_size * 2 <= ARC_SLAB_MAX_CHUNK_SIZE)
+    {
+        slab->chunk_objects *= 2;
+    }
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+void * arc_slab_alloc(struct arc_slab *slab)
+{
+    void *ptr;
+
+    if (slab->free_list != NULL)
+    {
+        ptr = slab->free_list;
+        slab->free_list = slab->free_list->next;
+
+        return ptr;
+    }
+
+    if (slab->next == slab->end && arc_slab_grow(slab) != ARC_SUCCESS)
+    {
+        return NULL;
+    }
+
+    ptr = slab->next;
+    slab->next += slab->object_size;
+
+    return ptr;
+}
+
+/******************************************************************************/
+
+void * arc_slab_alloc_array(struct arc_slab *slab, size_t num)
+{
+    size_t size;
+    union arc_slab_chunk *chunk;
+    void *ptr;
+
+    /* The array and the header of its chunk must fit in a size_t */
+    if (num > (SIZE_MAX - sizeof(union arc_slab_chunk)) / slab->object_size)
+    {
+        return NULL;
+    }
+
+    size = num * slab->object_size;
+
+    if ((size_t)(slab->end - slab->next) >= size)
+    {
+        ptr = slab->next;
+        slab->next += size;
+
+        return ptr;
+    }
+
+    chunk = malloc(sizeof(union arc_slab_chunk) + size);
+
+    if (chunk == NULL)
+    {
+        return NULL;
+    }
+
+    if (slab->chunks == NULL)
+    {
+        /* It becomes the latest chunk, with no unused tail */
+        chunk->next = NULL;
+        slab->chunks = chunk;
+        slab->next = (char *)(chunk + 1) + size;
+        slab->end = slab->next;
+    }
+    else
+    {
+        /* The tail of the latest chunk is still used by the next allocations,
+           the new chunk goes right after it */
+        chunk->next = slab->chunks->next;
+        slab->chunks->next = chunk;
+    }
+
+    return chunk + 1;
+}
+
+/******************************************************************************/
+
+size_t arc_slab_object_size(struct arc_slab *slab)
+{
+    return slab->object_size;
+}
+
+/******************************************************************************/
+
+void arc_slab_free(struct arc_slab *slab, void *ptr)
+{
+    struct arc_slab_free_node *node = ptr;
+
+    node->next = slab->free_list;
+    slab->free_list = node;
+}
+
+/******************************************************************************/
+
+void arc_slab_clear(struct arc_slab *slab)
+{
+    union arc_slab_chunk *chunk;
+
+    if (slab->chunks == NULL)
+    {
+        return;
+    }
+
+    /* Only the latest chunk is kept, its whole block is reused. It is not
+       necessarily the biggest one when arrays got chunks of their own */
+    chunk = slab->chunks->next;
+
+    while (chunk != NULL)
+    {
+        union arc_slab_chunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    slab->chunks->next = NULL;
+    slab->next = (char *)(slab->chunks + 1);
+    slab->free_list = NULL;
+}
+
+/******************************************************************************/
+
+static void * arc_slab_allocator_alloc(void *ctx, size_t size)
+{
+    struct arc_slab *slab = ctx;
+
+    if (size > slab->object_size)
+    {
+        return NULL;
+    }
+
+    return arc_slab_alloc(slab);
+}
+
+/******************************************************************************/
+
+static void arc_slab_allocator_free(void *ctx, void *ptr)
+{
+    arc_slab_free(ctx, ptr);
+}
+
+/******************************************************************************/
+
+static void * arc_slab_allocator_realloc(void *ctx, void *ptr, size_t size)
+{
+    struct arc_slab *slab = ctx;
+
+    if (size > slab->object_size)
+    {
+        return NULL;
+    }
+
+    return (ptr != NULL ? ptr : arc_slab_alloc(slab));
+}
+
+/******************************************************************************/
+
+void arc_slab_get_allocator(struct arc_slab *slab,
+                            struct arc_allocator *allocator)
+{
+    allocator->alloc_fn = &arc_slab_allocator_alloc;
+    allocator->free_fn = &arc_slab_allocator_free;
+    allocator->realloc_fn = &arc_slab_allocator_realloc;
+    allocator->ctx = slab;
+}
@@ -0,0 +1,65 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @file slab_def.h
+ * @author Anil M. Mahtani Mirchandani
+ * @date September, 2015
+ *
+ * @brief Slab
+ */
+#ifndef ARC_SLAB_DEF_H_
+#define ARC_SLAB_DEF_H_
+
+#include <stdlib.h>
+#include <arc/memory/slab.h>
+
+/* Number of objects in the first chunk, every following chunk doubles the
+   size of the previous one up to the maximum chunk size */
+#define ARC_SLAB_MIN_OBJECTS 32
+#define ARC_SLAB_MAX_CHUNK_SIZE 65536
+
+/* Every object is aligned to the size of this union */
+union arc_slab_align
+{
+    void *ptr;
+    long l;
+    double d;
+};
+
+/* Chunk header, the objects are stored right after it. Being a union keeps
+   the first object aligned */
+union arc_slab_chunk
+{
+    union arc_slab_chunk *next;
+    union arc_slab_align align;
+};
+
+/* Released objects store the pointer to the next free object in place */
+struct arc_slab_free_node
+{
+    struct arc_slab_free_node *next;
+};
+
+/* Container definition, objects are taken from the free list first and then
+   from the unused tail of the latest chunk */
+struct arc_slab
+{
+    size_t object_size; /**< Rounded up to keep every object aligned */
+    size_t chunk_objects; /**< Number of objects in the next chunk */
+    struct arc_slab_free_node *free_list;
+    union arc_slab_chunk *chunks; /**< Chunk list, latest first */
+    char *next; /**< First unused object of the latest chunk */
+    char *end; /**< End of the latest chunk */
+};
+
+int arc_slab_init(struct arc_slab *slab, size_t object_size);
+
+void arc_slab_fini(struct arc_slab *slab);
+
+#endif
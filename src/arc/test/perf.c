@@ -36,8 +36,9 @@ static struct
     size_t max_str_size;
     unsigned num_tests;
     arc_test_t * user_tests;
+    clockid_t clock; /**< CPU time of the process, or wall time with -w */
 } 
-info = {0, NULL, 0, 0, 0, 256, 0, 1, NULL};
+info = {0, NULL, 0, 0, 0, 256, 0, 1, NULL, CLOCK_PROCESS_CPUTIME_ID};
 
 /******************************************************************************/
 
@@ -159,6 +160,11 @@ void arc_perf_set_system(int argc, char * argv[])
         {
             info.coverage = 1;
         }
+        else if (strcmp(argv[i], "-w") == 0)
+        {
+            /* The CPU time adds up the time of every thread */
+            info.clock = CLOCK_MONOTONIC;
+        }
     }
     info.user_tests = malloc(sizeof(arc_test_t)*info.max_length);
 
@@ -181,9 +187,9 @@ void arc_perf_run_fixture(void)
             {
                 double test_time;
                 struct timespec start, end;
-                clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &start);
+                clock_gettime(info.clock, &start);
                 info.user_tests[info.idx].function();
-                clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &end);
+                clock_gettime(info.clock, &end);
 
                 test_time = (double)(end.tv_sec - start.tv_sec) + 
                             ((double)(end.tv_nsec - start.tv_nsec))/1e9;
@@ -0,0 +1,364 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+/**
+ * @file pool.c
+ * @author Anil M. Mahtani Mirchandani
+ * @date September, 2015
+ *
+ * @brief Thread pool
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arc/common/defines.h>
+#include <arc/thread/pool.h>
+
+#define ARC_POOL_INITIAL_TASKS 64
+
+struct arc_pool_task
+{
+    arc_task_fn_t fn;
+    void * arg;
+    int * done; /**< Set once it has run if it was forked, NULL otherwise */
+};
+
+struct arc_pool
+{
+    pthread_t * threads;
+    unsigned num_threads;
+    pthread_mutex_t mutex;
+    pthread_cond_t task_cond; /**< Signaled when a task is queued */
+    pthread_cond_t done_cond; /**< Signaled when every task has finished */
+    pthread_cond_t join_cond; /**< Signaled when a task is queued or a forked
+                                   task has finished */
+    struct arc_pool_task * tasks; /**< Circular queue */
+    size_t head;
+    size_t num_queued;
+    size_t capacity;
+    size_t num_pending; /**< Queued or running */
+    int stop;
+};
+
+/******************************************************************************/
+
+/* Runs the first queued task, it's called and returns with the mutex held */
+static void arc_pool_run_next(struct arc_pool * pool)
+{
+    struct arc_pool_task task = pool->tasks[pool->head];
+
+    pool->head = (pool->head + 1 == pool->capacity ? 0 : pool->head + 1);
+    pool->num_queued--;
+
+    pthread_mutex_unlock(&pool->mutex);
+    (*task.fn)(task.arg);
+    pthread_mutex_lock(&pool->mutex);
+
+    pool->num_pending--;
+
+    if (task.done != NULL)
+    {
+        *task.done = 1;
+        pthread_cond_broadcast(&pool->join_cond);
+    }
+
+    if (pool->num_pending == 0)
+    {
+        pthread_cond_broadcast(&pool->done_cond);
+    }
+}
+
+/******************************************************************************/
+
+static void * arc_pool_worker(void * arg)
+{
+    struct arc_pool * pool = arg;
+
+    pthread_mutex_lock(&pool->mutex);
+
+    for (;;)
+    {
+        while (pool->num_queued == 0 && !pool->stop)
+        {
+            pthread_cond_wait(&pool->task_cond, &pool->mutex);
+        }
+
+        if (pool->num_queued == 0)
+        {
+            break;
+        }
+
+        arc_pool_run_next(pool);
+    }
+
+    pthread_mutex_unlock(&pool->mutex);
+
+    return NULL;
+}
+
+/******************************************************************************/
+
+struct arc_pool * arc_pool_create(unsigned num_threads)
+{
+    struct arc_pool * pool;
+    unsigned i;
+
+    if (num_threads == 0)
+    {
+#ifdef _SC_NPROCESSORS_ONLN
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = (online > 0 ? (unsigned)online : 1);
+#else
+        num_threads = 1;
+#endif
+    }
+
+    pool = malloc(sizeof(struct arc_pool));
+
+    if (pool == NULL)
+    {
+        return NULL;
+    }
+
+    pool->threads = malloc(num_threads * sizeof(pthread_t));
+    pool->tasks = malloc(ARC_POOL_INITIAL_TASKS * sizeof(struct arc_pool_task));
+
+    if (pool->threads == NULL || pool->tasks == NULL)
+    {
+        free(pool->threads);
+        free(pool->tasks);
+        free(pool);
+        return NULL;
+    }
+
+    pool->num_threads = 0;
+    pool->head = 0;
+    pool->num_queued = 0;
+    pool->capacity = ARC_POOL_INITIAL_TASKS;
+    pool->num_pending = 0;
+    pool->stop = 0;
+
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->task_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+    pthread_cond_init(&pool->join_cond, NULL);
+
+    for (i = 0; i < num_threads; i++)
+    {
+        if (pthread_create(&pool->threads[i], NULL,
+                           &arc_pool_worker, pool) != 0)
+        {
+            break;
+        }
+
+        pool->num_threads++;
+    }
+
+    /* Work with the threads that could be started, if any */
+    if (pool->num_threads == 0)
+    {
+        arc_pool_destroy(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+/******************************************************************************/
+
+void arc_pool_destroy(struct arc_pool * pool)
+{
+    unsigned i;
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->task_cond);
+    pthread_mutex_unlock(&pool->mutex);
+
+    /* The threads leave once the queue is empty */
+    for (i = 0; i < pool->num_threads; i++)
+    {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    pthread_cond_destroy(&pool->join_cond);
+    pthread_cond_destroy(&pool->done_cond);
+    pthread_cond_destroy(&pool->task_cond);
+    pthread_mutex_destroy(&pool->mutex);
+
+    free(pool->tasks);
+    free(pool->threads);
+    free(pool);
+}
+
+/******************************************************************************/
+
+unsigned arc_pool_num_threads(struct arc_pool * pool)
+{
+    return pool->num_threads;
+}
+
+/******************************************************************************/
+
+static int arc_pool_push(struct arc_pool * pool, arc_task_fn_t fn, void * arg,
+                         int * done)
+{
+    size_t tail;
+
+    pthread_mutex_lock(&pool->mutex);
+
+    if (pool->num_queued == pool->capacity)
+    {
+        struct arc_pool_task * tasks = realloc(pool->tasks, 2 * pool->capacity *
+                                               sizeof(struct arc_pool_task));
+
+        if (tasks == NULL)
+        {
+            pthread_mutex_unlock(&pool->mutex);
+            return ARC_OUT_OF_MEMORY;
+        }
+
+        /* The tasks which wrapped around go after the old end */
+        memcpy(tasks + pool->capacity, tasks,
+               pool->head * sizeof(struct arc_pool_task));
+
+        pool->tasks = tasks;
+        pool->capacity *= 2;
+    }
+
+    tail = pool->head + pool->num_queued;
+
+    if (tail >= pool->capacity)
+    {
+        tail -= pool->capacity;
+    }
+
+    pool->tasks[tail].fn = fn;
+    pool->tasks[tail].arg = arg;
+    pool->tasks[tail].done = done;
+    pool->num_queued++;
+    pool->num_pending++;
+
+    /* A thread waiting for a forked task can run it meanwhile */
+    pthread_cond_signal(&pool->task_cond);
+    pthread_cond_broadcast(&pool->join_cond);
+    pthread_mutex_unlock(&pool->mutex);
+
+    return ARC_SUCCESS;
+}
+
+/******************************************************************************/
+
+int arc_pool_submit(struct arc_pool * pool, arc_task_fn_t fn, void * arg)
+{
+    return arc_pool_push(pool, fn, arg, NULL);
+}
+
+/******************************************************************************/
+
+/* Takes a forked task back from the queue if no thread has started it yet,
+   it's called with the mutex held */
+static int arc_pool_unqueue(struct arc_pool * pool, int * done)
+{
+    size_t i = pool->num_queued;
+
+    /* It's usually the last one */
+    while (i > 0)
+    {
+        size_t pos = pool->head + (--i);
+
+        if (pos >= pool->capacity)
+        {
+            pos -= pool->capacity;
+        }
+
+        if (pool->tasks[pos].done == done)
+        {
+            /* The tasks queued after it move one place forward */
+            for (i++; i < pool->num_queued; i++)
+            {
+                size_t next = (pos + 1 == pool->capacity ? 0 : pos + 1);
+
+                pool->tasks[pos] = pool->tasks[next];
+                pos = next;
+            }
+
+            pool->num_queued--;
+            pool->num_pending--;
+
+            if (pool->num_pending == 0)
+            {
+                pthread_cond_broadcast(&pool->done_cond);
+            }
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/******************************************************************************/
+
+void arc_pool_fork_join(struct arc_pool * pool,
+                        arc_task_fn_t fn1, void * arg1,
+                        arc_task_fn_t fn2, void * arg2)
+{
+    int done = 0;
+
+    if (pool == NULL || arc_pool_push(pool, fn2, arg2, &done) != ARC_SUCCESS)
+    {
+        (*fn1)(arg1);
+        (*fn2)(arg2);
+        return;
+    }
+
+    (*fn1)(arg1);
+
+    pthread_mutex_lock(&pool->mutex);
+
+    if (arc_pool_unqueue(pool, &done))
+    {
+        pthread_mutex_unlock(&pool->mutex);
+        (*fn2)(arg2);
+        return;
+    }
+
+    /* Another thread is running it, the queued tasks are run meanwhile so
+       that nested forks never wait for a thread which is waiting itself */
+    while (!done)
+    {
+        if (pool->num_queued > 0)
+        {
+            arc_pool_run_next(pool);
+        }
+        else
+        {
+            pthread_cond_wait(&pool->join_cond, &pool->mutex);
+        }
+    }
+
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+/******************************************************************************/
+
+void arc_pool_wait(struct arc_pool * pool)
+{
+    pthread_mutex_lock(&pool->mutex);
+
+    while (pool->num_pending > 0)
+    {
+        pthread_cond_wait(&pool->done_cond, &pool->mutex);
+    }
+
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+/******************************************************************************/
@@ -6,6 +6,9 @@
 * There is NO WARRANTY, to the extent permitted by law.                        *
 *                                                                              *
 *******************************************************************************/
+#include <limits.h>
+#include <string.h>
+#include <arc/type/function.h>
 
 /******************************************************************************/
 
@@ -80,3 +83,62 @@ int arc_cmp_double(const void * a, const void * b)
 }
 
 /******************************************************************************/
+
+unsigned long arc_key_int(const void * a)
+{
+    /* Flipping the sign bit puts the negative values first */
+    return (unsigned long)((unsigned)*((const int *)a) ^
+                           ((unsigned)INT_MAX + 1u));
+}
+
+/******************************************************************************/
+
+unsigned long arc_key_uint(const void * a)
+{
+    return *((const unsigned *)a);
+}
+
+/******************************************************************************/
+
+unsigned long arc_key_long(const void * a)
+{
+    return (unsigned long)*((const long *)a) ^ ((unsigned long)LONG_MAX + 1ul);
+}
+
+/******************************************************************************/
+
+unsigned long arc_key_ulong(const void * a)
+{
+    return *((const unsigned long *)a);
+}
+
+/******************************************************************************/
+
+unsigned long arc_key_float(const void * a)
+{
+    unsigned bits, sign = (unsigned)INT_MAX + 1u;
+
+    memcpy(&bits, a, sizeof(bits));
+
+    /* Negative values are ordered backwards, the rest after them */
+    return (bits & sign ? ~bits : bits | sign);
+}
+
+/******************************************************************************/
+
+unsigned long arc_key_double(const void * a)
+{
+#if ULONG_MAX > 0xFFFFFFFFUL
+    unsigned long bits, sign = (unsigned long)LONG_MAX + 1ul;
+
+    memcpy(&bits, a, sizeof(bits));
+
+    return (bits & sign ? ~bits : bits | sign);
+#else
+    float value = (float)*((const double *)a);
+
+    return arc_key_float(&value);
+#endif
+}
+
+/******************************************************************************/
@@ -1,4 +1,8 @@
+#include <time.h>
+#include <stdio.h>
 #include <limits.h>
+#include <pthread.h>
+#include <arc/common/defines.h>
 #include <arc/type/hash.h>
 
 arc_hkey_t arc_hash_pearson(const void *data, size_t data_size)
@@ -70,4 +74,290 @@ arc_hkey_t arc_hash_djb2(const void *data, size_t data_size)
     }
 
     return hkey;
-}
\ No newline at end of file
+}
+/* Word at a time hashing, keys are read as little endian words so the hash
+   values are the same on every platform with the same word size */
+
+#define ARC_HASH_R1(p, i) ((arc_hkey_t)(p)[i])
+
+static arc_hkey_t arc_hash_read4(const unsigned char *p)
+{
+    return ARC_HASH_R1(p, 0) | (ARC_HASH_R1(p, 1) << 8) |
+           (ARC_HASH_R1(p, 2) << 16) | (ARC_HASH_R1(p, 3) << 24);
+}
+
+static arc_hkey_t arc_hash_read3(const unsigned char *p, size_t k)
+{
+    return (ARC_HASH_R1(p, 0) << 16) | (ARC_HASH_R1(p, k >> 1) << 8) |
+           ARC_HASH_R1(p, k - 1);
+}
+
+#if ULONG_MAX > 0xFFFFFFFFUL
+
+static const arc_hkey_t arc_hash_wyp[4] = {
+    0x2D358DCCAA6C78A5UL, 0x8BB84B93962EACC9UL,
+    0x4B33A62ED433D4A3UL, 0x4D5A2DA51DE1AA47UL
+};
+
+static arc_hkey_t arc_hash_read8(const unsigned char *p)
+{
+    return arc_hash_read4(p) | (arc_hash_read4(p + 4) << 32);
+}
+
+/* Full 64x64 -> 128 bit multiplication, the low half is stored in a and the
+   high half in b */
+static void arc_hash_mum(arc_hkey_t *a, arc_hkey_t *b)
+{
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 arc_hash_u128_t;
+    arc_hash_u128_t r = (arc_hash_u128_t)*a * *b;
+
+    *a = (arc_hkey_t)r;
+    *b = (arc_hkey_t)(r >> 64);
+#else
+    arc_hkey_t ha = *a >> 32, hb = *b >> 32;
+    arc_hkey_t la = *a & 0xFFFFFFFFUL, lb = *b & 0xFFFFFFFFUL;
+    arc_hkey_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    arc_hkey_t t = rl + (rm0 << 32), c = t < rl, lo, hi;
+
+    lo = t + (rm1 << 32);
+    c += lo < t;
+    hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+
+    *a = lo;
+    *b = hi;
+#endif
+}
+
+static arc_hkey_t arc_hash_mix(arc_hkey_t a, arc_hkey_t b)
+{
+    arc_hash_mum(&a, &b);
+    return a ^ b;
+}
+
+static arc_hkey_t arc_hash_wy_impl(const void *data, size_t data_size,
+                                   arc_hkey_t seed)
+{
+    const unsigned char *p = data;
+    const arc_hkey_t *s = arc_hash_wyp;
+    arc_hkey_t a, b;
+
+    seed ^= arc_hash_mix(seed ^ s[0], s[1]);
+
+    if (data_size <= 16)
+    {
+        if (data_size >= 4)
+        {
+            size_t off = (data_size >> 3) << 2;
+
+            a = (arc_hash_read4(p) << 32) | arc_hash_read4(p + off);
+            b = (arc_hash_read4(p + data_size - 4) << 32) |
+                arc_hash_read4(p + data_size - 4 - off);
+        }
+        else if (data_size > 0)
+        {
+            a = arc_hash_read3(p, data_size);
+            b = 0;
+        }
+        else
+        {
+            a = b = 0;
+        }
+    }
+    else
+    {
+        size_t i = data_size;
+
+        if (i > 48)
+        {
+            arc_hkey_t see1 = seed, see2 = seed;
+
+            do
+            {
+                seed = arc_hash_mix(arc_hash_read8(p) ^ s[1],
+                                    arc_hash_read8(p + 8) ^ seed);
+                see1 = arc_hash_mix(arc_hash_read8(p + 16) ^ s[2],
+                                    arc_hash_read8(p + 24) ^ see1);
+                see2 = arc_hash_mix(arc_hash_read8(p + 32) ^ s[3],
+                                    arc_hash_read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            }
+            while (i > 48);
+
+            seed ^= see1 ^ see2;
+        }
+
+        while (i > 16)
+        {
+            seed = arc_hash_mix(arc_hash_read8(p) ^ s[1],
+                                arc_hash_read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+
+        a = arc_hash_read8(p + i - 16);
+        b = arc_hash_read8(p + i - 8);
+    }
+
+    a ^= s[1];
+    b ^= seed;
+    arc_hash_mum(&a, &b);
+
+    return arc_hash_mix(a ^ s[0] ^ (arc_hkey_t)data_size, b ^ s[1]);
+}
+
+static arc_hkey_t arc_hash_mix_int_seeded(arc_hkey_t key, arc_hkey_t seed)
+{
+    return arc_hash_mix(key ^ seed ^ arc_hash_wyp[0], seed ^ arc_hash_wyp[1]);
+}
+
+static arc_hkey_t arc_hash_read_int64(const void *data)
+{
+    return arc_hash_read8(data);
+}
+
+#else
+
+/* Without a 64 bit type the word at a time hash is murmur3 (x86_32) */
+
+static arc_hkey_t arc_hash_rotl(arc_hkey_t x, unsigned r)
+{
+    return ((x << r) | (x >> (32 - r))) & 0xFFFFFFFFUL;
+}
+
+static arc_hkey_t arc_hash_fmix(arc_hkey_t h)
+{
+    h ^= h >> 16;
+    h = (h * 0x85EBCA6BUL) & 0xFFFFFFFFUL;
+    h ^= h >> 13;
+    h = (h * 0xC2B2AE35UL) & 0xFFFFFFFFUL;
+    h ^= h >> 16;
+    return h;
+}
+
+static arc_hkey_t arc_hash_wy_impl(const void *data, size_t data_size,
+                                   arc_hkey_t seed)
+{
+    const unsigned char *p = data;
+    arc_hkey_t h = seed & 0xFFFFFFFFUL, k;
+    size_t i;
+
+    for (i = data_size; i >= 4; i -= 4, p += 4)
+    {
+        k = (arc_hash_read4(p) * 0xCC9E2D51UL) & 0xFFFFFFFFUL;
+        k = (arc_hash_rotl(k, 15) * 0x1B873593UL) & 0xFFFFFFFFUL;
+        h = arc_hash_rotl(h ^ k, 13);
+        h = (h * 5 + 0xE6546B64UL) & 0xFFFFFFFFUL;
+    }
+
+    if (i > 0)
+    {
+        k = (arc_hash_read3(p, i) * 0xCC9E2D51UL) & 0xFFFFFFFFUL;
+        k = (arc_hash_rotl(k, 15) * 0x1B873593UL) & 0xFFFFFFFFUL;
+        h ^= k;
+    }
+
+    return arc_hash_fmix(h ^ (arc_hkey_t)data_size);
+}
+
+static arc_hkey_t arc_hash_mix_int_seeded(arc_hkey_t key, arc_hkey_t seed)
+{
+    return arc_hash_fmix(arc_hash_fmix(key ^ seed) + seed);
+}
+
+static arc_hkey_t arc_hash_read_int64(const void *data)
+{
+    const unsigned char *p = data;
+
+    return arc_hash_read4(p) ^ arc_hash_fmix(arc_hash_read4(p + 4));
+}
+
+#endif
+
+arc_hkey_t arc_hash_mix_int(arc_hkey_t key)
+{
+    return arc_hash_mix_int_seeded(key, 0);
+}
+
+arc_hkey_t arc_hash_wy(const void *data, size_t data_size)
+{
+    return arc_hash_wy_impl(data, data_size, 0);
+}
+
+arc_hkey_t arc_hash_int32(const void *data, size_t data_size)
+{
+    ARC_UNUSED(data_size);
+    return arc_hash_mix_int_seeded(arc_hash_read4(data), 0);
+}
+
+arc_hkey_t arc_hash_int64(const void *data, size_t data_size)
+{
+    ARC_UNUSED(data_size);
+    return arc_hash_mix_int_seeded(arc_hash_read_int64(data), 0);
+}
+
+arc_hkey_t arc_hash_wy_seeded(const void *data, size_t data_size,
+                              arc_hkey_t seed)
+{
+    return arc_hash_wy_impl(data, data_size, seed);
+}
+
+arc_hkey_t arc_hash_int32_seeded(const void *data, size_t data_size,
+                                 arc_hkey_t seed)
+{
+    ARC_UNUSED(data_size);
+    return arc_hash_mix_int_seeded(arc_hash_read4(data), seed);
+}
+
+arc_hkey_t arc_hash_int64_seeded(const void *data, size_t data_size,
+                                 arc_hkey_t seed)
+{
+    ARC_UNUSED(data_size);
+    return arc_hash_mix_int_seeded(arc_hash_read_int64(data), seed);
+}
+
+static pthread_once_t arc_hash_seed_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t arc_hash_seed_mutex = PTHREAD_MUTEX_INITIALIZER;
+static arc_hkey_t arc_hash_base_seed;
+static arc_hkey_t arc_hash_seed_counter;
+
+/* Reads the entropy shared by every seed of the process, only once */
+static void arc_hash_init_base_seed(void)
+{
+    arc_hkey_t seed = 0;
+    FILE *urandom = fopen("/dev/urandom", "rb");
+
+    if (urandom != NULL)
+    {
+        if (fread(&seed, sizeof(seed), 1, urandom) != 1)
+        {
+            seed = 0;
+        }
+
+        fclose(urandom);
+    }
+
+    /* Processes without a source of entropy still get different seeds */
+    if (seed == 0)
+    {
+        seed = (arc_hkey_t)time(NULL) ^ ((arc_hkey_t)clock() << 16) ^
+               (arc_hkey_t)(size_t)&seed;
+    }
+
+    arc_hash_base_seed = seed;
+}
+
+arc_hkey_t arc_hash_random_seed(const void *salt)
+{
+    arc_hkey_t counter;
+    arc_hkey_t address = (arc_hkey_t)(size_t)salt;
+
+    pthread_once(&arc_hash_seed_once, &arc_hash_init_base_seed);
+
+    pthread_mutex_lock(&arc_hash_seed_mutex);
+    counter = ++arc_hash_seed_counter;
+    pthread_mutex_unlock(&arc_hash_seed_mutex);
+
+    return arc_hash_mix_int_seeded(arc_hash_base_seed ^ address, counter);
+}
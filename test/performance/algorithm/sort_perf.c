@@ -0,0 +1,117 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <arc/algorithm/sort.h>
+#include <arc/type/function.h>
+#include <arc/test/perf.h>
+#include <arc/common/defines.h>
+
+int *ints;
+double *doubles;
+size_t num_elems = 1000000;
+
+/* Same as arc_cmp_int, but it's not recognized by arc_sort */
+static int int_cmp(const void *a, const void *b)
+{
+    return arc_cmp_int(a, b);
+}
+
+ARC_PERF_FUNCTION(global_set_up)
+{
+    const char * num_elems_str = arc_get_param("-n");
+
+    if (num_elems_str != NULL)
+    {
+        num_elems = strtoul(num_elems_str, NULL, 10);
+    }
+
+    ints = malloc(num_elems * sizeof(int));
+    doubles = malloc(num_elems * sizeof(double));
+}
+
+ARC_PERF_FUNCTION(global_tear_down)
+{
+    free(doubles);
+    free(ints);
+}
+
+ARC_PERF_FUNCTION(set_up)
+{
+    size_t i;
+
+    srand(1);
+
+    for (i = 0; i < num_elems; i++)
+    {
+        ints[i] = rand() - RAND_MAX / 2;
+        doubles[i] = (double)rand() / RAND_MAX - 0.5;
+    }
+}
+
+ARC_PERF_TEST(qsort_int)
+{
+    qsort(ints, num_elems, sizeof(int), &arc_cmp_int);
+}
+
+ARC_PERF_TEST(sort_int)
+{
+    arc_sort(ints, num_elems, sizeof(int), &arc_cmp_int);
+}
+
+ARC_PERF_TEST(sort_int_cmp_fn)
+{
+    arc_sort(ints, num_elems, sizeof(int), &int_cmp);
+}
+
+ARC_PERF_TEST(radix_sort_int)
+{
+    arc_radix_sort(ints, num_elems, sizeof(int), &arc_key_int);
+}
+
+ARC_PERF_TEST(qsort_double)
+{
+    qsort(doubles, num_elems, sizeof(double), &arc_cmp_double);
+}
+
+ARC_PERF_TEST(sort_double)
+{
+    arc_sort(doubles, num_elems, sizeof(double), &arc_cmp_double);
+}
+
+ARC_PERF_TEST(radix_sort_double)
+{
+    arc_radix_sort(doubles, num_elems, sizeof(double), &arc_key_double);
+}
+
+ARC_PERF_TEST_FIXTURE()
+{
+    ARC_PERF_ADD_FUNCTION(global_set_up)
+
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(qsort_int)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(sort_int)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(sort_int_cmp_fn)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(radix_sort_int)
+
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(qsort_double)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(sort_double)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(radix_sort_double)
+
+    ARC_PERF_ADD_FUNCTION(global_tear_down)
+}
+
+ARC_PERF_RUN_TESTS()
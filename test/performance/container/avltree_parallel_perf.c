@@ -0,0 +1,207 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+
+/*
+ * Builds, merges and intersects the same avltrees with a growing number of
+ * threads. Run it with -w to measure wall clock time instead of the CPU time
+ * of the process.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <arc/container/avltree.h>
+#include <arc/thread/pool.h>
+#include <arc/type/function.h>
+#include <arc/test/perf.h>
+#include <arc/common/defines.h>
+
+arc_avltree_t tree, other;
+arc_pool_t pool;
+int *evens, *triples;
+size_t num_elems = 1000000;
+
+ARC_PERF_FUNCTION(global_set_up)
+{
+    size_t i;
+    const char * num_elems_str = arc_get_param("-n");
+
+    if (num_elems_str != NULL)
+    {
+        num_elems = strtoul(num_elems_str, NULL, 10);
+    }
+
+    evens = malloc(num_elems * sizeof(int));
+    triples = malloc(num_elems * sizeof(int));
+
+    for (i = 0; i < num_elems; i++)
+    {
+        evens[i] = (int)(2 * i);
+        triples[i] = (int)(3 * i);
+    }
+
+    pool = NULL;
+}
+
+ARC_PERF_FUNCTION(global_tear_down)
+{
+    arc_pool_destroy(pool);
+    free(triples);
+    free(evens);
+}
+
+ARC_PERF_FUNCTION(threads_1)
+{
+    if (pool != NULL)
+    {
+        arc_pool_destroy(pool);
+    }
+
+    pool = arc_pool_create(1);
+}
+
+ARC_PERF_FUNCTION(threads_2)
+{
+    if (pool != NULL)
+    {
+        arc_pool_destroy(pool);
+    }
+
+    pool = arc_pool_create(2);
+}
+
+ARC_PERF_FUNCTION(threads_4)
+{
+    if (pool != NULL)
+    {
+        arc_pool_destroy(pool);
+    }
+
+    pool = arc_pool_create(4);
+}
+
+ARC_PERF_FUNCTION(threads_8)
+{
+    if (pool != NULL)
+    {
+        arc_pool_destroy(pool);
+    }
+
+    pool = arc_pool_create(8);
+}
+
+ARC_PERF_FUNCTION(threads_online)
+{
+    if (pool != NULL)
+    {
+        arc_pool_destroy(pool);
+    }
+
+    pool = arc_pool_create(0);
+}
+
+/* Multiples of two in the tree and of three in the other one */
+ARC_PERF_FUNCTION(set_up)
+{
+    tree = arc_avltree_create(sizeof(int), arc_cmp_int);
+    other = arc_avltree_create(sizeof(int), arc_cmp_int);
+
+    arc_avltree_build_sorted(tree, evens, num_elems);
+    arc_avltree_build_sorted(other, triples, num_elems);
+}
+
+ARC_PERF_FUNCTION(set_up_empty)
+{
+    tree = arc_avltree_create(sizeof(int), arc_cmp_int);
+    other = arc_avltree_create(sizeof(int), arc_cmp_int);
+}
+
+ARC_PERF_FUNCTION(tear_down)
+{
+    arc_avltree_destroy(other);
+    arc_avltree_destroy(tree);
+}
+
+ARC_PERF_TEST(build_sorted)
+{
+    arc_avltree_parallel_build_sorted(tree, evens, num_elems, pool);
+}
+
+ARC_PERF_TEST(union)
+{
+    arc_avltree_parallel_union(tree, other, pool);
+}
+
+ARC_PERF_TEST(intersection)
+{
+    arc_avltree_parallel_intersection(tree, other, pool);
+}
+
+ARC_PERF_TEST_FIXTURE()
+{
+    ARC_PERF_ADD_FUNCTION(global_set_up)
+
+    ARC_PERF_ADD_FUNCTION(threads_1)
+    ARC_PERF_ADD_FUNCTION(set_up_empty)
+    ARC_PERF_ADD_TEST(build_sorted)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(union)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(intersection)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(threads_2)
+    ARC_PERF_ADD_FUNCTION(set_up_empty)
+    ARC_PERF_ADD_TEST(build_sorted)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(union)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(intersection)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(threads_4)
+    ARC_PERF_ADD_FUNCTION(set_up_empty)
+    ARC_PERF_ADD_TEST(build_sorted)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(union)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(intersection)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(threads_8)
+    ARC_PERF_ADD_FUNCTION(set_up_empty)
+    ARC_PERF_ADD_TEST(build_sorted)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(union)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(intersection)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(threads_online)
+    ARC_PERF_ADD_FUNCTION(set_up_empty)
+    ARC_PERF_ADD_TEST(build_sorted)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(union)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(intersection)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(global_tear_down)
+}
+
+ARC_PERF_RUN_TESTS()
@@ -14,8 +14,9 @@
 #include <string.h>
 #include <time.h>
 
-arc_avltree_t tree;
+arc_avltree_t tree, other;
 int *values, *random_values;
+void **results;
 int num_elems = 20000;
 
 ARC_PERF_FUNCTION(global_set_up)
@@ -45,11 +46,15 @@ ARC_PERF_FUNCTION(global_set_up)
     }
 
     free(visited);
+
+    results = malloc(sizeof(void *) * ((size_t)num_elems));
 }
 
 ARC_PERF_FUNCTION(global_tear_down)
 {
     free(values);
+    free(random_values);
+    free(results);
 }
 
 ARC_PERF_FUNCTION(set_up)
@@ -57,6 +62,80 @@ ARC_PERF_FUNCTION(set_up)
     tree = arc_avltree_create(sizeof(int), arc_cmp_int);
 }
 
+ARC_PERF_FUNCTION(set_up_pooled)
+{
+    tree = arc_avltree_create_pooled(sizeof(int), arc_cmp_int);
+}
+
+/* Even numbers in the tree, a tenth of the numbers in the other tree */
+ARC_PERF_FUNCTION(set_up_sets)
+{
+    int i;
+
+    tree = arc_avltree_create(sizeof(int), arc_cmp_int);
+    other = arc_avltree_create(sizeof(int), arc_cmp_int);
+
+    for (i = 0; i < num_elems; i++)
+    {
+        values[i] = 2 * i;
+    }
+
+    arc_avltree_build_sorted(tree, values, (size_t)num_elems);
+
+    for (i = 0; i < num_elems; i++)
+    {
+        values[i] = i;
+    }
+
+    for (i = 0; i < num_elems / 10; i++)
+    {
+        arc_avltree_insert(other, &random_values[i]);
+    }
+}
+
+ARC_PERF_FUNCTION(tear_down_sets)
+{
+    arc_avltree_destroy(other);
+    arc_avltree_destroy(tree);
+}
+
+ARC_PERF_TEST(union)
+{
+    arc_avltree_union(tree, other);
+}
+
+ARC_PERF_TEST(intersection)
+{
+    arc_avltree_intersection(tree, other);
+}
+
+ARC_PERF_TEST(difference)
+{
+    arc_avltree_difference(tree, other);
+}
+
+/* Element by element equivalent of the union */
+ARC_PERF_TEST(insert_other)
+{
+    int i;
+
+    for (i = 0; i < num_elems / 10; i++)
+    {
+        arc_avltree_insert(tree, &random_values[i]);
+    }
+}
+
+/* Element by element equivalent of the difference */
+ARC_PERF_TEST(remove_other)
+{
+    int i;
+
+    for (i = 0; i < num_elems / 10; i++)
+    {
+        arc_avltree_remove(tree, &random_values[i]);
+    }
+}
+
 ARC_PERF_TEST(insert)
 {
     int i;
@@ -66,6 +145,16 @@ ARC_PERF_TEST(insert)
     }
 }
 
+ARC_PERF_TEST(build_sorted)
+{
+    arc_avltree_build_sorted(tree, values, (size_t)num_elems);
+}
+
+ARC_PERF_TEST(insert_sorted)
+{
+    arc_avltree_insert_sorted(tree, values, (size_t)num_elems);
+}
+
 ARC_PERF_TEST(retrieve)
 {
     int i;
@@ -75,6 +164,41 @@ ARC_PERF_TEST(retrieve)
     }
 }
 
+ARC_PERF_TEST(random_retrieve)
+{
+    int i;
+    for (i = 0; i < num_elems; i++)
+    {
+        arc_avltree_retrieve(tree, &random_values[i]);
+    }
+}
+
+ARC_PERF_TEST(random_retrieve_batch)
+{
+    arc_avltree_retrieve_batch(tree, random_values,
+                               (size_t)num_elems, results);
+}
+
+ARC_PERF_TEST(random_select)
+{
+    int i;
+
+    for (i = 0; i < num_elems; i++)
+    {
+        arc_avltree_select(tree, (size_t)random_values[i]);
+    }
+}
+
+ARC_PERF_TEST(random_rank)
+{
+    int i;
+
+    for (i = 0; i < num_elems; i++)
+    {
+        arc_avltree_rank(tree, &random_values[i]);
+    }
+}
+
 ARC_PERF_TEST(random_insert)
 {
     int i;
@@ -85,6 +209,58 @@ ARC_PERF_TEST(random_insert)
     }
 }
 
+ARC_PERF_TEST(scan)
+{
+    arc_avltree_iterator_t it = arc_avltree_iterator_create(tree);
+    long sum = 0;
+
+    arc_avltree_before_begin(it);
+
+    while (arc_avltree_next(it))
+    {
+        sum += *(int *)arc_avltree_data(it);
+    }
+
+    arc_avltree_iterator_destroy(it);
+
+    if (sum < 0)
+    {
+        printf("Unexpected sum\n");
+    }
+}
+
+ARC_PERF_TEST(range_scan)
+{
+    arc_avltree_iterator_t it = arc_avltree_iterator_create(tree);
+    long sum = 0;
+    int i;
+
+    /* Windows of 100 consecutive elements starting at random positions */
+    for (i = 0; i < num_elems; i += 100)
+    {
+        int first = random_values[i];
+        int last = first + 100;
+        int found;
+
+        for (found = arc_avltree_range(it, &first, &last); found;
+             found = arc_avltree_range_next(it, &last))
+        {
+            sum += *(int *)arc_avltree_data(it);
+        }
+    }
+
+    arc_avltree_iterator_destroy(it);
+
+    if (sum < 0)
+    {
+        printf("Unexpected sum\n");
+    }
+}
+
+ARC_PERF_TEST(clear)
+{
+    arc_avltree_clear(tree);
+}
 
 ARC_PERF_FUNCTION(tear_down)
 {
@@ -105,6 +281,60 @@ ARC_PERF_TEST_FIXTURE()
     ARC_PERF_ADD_TEST(retrieve)
     ARC_PERF_ADD_FUNCTION(tear_down)
 
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(random_insert)
+    ARC_PERF_ADD_TEST(random_retrieve)
+    ARC_PERF_ADD_TEST(random_retrieve_batch)
+    ARC_PERF_ADD_TEST(random_select)
+    ARC_PERF_ADD_TEST(random_rank)
+    ARC_PERF_ADD_TEST(scan)
+    ARC_PERF_ADD_TEST(range_scan)
+    ARC_PERF_ADD_TEST(clear)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(build_sorted)
+    ARC_PERF_ADD_TEST(retrieve)
+    ARC_PERF_ADD_TEST(random_retrieve)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(random_insert)
+    ARC_PERF_ADD_TEST(insert_sorted)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up_pooled)
+    ARC_PERF_ADD_TEST(build_sorted)
+    ARC_PERF_ADD_TEST(random_retrieve)
+    ARC_PERF_ADD_TEST(clear)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up_pooled)
+    ARC_PERF_ADD_TEST(random_insert)
+    ARC_PERF_ADD_TEST(random_retrieve)
+    ARC_PERF_ADD_TEST(clear)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up_sets)
+    ARC_PERF_ADD_TEST(union)
+    ARC_PERF_ADD_FUNCTION(tear_down_sets)
+
+    ARC_PERF_ADD_FUNCTION(set_up_sets)
+    ARC_PERF_ADD_TEST(insert_other)
+    ARC_PERF_ADD_FUNCTION(tear_down_sets)
+
+    ARC_PERF_ADD_FUNCTION(set_up_sets)
+    ARC_PERF_ADD_TEST(intersection)
+    ARC_PERF_ADD_FUNCTION(tear_down_sets)
+
+    ARC_PERF_ADD_FUNCTION(set_up_sets)
+    ARC_PERF_ADD_TEST(difference)
+    ARC_PERF_ADD_FUNCTION(tear_down_sets)
+
+    ARC_PERF_ADD_FUNCTION(set_up_sets)
+    ARC_PERF_ADD_TEST(remove_other)
+    ARC_PERF_ADD_FUNCTION(tear_down_sets)
+
     ARC_PERF_ADD_FUNCTION(global_tear_down)
 }
 
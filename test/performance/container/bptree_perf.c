@@ -0,0 +1,152 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <arc/test/perf.h>
+#include <arc/container/bptree.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+arc_bptree_t tree;
+int *values, *random_values;
+int num_elems = 20000;
+
+ARC_PERF_FUNCTION(global_set_up)
+{
+    int i, *visited;
+    const char * num_elems_str = arc_get_param("-n");
+
+    if (num_elems_str != NULL)
+    {
+        num_elems = atoi(num_elems_str);
+    }
+
+    values = malloc(sizeof(int) * ((size_t)num_elems));
+    random_values = malloc(sizeof(int) * ((size_t)num_elems));
+    visited = malloc(sizeof(int) * ((size_t)num_elems));
+    memset(visited, 0, sizeof(int) * ((size_t)num_elems));
+
+    for (i = 0; i < num_elems; i++)
+    {
+        int rvalue = rand() % num_elems;
+        values[i] = i;
+
+        while (visited[rvalue]) rvalue = rand() % num_elems;
+        random_values[i] = rvalue;
+        visited[rvalue] = 1;
+
+    }
+
+    free(visited);
+}
+
+ARC_PERF_FUNCTION(global_tear_down)
+{
+    free(values);
+    free(random_values);
+}
+
+ARC_PERF_FUNCTION(set_up)
+{
+    tree = arc_bptree_create(sizeof(int), arc_cmp_int);
+}
+
+ARC_PERF_TEST(insert)
+{
+    int i;
+    for (i = 0; i < num_elems; i++)
+    {
+        arc_bptree_insert(tree, &i);
+    }
+}
+
+ARC_PERF_TEST(retrieve)
+{
+    int i;
+    for (i = num_elems - 1; i >= 0; i--)
+    {
+        arc_bptree_retrieve(tree, &i);
+    }
+}
+
+ARC_PERF_TEST(random_retrieve)
+{
+    int i;
+    for (i = 0; i < num_elems; i++)
+    {
+        arc_bptree_retrieve(tree, &random_values[i]);
+    }
+}
+
+ARC_PERF_TEST(random_insert)
+{
+    int i;
+
+    for (i = 0; i < num_elems; i++)
+    {
+        arc_bptree_insert(tree, &random_values[i]);
+    }
+}
+
+ARC_PERF_TEST(scan)
+{
+    arc_bptree_iterator_t it = arc_bptree_iterator_create(tree);
+    long sum = 0;
+
+    arc_bptree_before_begin(it);
+
+    while (arc_bptree_next(it))
+    {
+        sum += *(int *)arc_bptree_data(it);
+    }
+
+    arc_bptree_iterator_destroy(it);
+
+    if (sum < 0)
+    {
+        printf("Unexpected sum\n");
+    }
+}
+
+ARC_PERF_TEST(clear)
+{
+    arc_bptree_clear(tree);
+}
+
+ARC_PERF_FUNCTION(tear_down)
+{
+    arc_bptree_destroy(tree);
+}
+
+ARC_PERF_TEST_FIXTURE()
+{
+    ARC_PERF_ADD_FUNCTION(global_set_up)
+
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(insert)
+    ARC_PERF_ADD_TEST(retrieve)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(random_insert)
+    ARC_PERF_ADD_TEST(retrieve)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(random_insert)
+    ARC_PERF_ADD_TEST(random_retrieve)
+    ARC_PERF_ADD_TEST(scan)
+    ARC_PERF_ADD_TEST(clear)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(global_tear_down)
+}
+
+ARC_PERF_RUN_TESTS()
@@ -0,0 +1,110 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <arc/container/darray.h>
+#include <arc/test/perf.h>
+#include <arc/common/defines.h>
+
+arc_darray_t darray;
+unsigned long num_elems = 100000000;
+
+ARC_PERF_FUNCTION(global_set_up)
+{
+    const char * num_elems_str = arc_get_param("-n");
+
+    if (num_elems_str != NULL)
+    {
+        num_elems = strtoul(num_elems_str, NULL, 10);
+    }
+}
+
+ARC_PERF_FUNCTION(set_up_default)
+{
+    darray = arc_darray_create(sizeof(int));
+}
+
+ARC_PERF_FUNCTION(set_up_mmap)
+{
+    darray = arc_darray_create_large(sizeof(int), 0, 0);
+}
+
+ARC_PERF_FUNCTION(set_up_huge)
+{
+    darray = arc_darray_create_large(sizeof(int), 0, 1);
+}
+
+ARC_PERF_FUNCTION(tear_down)
+{
+    arc_darray_destroy(darray);
+}
+
+/* Fills the darray up to its capacity, so that the next insertion grows it */
+ARC_PERF_TEST(fill)
+{
+    int value = 0;
+
+    while (arc_darray_size(darray) < num_elems ||
+           arc_darray_size(darray) < arc_darray_capacity(darray))
+    {
+        arc_darray_push_back(darray, &value);
+        value++;
+    }
+}
+
+/* Latency of growing the full darray */
+ARC_PERF_TEST(grow)
+{
+    int value = 0;
+
+    arc_darray_push_back(darray, &value);
+}
+
+ARC_PERF_TEST(random_read)
+{
+    unsigned long i, idx = 1, sum = 0;
+    unsigned long size = arc_darray_size(darray);
+
+    for (i = 0; i < 10000000; i++)
+    {
+        idx = (idx * 1103515245 + 12345) % size;
+        sum += (unsigned long)*(int *)arc_darray_at(darray, idx);
+    }
+
+    if (sum == 0)
+    {
+        printf("Unexpected sum\n");
+    }
+}
+
+ARC_PERF_TEST_FIXTURE()
+{
+    ARC_PERF_ADD_FUNCTION(global_set_up)
+
+    ARC_PERF_ADD_FUNCTION(set_up_default)
+    ARC_PERF_ADD_TEST(fill)
+    ARC_PERF_ADD_TEST(grow)
+    ARC_PERF_ADD_TEST(random_read)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up_mmap)
+    ARC_PERF_ADD_TEST(fill)
+    ARC_PERF_ADD_TEST(grow)
+    ARC_PERF_ADD_TEST(random_read)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up_huge)
+    ARC_PERF_ADD_TEST(fill)
+    ARC_PERF_ADD_TEST(grow)
+    ARC_PERF_ADD_TEST(random_read)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+}
+
+ARC_PERF_RUN_TESTS()
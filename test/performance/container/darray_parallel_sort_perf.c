@@ -0,0 +1,127 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+
+/*
+ * Sorts the same random darray with a growing number of threads. Run it with
+ * -w to measure wall clock time instead of the CPU time of the process.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <arc/container/darray.h>
+#include <arc/type/function.h>
+#include <arc/test/perf.h>
+#include <arc/common/defines.h>
+
+arc_darray_t darray;
+size_t num_elems = 10000000;
+
+ARC_PERF_FUNCTION(global_set_up)
+{
+    const char * num_elems_str = arc_get_param("-n");
+
+    if (num_elems_str != NULL)
+    {
+        num_elems = strtoul(num_elems_str, NULL, 10);
+    }
+
+    darray = arc_darray_create_with_capacity(sizeof(int), num_elems, 0);
+}
+
+ARC_PERF_FUNCTION(global_tear_down)
+{
+    arc_darray_destroy(darray);
+}
+
+ARC_PERF_FUNCTION(set_up)
+{
+    size_t i;
+
+    srand(1);
+    arc_darray_clear(darray);
+
+    for (i = 0; i < num_elems; i++)
+    {
+        int value = rand() - RAND_MAX / 2;
+        arc_darray_push_back(darray, &value);
+    }
+}
+
+ARC_PERF_TEST(sort)
+{
+    arc_darray_sort(darray, &arc_cmp_int);
+}
+
+ARC_PERF_TEST(threads_1)
+{
+    arc_darray_parallel_sort(darray, &arc_cmp_int, 1);
+}
+
+ARC_PERF_TEST(threads_2)
+{
+    arc_darray_parallel_sort(darray, &arc_cmp_int, 2);
+}
+
+ARC_PERF_TEST(threads_4)
+{
+    arc_darray_parallel_sort(darray, &arc_cmp_int, 4);
+}
+
+ARC_PERF_TEST(threads_8)
+{
+    arc_darray_parallel_sort(darray, &arc_cmp_int, 8);
+}
+
+ARC_PERF_TEST(threads_16)
+{
+    arc_darray_parallel_sort(darray, &arc_cmp_int, 16);
+}
+
+ARC_PERF_TEST(threads_32)
+{
+    arc_darray_parallel_sort(darray, &arc_cmp_int, 32);
+}
+
+ARC_PERF_TEST(threads_64)
+{
+    arc_darray_parallel_sort(darray, &arc_cmp_int, 64);
+}
+
+ARC_PERF_TEST(threads_online)
+{
+    arc_darray_parallel_sort(darray, &arc_cmp_int, 0);
+}
+
+ARC_PERF_TEST_FIXTURE()
+{
+    ARC_PERF_ADD_FUNCTION(global_set_up)
+
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(sort)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(threads_1)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(threads_2)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(threads_4)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(threads_8)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(threads_16)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(threads_32)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(threads_64)
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(threads_online)
+
+    ARC_PERF_ADD_FUNCTION(global_tear_down)
+}
+
+ARC_PERF_RUN_TESTS()
@@ -15,10 +15,18 @@
 #include <string.h>
 
 arc_darray_t darray;
+int batch[1000];
 
 ARC_PERF_FUNCTION(set_up)
 {
+    int i;
+
     darray = arc_darray_create(sizeof(int));
+
+    for (i = 0; i < 1000; i++)
+    {
+        batch[i] = i;
+    }
 }
 
 ARC_PERF_TEST(push_front)
@@ -47,6 +55,23 @@ ARC_PERF_TEST(push_back)
     }
 }
 
+ARC_PERF_TEST(reserve_push_back)
+{
+    int i;
+
+    arc_darray_reserve(darray, 20000);
+
+    for (i = 0; i < 20000; i++)
+    {
+        arc_darray_push_back(darray, (void *)&i);
+    }
+}
+
+ARC_PERF_TEST(shrink_to_fit)
+{
+    arc_darray_shrink_to_fit(darray);
+}
+
 ARC_PERF_TEST(pop_back)
 {
     while(!arc_darray_empty(darray))
@@ -64,6 +89,85 @@ ARC_PERF_TEST(pop_back2)
     }
 }
 
+ARC_PERF_TEST(sliding_window)
+{
+    int i;
+    for (i = 0; i < 200000; i++)
+    {
+        arc_darray_push_back(darray, (void *)&i);
+
+        if (arc_darray_size(darray) > 10000)
+        {
+            arc_darray_pop_front(darray);
+        }
+    }
+}
+
+ARC_PERF_TEST(insert_middle)
+{
+    int i, j;
+    arc_darray_iterator_t it = arc_darray_iterator_create(darray);
+
+    /* Batches inserted one element at a time */
+    for (i = 0; i < 20; i++)
+    {
+        unsigned long middle = arc_darray_size(darray) / 2;
+
+        for (j = 0; j < 1000; j++)
+        {
+            if (arc_darray_position(it, middle + (unsigned long)j) == ARC_SUCCESS)
+            {
+                arc_darray_insert_before(it, &batch[j]);
+            }
+            else
+            {
+                arc_darray_push_back(darray, &batch[j]);
+            }
+        }
+    }
+
+    arc_darray_iterator_destroy(it);
+}
+
+ARC_PERF_TEST(insert_range_middle)
+{
+    int i;
+
+    for (i = 0; i < 20; i++)
+    {
+        arc_darray_insert_range(darray, arc_darray_size(darray) / 2, batch, 1000);
+    }
+}
+
+ARC_PERF_TEST(erase_middle)
+{
+    int i, j;
+    arc_darray_iterator_t it = arc_darray_iterator_create(darray);
+
+    for (i = 0; i < 10; i++)
+    {
+        unsigned long middle = arc_darray_size(darray) / 2;
+
+        for (j = 0; j < 1000; j++)
+        {
+            arc_darray_position(it, middle);
+            arc_darray_erase(it);
+        }
+    }
+
+    arc_darray_iterator_destroy(it);
+}
+
+ARC_PERF_TEST(erase_range_middle)
+{
+    int i;
+
+    for (i = 0; i < 10; i++)
+    {
+        arc_darray_erase_range(darray, arc_darray_size(darray) / 2, 1000);
+    }
+}
+
 ARC_PERF_FUNCTION(tear_down)
 {
     arc_darray_destroy(darray);
@@ -85,6 +189,26 @@ ARC_PERF_TEST_FIXTURE()
     ARC_PERF_ADD_TEST(push_back)
     ARC_PERF_ADD_TEST(pop_back2)
     ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(reserve_push_back)
+    ARC_PERF_ADD_TEST(pop_back2)
+    ARC_PERF_ADD_TEST(shrink_to_fit)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(sliding_window)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(insert_middle)
+    ARC_PERF_ADD_TEST(erase_middle)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(insert_range_middle)
+    ARC_PERF_ADD_TEST(erase_range_middle)
+    ARC_PERF_ADD_FUNCTION(tear_down)
 }
 
 ARC_PERF_RUN_TESTS()
@@ -0,0 +1,108 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <arc/container/darray.h>
+#include <arc/type/function.h>
+#include <arc/test/perf.h>
+#include <arc/common/defines.h>
+
+arc_darray_t darray;
+int *keys;
+size_t num_elems = 1000000;
+unsigned long checksum;
+
+ARC_PERF_FUNCTION(global_set_up)
+{
+    const char * num_elems_str = arc_get_param("-n");
+    size_t i;
+
+    if (num_elems_str != NULL)
+    {
+        num_elems = strtoul(num_elems_str, NULL, 10);
+    }
+
+    darray = arc_darray_create_with_capacity(sizeof(int), num_elems, 0);
+    keys = malloc(num_elems * sizeof(int));
+
+    srand(1);
+
+    for (i = 0; i < num_elems; i++)
+    {
+        int value = (int)(2 * i);
+
+        arc_darray_push_back(darray, &value);
+        keys[i] = (int)((size_t)rand() % (2 * num_elems));
+    }
+}
+
+ARC_PERF_FUNCTION(global_tear_down)
+{
+    free(keys);
+    arc_darray_destroy(darray);
+    printf("checksum %lu\n", checksum);
+}
+
+ARC_PERF_TEST(lower_bound)
+{
+    size_t i;
+
+    for (i = 0; i < num_elems; i++)
+    {
+        checksum += arc_darray_lower_bound(darray, &keys[i], &arc_cmp_int);
+    }
+}
+
+ARC_PERF_TEST(lower_bound_int)
+{
+    size_t i;
+
+    for (i = 0; i < num_elems; i++)
+    {
+        checksum += arc_darray_lower_bound_int(darray, keys[i]);
+    }
+}
+
+ARC_PERF_TEST(equal_range)
+{
+    size_t i;
+    unsigned long first, last;
+
+    for (i = 0; i < num_elems; i++)
+    {
+        arc_darray_equal_range(darray, &keys[i], &arc_cmp_int, &first, &last);
+        checksum += last - first;
+    }
+}
+
+ARC_PERF_TEST(equal_range_int)
+{
+    size_t i;
+
+    for (i = 0; i < num_elems; i++)
+    {
+        checksum += arc_darray_upper_bound_int(darray, keys[i]) -
+                    arc_darray_lower_bound_int(darray, keys[i]);
+    }
+}
+
+ARC_PERF_TEST_FIXTURE()
+{
+    ARC_PERF_ADD_FUNCTION(global_set_up)
+
+    ARC_PERF_ADD_TEST(lower_bound)
+    ARC_PERF_ADD_TEST(lower_bound_int)
+    ARC_PERF_ADD_TEST(equal_range)
+    ARC_PERF_ADD_TEST(equal_range_int)
+
+    ARC_PERF_ADD_FUNCTION(global_tear_down)
+}
+
+ARC_PERF_RUN_TESTS()
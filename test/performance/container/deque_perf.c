@@ -15,10 +15,18 @@
 #include <string.h>
 
 arc_deque_t deque;
+int batch[1000];
 
 ARC_PERF_FUNCTION(set_up)
 {
+    int i;
+
     deque = arc_deque_create(sizeof(int));
+
+    for (i = 0; i < 1000; i++)
+    {
+        batch[i] = i;
+    }
 }
 
 ARC_PERF_TEST(push_front)
@@ -64,6 +72,71 @@ ARC_PERF_TEST(pop_back2)
     }
 }
 
+ARC_PERF_TEST(insert_middle)
+{
+    int i, j;
+    arc_deque_iterator_t it = arc_deque_iterator_create(deque);
+
+    /* Batches inserted one element at a time */
+    for (i = 0; i < 20; i++)
+    {
+        unsigned long middle = arc_deque_size(deque) / 2;
+
+        for (j = 0; j < 1000; j++)
+        {
+            if (arc_deque_position(it, middle + (unsigned long)j) == ARC_SUCCESS)
+            {
+                arc_deque_insert_before(it, &batch[j]);
+            }
+            else
+            {
+                arc_deque_push_back(deque, &batch[j]);
+            }
+        }
+    }
+
+    arc_deque_iterator_destroy(it);
+}
+
+ARC_PERF_TEST(insert_range_middle)
+{
+    int i;
+
+    for (i = 0; i < 20; i++)
+    {
+        arc_deque_insert_range(deque, arc_deque_size(deque) / 2, batch, 1000);
+    }
+}
+
+ARC_PERF_TEST(erase_middle)
+{
+    int i, j;
+    arc_deque_iterator_t it = arc_deque_iterator_create(deque);
+
+    for (i = 0; i < 10; i++)
+    {
+        unsigned long middle = arc_deque_size(deque) / 2;
+
+        for (j = 0; j < 1000; j++)
+        {
+            arc_deque_position(it, middle);
+            arc_deque_erase(it);
+        }
+    }
+
+    arc_deque_iterator_destroy(it);
+}
+
+ARC_PERF_TEST(erase_range_middle)
+{
+    int i;
+
+    for (i = 0; i < 10; i++)
+    {
+        arc_deque_erase_range(deque, arc_deque_size(deque) / 2, 1000);
+    }
+}
+
 ARC_PERF_FUNCTION(tear_down)
 {
     arc_deque_destroy(deque);
@@ -85,6 +158,16 @@ ARC_PERF_TEST_FIXTURE()
     ARC_PERF_ADD_TEST(push_back)
     ARC_PERF_ADD_TEST(pop_back2)
     ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(insert_middle)
+    ARC_PERF_ADD_TEST(erase_middle)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(insert_range_middle)
+    ARC_PERF_ADD_TEST(erase_range_middle)
+    ARC_PERF_ADD_FUNCTION(tear_down)
 }
 
 ARC_PERF_RUN_TESTS()
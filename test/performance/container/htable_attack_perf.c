@@ -0,0 +1,127 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <arc/common/defines.h>
+#include <arc/test/perf.h>
+#include <arc/container/htable.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+/* Every key is a sequence of two byte blocks, each of them either "Pa" or
+   "Q@". Both blocks leave the djb2 state in the same value, so all the keys
+   share the same djb2 hash and end up in a single bucket */
+#define KEY_BLOCKS 16
+#define KEY_SIZE (2 * KEY_BLOCKS)
+
+arc_htable_t htable;
+int num_elems = 20000;
+char *keys;
+
+static int key_cmp(const void *a, const void *b)
+{
+    int result = memcmp(a, b, KEY_SIZE);
+
+    return (result > 0) - (result < 0);
+}
+
+ARC_PERF_FUNCTION(global_set_up)
+{
+    int i, j;
+    const char * num_elems_str = arc_get_param("-n");
+
+    if (num_elems_str != NULL)
+    {
+        num_elems = atoi(num_elems_str);
+    }
+
+    keys = malloc(KEY_SIZE * ((size_t)num_elems));
+
+    for (i = 0; i < num_elems; i++)
+    {
+        char *key = keys + i * KEY_SIZE;
+
+        for (j = 0; j < KEY_BLOCKS; j++)
+        {
+            int bit = (i >> j) & 1;
+
+            key[2 * j] = bit ? 'Q' : 'P';
+            key[2 * j + 1] = bit ? '@' : 'a';
+        }
+    }
+}
+
+ARC_PERF_FUNCTION(global_tear_down)
+{
+    free(keys);
+}
+
+ARC_PERF_FUNCTION(set_up_djb2)
+{
+    htable = arc_htable_create(100, KEY_SIZE, key_cmp, arc_hash_djb2);
+}
+
+ARC_PERF_FUNCTION(set_up_seeded)
+{
+    htable = arc_htable_create_seeded(100, KEY_SIZE, key_cmp,
+                                      arc_hash_wy_seeded);
+}
+
+ARC_PERF_FUNCTION(set_up_open_seeded)
+{
+    htable = arc_htable_create_open_seeded(100, KEY_SIZE, key_cmp,
+                                           arc_hash_wy_seeded);
+}
+
+ARC_PERF_TEST(insert)
+{
+    int i;
+    for (i = 0; i < num_elems; i++)
+    {
+        arc_htable_insert(htable, keys + i * KEY_SIZE);
+    }
+}
+
+ARC_PERF_TEST(retrieve)
+{
+    int i;
+    for (i = 0; i < num_elems; i++)
+    {
+        arc_htable_retrieve(htable, keys + i * KEY_SIZE);
+    }
+}
+
+ARC_PERF_FUNCTION(tear_down)
+{
+    arc_htable_destroy(htable);
+}
+
+ARC_PERF_TEST_FIXTURE()
+{
+    ARC_PERF_ADD_FUNCTION(global_set_up)
+
+    ARC_PERF_ADD_FUNCTION(set_up_djb2)
+    ARC_PERF_ADD_TEST(insert)
+    ARC_PERF_ADD_TEST(retrieve)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up_seeded)
+    ARC_PERF_ADD_TEST(insert)
+    ARC_PERF_ADD_TEST(retrieve)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up_open_seeded)
+    ARC_PERF_ADD_TEST(insert)
+    ARC_PERF_ADD_TEST(retrieve)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(global_tear_down)
+}
+
+ARC_PERF_RUN_TESTS()
@@ -17,6 +17,8 @@
 arc_htable_t htable;
 int num_elems = 20000;
 int *values;
+int *random_keys;
+void **results;
 
 arc_hkey_t hash_function(const void *key, size_t size)
 {
@@ -40,11 +42,23 @@ ARC_PERF_FUNCTION(global_set_up)
     {
         values[i] = i;
     }
+
+    random_keys = malloc(sizeof(int) * ((size_t)num_elems));
+    results = malloc(sizeof(void *) * ((size_t)num_elems));
+
+    srand(0);
+
+    for (i = 0; i < num_elems; i++)
+    {
+        random_keys[i] = rand() % num_elems;
+    }
 }
 
 ARC_PERF_FUNCTION(global_tear_down)
 {
     free(values);
+    free(random_keys);
+    free(results);
 }
 
 ARC_PERF_FUNCTION(set_up)
@@ -52,6 +66,23 @@ ARC_PERF_FUNCTION(set_up)
     htable = arc_htable_create(100, sizeof(int), arc_cmp_int, hash_function);
 }
 
+ARC_PERF_FUNCTION(set_up_pooled)
+{
+    htable = arc_htable_create_pooled(100, sizeof(int), arc_cmp_int,
+                                      hash_function);
+}
+
+ARC_PERF_FUNCTION(set_up_open)
+{
+    htable = arc_htable_create_open(100, sizeof(int),
+                                    arc_cmp_int, hash_function);
+}
+
+ARC_PERF_FUNCTION(set_up_int32)
+{
+    htable = arc_htable_create(100, sizeof(int), arc_cmp_int, arc_hash_int32);
+}
+
 ARC_PERF_TEST(insert)
 {
     int i;
@@ -74,10 +105,10 @@ ARC_PERF_TEST(random_insert)
 }
 
 
-/*ARC_PERF_TEST(rehash)*/
-/*{*/
-    /*arc_htable_rehash(htable, (size_t)num_elems);*/
-/*}*/
+ARC_PERF_TEST(rehash)
+{
+    arc_htable_rehash(htable, (size_t)num_elems);
+}
 
 ARC_PERF_TEST(retrieve)
 {
@@ -88,6 +119,11 @@ ARC_PERF_TEST(retrieve)
     }
 }
 
+ARC_PERF_TEST(clear)
+{
+    arc_htable_clear(htable);
+}
+
 ARC_PERF_TEST(random_retrieve)
 {
     int i;
@@ -101,6 +137,21 @@ ARC_PERF_TEST(random_retrieve)
 }
 
 
+ARC_PERF_TEST(random_retrieve_keys)
+{
+    int i;
+
+    for (i = 0; i < num_elems; i++)
+    {
+        arc_htable_retrieve(htable, &random_keys[i]);
+    }
+}
+
+ARC_PERF_TEST(random_retrieve_batch)
+{
+    arc_htable_retrieve_batch(htable, random_keys, (size_t)num_elems, results);
+}
+
 ARC_PERF_FUNCTION(tear_down)
 {
     arc_htable_destroy(htable);
@@ -113,11 +164,18 @@ ARC_PERF_TEST_FIXTURE()
     ARC_PERF_ADD_FUNCTION(set_up)
     ARC_PERF_ADD_TEST(insert)
     ARC_PERF_ADD_TEST(retrieve)
+    ARC_PERF_ADD_TEST(clear)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up_pooled)
+    ARC_PERF_ADD_TEST(insert)
+    ARC_PERF_ADD_TEST(retrieve)
+    ARC_PERF_ADD_TEST(clear)
     ARC_PERF_ADD_FUNCTION(tear_down)
 
     ARC_PERF_ADD_FUNCTION(set_up)
     ARC_PERF_ADD_TEST(insert)
-    /*ARC_PERF_ADD_TEST(rehash)*/
+    ARC_PERF_ADD_TEST(rehash)
     ARC_PERF_ADD_TEST(retrieve)
     ARC_PERF_ADD_FUNCTION(tear_down)
 
@@ -128,10 +186,37 @@ ARC_PERF_TEST_FIXTURE()
 
     ARC_PERF_ADD_FUNCTION(set_up)
     ARC_PERF_ADD_TEST(random_insert)
-    /*ARC_PERF_ADD_TEST(rehash)*/
+    ARC_PERF_ADD_TEST(rehash)
     ARC_PERF_ADD_TEST(random_retrieve)
     ARC_PERF_ADD_FUNCTION(tear_down)
 
+    ARC_PERF_ADD_FUNCTION(set_up_open)
+    ARC_PERF_ADD_TEST(insert)
+    ARC_PERF_ADD_TEST(retrieve)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up_open)
+    ARC_PERF_ADD_TEST(random_insert)
+    ARC_PERF_ADD_TEST(random_retrieve)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up_int32)
+    ARC_PERF_ADD_TEST(random_insert)
+    ARC_PERF_ADD_TEST(random_retrieve)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up_int32)
+    ARC_PERF_ADD_TEST(insert)
+    ARC_PERF_ADD_TEST(random_retrieve_keys)
+    ARC_PERF_ADD_TEST(random_retrieve_batch)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up_open)
+    ARC_PERF_ADD_TEST(insert)
+    ARC_PERF_ADD_TEST(random_retrieve_keys)
+    ARC_PERF_ADD_TEST(random_retrieve_batch)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
     ARC_PERF_ADD_FUNCTION(global_tear_down)
 }
 
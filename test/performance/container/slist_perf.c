@@ -21,6 +21,11 @@ ARC_PERF_FUNCTION(set_up)
     slist = arc_slist_create(sizeof(int));
 }
 
+ARC_PERF_FUNCTION(set_up_pooled)
+{
+    slist = arc_slist_create_pooled(sizeof(int));
+}
+
 ARC_PERF_TEST(push_front)
 {
     int i;
@@ -49,6 +54,12 @@ ARC_PERF_TEST_FIXTURE()
     ARC_PERF_ADD_TEST(push_front)
     ARC_PERF_ADD_TEST(pop_front)
     ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up_pooled)
+    ARC_PERF_ADD_TEST(push_front)
+    ARC_PERF_ADD_TEST(pop_front)
+    ARC_PERF_ADD_TEST(push_front)
+    ARC_PERF_ADD_FUNCTION(tear_down)
 }
 
 ARC_PERF_RUN_TESTS()
@@ -0,0 +1,167 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+
+/*
+ * Same lookups as the retrieve tests of avltree_perf and the find test of
+ * stl_set_perf, with the avltree and a sorted darray built here as well.
+ */
+
+#include <arc/test/perf.h>
+#include <arc/container/sset.h>
+#include <arc/container/avltree.h>
+#include <arc/container/darray.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+arc_sset_t sset, generic_sset;
+arc_avltree_t tree;
+arc_darray_t darray;
+int *random_values;
+int num_elems = 20000;
+size_t found;
+
+/* Same as arc_cmp_int, but it's not recognized by the sset */
+static int int_cmp(const void *a, const void *b)
+{
+    return arc_cmp_int(a, b);
+}
+
+ARC_PERF_FUNCTION(global_set_up)
+{
+    int i, *visited;
+    const char * num_elems_str = arc_get_param("-n");
+
+    if (num_elems_str != NULL)
+    {
+        num_elems = atoi(num_elems_str);
+    }
+
+    random_values = malloc(sizeof(int) * ((size_t)num_elems));
+    visited = malloc(sizeof(int) * ((size_t)num_elems));
+    memset(visited, 0, sizeof(int) * ((size_t)num_elems));
+
+    for (i = 0; i < num_elems; i++)
+    {
+        int rvalue = rand() % num_elems;
+
+        while (visited[rvalue]) rvalue = rand() % num_elems;
+        random_values[i] = rvalue;
+        visited[rvalue] = 1;
+    }
+
+    free(visited);
+
+    tree = arc_avltree_create(sizeof(int), arc_cmp_int);
+    darray = arc_darray_create_with_capacity(sizeof(int), (size_t)num_elems, 0);
+
+    for (i = 0; i < num_elems; i++)
+    {
+        arc_avltree_insert(tree, &random_values[i]);
+        arc_darray_push_back(darray, &i);
+    }
+}
+
+ARC_PERF_FUNCTION(global_tear_down)
+{
+    if (found == 0)
+    {
+        printf("Unexpected number of elements\n");
+    }
+
+    arc_darray_destroy(darray);
+    arc_avltree_destroy(tree);
+    free(random_values);
+}
+
+ARC_PERF_TEST(build_from_darray)
+{
+    sset = arc_sset_create_from_darray(darray, arc_cmp_int);
+    generic_sset = arc_sset_create_from_darray(darray, int_cmp);
+}
+
+ARC_PERF_TEST(build_from_avltree)
+{
+    arc_sset_destroy(sset);
+    sset = arc_sset_create_from_avltree(tree);
+}
+
+ARC_PERF_TEST(retrieve)
+{
+    int i;
+
+    for (i = num_elems - 1; i >= 0; i--)
+    {
+        found += (arc_sset_retrieve(sset, &i) != NULL);
+    }
+}
+
+ARC_PERF_TEST(random_retrieve)
+{
+    int i;
+
+    for (i = 0; i < num_elems; i++)
+    {
+        found += (arc_sset_retrieve(sset, &random_values[i]) != NULL);
+    }
+}
+
+ARC_PERF_TEST(random_retrieve_generic)
+{
+    int i;
+
+    for (i = 0; i < num_elems; i++)
+    {
+        found += (arc_sset_retrieve(generic_sset, &random_values[i]) != NULL);
+    }
+}
+
+ARC_PERF_TEST(random_retrieve_avltree)
+{
+    int i;
+
+    for (i = 0; i < num_elems; i++)
+    {
+        found += (arc_avltree_retrieve(tree, &random_values[i]) != NULL);
+    }
+}
+
+ARC_PERF_TEST(random_lower_bound_darray)
+{
+    int i;
+
+    for (i = 0; i < num_elems; i++)
+    {
+        found += arc_darray_lower_bound_int(darray, random_values[i]);
+    }
+}
+
+ARC_PERF_FUNCTION(tear_down)
+{
+    arc_sset_destroy(generic_sset);
+    arc_sset_destroy(sset);
+}
+
+ARC_PERF_TEST_FIXTURE()
+{
+    ARC_PERF_ADD_FUNCTION(global_set_up)
+
+    ARC_PERF_ADD_TEST(build_from_darray)
+    ARC_PERF_ADD_TEST(build_from_avltree)
+    ARC_PERF_ADD_TEST(retrieve)
+    ARC_PERF_ADD_TEST(random_retrieve)
+    ARC_PERF_ADD_TEST(random_retrieve_generic)
+    ARC_PERF_ADD_TEST(random_retrieve_avltree)
+    ARC_PERF_ADD_TEST(random_lower_bound_darray)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(global_tear_down)
+}
+
+ARC_PERF_RUN_TESTS()
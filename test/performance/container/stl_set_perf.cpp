@@ -10,6 +10,7 @@
 #include <arc/test/perf.h>
 #include <set>
 #include <cstdlib>
+#include <cstdio>
 
 
 std::set<int> * set;
@@ -39,6 +40,21 @@ ARC_PERF_TEST(insert)
     }
 }
 
+ARC_PERF_TEST(find)
+{
+    int found = 0;
+
+    for (int i = num_elems - 1; i >= 0; i--)
+    {
+        found += (set->find(i) != set->end());
+    }
+
+    if (found != num_elems)
+    {
+        printf("Unexpected number of elements\n");
+    }
+}
+
 ARC_PERF_FUNCTION(destroy)
 {
     delete set;
@@ -55,6 +71,7 @@ ARC_PERF_TEST_FIXTURE()
 
     ARC_PERF_ADD_FUNCTION(create)
     ARC_PERF_ADD_TEST(insert)
+    ARC_PERF_ADD_TEST(find)
     ARC_PERF_ADD_FUNCTION(destroy)
 
     ARC_PERF_ADD_FUNCTION(tear_down)
@@ -0,0 +1,150 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <arc/common/defines.h>
+#include <arc/test/perf.h>
+#include <arc/container/swtable.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+arc_swtable_t swtable;
+int num_elems = 20000;
+int *values;
+
+arc_hkey_t hash_function(const void *key, size_t size)
+{
+    ARC_UNUSED(size);
+    return (arc_hkey_t)*((const int *)key);
+}
+
+ARC_PERF_FUNCTION(global_set_up)
+{
+    int i;
+    const char * num_elems_str = arc_get_param("-n");
+
+    if (num_elems_str != NULL)
+    {
+        num_elems = atoi(num_elems_str);
+    }
+
+    values = malloc(sizeof(int) * ((size_t)num_elems));
+
+    for (i = 0; i < num_elems; i++)
+    {
+        values[i] = i;
+    }
+}
+
+ARC_PERF_FUNCTION(global_tear_down)
+{
+    free(values);
+}
+
+ARC_PERF_FUNCTION(set_up)
+{
+    swtable = arc_swtable_create(100, sizeof(int), arc_cmp_int, hash_function);
+}
+
+ARC_PERF_TEST(insert)
+{
+    int i;
+    for (i = 0; i < num_elems; i++)
+    {
+        arc_swtable_insert(swtable, &i);
+    }
+}
+
+ARC_PERF_TEST(random_insert)
+{
+    int i;
+
+    srand(0);
+
+    for (i = 0; i < num_elems; i++)
+    {
+        arc_swtable_insert(swtable, &values[rand() % num_elems]);
+    }
+}
+
+ARC_PERF_TEST(rehash)
+{
+    arc_swtable_rehash(swtable, (size_t)num_elems);
+}
+
+ARC_PERF_TEST(retrieve)
+{
+    int i;
+    for (i = 0; i < num_elems; i++)
+    {
+        arc_swtable_retrieve(swtable, &i);
+    }
+}
+
+ARC_PERF_TEST(random_retrieve)
+{
+    int i;
+
+    srand(0);
+
+    for (i = 0; i < num_elems; i++)
+    {
+        arc_swtable_retrieve(swtable, &values[rand() % num_elems]);
+    }
+}
+
+ARC_PERF_TEST(missing_retrieve)
+{
+    int i;
+    for (i = num_elems; i < 2 * num_elems; i++)
+    {
+        arc_swtable_retrieve(swtable, &i);
+    }
+}
+
+ARC_PERF_TEST(remove)
+{
+    int i;
+    for (i = 0; i < num_elems; i++)
+    {
+        arc_swtable_remove(swtable, &i);
+    }
+}
+
+ARC_PERF_FUNCTION(tear_down)
+{
+    arc_swtable_destroy(swtable);
+}
+
+ARC_PERF_TEST_FIXTURE()
+{
+    ARC_PERF_ADD_FUNCTION(global_set_up)
+
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(insert)
+    ARC_PERF_ADD_TEST(retrieve)
+    ARC_PERF_ADD_TEST(missing_retrieve)
+    ARC_PERF_ADD_TEST(remove)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(insert)
+    ARC_PERF_ADD_TEST(rehash)
+    ARC_PERF_ADD_TEST(retrieve)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(set_up)
+    ARC_PERF_ADD_TEST(random_insert)
+    ARC_PERF_ADD_TEST(random_retrieve)
+    ARC_PERF_ADD_TEST(missing_retrieve)
+    ARC_PERF_ADD_FUNCTION(tear_down)
+
+    ARC_PERF_ADD_FUNCTION(global_tear_down)
+}
+
+ARC_PERF_RUN_TESTS()
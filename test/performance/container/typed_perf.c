@@ -0,0 +1,206 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <arc/test/perf.h>
+#include <arc/container/typed.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#define int_cmp(a, b) ARC_TYPED_CMP(a, b)
+
+ARC_DEFINE_DARRAY(int_vec, int)
+ARC_DEFINE_AVLTREE(int_set, int, int_cmp)
+
+arc_darray_t darray;
+arc_avltree_t tree;
+int *random_values;
+int num_elems = 20000;
+
+ARC_PERF_FUNCTION(global_set_up)
+{
+    int i, *visited;
+    const char * num_elems_str = arc_get_param("-n");
+
+    if (num_elems_str != NULL)
+    {
+        num_elems = atoi(num_elems_str);
+    }
+
+    random_values = malloc(sizeof(int) * ((size_t)num_elems));
+    visited = malloc(sizeof(int) * ((size_t)num_elems));
+    memset(visited, 0, sizeof(int) * ((size_t)num_elems));
+
+    for (i = 0; i < num_elems; i++)
+    {
+        int rvalue = rand() % num_elems;
+
+        while (visited[rvalue]) rvalue = rand() % num_elems;
+        random_values[i] = rvalue;
+        visited[rvalue] = 1;
+    }
+
+    free(visited);
+}
+
+ARC_PERF_FUNCTION(global_tear_down)
+{
+    free(random_values);
+}
+
+ARC_PERF_FUNCTION(set_up_darray)
+{
+    darray = arc_darray_create(sizeof(int));
+}
+
+ARC_PERF_FUNCTION(set_up_int_vec)
+{
+    darray = int_vec_create();
+}
+
+ARC_PERF_FUNCTION(tear_down_darray)
+{
+    arc_darray_destroy(darray);
+}
+
+ARC_PERF_TEST(darray_push_back)
+{
+    int i;
+
+    for (i = 0; i < num_elems; i++)
+    {
+        arc_darray_push_back(darray, &i);
+    }
+}
+
+ARC_PERF_TEST(darray_sum)
+{
+    long sum = 0;
+    unsigned long i, size = (unsigned long)arc_darray_size(darray);
+
+    for (i = 0; i < size; i++)
+    {
+        sum += *(int *)arc_darray_at(darray, i);
+    }
+
+    if (sum < 0)
+    {
+        printf("Unexpected sum\n");
+    }
+}
+
+ARC_PERF_TEST(int_vec_push_back)
+{
+    int i;
+
+    for (i = 0; i < num_elems; i++)
+    {
+        int_vec_push_back(darray, i);
+    }
+}
+
+ARC_PERF_TEST(int_vec_sum)
+{
+    long sum = 0;
+    size_t i, size = int_vec_size(darray);
+
+    for (i = 0; i < size; i++)
+    {
+        sum += *int_vec_at(darray, i);
+    }
+
+    if (sum < 0)
+    {
+        printf("Unexpected sum\n");
+    }
+}
+
+ARC_PERF_FUNCTION(set_up_avltree)
+{
+    tree = arc_avltree_create_pooled(sizeof(int), arc_cmp_int);
+}
+
+ARC_PERF_FUNCTION(set_up_int_set)
+{
+    tree = int_set_create_pooled();
+}
+
+ARC_PERF_FUNCTION(tear_down_avltree)
+{
+    arc_avltree_destroy(tree);
+}
+
+ARC_PERF_TEST(avltree_random_insert)
+{
+    int i;
+
+    for (i = 0; i < num_elems; i++)
+    {
+        arc_avltree_insert(tree, &random_values[i]);
+    }
+}
+
+ARC_PERF_TEST(avltree_random_retrieve)
+{
+    int i;
+
+    for (i = 0; i < num_elems; i++)
+    {
+        arc_avltree_retrieve(tree, &random_values[i]);
+    }
+}
+
+ARC_PERF_TEST(int_set_random_insert)
+{
+    int i;
+
+    for (i = 0; i < num_elems; i++)
+    {
+        int_set_insert(tree, random_values[i]);
+    }
+}
+
+ARC_PERF_TEST(int_set_random_retrieve)
+{
+    int i;
+
+    for (i = 0; i < num_elems; i++)
+    {
+        int_set_retrieve(tree, random_values[i]);
+    }
+}
+
+ARC_PERF_TEST_FIXTURE()
+{
+    ARC_PERF_ADD_FUNCTION(global_set_up)
+
+    ARC_PERF_ADD_FUNCTION(set_up_darray)
+    ARC_PERF_ADD_TEST(darray_push_back)
+    ARC_PERF_ADD_TEST(darray_sum)
+    ARC_PERF_ADD_FUNCTION(tear_down_darray)
+
+    ARC_PERF_ADD_FUNCTION(set_up_int_vec)
+    ARC_PERF_ADD_TEST(int_vec_push_back)
+    ARC_PERF_ADD_TEST(int_vec_sum)
+    ARC_PERF_ADD_FUNCTION(tear_down_darray)
+
+    ARC_PERF_ADD_FUNCTION(set_up_avltree)
+    ARC_PERF_ADD_TEST(avltree_random_insert)
+    ARC_PERF_ADD_TEST(avltree_random_retrieve)
+    ARC_PERF_ADD_FUNCTION(tear_down_avltree)
+
+    ARC_PERF_ADD_FUNCTION(set_up_int_set)
+    ARC_PERF_ADD_TEST(int_set_random_insert)
+    ARC_PERF_ADD_TEST(int_set_random_retrieve)
+    ARC_PERF_ADD_FUNCTION(tear_down_avltree)
+
+    ARC_PERF_ADD_FUNCTION(global_tear_down)
+}
+
+ARC_PERF_RUN_TESTS()
@@ -0,0 +1,134 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <arc/common/defines.h>
+#include <arc/test/perf.h>
+#include <arc/type/hash.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#define KEY_SIZE 32
+
+int num_elems = 1000000;
+int *values;
+unsigned char *keys;
+volatile arc_hkey_t sink;
+
+ARC_PERF_FUNCTION(global_set_up)
+{
+    int i;
+    const char * num_elems_str = arc_get_param("-n");
+
+    if (num_elems_str != NULL)
+    {
+        num_elems = atoi(num_elems_str);
+    }
+
+    values = malloc(sizeof(int) * ((size_t)num_elems));
+    keys = malloc(KEY_SIZE * ((size_t)num_elems));
+
+    srand(0);
+
+    for (i = 0; i < num_elems; i++)
+    {
+        values[i] = i;
+    }
+
+    for (i = 0; i < KEY_SIZE * num_elems; i++)
+    {
+        keys[i] = (unsigned char)rand();
+    }
+}
+
+ARC_PERF_FUNCTION(global_tear_down)
+{
+    free(values);
+    free(keys);
+}
+
+ARC_PERF_TEST(int_pearson)
+{
+    int i;
+    for (i = 0; i < num_elems; i++)
+    {
+        sink = arc_hash_pearson(&values[i], sizeof(int));
+    }
+}
+
+ARC_PERF_TEST(int_djb2)
+{
+    int i;
+    for (i = 0; i < num_elems; i++)
+    {
+        sink = arc_hash_djb2(&values[i], sizeof(int));
+    }
+}
+
+ARC_PERF_TEST(int_wy)
+{
+    int i;
+    for (i = 0; i < num_elems; i++)
+    {
+        sink = arc_hash_wy(&values[i], sizeof(int));
+    }
+}
+
+ARC_PERF_TEST(int_int32)
+{
+    int i;
+    for (i = 0; i < num_elems; i++)
+    {
+        sink = arc_hash_int32(&values[i], sizeof(int));
+    }
+}
+
+ARC_PERF_TEST(key_pearson)
+{
+    int i;
+    for (i = 0; i < num_elems; i++)
+    {
+        sink = arc_hash_pearson(keys + i * KEY_SIZE, KEY_SIZE);
+    }
+}
+
+ARC_PERF_TEST(key_djb2)
+{
+    int i;
+    for (i = 0; i < num_elems; i++)
+    {
+        sink = arc_hash_djb2(keys + i * KEY_SIZE, KEY_SIZE);
+    }
+}
+
+ARC_PERF_TEST(key_wy)
+{
+    int i;
+    for (i = 0; i < num_elems; i++)
+    {
+        sink = arc_hash_wy(keys + i * KEY_SIZE, KEY_SIZE);
+    }
+}
+
+ARC_PERF_TEST_FIXTURE()
+{
+    ARC_PERF_ADD_FUNCTION(global_set_up)
+
+    ARC_PERF_ADD_TEST(int_pearson)
+    ARC_PERF_ADD_TEST(int_djb2)
+    ARC_PERF_ADD_TEST(int_wy)
+    ARC_PERF_ADD_TEST(int_int32)
+
+    ARC_PERF_ADD_TEST(key_pearson)
+    ARC_PERF_ADD_TEST(key_djb2)
+    ARC_PERF_ADD_TEST(key_wy)
+
+    ARC_PERF_ADD_FUNCTION(global_tear_down)
+}
+
+ARC_PERF_RUN_TESTS()
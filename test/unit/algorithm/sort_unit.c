@@ -0,0 +1,356 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <arc/algorithm/sort.h>
+#include <arc/type/function.h>
+#include <arc/test/unit.h>
+#include <arc/common/defines.h>
+
+/* Not one of the standard sizes, so it goes through the generic sort */
+struct record
+{
+    int key;
+    int id;
+    char payload[12];
+};
+
+static int record_cmp(const void *a, const void *b)
+{
+    return arc_cmp_int(&((const struct record *)a)->key,
+                       &((const struct record *)b)->key);
+}
+
+static unsigned long record_key(const void *a)
+{
+    return arc_key_int(&((const struct record *)a)->key);
+}
+
+/* Same as arc_cmp_int, but it's not recognized by arc_sort */
+static int int_cmp(const void *a, const void *b)
+{
+    return arc_cmp_int(a, b);
+}
+
+static int random_int(void)
+{
+    return rand() - RAND_MAX / 2;
+}
+
+static void fill_pattern(int *array, int num, int pattern)
+{
+    int i;
+
+    for (i = 0; i < num; i++)
+    {
+        if (pattern == 0)
+        {
+            array[i] = random_int();
+        }
+        else if (pattern == 1)
+        {
+            array[i] = i;
+        }
+        else if (pattern == 2)
+        {
+            array[i] = num - i;
+        }
+        else if (pattern == 3)
+        {
+            array[i] = 7;
+        }
+        else if (pattern == 4)
+        {
+            array[i] = (i < num / 2 ? i : num - i);
+        }
+        else
+        {
+            array[i] = rand() & 3;
+        }
+    }
+}
+
+ARC_UNIT_TEST(int_patterns)
+{
+    int sizes[] = {0, 1, 2, 3, 16, 17, 100, 1000, 100000};
+    int *array = malloc(100000 * sizeof(int));
+    int *expected = malloc(100000 * sizeof(int));
+    int *generic = malloc(100000 * sizeof(int));
+    int *radix = malloc(100000 * sizeof(int));
+    unsigned i;
+    int pattern;
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        for (pattern = 0; pattern < 6; pattern++)
+        {
+            size_t num = (size_t)sizes[i];
+
+            fill_pattern(array, sizes[i], pattern);
+            memcpy(expected, array, num * sizeof(int));
+            memcpy(generic, array, num * sizeof(int));
+            memcpy(radix, array, num * sizeof(int));
+            qsort(expected, num, sizeof(int), &arc_cmp_int);
+
+            arc_sort(array, num, sizeof(int), &arc_cmp_int);
+            ARC_ASSERT_INT_EQ(memcmp(array, expected, num * sizeof(int)), 0);
+
+            arc_sort(generic, num, sizeof(int), &int_cmp);
+            ARC_ASSERT_INT_EQ(memcmp(generic, expected, num * sizeof(int)),
+                              0);
+
+            ARC_ASSERT_INT_EQ(arc_radix_sort(radix, num, sizeof(int),
+                                             &arc_key_int), ARC_SUCCESS);
+            ARC_ASSERT_INT_EQ(memcmp(radix, expected, num * sizeof(int)), 0);
+        }
+    }
+
+    free(radix);
+    free(generic);
+    free(expected);
+    free(array);
+}
+
+ARC_UNIT_TEST(typed_fast_paths)
+{
+    int i;
+    unsigned uvalues[1000];
+    long lvalues[1000];
+    unsigned long ulvalues[1000];
+    float fvalues[1000];
+    double dvalues[1000];
+
+    for (i = 0; i < 1000; i++)
+    {
+        uvalues[i] = (unsigned)rand();
+        lvalues[i] = (long)random_int() * 1000;
+        ulvalues[i] = (unsigned long)rand() * 1000;
+        fvalues[i] = (float)random_int() / 1000.0f;
+        dvalues[i] = (double)random_int() / 1000.0;
+    }
+
+    arc_sort(uvalues, 1000, sizeof(unsigned), &arc_cmp_uint);
+    arc_sort(lvalues, 1000, sizeof(long), &arc_cmp_long);
+    arc_sort(ulvalues, 1000, sizeof(unsigned long), &arc_cmp_ulong);
+    arc_sort(fvalues, 1000, sizeof(float), &arc_cmp_float);
+    arc_sort(dvalues, 1000, sizeof(double), &arc_cmp_double);
+
+    for (i = 1; i < 1000; i++)
+    {
+        ARC_ASSERT_TRUE(uvalues[i - 1] <= uvalues[i]);
+        ARC_ASSERT_TRUE(lvalues[i - 1] <= lvalues[i]);
+        ARC_ASSERT_TRUE(ulvalues[i - 1] <= ulvalues[i]);
+        ARC_ASSERT_TRUE(fvalues[i - 1] <= fvalues[i]);
+        ARC_ASSERT_TRUE(dvalues[i - 1] <= dvalues[i]);
+    }
+}
+
+ARC_UNIT_TEST(radix_keys)
+{
+    int i;
+    unsigned uvalues[1000];
+    long lvalues[1000];
+    unsigned long ulvalues[1000];
+    float fvalues[1000];
+    double dvalues[1000];
+
+    for (i = 0; i < 1000; i++)
+    {
+        uvalues[i] = (unsigned)rand();
+        lvalues[i] = (long)random_int() * 1000;
+        ulvalues[i] = (unsigned long)rand() * 1000;
+        fvalues[i] = (float)random_int() / 1000.0f;
+        dvalues[i] = (double)random_int() / 1000.0;
+    }
+
+    ARC_ASSERT_INT_EQ(arc_radix_sort(uvalues, 1000, sizeof(unsigned),
+                                     &arc_key_uint), ARC_SUCCESS);
+    ARC_ASSERT_INT_EQ(arc_radix_sort(lvalues, 1000, sizeof(long),
+                                     &arc_key_long), ARC_SUCCESS);
+    ARC_ASSERT_INT_EQ(arc_radix_sort(ulvalues, 1000, sizeof(unsigned long),
+                                     &arc_key_ulong), ARC_SUCCESS);
+    ARC_ASSERT_INT_EQ(arc_radix_sort(fvalues, 1000, sizeof(float),
+                                     &arc_key_float), ARC_SUCCESS);
+    ARC_ASSERT_INT_EQ(arc_radix_sort(dvalues, 1000, sizeof(double),
+                                     &arc_key_double), ARC_SUCCESS);
+
+    for (i = 1; i < 1000; i++)
+    {
+        ARC_ASSERT_TRUE(uvalues[i - 1] <= uvalues[i]);
+        ARC_ASSERT_TRUE(lvalues[i - 1] <= lvalues[i]);
+        ARC_ASSERT_TRUE(ulvalues[i - 1] <= ulvalues[i]);
+        ARC_ASSERT_TRUE(fvalues[i - 1] <= fvalues[i]);
+        ARC_ASSERT_TRUE(dvalues[i - 1] <= dvalues[i]);
+    }
+}
+
+ARC_UNIT_TEST(records)
+{
+    int i;
+    struct record *records = malloc(10000 * sizeof(struct record));
+    struct record *sorted = malloc(10000 * sizeof(struct record));
+
+    for (i = 0; i < 10000; i++)
+    {
+        records[i].key = (rand() & 255) - 128;
+        records[i].id = i;
+        memset(records[i].payload, i & 0x7F, sizeof(records[i].payload));
+    }
+
+    memcpy(sorted, records, 10000 * sizeof(struct record));
+    arc_sort(sorted, 10000, sizeof(struct record), &record_cmp);
+
+    for (i = 0; i < 10000; i++)
+    {
+        /* The records are moved as a whole */
+        ARC_ASSERT_INT_EQ(sorted[i].payload[11], sorted[i].id & 0x7F);
+        ARC_ASSERT_INT_EQ(sorted[i].key, records[sorted[i].id].key);
+
+        if (i > 0)
+        {
+            ARC_ASSERT_INT_LE(sorted[i - 1].key, sorted[i].key);
+        }
+    }
+
+    /* The radix sort is stable, equal keys keep their order */
+    memcpy(sorted, records, 10000 * sizeof(struct record));
+    ARC_ASSERT_INT_EQ(arc_radix_sort(sorted, 10000, sizeof(struct record),
+                                     &record_key), ARC_SUCCESS);
+
+    for (i = 1; i < 10000; i++)
+    {
+        ARC_ASSERT_INT_LE(sorted[i - 1].key, sorted[i].key);
+        ARC_ASSERT_INT_EQ(sorted[i].payload[0], sorted[i].id & 0x7F);
+
+        if (sorted[i - 1].key == sorted[i].key)
+        {
+            ARC_ASSERT_INT_LT(sorted[i - 1].id, sorted[i].id);
+        }
+    }
+
+    free(sorted);
+    free(records);
+}
+
+ARC_UNIT_TEST(parallel)
+{
+    int sizes[] = {0, 1, 100, 9000, 100000, 300001};
+    int *array = malloc(300001 * sizeof(int));
+    int *expected = malloc(300001 * sizeof(int));
+    struct record *records = malloc(50000 * sizeof(struct record));
+    arc_pool_t pool = arc_pool_create(5);
+    unsigned i;
+    int pattern;
+
+    ARC_ASSERT_POINTER_NOT_NULL(pool);
+    ARC_ASSERT_INT_EQ((int)arc_pool_num_threads(pool), 5);
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        for (pattern = 0; pattern < 6; pattern++)
+        {
+            size_t num = (size_t)sizes[i];
+
+            fill_pattern(array, sizes[i], pattern);
+            memcpy(expected, array, num * sizeof(int));
+            qsort(expected, num, sizeof(int), &arc_cmp_int);
+
+            ARC_ASSERT_INT_EQ(arc_parallel_sort(array, num, sizeof(int),
+                                                &int_cmp, pool), ARC_SUCCESS);
+            ARC_ASSERT_INT_EQ(memcmp(array, expected, num * sizeof(int)), 0);
+        }
+    }
+
+    for (i = 0; i < 50000; i++)
+    {
+        records[i].key = (rand() & 1023) - 512;
+        records[i].id = (int)i;
+        memset(records[i].payload, (int)(i & 0x7F), sizeof(records[i].payload));
+    }
+
+    ARC_ASSERT_INT_EQ(arc_parallel_sort(records, 50000, sizeof(struct record),
+                                        &record_cmp, pool), ARC_SUCCESS);
+
+    for (i = 0; i < 50000; i++)
+    {
+        ARC_ASSERT_INT_EQ(records[i].payload[11], records[i].id & 0x7F);
+
+        if (i > 0)
+        {
+            ARC_ASSERT_INT_LE(records[i - 1].key, records[i].key);
+        }
+    }
+
+    arc_pool_destroy(pool);
+    free(records);
+    free(expected);
+    free(array);
+}
+
+ARC_UNIT_TEST(memcmp_order)
+{
+    char *keys = malloc(20000 * 5);
+    arc_pool_t pool = arc_pool_create(2);
+    unsigned long sum, sorted_sum;
+    int round;
+    size_t i;
+
+    ARC_ASSERT_POINTER_NOT_NULL(pool);
+
+    /* Without comparison function the bytes are compared with memcmp */
+    for (round = 0; round < 2; round++)
+    {
+        sum = sorted_sum = 0;
+
+        for (i = 0; i < 20000 * 5; i++)
+        {
+            keys[i] = (char)(rand() & 0xFF);
+            sum += (unsigned char)keys[i];
+        }
+
+        if (round == 0)
+        {
+            arc_sort(keys, 20000, 5, NULL);
+        }
+        else
+        {
+            ARC_ASSERT_INT_EQ(arc_parallel_sort(keys, 20000, 5, NULL, pool),
+                              ARC_SUCCESS);
+        }
+
+        for (i = 0; i < 20000 * 5; i++)
+        {
+            sorted_sum += (unsigned char)keys[i];
+        }
+
+        ARC_ASSERT_TRUE(sum == sorted_sum);
+
+        for (i = 1; i < 20000; i++)
+        {
+            ARC_ASSERT_INT_LE(memcmp(keys + (i - 1) * 5, keys + i * 5, 5), 0);
+        }
+    }
+
+    arc_pool_destroy(pool);
+    free(keys);
+}
+
+ARC_UNIT_TEST_FIXTURE()
+{
+    ARC_UNIT_ADD_TEST(int_patterns)
+    ARC_UNIT_ADD_TEST(typed_fast_paths)
+    ARC_UNIT_ADD_TEST(radix_keys)
+    ARC_UNIT_ADD_TEST(records)
+    ARC_UNIT_ADD_TEST(parallel)
+    ARC_UNIT_ADD_TEST(memcmp_order)
+}
+
+ARC_UNIT_RUN_TESTS()
@@ -9,6 +9,8 @@
 
 #include <stdio.h>
 #include <arc/container/avltree.h>
+#include <arc/container/tree_def.h>
+#include <arc/container/avltree_def.h>
 #include <arc/test/unit.h>
 #include <arc/common/defines.h>
 #include <stdlib.h>
@@ -143,6 +145,45 @@ ARC_UNIT_TEST(retrieve)
     arc_avltree_destroy(avltree);
 }
 
+ARC_UNIT_TEST(retrieve_batch)
+{
+    unsigned i;
+    int keys[64];
+    void *results[64];
+    arc_avltree_t avltree = arc_avltree_create(sizeof(int), arc_cmp_int);
+
+    ARC_ASSERT_POINTER_NOT_NULL(avltree);
+
+    for (i = 0; i < sizeof(tree_data)/sizeof(unsigned); i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_avltree_insert(avltree, (void *)&tree_data[i]),
+                          ARC_SUCCESS);
+    }
+
+    for (i = 0; i < 64; i++)
+    {
+        keys[i] = (int)(63 - i);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_avltree_retrieve_batch(avltree, keys, 64, results),
+                      31);
+
+    for (i = 0; i < 64; i++)
+    {
+        if (keys[i] >= 1 && keys[i] < 32)
+        {
+            ARC_ASSERT_POINTER_NOT_NULL(results[i]);
+            ARC_ASSERT_INT_EQ(*(int *)results[i], keys[i]);
+        }
+        else
+        {
+            ARC_ASSERT_POINTER_NULL(results[i]);
+        }
+    }
+
+    arc_avltree_destroy(avltree);
+}
+
 ARC_UNIT_TEST(remove)
 {
     unsigned i, val;
@@ -298,6 +339,99 @@ ARC_UNIT_TEST(iterators_position)
     arc_avltree_destroy(avltree);
 }
 
+ARC_UNIT_TEST(iterators_bounds)
+{
+    int i, key;
+    arc_avltree_t avltree = arc_avltree_create(sizeof(int), arc_cmp_int);
+    arc_avltree_iterator_t it = arc_avltree_iterator_create(avltree);
+
+    ARC_ASSERT_POINTER_NOT_NULL(avltree);
+
+    /* Empty tree */
+    key = 0;
+    ARC_ASSERT_FALSE(arc_avltree_lower_bound(it, &key));
+    ARC_ASSERT_FALSE(arc_avltree_upper_bound(it, &key));
+
+    /* Even numbers from 0 to 98 */
+    for (i = 0; i < 50; i++)
+    {
+        key = 2 * ((i * 17) % 50);
+        ARC_ASSERT_INT_EQ(arc_avltree_insert(avltree, &key), ARC_SUCCESS);
+    }
+
+    for (key = -1; key < 98; key++)
+    {
+        int lower = (key < 0 ? 0 : key + (key & 1));
+        int upper = (key < 0 ? 0 : key + 2 - (key & 1));
+
+        ARC_ASSERT_TRUE(arc_avltree_lower_bound(it, &key));
+        ARC_ASSERT_INT_EQ(*(int *)arc_avltree_data(it), lower);
+
+        if (upper < 100)
+        {
+            ARC_ASSERT_TRUE(arc_avltree_upper_bound(it, &key));
+            ARC_ASSERT_INT_EQ(*(int *)arc_avltree_data(it), upper);
+        }
+        else
+        {
+            ARC_ASSERT_FALSE(arc_avltree_upper_bound(it, &key));
+        }
+    }
+
+    /* Past the last element the iterator can still go backwards */
+    key = 99;
+    ARC_ASSERT_FALSE(arc_avltree_lower_bound(it, &key));
+    ARC_ASSERT_TRUE(arc_avltree_previous(it));
+    ARC_ASSERT_INT_EQ(*(int *)arc_avltree_data(it), 98);
+
+    arc_avltree_iterator_destroy(it);
+    arc_avltree_destroy(avltree);
+}
+
+ARC_UNIT_TEST(iterators_range)
+{
+    int i, key, first, last, found;
+    arc_avltree_t avltree = arc_avltree_create(sizeof(int), arc_cmp_int);
+    arc_avltree_iterator_t it = arc_avltree_iterator_create(avltree);
+
+    ARC_ASSERT_POINTER_NOT_NULL(avltree);
+
+    /* Even numbers from 0 to 98 */
+    for (i = 0; i < 50; i++)
+    {
+        key = 2 * ((i * 17) % 50);
+        ARC_ASSERT_INT_EQ(arc_avltree_insert(avltree, &key), ARC_SUCCESS);
+    }
+
+    for (first = -3; first < 102; first += 3)
+    {
+        for (last = first - 1; last < 104; last += 5)
+        {
+            int expected = (first < 0 ? 0 : first + (first & 1));
+            int count = 0;
+
+            for (found = arc_avltree_range(it, &first, &last); found;
+                 found = arc_avltree_range_next(it, &last))
+            {
+                ARC_ASSERT_INT_EQ(*(int *)arc_avltree_data(it), expected);
+                expected += 2;
+                count++;
+            }
+
+            /* Every element of the range was visited */
+            for (key = 0; key < 100; key += 2)
+            {
+                count -= (key >= first && key < last);
+            }
+
+            ARC_ASSERT_INT_EQ(count, 0);
+        }
+    }
+
+    arc_avltree_iterator_destroy(it);
+    arc_avltree_destroy(avltree);
+}
+
 ARC_UNIT_TEST(iterators_remove)
 {
     unsigned i, val;
@@ -371,6 +505,534 @@ ARC_UNIT_TEST(iterators_remove)
     arc_avltree_destroy(avltree);
 }
 
+ARC_UNIT_TEST(order_statistics)
+{
+    int i, k, round;
+    char present[1000];
+    arc_avltree_t avltree = arc_avltree_create(sizeof(int), arc_cmp_int);
+    arc_avltree_iterator_t it = arc_avltree_iterator_create(avltree);
+
+    ARC_ASSERT_POINTER_NOT_NULL(avltree);
+    ARC_ASSERT_POINTER_NULL(arc_avltree_select(avltree, 0));
+
+    memset(present, 0, sizeof(present));
+    srand(7);
+
+    /* Random insertions and removals, checking every position each round */
+    for (round = 0; round < 40; round++)
+    {
+        int rank = 0;
+
+        for (i = 0; i < 100; i++)
+        {
+            int value = rand() % 1000;
+
+            if (round % 3 == 2)
+            {
+                arc_avltree_remove(avltree, &value);
+                present[value] = 0;
+            }
+            else
+            {
+                arc_avltree_insert(avltree, &value);
+                present[value] = 1;
+            }
+        }
+
+        for (i = 0; i < 1000; i++)
+        {
+            ARC_ASSERT_INT_EQ((int)arc_avltree_rank(avltree, &i), rank);
+
+            if (present[i])
+            {
+                k = rank++;
+                ARC_ASSERT_INT_EQ(*(int *)arc_avltree_select(avltree,
+                                                             (size_t)k), i);
+                ARC_ASSERT_TRUE(arc_avltree_position_select(it, (size_t)k));
+                ARC_ASSERT_INT_EQ(*(int *)arc_avltree_data(it), i);
+            }
+        }
+
+        ARC_ASSERT_INT_EQ(rank, (int)arc_avltree_size(avltree));
+        ARC_ASSERT_POINTER_NULL(arc_avltree_select(avltree, (size_t)rank));
+        ARC_ASSERT_FALSE(arc_avltree_position_select(it, (size_t)rank));
+    }
+
+    arc_avltree_iterator_destroy(it);
+    arc_avltree_destroy(avltree);
+}
+
+/* Returns the height of the subtree, or -1 if its links, balance factors or
+   sizes are wrong */
+static int check_node(struct arc_avltree_node *node,
+                      struct arc_avltree_node *parent)
+{
+    int left, right;
+
+    if (node == NULL)
+    {
+        return 0;
+    }
+
+    left = check_node(node->left, node);
+    right = check_node(node->right, node);
+
+    if (left < 0 || right < 0 || node->parent != parent ||
+        node->balance_factor != right - left || abs(right - left) > 1 ||
+        node->count != 1 + (node->left ? node->left->count : 0) +
+                       (node->right ? node->right->count : 0))
+    {
+        return -1;
+    }
+
+    return 1 + (left > right ? left : right);
+}
+
+/* Checks that the avltree holds the elements, in order, with the right
+   positions and no matter how it was built */
+static int check_elements(arc_avltree_t avltree, const int * data, int n)
+{
+    int i;
+    arc_avltree_iterator_t it = arc_avltree_iterator_create(avltree);
+    struct arc_avltree_node *root = (struct arc_avltree_node *)avltree->root;
+
+    if ((int)arc_avltree_size(avltree) != n || check_node(root, NULL) < 0 ||
+        (root != NULL && (int)root->count != n))
+    {
+        arc_avltree_iterator_destroy(it);
+        return 0;
+    }
+
+    arc_avltree_before_begin(it);
+
+    for (i = 0; i < n; i++)
+    {
+        if (!arc_avltree_next(it) || *(int *)arc_avltree_data(it) != data[i] ||
+            *(int *)arc_avltree_select(avltree, (size_t)i) != data[i] ||
+            (int)arc_avltree_rank(avltree, &data[i]) != i)
+        {
+            arc_avltree_iterator_destroy(it);
+            return 0;
+        }
+    }
+
+    i = arc_avltree_next(it);
+    arc_avltree_iterator_destroy(it);
+
+    return !i;
+}
+
+ARC_UNIT_TEST(build_sorted)
+{
+    int i, n;
+    int data[600];
+    arc_avltree_t avltree;
+
+    for (i = 0; i < 600; i++)
+    {
+        data[i] = 2 * i;
+    }
+
+    for (n = 0; n <= 600; n += (n < 40 ? 1 : 140))
+    {
+        avltree = arc_avltree_create(sizeof(int), arc_cmp_int);
+
+        ARC_ASSERT_POINTER_NOT_NULL(avltree);
+        ARC_ASSERT_INT_EQ(arc_avltree_build_sorted(avltree, data, (size_t)n),
+                          ARC_SUCCESS);
+        ARC_ASSERT_TRUE(check_elements(avltree, data, n));
+
+        /* The balance factors allow regular updates afterwards */
+        for (i = 0; i < n; i += 2)
+        {
+            arc_avltree_remove(avltree, &data[i]);
+        }
+
+        for (i = 0; i < n; i += 2)
+        {
+            ARC_ASSERT_INT_EQ(arc_avltree_insert(avltree, &data[i]),
+                              ARC_SUCCESS);
+        }
+
+        ARC_ASSERT_TRUE(check_elements(avltree, data, n));
+
+        arc_avltree_destroy(avltree);
+    }
+
+    avltree = arc_avltree_create(sizeof(int), arc_cmp_int);
+
+    ARC_ASSERT_POINTER_NOT_NULL(avltree);
+
+    /* Unsorted input, repeated elements and a non empty avltree */
+    data[1] = 1000;
+    ARC_ASSERT_INT_EQ(arc_avltree_build_sorted(avltree, data, 10), ARC_ERROR);
+    data[1] = 0;
+    ARC_ASSERT_INT_EQ(arc_avltree_build_sorted(avltree, data, 10), ARC_ERROR);
+    data[1] = 2;
+    ARC_ASSERT_TRUE(arc_avltree_empty(avltree));
+
+    ARC_ASSERT_INT_EQ(arc_avltree_build_sorted(avltree, data, 10),
+                      ARC_SUCCESS);
+    ARC_ASSERT_INT_EQ(arc_avltree_build_sorted(avltree, data, 10), ARC_ERROR);
+    ARC_ASSERT_TRUE(check_elements(avltree, data, 10));
+
+    arc_avltree_destroy(avltree);
+}
+
+ARC_UNIT_TEST(insert_sorted)
+{
+    int i;
+    int input[400], merged[300];
+    int num_merged = 0;
+    arc_avltree_t avltree = arc_avltree_create(sizeof(int), arc_cmp_int);
+
+    ARC_ASSERT_POINTER_NOT_NULL(avltree);
+
+    /* Multiples of three in the avltree, every even number twice in the
+       input */
+    for (i = 0; i < 400; i++)
+    {
+        input[i] = 2 * (i / 2);
+    }
+
+    for (i = 0; i < 400; i++)
+    {
+        if (i * 3 < 400)
+        {
+            int value = i * 3;
+            arc_avltree_insert(avltree, &value);
+        }
+
+        if (i % 2 == 0 || i % 3 == 0)
+        {
+            merged[num_merged++] = i;
+        }
+    }
+
+    ARC_ASSERT_INT_EQ(arc_avltree_insert_sorted(avltree, input, 400),
+                      ARC_SUCCESS);
+    ARC_ASSERT_TRUE(check_elements(avltree, merged, num_merged));
+
+    /* Nothing new to insert */
+    ARC_ASSERT_INT_EQ(arc_avltree_insert_sorted(avltree, merged,
+                                                (size_t)num_merged),
+                      ARC_SUCCESS);
+    ARC_ASSERT_INT_EQ(arc_avltree_insert_sorted(avltree, input, 0),
+                      ARC_SUCCESS);
+    ARC_ASSERT_TRUE(check_elements(avltree, merged, num_merged));
+
+    input[10] = 1000;
+    ARC_ASSERT_INT_EQ(arc_avltree_insert_sorted(avltree, input, 400),
+                      ARC_ERROR);
+    ARC_ASSERT_TRUE(check_elements(avltree, merged, num_merged));
+
+    for (i = 0; i < num_merged; i++)
+    {
+        arc_avltree_remove(avltree, &merged[i]);
+    }
+
+    ARC_ASSERT_TRUE(arc_avltree_empty(avltree));
+
+    arc_avltree_destroy(avltree);
+}
+
+/* Fills the avltree with the values marked in the set and the expected
+   elements with those marked in the result */
+static int fill_set(arc_avltree_t avltree, const char * set, int * expected,
+                    const char * result, int n)
+{
+    int i, num = 0;
+
+    for (i = 0; i < n; i++)
+    {
+        if (set != NULL && set[i])
+        {
+            arc_avltree_insert(avltree, &i);
+        }
+
+        if (result != NULL && result[i])
+        {
+            expected[num++] = i;
+        }
+    }
+
+    return num;
+}
+
+ARC_UNIT_TEST(split_join)
+{
+    int i, key, num;
+    int expected[500];
+    char set[1000], result[1000];
+    arc_avltree_t avltree = arc_avltree_create(sizeof(int), arc_cmp_int);
+    arc_avltree_t left = arc_avltree_create(sizeof(int), arc_cmp_int);
+    arc_avltree_t right = arc_avltree_create(sizeof(int), arc_cmp_int);
+    arc_avltree_t pooled = arc_avltree_create_pooled(sizeof(int), arc_cmp_int);
+
+    ARC_ASSERT_POINTER_NOT_NULL(avltree);
+    ARC_ASSERT_POINTER_NOT_NULL(left);
+    ARC_ASSERT_POINTER_NOT_NULL(right);
+    ARC_ASSERT_POINTER_NOT_NULL(pooled);
+
+    /* Even numbers, inserted in a scrambled order */
+    for (i = 0; i < 1000; i++)
+    {
+        set[i] = (char)(i % 2 == 0);
+    }
+
+    for (i = 0; i < 500; i++)
+    {
+        int value = 2 * (i * 37 % 500);
+        arc_avltree_insert(avltree, &value);
+    }
+
+    num = fill_set(avltree, NULL, expected, set, 1000);
+    ARC_ASSERT_TRUE(check_elements(avltree, expected, num));
+
+    for (key = -1; key <= 1000; key += 7)
+    {
+        memset(result, 0, sizeof(result));
+
+        ARC_ASSERT_INT_EQ(arc_avltree_split(avltree, &key, left, right),
+                          ARC_SUCCESS);
+
+        /* The element equal to the key stays */
+        if (key >= 0 && key < 1000 && set[key])
+        {
+            ARC_ASSERT_TRUE(check_elements(avltree, &key, 1));
+        }
+        else
+        {
+            ARC_ASSERT_TRUE(arc_avltree_empty(avltree));
+        }
+
+        for (i = 0; i < 1000 && i < key; i++)
+        {
+            result[i] = set[i];
+        }
+
+        num = fill_set(left, NULL, expected, result, 1000);
+        ARC_ASSERT_TRUE(check_elements(left, expected, num));
+
+        for (i = 0; i < 1000; i++)
+        {
+            result[i] = (char)(i > key && set[i]);
+        }
+
+        num = fill_set(right, NULL, expected, result, 1000);
+        ARC_ASSERT_TRUE(check_elements(right, expected, num));
+
+        /* Out of order */
+        if (!arc_avltree_empty(left) && !arc_avltree_empty(right))
+        {
+            ARC_ASSERT_INT_EQ(arc_avltree_join(right, left), ARC_ERROR);
+        }
+
+        ARC_ASSERT_INT_EQ(arc_avltree_join(left, avltree), ARC_SUCCESS);
+        ARC_ASSERT_INT_EQ(arc_avltree_join(left, right), ARC_SUCCESS);
+        ARC_ASSERT_INT_EQ(arc_avltree_join(avltree, left), ARC_SUCCESS);
+
+        ARC_ASSERT_TRUE(arc_avltree_empty(left));
+        ARC_ASSERT_TRUE(arc_avltree_empty(right));
+
+        num = fill_set(avltree, NULL, expected, set, 1000);
+        ARC_ASSERT_TRUE(check_elements(avltree, expected, num));
+    }
+
+    /* Not empty or nodes from a different allocator */
+    key = 500;
+    arc_avltree_insert(left, &key);
+    ARC_ASSERT_INT_EQ(arc_avltree_split(avltree, &key, left, right),
+                      ARC_ERROR);
+    ARC_ASSERT_INT_EQ(arc_avltree_split(avltree, &key, right, right),
+                      ARC_ERROR);
+    ARC_ASSERT_INT_EQ(arc_avltree_split(avltree, &key, right, pooled),
+                      ARC_ERROR);
+    ARC_ASSERT_INT_EQ(arc_avltree_join(pooled, left), ARC_ERROR);
+    ARC_ASSERT_INT_EQ(arc_avltree_join(left, left), ARC_ERROR);
+    ARC_ASSERT_INT_EQ((int)arc_avltree_size(avltree), 500);
+
+    arc_avltree_destroy(pooled);
+    arc_avltree_destroy(right);
+    arc_avltree_destroy(left);
+    arc_avltree_destroy(avltree);
+}
+
+ARC_UNIT_TEST(set_operations)
+{
+    int i, op, num, round;
+    int expected[2000];
+    char a[2000], b[2000], result[2000];
+
+    srand(11);
+
+    /* Sets of similar and of very different sizes */
+    for (round = 0; round < 12; round++)
+    {
+        int density_a = 1 + round % 4 * 30;
+        int density_b = 1 + round / 4 * 45;
+
+        for (i = 0; i < 2000; i++)
+        {
+            a[i] = (char)(rand() % 100 < density_a);
+            b[i] = (char)(rand() % 100 < density_b);
+        }
+
+        for (op = 0; op < 3; op++)
+        {
+            arc_avltree_t tree_a = arc_avltree_create(sizeof(int),
+                                                      arc_cmp_int);
+            arc_avltree_t tree_b = arc_avltree_create(sizeof(int),
+                                                      arc_cmp_int);
+            int num_b;
+
+            ARC_ASSERT_POINTER_NOT_NULL(tree_a);
+            ARC_ASSERT_POINTER_NOT_NULL(tree_b);
+
+            for (i = 0; i < 2000; i++)
+            {
+                result[i] = (char)(op == 0 ? a[i] || b[i] :
+                                   op == 1 ? a[i] && b[i] : a[i] && !b[i]);
+            }
+
+            fill_set(tree_a, a, expected, NULL, 2000);
+            num_b = fill_set(tree_b, b, expected, b, 2000);
+
+            if (op == 0)
+            {
+                ARC_ASSERT_INT_EQ(arc_avltree_union(tree_a, tree_b),
+                                  ARC_SUCCESS);
+                num_b = 0;
+            }
+            else if (op == 1)
+            {
+                ARC_ASSERT_INT_EQ(arc_avltree_intersection(tree_a, tree_b),
+                                  ARC_SUCCESS);
+            }
+            else
+            {
+                ARC_ASSERT_INT_EQ(arc_avltree_difference(tree_a, tree_b),
+                                  ARC_SUCCESS);
+            }
+
+            /* Only the union takes the nodes of the other avltree */
+            ARC_ASSERT_TRUE(check_elements(tree_b, expected, num_b));
+
+            num = fill_set(tree_a, NULL, expected, result, 2000);
+            ARC_ASSERT_TRUE(check_elements(tree_a, expected, num));
+
+            arc_avltree_destroy(tree_b);
+            arc_avltree_destroy(tree_a);
+        }
+    }
+}
+
+ARC_UNIT_TEST(parallel)
+{
+    int i, op, num;
+    int n = 40000;
+    int *expected = malloc((size_t)n * sizeof(int));
+    char *a = malloc((size_t)n);
+    char *b = malloc((size_t)n);
+    char *result = malloc((size_t)n);
+    arc_pool_t pool = arc_pool_create(4);
+    arc_avltree_t tree_a, tree_b;
+
+    ARC_ASSERT_POINTER_NOT_NULL(expected);
+    ARC_ASSERT_POINTER_NOT_NULL(a);
+    ARC_ASSERT_POINTER_NOT_NULL(b);
+    ARC_ASSERT_POINTER_NOT_NULL(result);
+    ARC_ASSERT_POINTER_NOT_NULL(pool);
+
+    srand(13);
+
+    for (i = 0; i < n; i++)
+    {
+        a[i] = (char)(rand() % 2);
+        b[i] = (char)(rand() % 3 == 0);
+        expected[i] = i;
+    }
+
+    /* Bulk build, with and without a pool of nodes */
+    tree_a = arc_avltree_create(sizeof(int), arc_cmp_int);
+    tree_b = arc_avltree_create_pooled(sizeof(int), arc_cmp_int);
+
+    ARC_ASSERT_POINTER_NOT_NULL(tree_a);
+    ARC_ASSERT_POINTER_NOT_NULL(tree_b);
+    ARC_ASSERT_INT_EQ(arc_avltree_parallel_build_sorted(tree_a, expected,
+                                                        (size_t)n, pool),
+                      ARC_SUCCESS);
+    ARC_ASSERT_INT_EQ(arc_avltree_parallel_build_sorted(tree_b, expected,
+                                                        (size_t)n, pool),
+                      ARC_SUCCESS);
+    ARC_ASSERT_INT_EQ(arc_avltree_parallel_build_sorted(tree_b, expected,
+                                                        (size_t)n, pool),
+                      ARC_ERROR);
+    ARC_ASSERT_TRUE(check_elements(tree_a, expected, n));
+    ARC_ASSERT_TRUE(check_elements(tree_b, expected, n));
+
+    /* A pooled avltree is filtered without the threads */
+    arc_avltree_clear(tree_a);
+    num = fill_set(tree_a, a, expected, a, n);
+    ARC_ASSERT_INT_EQ(arc_avltree_parallel_intersection(tree_b, tree_a,
+                                                        pool),
+                      ARC_SUCCESS);
+    ARC_ASSERT_TRUE(check_elements(tree_b, expected, num));
+
+    arc_avltree_destroy(tree_b);
+    arc_avltree_destroy(tree_a);
+
+    for (op = 0; op < 3; op++)
+    {
+        tree_a = arc_avltree_create(sizeof(int), arc_cmp_int);
+        tree_b = arc_avltree_create(sizeof(int), arc_cmp_int);
+
+        ARC_ASSERT_POINTER_NOT_NULL(tree_a);
+        ARC_ASSERT_POINTER_NOT_NULL(tree_b);
+
+        for (i = 0; i < n; i++)
+        {
+            result[i] = (char)(op == 0 ? a[i] || b[i] :
+                               op == 1 ? a[i] && b[i] : a[i] && !b[i]);
+        }
+
+        fill_set(tree_a, a, expected, NULL, n);
+        fill_set(tree_b, b, expected, NULL, n);
+
+        if (op == 0)
+        {
+            ARC_ASSERT_INT_EQ(arc_avltree_parallel_union(tree_a, tree_b,
+                                                         pool),
+                              ARC_SUCCESS);
+            ARC_ASSERT_TRUE(arc_avltree_empty(tree_b));
+        }
+        else if (op == 1)
+        {
+            ARC_ASSERT_INT_EQ(arc_avltree_parallel_intersection(tree_a,
+                                                                tree_b, pool),
+                              ARC_SUCCESS);
+        }
+        else
+        {
+            ARC_ASSERT_INT_EQ(arc_avltree_parallel_difference(tree_a,
+                                                              tree_b, pool),
+                              ARC_SUCCESS);
+        }
+
+        num = fill_set(tree_a, NULL, expected, result, n);
+        ARC_ASSERT_TRUE(check_elements(tree_a, expected, num));
+
+        arc_avltree_destroy(tree_b);
+        arc_avltree_destroy(tree_a);
+    }
+
+    arc_pool_destroy(pool);
+    free(result);
+    free(b);
+    free(a);
+    free(expected);
+}
+
 ARC_UNIT_TEST(destruction)
 {
     unsigned i;
@@ -386,6 +1048,101 @@ ARC_UNIT_TEST(destruction)
     arc_avltree_destroy(avltree);
 }
 
+ARC_UNIT_TEST(clear)
+{
+    int i, round;
+    arc_avltree_t avltree = arc_avltree_create(sizeof(int), arc_cmp_int);
+
+    ARC_ASSERT_POINTER_NOT_NULL(avltree);
+
+    for (round = 0; round < 2; round++)
+    {
+        for (i = 0; i < 1000; i++)
+        {
+            ARC_ASSERT_INT_EQ(arc_avltree_insert(avltree, &i), ARC_SUCCESS);
+        }
+
+        arc_avltree_clear(avltree);
+
+        ARC_ASSERT_TRUE(arc_avltree_empty(avltree));
+
+        i = 500;
+        ARC_ASSERT_POINTER_NULL(arc_avltree_retrieve(avltree, &i));
+    }
+
+    arc_avltree_destroy(avltree);
+}
+
+ARC_UNIT_TEST(pooled)
+{
+    int i;
+    int values[1000];
+    arc_avltree_t avltree = arc_avltree_create_pooled(sizeof(int),
+                                                      arc_cmp_int);
+
+    ARC_ASSERT_POINTER_NOT_NULL(avltree);
+
+    for (i = 0; i < 1000; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_avltree_insert(avltree, &i), ARC_SUCCESS);
+    }
+
+    /* The released nodes are reused by the following insertions */
+    for (i = 0; i < 1000; i += 2)
+    {
+        arc_avltree_remove(avltree, &i);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_avltree_size(avltree), 500);
+
+    for (i = 0; i < 1000; i += 2)
+    {
+        ARC_ASSERT_INT_EQ(arc_avltree_insert(avltree, &i), ARC_SUCCESS);
+    }
+
+    for (i = 0; i < 1000; i++)
+    {
+        int *data = arc_avltree_retrieve(avltree, &i);
+        ARC_ASSERT_POINTER_NOT_NULL(data);
+        ARC_ASSERT_INT_EQ(*data, i);
+    }
+
+    arc_avltree_clear(avltree);
+
+    ARC_ASSERT_TRUE(arc_avltree_empty(avltree));
+
+    /* The tree is usable again after releasing the whole pool */
+    for (i = 0; i < 1000; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_avltree_insert(avltree, &i), ARC_SUCCESS);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_avltree_size(avltree), 1000);
+
+    arc_avltree_clear(avltree);
+
+    /* Nodes allocated in a single block are released one by one as well */
+    for (i = 0; i < 1000; i++)
+    {
+        values[i] = i;
+    }
+
+    ARC_ASSERT_INT_EQ(arc_avltree_build_sorted(avltree, values, 1000),
+                      ARC_SUCCESS);
+    ARC_ASSERT_TRUE(check_elements(avltree, values, 1000));
+
+    for (i = 0; i < 1000; i += 2)
+    {
+        arc_avltree_remove(avltree, &i);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_avltree_insert_sorted(avltree, values, 1000),
+                      ARC_SUCCESS);
+    ARC_ASSERT_TRUE(check_elements(avltree, values, 1000));
+
+    arc_avltree_destroy(avltree);
+}
+
 ARC_UNIT_TEST_FIXTURE()
 {
     /*ARC_UNIT_ADD_TEST(random)*/
@@ -394,12 +1151,23 @@ ARC_UNIT_TEST_FIXTURE()
     ARC_UNIT_ADD_TEST(size)
     ARC_UNIT_ADD_TEST(insertion)
     ARC_UNIT_ADD_TEST(retrieve)
+    ARC_UNIT_ADD_TEST(retrieve_batch)
     ARC_UNIT_ADD_TEST(remove)
     ARC_UNIT_ADD_TEST(iterators_forward)
     ARC_UNIT_ADD_TEST(iterators_backward)
     ARC_UNIT_ADD_TEST(iterators_position)
+    ARC_UNIT_ADD_TEST(iterators_bounds)
+    ARC_UNIT_ADD_TEST(iterators_range)
     ARC_UNIT_ADD_TEST(iterators_remove)
+    ARC_UNIT_ADD_TEST(order_statistics)
+    ARC_UNIT_ADD_TEST(build_sorted)
+    ARC_UNIT_ADD_TEST(insert_sorted)
+    ARC_UNIT_ADD_TEST(split_join)
+    ARC_UNIT_ADD_TEST(set_operations)
+    ARC_UNIT_ADD_TEST(parallel)
     ARC_UNIT_ADD_TEST(destruction)
+    ARC_UNIT_ADD_TEST(clear)
+    ARC_UNIT_ADD_TEST(pooled)
 }
 
 ARC_UNIT_RUN_TESTS()
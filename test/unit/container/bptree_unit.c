@@ -0,0 +1,373 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <stdio.h>
+#include <arc/container/bptree.h>
+#include <arc/test/unit.h>
+#include <arc/common/defines.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NUM_ELEMS 20000
+
+/* Big element, only a few of them fit in a node so the tree grows tall */
+struct big_elem
+{
+    int key;
+    char padding[252];
+};
+
+static int cmp_big_elem(const void *a, const void *b)
+{
+    int ka = ((const struct big_elem *)a)->key;
+    int kb = ((const struct big_elem *)b)->key;
+
+    return (ka < kb ? -1 : (ka > kb ? 1 : 0));
+}
+
+static void shuffle(int *values, int n)
+{
+    int i;
+
+    for (i = n - 1; i > 0; i--)
+    {
+        int j = rand() % (i + 1);
+        int tmp = values[i];
+        values[i] = values[j];
+        values[j] = tmp;
+    }
+}
+
+ARC_UNIT_TEST(size)
+{
+    int i = 10;
+    arc_bptree_t bptree = arc_bptree_create(sizeof(int), arc_cmp_int);
+
+    ARC_ASSERT_POINTER_NOT_NULL(bptree);
+
+    ARC_ASSERT_TRUE(arc_bptree_empty(bptree));
+
+    ARC_ASSERT_INT_EQ(arc_bptree_insert(bptree, &i), ARC_SUCCESS);
+    ARC_ASSERT_INT_EQ(arc_bptree_insert(bptree, &i), ARC_DUPLICATE);
+
+    ARC_ASSERT_FALSE(arc_bptree_empty(bptree));
+    ARC_ASSERT_INT_EQ(arc_bptree_size(bptree), 1);
+
+    for (i = 0; i < 1000; i++)
+    {
+        arc_bptree_insert(bptree, &i);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_bptree_size(bptree), 1000);
+
+    arc_bptree_clear(bptree);
+
+    ARC_ASSERT_TRUE(arc_bptree_empty(bptree));
+
+    i = 10;
+    ARC_ASSERT_POINTER_NULL(arc_bptree_retrieve(bptree, &i));
+
+    arc_bptree_destroy(bptree);
+}
+
+ARC_UNIT_TEST(retrieve)
+{
+    int i, *values = malloc(NUM_ELEMS * sizeof(int));
+    arc_bptree_t bptree = arc_bptree_create(sizeof(int), arc_cmp_int);
+
+    ARC_ASSERT_POINTER_NOT_NULL(bptree);
+
+    for (i = 0; i < NUM_ELEMS; i++)
+    {
+        values[i] = i * 2;
+    }
+
+    shuffle(values, NUM_ELEMS);
+
+    for (i = 0; i < NUM_ELEMS; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_bptree_insert(bptree, &values[i]), ARC_SUCCESS);
+    }
+
+    for (i = 0; i < NUM_ELEMS * 2; i++)
+    {
+        int *data = arc_bptree_retrieve(bptree, &i);
+
+        if (i % 2 == 0)
+        {
+            ARC_ASSERT_POINTER_NOT_NULL(data);
+            ARC_ASSERT_INT_EQ(*data, i);
+        }
+        else
+        {
+            ARC_ASSERT_POINTER_NULL(data);
+        }
+    }
+
+    free(values);
+    arc_bptree_destroy(bptree);
+}
+
+ARC_UNIT_TEST(remove)
+{
+    int i, *values = malloc(NUM_ELEMS * sizeof(int));
+    arc_bptree_t bptree = arc_bptree_create(sizeof(int), arc_cmp_int);
+    arc_bptree_iterator_t it = arc_bptree_iterator_create(bptree);
+
+    ARC_ASSERT_POINTER_NOT_NULL(bptree);
+
+    for (i = 0; i < NUM_ELEMS; i++)
+    {
+        values[i] = i;
+    }
+
+    shuffle(values, NUM_ELEMS);
+
+    for (i = 0; i < NUM_ELEMS; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_bptree_insert(bptree, &values[i]), ARC_SUCCESS);
+    }
+
+    /* Remove the odd elements in random order */
+    for (i = 0; i < NUM_ELEMS; i++)
+    {
+        if (values[i] % 2 == 1)
+        {
+            arc_bptree_remove(bptree, &values[i]);
+        }
+    }
+
+    ARC_ASSERT_INT_EQ(arc_bptree_size(bptree), NUM_ELEMS / 2);
+
+    /* Removing a missing element has no effect */
+    i = 1;
+    arc_bptree_remove(bptree, &i);
+    ARC_ASSERT_INT_EQ(arc_bptree_size(bptree), NUM_ELEMS / 2);
+
+    i = 0;
+    arc_bptree_before_begin(it);
+
+    while (arc_bptree_next(it))
+    {
+        ARC_ASSERT_INT_EQ(*(int *)arc_bptree_data(it), i);
+        i += 2;
+    }
+
+    ARC_ASSERT_INT_EQ(i, NUM_ELEMS);
+
+    /* Remove everything else, the tree shrinks down to nothing */
+    for (i = 0; i < NUM_ELEMS; i++)
+    {
+        arc_bptree_remove(bptree, &values[i]);
+    }
+
+    ARC_ASSERT_TRUE(arc_bptree_empty(bptree));
+
+    arc_bptree_begin(it);
+    ARC_ASSERT_FALSE(arc_bptree_next(it));
+
+    for (i = 0; i < 100; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_bptree_insert(bptree, &i), ARC_SUCCESS);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_bptree_size(bptree), 100);
+
+    free(values);
+    arc_bptree_iterator_destroy(it);
+    arc_bptree_destroy(bptree);
+}
+
+ARC_UNIT_TEST(big_elements)
+{
+    int i, *values = malloc(2000 * sizeof(int));
+    struct big_elem elem;
+    arc_bptree_t bptree = arc_bptree_create(sizeof(struct big_elem),
+                                            cmp_big_elem);
+
+    ARC_ASSERT_POINTER_NOT_NULL(bptree);
+
+    memset(&elem, 0, sizeof(elem));
+
+    for (i = 0; i < 2000; i++)
+    {
+        values[i] = i;
+    }
+
+    shuffle(values, 2000);
+
+    for (i = 0; i < 2000; i++)
+    {
+        elem.key = values[i];
+        ARC_ASSERT_INT_EQ(arc_bptree_insert(bptree, &elem), ARC_SUCCESS);
+    }
+
+    for (i = 0; i < 2000; i += 3)
+    {
+        elem.key = values[i];
+        arc_bptree_remove(bptree, &elem);
+    }
+
+    for (i = 0; i < 2000; i++)
+    {
+        struct big_elem *data;
+
+        elem.key = values[i];
+        data = arc_bptree_retrieve(bptree, &elem);
+
+        if (i % 3 == 0)
+        {
+            ARC_ASSERT_POINTER_NULL(data);
+        }
+        else
+        {
+            ARC_ASSERT_POINTER_NOT_NULL(data);
+            ARC_ASSERT_INT_EQ(data->key, values[i]);
+        }
+    }
+
+    free(values);
+    arc_bptree_destroy(bptree);
+}
+
+ARC_UNIT_TEST(iterators)
+{
+    int i;
+    arc_bptree_t bptree = arc_bptree_create(sizeof(int), arc_cmp_int);
+    arc_bptree_iterator_t it = arc_bptree_iterator_create(bptree);
+
+    ARC_ASSERT_POINTER_NOT_NULL(it);
+
+    for (i = 1000; i > 0; i--)
+    {
+        ARC_ASSERT_INT_EQ(arc_bptree_insert(bptree, &i), ARC_SUCCESS);
+    }
+
+    i = 1;
+    arc_bptree_before_begin(it);
+
+    while (arc_bptree_next(it))
+    {
+        ARC_ASSERT_INT_EQ(*(int *)arc_bptree_data(it), i);
+        i++;
+    }
+
+    ARC_ASSERT_INT_EQ(i, 1001);
+
+    /* Going back from after the end */
+    while (arc_bptree_previous(it))
+    {
+        i--;
+        ARC_ASSERT_INT_EQ(*(int *)arc_bptree_data(it), i);
+    }
+
+    ARC_ASSERT_INT_EQ(i, 1);
+
+    arc_bptree_begin(it);
+    ARC_ASSERT_INT_EQ(*(int *)arc_bptree_data(it), 1);
+
+    arc_bptree_end(it);
+    ARC_ASSERT_INT_EQ(*(int *)arc_bptree_data(it), 1000);
+
+    arc_bptree_after_end(it);
+    ARC_ASSERT_TRUE(arc_bptree_previous(it));
+    ARC_ASSERT_INT_EQ(*(int *)arc_bptree_data(it), 1000);
+
+    arc_bptree_iterator_destroy(it);
+    arc_bptree_destroy(bptree);
+}
+
+ARC_UNIT_TEST(iterators_position)
+{
+    int i;
+    arc_bptree_t bptree = arc_bptree_create(sizeof(int), arc_cmp_int);
+    arc_bptree_iterator_t it = arc_bptree_iterator_create(bptree);
+
+    for (i = 0; i < 1000; i += 2)
+    {
+        ARC_ASSERT_INT_EQ(arc_bptree_insert(bptree, &i), ARC_SUCCESS);
+    }
+
+    i = 500;
+    ARC_ASSERT_TRUE(arc_bptree_position(it, &i));
+    ARC_ASSERT_INT_EQ(*(int *)arc_bptree_data(it), 500);
+
+    ARC_ASSERT_TRUE(arc_bptree_next(it));
+    ARC_ASSERT_INT_EQ(*(int *)arc_bptree_data(it), 502);
+
+    ARC_ASSERT_TRUE(arc_bptree_previous(it));
+    ARC_ASSERT_TRUE(arc_bptree_previous(it));
+    ARC_ASSERT_INT_EQ(*(int *)arc_bptree_data(it), 498);
+
+    i = 501;
+    ARC_ASSERT_FALSE(arc_bptree_position(it, &i));
+
+    arc_bptree_iterator_destroy(it);
+    arc_bptree_destroy(bptree);
+}
+
+ARC_UNIT_TEST(iterators_erase)
+{
+    int i;
+    arc_bptree_t bptree = arc_bptree_create(sizeof(int), arc_cmp_int);
+    arc_bptree_iterator_t it = arc_bptree_iterator_create(bptree);
+
+    for (i = 0; i < 1000; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_bptree_insert(bptree, &i), ARC_SUCCESS);
+    }
+
+    /* Erase every element with an odd value while iterating */
+    arc_bptree_begin(it);
+    i = 1;
+
+    while (arc_bptree_next(it))
+    {
+        ARC_ASSERT_INT_EQ(*(int *)arc_bptree_data(it), i);
+        arc_bptree_erase(it);
+
+        /* The iterator is left on the following element */
+        if (i != 999)
+        {
+            ARC_ASSERT_INT_EQ(*(int *)arc_bptree_data(it), i + 1);
+        }
+
+        i += 2;
+    }
+
+    ARC_ASSERT_INT_EQ(arc_bptree_size(bptree), 500);
+
+    for (i = 0; i < 1000; i++)
+    {
+        if (i % 2 == 0)
+        {
+            ARC_ASSERT_POINTER_NOT_NULL(arc_bptree_retrieve(bptree, &i));
+        }
+        else
+        {
+            ARC_ASSERT_POINTER_NULL(arc_bptree_retrieve(bptree, &i));
+        }
+    }
+
+    arc_bptree_iterator_destroy(it);
+    arc_bptree_destroy(bptree);
+}
+
+ARC_UNIT_TEST_FIXTURE()
+{
+    ARC_UNIT_ADD_TEST(size)
+    ARC_UNIT_ADD_TEST(retrieve)
+    ARC_UNIT_ADD_TEST(remove)
+    ARC_UNIT_ADD_TEST(big_elements)
+    ARC_UNIT_ADD_TEST(iterators)
+    ARC_UNIT_ADD_TEST(iterators_position)
+    ARC_UNIT_ADD_TEST(iterators_erase)
+}
+
+ARC_UNIT_RUN_TESTS()
@@ -307,6 +307,99 @@ ARC_UNIT_TEST(iterators_position)
     arc_bstree_destroy(bstree);
 }
 
+ARC_UNIT_TEST(iterators_bounds)
+{
+    int i, key;
+    arc_bstree_t bstree = arc_bstree_create(sizeof(int), arc_cmp_int);
+    arc_bstree_iterator_t it = arc_bstree_iterator_create(bstree);
+
+    ARC_ASSERT_POINTER_NOT_NULL(bstree);
+
+    /* Empty tree */
+    key = 0;
+    ARC_ASSERT_FALSE(arc_bstree_lower_bound(it, &key));
+    ARC_ASSERT_FALSE(arc_bstree_upper_bound(it, &key));
+
+    /* Even numbers from 0 to 98 */
+    for (i = 0; i < 50; i++)
+    {
+        key = 2 * ((i * 17) % 50);
+        ARC_ASSERT_INT_EQ(arc_bstree_insert(bstree, &key), ARC_SUCCESS);
+    }
+
+    for (key = -1; key < 98; key++)
+    {
+        int lower = (key < 0 ? 0 : key + (key & 1));
+        int upper = (key < 0 ? 0 : key + 2 - (key & 1));
+
+        ARC_ASSERT_TRUE(arc_bstree_lower_bound(it, &key));
+        ARC_ASSERT_INT_EQ(*(int *)arc_bstree_data(it), lower);
+
+        if (upper < 100)
+        {
+            ARC_ASSERT_TRUE(arc_bstree_upper_bound(it, &key));
+            ARC_ASSERT_INT_EQ(*(int *)arc_bstree_data(it), upper);
+        }
+        else
+        {
+            ARC_ASSERT_FALSE(arc_bstree_upper_bound(it, &key));
+        }
+    }
+
+    /* Past the last element the iterator can still go backwards */
+    key = 99;
+    ARC_ASSERT_FALSE(arc_bstree_lower_bound(it, &key));
+    ARC_ASSERT_TRUE(arc_bstree_previous(it));
+    ARC_ASSERT_INT_EQ(*(int *)arc_bstree_data(it), 98);
+
+    arc_bstree_iterator_destroy(it);
+    arc_bstree_destroy(bstree);
+}
+
+ARC_UNIT_TEST(iterators_range)
+{
+    int i, key, first, last, found;
+    arc_bstree_t bstree = arc_bstree_create(sizeof(int), arc_cmp_int);
+    arc_bstree_iterator_t it = arc_bstree_iterator_create(bstree);
+
+    ARC_ASSERT_POINTER_NOT_NULL(bstree);
+
+    /* Even numbers from 0 to 98 */
+    for (i = 0; i < 50; i++)
+    {
+        key = 2 * ((i * 17) % 50);
+        ARC_ASSERT_INT_EQ(arc_bstree_insert(bstree, &key), ARC_SUCCESS);
+    }
+
+    for (first = -3; first < 102; first += 3)
+    {
+        for (last = first - 1; last < 104; last += 5)
+        {
+            int expected = (first < 0 ? 0 : first + (first & 1));
+            int count = 0;
+
+            for (found = arc_bstree_range(it, &first, &last); found;
+                 found = arc_bstree_range_next(it, &last))
+            {
+                ARC_ASSERT_INT_EQ(*(int *)arc_bstree_data(it), expected);
+                expected += 2;
+                count++;
+            }
+
+            /* Every element of the range was visited */
+            for (key = 0; key < 100; key += 2)
+            {
+                count -= (key >= first && key < last);
+            }
+
+            ARC_ASSERT_INT_EQ(count, 0);
+        }
+    }
+
+    arc_bstree_iterator_destroy(it);
+    arc_bstree_destroy(bstree);
+}
+
 ARC_UNIT_TEST(iterators_remove)
 {
     unsigned i, val;
@@ -407,6 +500,8 @@ ARC_UNIT_TEST_FIXTURE()
     ARC_UNIT_ADD_TEST(iterators_forward)
     ARC_UNIT_ADD_TEST(iterators_backward)
     ARC_UNIT_ADD_TEST(iterators_position)
+    ARC_UNIT_ADD_TEST(iterators_bounds)
+    ARC_UNIT_ADD_TEST(iterators_range)
     ARC_UNIT_ADD_TEST(iterators_remove)
     ARC_UNIT_ADD_TEST(destruction)
 }
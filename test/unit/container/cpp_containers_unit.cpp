@@ -0,0 +1,276 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cstdio>
+#include <string>
+#include <arc/container/darray.hpp>
+#include <arc/container/deque.hpp>
+#include <arc/container/avltree.hpp>
+#include <arc/test/unit.h>
+#include <arc/common/defines.h>
+
+/* Element which keeps track of how it was constructed */
+struct tracked
+{
+    static int live;
+    static int copies;
+
+    int value;
+    std::string name;
+
+    explicit tracked(int v) : value(v), name(std::to_string(v)) { live++; }
+    tracked(const tracked &other) : value(other.value), name(other.name)
+    {
+        live++;
+        copies++;
+    }
+    tracked(tracked &&other)
+        : value(other.value), name(std::move(other.name))
+    {
+        live++;
+    }
+    ~tracked() { live--; }
+
+    bool operator<(const tracked &other) const { return value < other.value; }
+};
+
+int tracked::live = 0;
+int tracked::copies = 0;
+
+ARC_UNIT_TEST(darray)
+{
+    int i;
+
+    tracked::copies = 0;
+
+    {
+        arc::darray<tracked> darray;
+
+        ARC_ASSERT_TRUE(darray.empty());
+
+        /* Grows several times, the elements are moved to the new blocks */
+        for (i = 0; i < 1000; i++)
+        {
+            ARC_ASSERT_INT_EQ(darray.emplace_back(i), ARC_SUCCESS);
+        }
+
+        ARC_ASSERT_INT_EQ(darray.size(), 1000);
+        ARC_ASSERT_INT_EQ(tracked::live, 1000);
+        ARC_ASSERT_INT_EQ(tracked::copies, 0);
+
+        for (i = 0; i < 1000; i++)
+        {
+            ARC_ASSERT_INT_EQ(darray[(size_t)i].value, i);
+            ARC_ASSERT_TRUE(darray[(size_t)i].name == std::to_string(i));
+        }
+
+        darray.pop_back();
+        ARC_ASSERT_INT_EQ(darray.back().value, 998);
+        ARC_ASSERT_INT_EQ(tracked::live, 999);
+
+        arc::darray<tracked> other(std::move(darray));
+        ARC_ASSERT_TRUE(darray.empty());
+        ARC_ASSERT_INT_EQ(other.front().value, 0);
+
+        other.clear();
+        ARC_ASSERT_INT_EQ(tracked::live, 0);
+
+        ARC_ASSERT_INT_EQ(other.push_back(tracked(5)), ARC_SUCCESS);
+    }
+
+    ARC_ASSERT_INT_EQ(tracked::live, 0);
+    ARC_ASSERT_INT_EQ(tracked::copies, 0);
+}
+
+ARC_UNIT_TEST(darray_self_insertion)
+{
+    int i;
+
+    {
+        arc::darray<tracked> darray;
+        arc::darray<long> longs;
+
+        /* Every insertion at full capacity refers to an element of the old
+           block */
+        ARC_ASSERT_INT_EQ(darray.emplace_back(0), ARC_SUCCESS);
+        ARC_ASSERT_INT_EQ(longs.push_back(0), ARC_SUCCESS);
+
+        for (i = 1; i < 1000; i++)
+        {
+            if (darray.size() == darray.capacity())
+            {
+                ARC_ASSERT_INT_EQ(darray.push_back(darray[0]), ARC_SUCCESS);
+                ARC_ASSERT_INT_EQ(longs.emplace_back(longs.back()),
+                                  ARC_SUCCESS);
+            }
+            else
+            {
+                ARC_ASSERT_INT_EQ(darray.emplace_back(i), ARC_SUCCESS);
+                ARC_ASSERT_INT_EQ(longs.push_back(i), ARC_SUCCESS);
+            }
+        }
+
+        /* Copies were appended when the size was a power of two */
+        for (i = 1; i < 1000; i++)
+        {
+            bool full = (i >= 32 && (i & (i - 1)) == 0);
+
+            ARC_ASSERT_INT_EQ(darray[(size_t)i].value, full ? 0 : i);
+            ARC_ASSERT_TRUE(darray[(size_t)i].name ==
+                            std::to_string(darray[(size_t)i].value));
+            ARC_ASSERT_TRUE(longs[(size_t)i] == (full ? i - 1 : i));
+        }
+    }
+
+    ARC_ASSERT_INT_EQ(tracked::live, 0);
+}
+
+ARC_UNIT_TEST(deque)
+{
+    int i, sum = 0;
+
+    tracked::copies = 0;
+
+    {
+        arc::deque<tracked> deque;
+
+        for (i = 0; i < 1000; i++)
+        {
+            ARC_ASSERT_INT_EQ(deque.emplace_back(i), ARC_SUCCESS);
+            ARC_ASSERT_INT_EQ(deque.emplace_front(-i - 1), ARC_SUCCESS);
+        }
+
+        ARC_ASSERT_INT_EQ(deque.size(), 2000);
+        ARC_ASSERT_INT_EQ(tracked::live, 2000);
+        ARC_ASSERT_INT_EQ(deque.front().value, -1000);
+        ARC_ASSERT_INT_EQ(deque.back().value, 999);
+
+        for (i = 0; i < 2000; i++)
+        {
+            ARC_ASSERT_INT_EQ(deque[(size_t)i].value, i - 1000);
+        }
+
+        for (arc::deque<tracked>::iterator it = deque.begin();
+             it != deque.end(); ++it)
+        {
+            sum += it->value;
+        }
+
+        ARC_ASSERT_INT_EQ(sum, -1000);
+
+        deque.pop_front();
+        deque.pop_back();
+        ARC_ASSERT_INT_EQ(deque.front().value, -999);
+        ARC_ASSERT_INT_EQ(deque.back().value, 998);
+        ARC_ASSERT_INT_EQ(tracked::live, 1998);
+
+        deque.clear();
+        ARC_ASSERT_INT_EQ(tracked::live, 0);
+
+        for (i = 0; i < 100; i++)
+        {
+            ARC_ASSERT_INT_EQ(deque.push_back(tracked(i)), ARC_SUCCESS);
+        }
+    }
+
+    ARC_ASSERT_INT_EQ(tracked::live, 0);
+    ARC_ASSERT_INT_EQ(tracked::copies, 0);
+}
+
+ARC_UNIT_TEST(avl_set)
+{
+    int i;
+
+    tracked::copies = 0;
+
+    {
+        arc::avl_set<tracked> set;
+
+        for (i = 999; i >= 0; i--)
+        {
+            ARC_ASSERT_INT_EQ(set.emplace(i), ARC_SUCCESS);
+        }
+
+        /* The rejected element is destroyed */
+        ARC_ASSERT_INT_EQ(set.emplace(10), ARC_DUPLICATE);
+        ARC_ASSERT_INT_EQ(set.insert(tracked(10)), ARC_DUPLICATE);
+        ARC_ASSERT_INT_EQ(tracked::live, 1000);
+        ARC_ASSERT_INT_EQ(set.size(), 1000);
+
+        i = 0;
+        for (arc::avl_set<tracked>::iterator it = set.begin();
+             it != set.end(); ++it)
+        {
+            ARC_ASSERT_INT_EQ(it->value, i);
+            i++;
+        }
+
+        ARC_ASSERT_INT_EQ(i, 1000);
+
+        ARC_ASSERT_TRUE(set.contains(tracked(500)));
+        ARC_ASSERT_TRUE(set.retrieve(tracked(500))->name == "500");
+
+        for (i = 0; i < 1000; i += 2)
+        {
+            set.remove(tracked(i));
+        }
+
+        ARC_ASSERT_INT_EQ(set.size(), 500);
+        ARC_ASSERT_POINTER_NULL(set.retrieve(tracked(500)));
+
+        /* Erase returns the following element */
+        arc::avl_set<tracked>::iterator it = set.find(tracked(501));
+        it = set.erase(it);
+        ARC_ASSERT_INT_EQ(it->value, 503);
+
+        --it;
+        ARC_ASSERT_INT_EQ(it->value, 499);
+
+        it = set.end();
+        --it;
+        ARC_ASSERT_INT_EQ(it->value, 999);
+
+        arc::avl_set<tracked> other(std::move(set));
+        ARC_ASSERT_TRUE(set.empty());
+        ARC_ASSERT_INT_EQ(other.size(), 499);
+        ARC_ASSERT_INT_EQ(tracked::live, 499);
+    }
+
+    ARC_ASSERT_INT_EQ(tracked::live, 0);
+    ARC_ASSERT_INT_EQ(tracked::copies, 0);
+}
+
+ARC_UNIT_TEST(avl_set_generic)
+{
+    int i;
+    arc::avl_set<double, std::greater<double> > set;
+
+    for (i = 0; i < 100; i++)
+    {
+        ARC_ASSERT_INT_EQ(set.insert(i * 0.5), ARC_SUCCESS);
+    }
+
+    /* The comparator decides the order */
+    ARC_ASSERT_DOUBLE_EQ(*set.begin(), 49.5, 0.0001);
+
+    set.clear();
+    ARC_ASSERT_TRUE(set.empty());
+    ARC_ASSERT_TRUE(set.begin() == set.end());
+}
+
+ARC_UNIT_TEST_FIXTURE()
+{
+    ARC_UNIT_ADD_TEST(darray)
+    ARC_UNIT_ADD_TEST(darray_self_insertion)
+    ARC_UNIT_ADD_TEST(deque)
+    ARC_UNIT_ADD_TEST(avl_set)
+    ARC_UNIT_ADD_TEST(avl_set_generic)
+}
+
+ARC_UNIT_RUN_TESTS()
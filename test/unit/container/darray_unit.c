@@ -12,6 +12,7 @@
 #include <arc/test/unit.h>
 #include <arc/common/defines.h>
 
+#include <stdlib.h>
 #include <string.h>
 
 ARC_UNIT_TEST(creation)
@@ -518,6 +519,610 @@ ARC_UNIT_TEST(iterators_erase)
     arc_darray_destroy(darray);
 }
 
+ARC_UNIT_TEST(sliding_window)
+{
+    int i;
+    arc_darray_t darray = arc_darray_create(sizeof(int));
+
+    ARC_ASSERT_POINTER_NOT_NULL(darray);
+
+    /* The window keeps wrapping around the end of the block */
+    for (i = 0; i < 100000; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_darray_push_back(darray, &i), ARC_SUCCESS);
+
+        if (arc_darray_size(darray) > 20)
+        {
+            arc_darray_pop_front(darray);
+        }
+
+        ARC_ASSERT_INT_EQ(*(int *)arc_darray_back(darray), i);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_darray_size(darray), 20);
+
+    for (i = 0; i < 20; i++)
+    {
+        int expected = 99980 + i;
+        ARC_ASSERT_INT_EQ(*(int *)arc_darray_at(darray, (unsigned long)i),
+                          expected);
+    }
+
+    arc_darray_destroy(darray);
+}
+
+ARC_UNIT_TEST(parallel_sort)
+{
+    int i;
+    arc_darray_t darray = arc_darray_create(sizeof(int));
+
+    ARC_ASSERT_POINTER_NOT_NULL(darray);
+
+    /* Elements at both ends, so they wrap around the end of the block */
+    for (i = 0; i < 50000; i++)
+    {
+        int value = (i * 7919) % 50000;
+
+        if (i & 1)
+        {
+            ARC_ASSERT_INT_EQ(arc_darray_push_front(darray, &value), ARC_SUCCESS);
+        }
+        else
+        {
+            ARC_ASSERT_INT_EQ(arc_darray_push_back(darray, &value), ARC_SUCCESS);
+        }
+    }
+
+    ARC_ASSERT_INT_EQ(arc_darray_parallel_sort(darray, &arc_cmp_int, 4),
+                      ARC_SUCCESS);
+
+    for (i = 0; i < 50000; i++)
+    {
+        ARC_ASSERT_INT_EQ(*(int *)arc_darray_at(darray, (unsigned long)i), i);
+    }
+
+    /* Too small to be split, sorted by the caller */
+    arc_darray_clear(darray);
+
+    for (i = 100; i > 0; i--)
+    {
+        ARC_ASSERT_INT_EQ(arc_darray_push_back(darray, &i), ARC_SUCCESS);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_darray_parallel_sort(darray, &arc_cmp_int, 4),
+                      ARC_SUCCESS);
+
+    for (i = 0; i < 100; i++)
+    {
+        ARC_ASSERT_INT_EQ(*(int *)arc_darray_at(darray, (unsigned long)i),
+                          i + 1);
+    }
+
+    arc_darray_destroy(darray);
+}
+
+ARC_UNIT_TEST(linearize)
+{
+    int front, back, i;
+
+    /* Every split of a full or almost full block between both ends */
+    for (front = 1; front < 32; front++)
+    {
+        for (back = 1; front + back <= 32; back++)
+        {
+            arc_darray_t darray = arc_darray_create(sizeof(int));
+            int *data;
+
+            ARC_ASSERT_POINTER_NOT_NULL(darray);
+
+            for (i = front; i < front + back; i++)
+            {
+                ARC_ASSERT_INT_EQ(arc_darray_push_back(darray, &i),
+                                  ARC_SUCCESS);
+            }
+
+            for (i = front - 1; i >= 0; i--)
+            {
+                ARC_ASSERT_INT_EQ(arc_darray_push_front(darray, &i),
+                                  ARC_SUCCESS);
+            }
+
+            data = arc_darray_linearize(darray);
+
+            for (i = 0; i < front + back; i++)
+            {
+                ARC_ASSERT_INT_EQ(data[i], i);
+            }
+
+            arc_darray_destroy(darray);
+        }
+    }
+}
+
+ARC_UNIT_TEST(ring_buffer)
+{
+    int i, size = 0, value = 0;
+    int *model = malloc(4000 * sizeof(int));
+    arc_darray_t darray = arc_darray_create(sizeof(int));
+    arc_darray_iterator_t it = arc_darray_iterator_create(darray);
+
+    /* Random operations checked against a plain array */
+    for (i = 0; i < 20000; i++)
+    {
+        int op = rand() % 6;
+        int pos = (size > 0 ? rand() % size : 0);
+
+        if (size >= 3000)
+        {
+            op = 3;
+        }
+
+        if (op == 0)
+        {
+            memmove(model + 1, model, (size_t)size * sizeof(int));
+            model[0] = value;
+            size++;
+            ARC_ASSERT_INT_EQ(arc_darray_push_front(darray, &value),
+                              ARC_SUCCESS);
+        }
+        else if (op == 1)
+        {
+            model[size] = value;
+            size++;
+            ARC_ASSERT_INT_EQ(arc_darray_push_back(darray, &value),
+                              ARC_SUCCESS);
+        }
+        else if (op == 2 && size > 0)
+        {
+            memmove(model + pos + 1, model + pos,
+                    (size_t)(size - pos) * sizeof(int));
+            model[pos] = value;
+            size++;
+            arc_darray_position(it, (unsigned long)pos);
+            ARC_ASSERT_INT_EQ(arc_darray_insert_before(it, &value),
+                              ARC_SUCCESS);
+        }
+        else if (op == 3 && size > 0)
+        {
+            memmove(model, model + 1, (size_t)(size - 1) * sizeof(int));
+            size--;
+            arc_darray_pop_front(darray);
+        }
+        else if (op == 4 && size > 0)
+        {
+            size--;
+            arc_darray_pop_back(darray);
+        }
+        else if (op == 5 && size > 0)
+        {
+            size--;
+            memmove(model + pos, model + pos + 1,
+                    (size_t)(size - pos) * sizeof(int));
+            arc_darray_position(it, (unsigned long)pos);
+            arc_darray_erase(it);
+        }
+
+        value++;
+
+        ARC_ASSERT_INT_EQ(arc_darray_size(darray), size);
+
+        if (size > 0)
+        {
+            ARC_ASSERT_INT_EQ(*(int *)arc_darray_front(darray), model[0]);
+            ARC_ASSERT_INT_EQ(*(int *)arc_darray_back(darray),
+                              model[size - 1]);
+        }
+
+        if (pos < size)
+        {
+            ARC_ASSERT_INT_EQ(*(int *)arc_darray_at(darray,
+                                                    (unsigned long)pos),
+                              model[pos]);
+        }
+    }
+
+    /* After linearizing the elements can be read as a plain array */
+    ARC_ASSERT_INT_EQ(memcmp(arc_darray_linearize(darray), model,
+                             (size_t)size * sizeof(int)), 0);
+
+    arc_darray_iterator_destroy(it);
+    arc_darray_destroy(darray);
+    free(model);
+}
+
+ARC_UNIT_TEST(capacity)
+{
+    int i;
+    arc_darray_t darray = arc_darray_create_with_capacity(sizeof(int), 4, 1.5);
+
+    ARC_ASSERT_POINTER_NOT_NULL(darray);
+    ARC_ASSERT_INT_EQ(arc_darray_capacity(darray), 4);
+
+    /* 4 * 1.5 = 6, 6 * 1.5 = 9 */
+    for (i = 0; i < 7; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_darray_push_back(darray, &i), ARC_SUCCESS);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_darray_capacity(darray), 9);
+
+    /* Reserving less than the capacity does nothing */
+    ARC_ASSERT_INT_EQ(arc_darray_reserve(darray, 5), ARC_SUCCESS);
+    ARC_ASSERT_INT_EQ(arc_darray_capacity(darray), 9);
+
+    ARC_ASSERT_INT_EQ(arc_darray_reserve(darray, 1000), ARC_SUCCESS);
+    ARC_ASSERT_INT_EQ(arc_darray_capacity(darray), 1000);
+
+    for (i = 7; i < 1000; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_darray_push_back(darray, &i), ARC_SUCCESS);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_darray_capacity(darray), 1000);
+
+    for (i = 0; i < 1000; i++)
+    {
+        ARC_ASSERT_INT_EQ(*(int *)arc_darray_at(darray, (unsigned long)i), i);
+    }
+
+    /* A growth factor close to 1 still grows */
+    arc_darray_destroy(darray);
+    darray = arc_darray_create_with_capacity(sizeof(int), 0, 1.01);
+
+    ARC_ASSERT_POINTER_NOT_NULL(darray);
+    ARC_ASSERT_INT_EQ(arc_darray_capacity(darray), 1);
+
+    for (i = 0; i < 100; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_darray_push_front(darray, &i), ARC_SUCCESS);
+    }
+
+    for (i = 0; i < 100; i++)
+    {
+        int expected = 99 - i;
+        ARC_ASSERT_INT_EQ(*(int *)arc_darray_at(darray, (unsigned long)i),
+                          expected);
+    }
+
+    arc_darray_destroy(darray);
+}
+
+ARC_UNIT_TEST(reserve_wrapped)
+{
+    int i;
+    arc_darray_t darray = arc_darray_create_with_capacity(sizeof(int), 8, 2);
+
+    ARC_ASSERT_POINTER_NOT_NULL(darray);
+
+    /* The elements wrap around the end of the block */
+    for (i = 0; i < 4; i++)
+    {
+        int value = 10 + i;
+        int front = 9 - i;
+
+        ARC_ASSERT_INT_EQ(arc_darray_push_back(darray, &value), ARC_SUCCESS);
+        ARC_ASSERT_INT_EQ(arc_darray_push_front(darray, &front), ARC_SUCCESS);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_darray_reserve(darray, 9), ARC_SUCCESS);
+    ARC_ASSERT_INT_EQ(arc_darray_capacity(darray), 9);
+
+    for (i = 0; i < 8; i++)
+    {
+        int expected = 6 + i;
+        ARC_ASSERT_INT_EQ(*(int *)arc_darray_at(darray, (unsigned long)i),
+                          expected);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_darray_reserve(darray, 64), ARC_SUCCESS);
+
+    for (i = 0; i < 8; i++)
+    {
+        int expected = 6 + i;
+        ARC_ASSERT_INT_EQ(*(int *)arc_darray_at(darray, (unsigned long)i),
+                          expected);
+    }
+
+    arc_darray_destroy(darray);
+}
+
+ARC_UNIT_TEST(shrink_to_fit)
+{
+    int i;
+    arc_darray_t darray = arc_darray_create(sizeof(int));
+
+    ARC_ASSERT_POINTER_NOT_NULL(darray);
+
+    for (i = 0; i < 1000; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_darray_push_back(darray, &i), ARC_SUCCESS);
+    }
+
+    /* Leave a few elements wrapped around the end of the block */
+    for (i = 0; i < 990; i++)
+    {
+        arc_darray_pop_front(darray);
+    }
+
+    for (i = 0; i < 5; i++)
+    {
+        int value = 1000 + i;
+        ARC_ASSERT_INT_EQ(arc_darray_push_back(darray, &value), ARC_SUCCESS);
+    }
+
+    for (i = 0; i < 40; i++)
+    {
+        int value = 989 - i;
+        ARC_ASSERT_INT_EQ(arc_darray_push_front(darray, &value), ARC_SUCCESS);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_darray_size(darray), 55);
+    ARC_ASSERT_INT_EQ(arc_darray_shrink_to_fit(darray), ARC_SUCCESS);
+    ARC_ASSERT_INT_EQ(arc_darray_capacity(darray), 55);
+
+    for (i = 0; i < 55; i++)
+    {
+        int expected = 950 + i;
+        ARC_ASSERT_INT_EQ(*(int *)arc_darray_at(darray, (unsigned long)i),
+                          expected);
+    }
+
+    /* It keeps working after shrinking */
+    i = 1005;
+    ARC_ASSERT_INT_EQ(arc_darray_push_back(darray, &i), ARC_SUCCESS);
+    ARC_ASSERT_INT_EQ(*(int *)arc_darray_back(darray), 1005);
+    ARC_ASSERT_INT_EQ(*(int *)arc_darray_front(darray), 950);
+
+    /* Memory is only released after clearing if requested */
+    arc_darray_clear(darray);
+    ARC_ASSERT_INT_EQ(arc_darray_capacity(darray), 110);
+    ARC_ASSERT_INT_EQ(arc_darray_shrink_to_fit(darray), ARC_SUCCESS);
+    ARC_ASSERT_INT_EQ(arc_darray_capacity(darray), 1);
+
+    for (i = 0; i < 10; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_darray_push_front(darray, &i), ARC_SUCCESS);
+    }
+
+    ARC_ASSERT_INT_EQ(*(int *)arc_darray_front(darray), 9);
+    ARC_ASSERT_INT_EQ(*(int *)arc_darray_back(darray), 0);
+
+    arc_darray_destroy(darray);
+}
+
+ARC_UNIT_TEST(ranges)
+{
+    int i, j, size = 0, value = 0;
+    int *model = malloc(8000 * sizeof(int));
+    int *batch = malloc(500 * sizeof(int));
+    arc_darray_t darray = arc_darray_create(sizeof(int));
+
+    /* Random range operations checked against a plain array */
+    for (i = 0; i < 3000; i++)
+    {
+        int op = rand() % 3;
+        int pos = rand() % (size + 1);
+        int count = rand() % 500;
+
+        if (size >= 6000)
+        {
+            op = 2;
+        }
+
+        for (j = 0; j < count; j++)
+        {
+            batch[j] = value;
+            value++;
+        }
+
+        if (op == 0)
+        {
+            memmove(model + pos + count, model + pos,
+                    (size_t)(size - pos) * sizeof(int));
+            memcpy(model + pos, batch, (size_t)count * sizeof(int));
+            size += count;
+            ARC_ASSERT_INT_EQ(arc_darray_insert_range(darray, (unsigned long)pos,
+                                                  batch, (size_t)count),
+                              ARC_SUCCESS);
+        }
+        else if (op == 1)
+        {
+            memcpy(model + size, batch, (size_t)count * sizeof(int));
+            size += count;
+            ARC_ASSERT_INT_EQ(arc_darray_append_range(darray, batch,
+                                                  (size_t)count),
+                              ARC_SUCCESS);
+        }
+        else
+        {
+            int erased = (count < size - pos ? count : size - pos);
+
+            memmove(model + pos, model + pos + erased,
+                    (size_t)(size - pos - erased) * sizeof(int));
+            size -= erased;
+            arc_darray_erase_range(darray, (unsigned long)pos, (size_t)count);
+        }
+
+        ARC_ASSERT_INT_EQ(arc_darray_size(darray), size);
+
+        for (j = 0; j < size; j++)
+        {
+            ARC_ASSERT_INT_EQ(*(int *)arc_darray_at(darray, (unsigned long)j),
+                              model[j]);
+        }
+    }
+
+    /* Inserting past the end fails */
+    ARC_ASSERT_INT_EQ(arc_darray_insert_range(darray, (unsigned long)size + 1,
+                                          batch, 1), ARC_ERROR);
+
+    /* The single element operations still work after the range ones */
+    ARC_ASSERT_INT_EQ(arc_darray_push_front(darray, &value), ARC_SUCCESS);
+    ARC_ASSERT_INT_EQ(*(int *)arc_darray_front(darray), value);
+    ARC_ASSERT_INT_EQ(arc_darray_push_back(darray, &value), ARC_SUCCESS);
+    ARC_ASSERT_INT_EQ(*(int *)arc_darray_back(darray), value);
+
+    arc_darray_destroy(darray);
+    free(batch);
+    free(model);
+}
+
+ARC_UNIT_TEST(sort)
+{
+    int i;
+    arc_darray_t darray = arc_darray_create(sizeof(int));
+
+    ARC_ASSERT_POINTER_NOT_NULL(darray);
+
+    /* Elements at both ends, so they wrap around the end of the block */
+    for (i = 0; i < 5000; i++)
+    {
+        int value = (i * 7919) % 5000;
+
+        if (i & 1)
+        {
+            ARC_ASSERT_INT_EQ(arc_darray_push_front(darray, &value), ARC_SUCCESS);
+        }
+        else
+        {
+            ARC_ASSERT_INT_EQ(arc_darray_push_back(darray, &value), ARC_SUCCESS);
+        }
+    }
+
+    arc_darray_sort(darray, &arc_cmp_int);
+
+    for (i = 0; i < 5000; i++)
+    {
+        ARC_ASSERT_INT_EQ(*(int *)arc_darray_at(darray, (unsigned long)i), i);
+    }
+
+    for (i = 0; i < 5000; i++)
+    {
+        int value = 4999 - i;
+        *(int *)arc_darray_at(darray, (unsigned long)i) = -value;
+    }
+
+    ARC_ASSERT_INT_EQ(arc_darray_radix_sort(darray, &arc_key_int), ARC_SUCCESS);
+
+    for (i = 0; i < 5000; i++)
+    {
+        int expected = i - 4999;
+        ARC_ASSERT_INT_EQ(*(int *)arc_darray_at(darray, (unsigned long)i),
+                          expected);
+    }
+
+    arc_darray_destroy(darray);
+}
+
+ARC_UNIT_TEST(search)
+{
+    int i, key;
+    long lkey;
+    double dkey;
+    unsigned long first, last, expected_first, expected_last;
+    arc_darray_t darray = arc_darray_create(sizeof(int));
+    arc_darray_t ldarray = arc_darray_create(sizeof(long));
+    arc_darray_t ddarray = arc_darray_create(sizeof(double));
+
+    ARC_ASSERT_POINTER_NOT_NULL(darray);
+    ARC_ASSERT_POINTER_NOT_NULL(ldarray);
+    ARC_ASSERT_POINTER_NOT_NULL(ddarray);
+
+    /* Empty darrays */
+    key = 3;
+    ARC_ASSERT_INT_EQ((int)arc_darray_lower_bound(darray, &key, &arc_cmp_int),
+                      0);
+    ARC_ASSERT_INT_EQ((int)arc_darray_upper_bound_int(darray, 3), 0);
+
+    /* Every even value three times, the lower half pushed at the front so
+       the darrays wrap around the end of their blocks */
+    for (i = 100; i < 200; i++)
+    {
+        long lvalue = 2 * (i / 3);
+        double dvalue = 2 * (i / 3);
+
+        key = 2 * (i / 3);
+        ARC_ASSERT_INT_EQ(arc_darray_push_back(darray, &key), ARC_SUCCESS);
+        ARC_ASSERT_INT_EQ(arc_darray_push_back(ldarray, &lvalue), ARC_SUCCESS);
+        ARC_ASSERT_INT_EQ(arc_darray_push_back(ddarray, &dvalue), ARC_SUCCESS);
+    }
+
+    for (i = 99; i >= 0; i--)
+    {
+        long lvalue = 2 * (i / 3);
+        double dvalue = 2 * (i / 3);
+
+        key = 2 * (i / 3);
+        ARC_ASSERT_INT_EQ(arc_darray_push_front(darray, &key), ARC_SUCCESS);
+        ARC_ASSERT_INT_EQ(arc_darray_push_front(ldarray, &lvalue),
+                          ARC_SUCCESS);
+        ARC_ASSERT_INT_EQ(arc_darray_push_front(ddarray, &dvalue),
+                          ARC_SUCCESS);
+    }
+
+    for (key = -2; key < 140; key++)
+    {
+        expected_first = 0;
+
+        while (expected_first < 200 &&
+               *(int *)arc_darray_at(darray, expected_first) < key)
+        {
+            expected_first++;
+        }
+
+        expected_last = expected_first;
+
+        while (expected_last < 200 &&
+               *(int *)arc_darray_at(darray, expected_last) == key)
+        {
+            expected_last++;
+        }
+
+        arc_darray_equal_range(darray, &key, &arc_cmp_int, &first, &last);
+        ARC_ASSERT_INT_EQ((int)first, (int)expected_first);
+        ARC_ASSERT_INT_EQ((int)last, (int)expected_last);
+
+        ARC_ASSERT_INT_EQ((int)arc_darray_lower_bound_int(darray, key),
+                          (int)expected_first);
+        ARC_ASSERT_INT_EQ((int)arc_darray_upper_bound_int(darray, key),
+                          (int)expected_last);
+
+        lkey = key;
+        ARC_ASSERT_INT_EQ((int)arc_darray_lower_bound_long(ldarray, lkey),
+                          (int)expected_first);
+        ARC_ASSERT_INT_EQ((int)arc_darray_upper_bound_long(ldarray, lkey),
+                          (int)expected_last);
+
+        dkey = key;
+        ARC_ASSERT_INT_EQ((int)arc_darray_lower_bound_double(ddarray, dkey),
+                          (int)expected_first);
+        ARC_ASSERT_INT_EQ((int)arc_darray_upper_bound_double(ddarray, dkey),
+                          (int)expected_last);
+
+        dkey = key + 0.5;
+        ARC_ASSERT_INT_EQ((int)arc_darray_lower_bound_double(ddarray, dkey),
+                          (int)expected_last);
+    }
+
+    /* A single piece */
+    arc_darray_linearize(darray);
+
+    for (key = 0; key <= 132; key += 2)
+    {
+        ARC_ASSERT_INT_EQ((int)arc_darray_lower_bound(darray, &key,
+                                                      &arc_cmp_int),
+                          key / 2 * 3);
+        ARC_ASSERT_INT_EQ((int)arc_darray_lower_bound_int(darray, key),
+                          key / 2 * 3);
+        ARC_ASSERT_INT_EQ((int)arc_darray_upper_bound_int(darray, key),
+                          (key < 132 ? key / 2 * 3 + 3 : 200));
+    }
+
+    arc_darray_destroy(ddarray);
+    arc_darray_destroy(ldarray);
+    arc_darray_destroy(darray);
+}
+
 ARC_UNIT_TEST(destruction)
 {
     int i;
@@ -553,6 +1158,16 @@ ARC_UNIT_TEST_FIXTURE()
     ARC_UNIT_ADD_TEST(iterators_insertion_back)
     ARC_UNIT_ADD_TEST(iterators_insertion_middle)
     ARC_UNIT_ADD_TEST(iterators_erase)
+    ARC_UNIT_ADD_TEST(sliding_window)
+    ARC_UNIT_ADD_TEST(linearize)
+    ARC_UNIT_ADD_TEST(ring_buffer)
+    ARC_UNIT_ADD_TEST(capacity)
+    ARC_UNIT_ADD_TEST(reserve_wrapped)
+    ARC_UNIT_ADD_TEST(shrink_to_fit)
+    ARC_UNIT_ADD_TEST(ranges)
+    ARC_UNIT_ADD_TEST(sort)
+    ARC_UNIT_ADD_TEST(parallel_sort)
+    ARC_UNIT_ADD_TEST(search)
     ARC_UNIT_ADD_TEST(destruction)
 }
 
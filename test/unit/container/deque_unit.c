@@ -12,6 +12,7 @@
 #include <arc/test/unit.h>
 #include <arc/common/defines.h>
 
+#include <stdlib.h>
 #include <string.h>
 
 ARC_UNIT_TEST(creation)
@@ -525,6 +526,130 @@ ARC_UNIT_TEST(iterators_erase)
     arc_deque_destroy(deque);
 }
 
+ARC_UNIT_TEST(ranges)
+{
+    int i, j, size = 0, value = 0;
+    int *model = malloc(8000 * sizeof(int));
+    int *batch = malloc(500 * sizeof(int));
+    arc_deque_t deque = arc_deque_create(sizeof(int));
+
+    /* Random range operations checked against a plain array */
+    for (i = 0; i < 3000; i++)
+    {
+        int op = rand() % 3;
+        int pos = rand() % (size + 1);
+        int count = rand() % 500;
+
+        if (size >= 6000)
+        {
+            op = 2;
+        }
+
+        for (j = 0; j < count; j++)
+        {
+            batch[j] = value;
+            value++;
+        }
+
+        if (op == 0)
+        {
+            memmove(model + pos + count, model + pos,
+                    (size_t)(size - pos) * sizeof(int));
+            memcpy(model + pos, batch, (size_t)count * sizeof(int));
+            size += count;
+            ARC_ASSERT_INT_EQ(arc_deque_insert_range(deque, (unsigned long)pos,
+                                                  batch, (size_t)count),
+                              ARC_SUCCESS);
+        }
+        else if (op == 1)
+        {
+            memcpy(model + size, batch, (size_t)count * sizeof(int));
+            size += count;
+            ARC_ASSERT_INT_EQ(arc_deque_append_range(deque, batch,
+                                                  (size_t)count),
+                              ARC_SUCCESS);
+        }
+        else
+        {
+            int erased = (count < size - pos ? count : size - pos);
+
+            memmove(model + pos, model + pos + erased,
+                    (size_t)(size - pos - erased) * sizeof(int));
+            size -= erased;
+            arc_deque_erase_range(deque, (unsigned long)pos, (size_t)count);
+        }
+
+        ARC_ASSERT_INT_EQ(arc_deque_size(deque), size);
+
+        for (j = 0; j < size; j++)
+        {
+            ARC_ASSERT_INT_EQ(*(int *)arc_deque_at(deque, (unsigned long)j),
+                              model[j]);
+        }
+    }
+
+    /* Inserting past the end fails */
+    ARC_ASSERT_INT_EQ(arc_deque_insert_range(deque, (unsigned long)size + 1,
+                                          batch, 1), ARC_ERROR);
+
+    /* The single element operations still work after the range ones */
+    ARC_ASSERT_INT_EQ(arc_deque_push_front(deque, &value), ARC_SUCCESS);
+    ARC_ASSERT_INT_EQ(*(int *)arc_deque_front(deque), value);
+    ARC_ASSERT_INT_EQ(arc_deque_push_back(deque, &value), ARC_SUCCESS);
+    ARC_ASSERT_INT_EQ(*(int *)arc_deque_back(deque), value);
+
+    arc_deque_destroy(deque);
+    free(batch);
+    free(model);
+}
+
+ARC_UNIT_TEST(sort)
+{
+    int i;
+    arc_deque_t deque = arc_deque_create(sizeof(int));
+
+    ARC_ASSERT_POINTER_NOT_NULL(deque);
+
+    /* Elements at both ends, across several blocks */
+    for (i = 0; i < 5000; i++)
+    {
+        int value = (i * 7919) % 5000;
+
+        if (i & 1)
+        {
+            ARC_ASSERT_INT_EQ(arc_deque_push_front(deque, &value), ARC_SUCCESS);
+        }
+        else
+        {
+            ARC_ASSERT_INT_EQ(arc_deque_push_back(deque, &value), ARC_SUCCESS);
+        }
+    }
+
+    ARC_ASSERT_INT_EQ(arc_deque_sort(deque, &arc_cmp_int), ARC_SUCCESS);
+
+    for (i = 0; i < 5000; i++)
+    {
+        ARC_ASSERT_INT_EQ(*(int *)arc_deque_at(deque, (unsigned long)i), i);
+    }
+
+    for (i = 0; i < 5000; i++)
+    {
+        int value = 4999 - i;
+        *(int *)arc_deque_at(deque, (unsigned long)i) = -value;
+    }
+
+    ARC_ASSERT_INT_EQ(arc_deque_radix_sort(deque, &arc_key_int), ARC_SUCCESS);
+
+    for (i = 0; i < 5000; i++)
+    {
+        int expected = i - 4999;
+        ARC_ASSERT_INT_EQ(*(int *)arc_deque_at(deque, (unsigned long)i),
+                          expected);
+    }
+
+    arc_deque_destroy(deque);
+}
+
 ARC_UNIT_TEST(destruction)
 {
     int i;
@@ -559,6 +684,8 @@ ARC_UNIT_TEST_FIXTURE()
     ARC_UNIT_ADD_TEST(iterators_insertion_back)
     ARC_UNIT_ADD_TEST(iterators_insertion_middle)
     ARC_UNIT_ADD_TEST(iterators_erase)
+    ARC_UNIT_ADD_TEST(ranges)
+    ARC_UNIT_ADD_TEST(sort)
     ARC_UNIT_ADD_TEST(destruction)
 }
 
@@ -15,6 +15,34 @@
 
 #include <string.h>
 
+struct counting_ctx
+{
+    unsigned long allocs;
+    unsigned long frees;
+};
+
+static void * counting_alloc(void *ctx, size_t size)
+{
+    ((struct counting_ctx *)ctx)->allocs++;
+    return malloc(size);
+}
+
+static void counting_free(void *ctx, void *ptr)
+{
+    ((struct counting_ctx *)ctx)->frees++;
+    free(ptr);
+}
+
+static void * counting_realloc(void *ctx, void *ptr, size_t size)
+{
+    if (ptr == NULL)
+    {
+        ((struct counting_ctx *)ctx)->allocs++;
+    }
+
+    return realloc(ptr, size);
+}
+
 ARC_UNIT_TEST(size)
 {
     int i = 10;
@@ -100,43 +128,481 @@ ARC_UNIT_TEST(removal)
     arc_htable_destroy(htable);
 }
 
-/* TODO: Add rehashing unit test to which doesn't lead to perfect hash */
-/*ARC_UNIT_TEST(rehash)*/
-/*{*/
-    /*int i = 10;*/
-    /*arc_htable_t htable = arc_htable_create(32,*/
-                                            /*sizeof(int),*/
-                                            /*arc_cmp_int,*/
-                                            /*arc_hash_pearson);*/
+ARC_UNIT_TEST(open_retrieval)
+{
+    int i;
+    arc_htable_t htable = arc_htable_create_open(32,
+                                                 sizeof(int),
+                                                 arc_cmp_int,
+                                                 arc_hash_pearson);
+
+    ARC_ASSERT_POINTER_NOT_NULL(htable);
+
+    ARC_ASSERT_TRUE(arc_htable_empty(htable));
+
+    for (i = 0; i < 10; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_htable_insert(htable, (void *)&i), ARC_SUCCESS);
+    }
+
+    for (i = 0; i < 10; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_htable_insert(htable, (void *)&i), ARC_DUPLICATE);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_htable_size(htable), 10);
+
+    for (i = 0; i < 10; i++)
+    {
+        int *data = arc_htable_retrieve(htable, (void *)&i);
+        ARC_ASSERT_POINTER_NOT_NULL(data);
+        ARC_ASSERT_INT_EQ(*data, i);
+    }
+
+    for (i = 10; i < 20; i++)
+    {
+        ARC_ASSERT_POINTER_NULL(arc_htable_retrieve(htable, (void *)&i));
+    }
+
+    arc_htable_destroy(htable);
+}
+
+ARC_UNIT_TEST(open_removal)
+{
+    int i;
+    arc_htable_t htable = arc_htable_create_open(8,
+                                                 sizeof(int),
+                                                 arc_cmp_int,
+                                                 arc_hash_djb2);
+
+    ARC_ASSERT_POINTER_NOT_NULL(htable);
+
+    for (i = 0; i < 1000; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_htable_insert(htable, (void *)&i), ARC_SUCCESS);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_htable_size(htable), 1000);
+
+    for (i = 0; i < 1000; i += 2)
+    {
+        arc_htable_remove(htable, (void *)&i);
+        ARC_ASSERT_POINTER_NULL(arc_htable_retrieve(htable, (void *)&i));
+    }
+
+    /* Removing an element which is not in the table has no effect */
+    i = 2000;
+    arc_htable_remove(htable, (void *)&i);
+
+    ARC_ASSERT_INT_EQ(arc_htable_size(htable), 500);
+
+    for (i = 1; i < 1000; i += 2)
+    {
+        int *data = arc_htable_retrieve(htable, (void *)&i);
+        ARC_ASSERT_POINTER_NOT_NULL(data);
+        ARC_ASSERT_INT_EQ(*data, i);
+    }
+
+    for (i = 0; i < 1000; i += 2)
+    {
+        ARC_ASSERT_INT_EQ(arc_htable_insert(htable, (void *)&i), ARC_SUCCESS);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_htable_size(htable), 1000);
+
+    arc_htable_clear(htable);
+
+    ARC_ASSERT_TRUE(arc_htable_empty(htable));
+
+    for (i = 0; i < 1000; i++)
+    {
+        ARC_ASSERT_POINTER_NULL(arc_htable_retrieve(htable, (void *)&i));
+    }
+
+    arc_htable_destroy(htable);
+}
+
+ARC_UNIT_TEST(open_alignment)
+{
+    int i;
+    arc_htable_t htable = arc_htable_create_open(32,
+                                                 sizeof(double),
+                                                 arc_cmp_double,
+                                                 arc_hash_pearson);
+
+    ARC_ASSERT_POINTER_NOT_NULL(htable);
+
+    for (i = 0; i < 100; i++)
+    {
+        double value = i * 0.5;
+
+        ARC_ASSERT_INT_EQ(arc_htable_insert(htable, &value), ARC_SUCCESS);
+    }
+
+    for (i = 0; i < 100; i++)
+    {
+        double value = i * 0.5;
+        double *data = arc_htable_retrieve(htable, &value);
+        size_t misalignment = (size_t)data % sizeof(double);
+
+        ARC_ASSERT_POINTER_NOT_NULL(data);
+        ARC_ASSERT_ULONG_EQ(misalignment, 0);
+        ARC_ASSERT_DOUBLE_EQ(*data, value, 1e-9);
+    }
+
+    arc_htable_destroy(htable);
+}
+
+ARC_UNIT_TEST(rehash)
+{
+    int i;
+    arc_htable_t htable = arc_htable_create(32,
+                                            sizeof(int),
+                                            arc_cmp_int,
+                                            arc_hash_pearson);
+
+    ARC_ASSERT_POINTER_NOT_NULL(htable);
+
+    ARC_ASSERT_TRUE(arc_htable_empty(htable));
+
+    for (i = 0; i < 100; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_htable_insert(htable, (void *)&i), ARC_SUCCESS);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_htable_size(htable), 100);
+
+    ARC_ASSERT_INT_EQ(arc_htable_rehash(htable, 100), ARC_SUCCESS);
+
+    for (i = 0; i < 100; i++)
+    {
+        int *data = arc_htable_retrieve(htable, (void *)&i);
+        ARC_ASSERT_POINTER_NOT_NULL(data);
+        ARC_ASSERT_INT_EQ(*data, i);
+    }
+
+    arc_htable_destroy(htable);
+}
+
+ARC_UNIT_TEST(incremental_rehash)
+{
+    int i, j;
+    arc_htable_t tables[2];
+
+    tables[0] = arc_htable_create(4, sizeof(int), arc_cmp_int, arc_hash_djb2);
+    tables[1] = arc_htable_create_open(4, sizeof(int),
+                                       arc_cmp_int, arc_hash_djb2);
+
+    for (j = 0; j < 2; j++)
+    {
+        arc_htable_t htable = tables[j];
+
+        ARC_ASSERT_POINTER_NOT_NULL(htable);
+
+        ARC_ASSERT_INT_EQ(arc_htable_set_max_load_factor(htable, 0.0),
+                          ARC_ERROR);
+        ARC_ASSERT_INT_EQ(arc_htable_set_max_load_factor(htable, 0.5),
+                          ARC_SUCCESS);
+
+        /* Every insertion is checked against both bucket arrays */
+        for (i = 0; i < 5000; i++)
+        {
+            ARC_ASSERT_INT_EQ(arc_htable_insert(htable, (void *)&i),
+                              ARC_SUCCESS);
+            ARC_ASSERT_INT_EQ(arc_htable_insert(htable, (void *)&i),
+                              ARC_DUPLICATE);
+
+            if (i % 3 == 0)
+            {
+                arc_htable_remove(htable, (void *)&i);
+                ARC_ASSERT_POINTER_NULL(arc_htable_retrieve(htable,
+                                                            (void *)&i));
+            }
+        }
+
+        ARC_ASSERT_INT_EQ(arc_htable_size(htable), 3333);
+
+        for (i = 0; i < 5000; i++)
+        {
+            int *data = arc_htable_retrieve(htable, (void *)&i);
+
+            if (i % 3 == 0)
+            {
+                ARC_ASSERT_POINTER_NULL(data);
+            }
+            else
+            {
+                ARC_ASSERT_POINTER_NOT_NULL(data);
+                ARC_ASSERT_INT_EQ(*data, i);
+            }
+        }
+
+        arc_htable_clear(htable);
+
+        ARC_ASSERT_TRUE(arc_htable_empty(htable));
+
+        arc_htable_destroy(htable);
+    }
+}
+
+ARC_UNIT_TEST(seeded)
+{
+    int i, j;
+    arc_htable_t tables[2];
+
+    tables[0] = arc_htable_create_seeded(4, sizeof(int), arc_cmp_int,
+                                         arc_hash_int32_seeded);
+    tables[1] = arc_htable_create_open_seeded(4, sizeof(int), arc_cmp_int,
+                                              arc_hash_int32_seeded);
+
+    for (j = 0; j < 2; j++)
+    {
+        arc_htable_t htable = tables[j];
+
+        ARC_ASSERT_POINTER_NOT_NULL(htable);
+
+        for (i = 0; i < 1000; i++)
+        {
+            ARC_ASSERT_INT_EQ(arc_htable_insert(htable, (void *)&i),
+                              ARC_SUCCESS);
+        }
+
+        for (i = 0; i < 1000; i += 2)
+        {
+            arc_htable_remove(htable, (void *)&i);
+        }
+
+        ARC_ASSERT_INT_EQ(arc_htable_size(htable), 500);
+
+        for (i = 0; i < 1000; i++)
+        {
+            int *data = arc_htable_retrieve(htable, (void *)&i);
+
+            if (i % 2 == 0)
+            {
+                ARC_ASSERT_POINTER_NULL(data);
+            }
+            else
+            {
+                ARC_ASSERT_POINTER_NOT_NULL(data);
+                ARC_ASSERT_INT_EQ(*data, i);
+            }
+        }
+
+        arc_htable_destroy(htable);
+    }
+
+    /* Two seeds should not agree on every hash value, even for the same
+       salt */
+    ARC_ASSERT_TRUE(arc_hash_random_seed(NULL) != arc_hash_random_seed(NULL));
+    ARC_ASSERT_TRUE(arc_hash_random_seed(&i) != arc_hash_random_seed(&i));
+}
+
+ARC_UNIT_TEST(retrieve_batch)
+{
+    int i, j, keys[100];
+    void *results[100];
+    arc_htable_t tables[2];
+
+    tables[0] = arc_htable_create(4, sizeof(int), arc_cmp_int, arc_hash_djb2);
+    tables[1] = arc_htable_create_open(4, sizeof(int),
+                                       arc_cmp_int, arc_hash_djb2);
+
+    for (i = 0; i < 100; i++)
+    {
+        keys[i] = 99 - i;
+    }
+
+    for (j = 0; j < 2; j++)
+    {
+        arc_htable_t htable = tables[j];
+
+        ARC_ASSERT_POINTER_NOT_NULL(htable);
+
+        for (i = 0; i < 100; i += 2)
+        {
+            ARC_ASSERT_INT_EQ(arc_htable_insert(htable, (void *)&i),
+                              ARC_SUCCESS);
+        }
+
+        ARC_ASSERT_INT_EQ(arc_htable_retrieve_batch(htable, keys, 100,
+                                                    results), 50);
+
+        for (i = 0; i < 100; i++)
+        {
+            if (keys[i] % 2 == 0)
+            {
+                ARC_ASSERT_POINTER_NOT_NULL(results[i]);
+                ARC_ASSERT_INT_EQ(*(int *)results[i], keys[i]);
+            }
+            else
+            {
+                ARC_ASSERT_POINTER_NULL(results[i]);
+            }
+        }
+
+        arc_htable_destroy(htable);
+    }
+}
+
+ARC_UNIT_TEST(allocator)
+{
+    int i;
+    struct counting_ctx ctx = {0, 0};
+    struct arc_allocator allocator;
+    arc_htable_t htable;
+
+    allocator.alloc_fn = counting_alloc;
+    allocator.free_fn = counting_free;
+    allocator.realloc_fn = counting_realloc;
+    allocator.ctx = &ctx;
+
+    htable = arc_htable_create_with_allocator(16, sizeof(int), arc_cmp_int,
+                                              arc_hash_int32, &allocator);
+
+    ARC_ASSERT_POINTER_NOT_NULL(htable);
+
+    /* The bucket array and a node per element */
+    for (i = 0; i < 10; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_htable_insert(htable, &i), ARC_SUCCESS);
+    }
+
+    ARC_ASSERT_ULONG_EQ(ctx.allocs, 11);
+
+    /* Growing and removing go through the allocator too */
+    for (i = 10; i < 1000; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_htable_insert(htable, &i), ARC_SUCCESS);
+    }
+
+    for (i = 0; i < 1000; i += 2)
+    {
+        arc_htable_remove(htable, &i);
+    }
+
+    arc_htable_destroy(htable);
+
+    ARC_ASSERT_ULONG_EQ(ctx.frees, ctx.allocs);
+
+    ctx.allocs = ctx.frees = 0;
+
+    htable = arc_htable_create_open_with_allocator(16, sizeof(int),
+                                                   arc_cmp_int,
+                                                   arc_hash_int32,
+                                                   &allocator);
+
+    ARC_ASSERT_POINTER_NOT_NULL(htable);
+
+    for (i = 0; i < 1000; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_htable_insert(htable, &i), ARC_SUCCESS);
+    }
+
+    arc_htable_destroy(htable);
+
+    ARC_ASSERT_ULONG_GT(ctx.allocs, 1);
+    ARC_ASSERT_ULONG_EQ(ctx.frees, ctx.allocs);
+}
+
+ARC_UNIT_TEST(duplicate_no_grow)
+{
+    int i;
+    int zero = 0;
+    struct counting_ctx ctx = {0, 0};
+    struct arc_allocator allocator;
+    arc_htable_t htable;
+
+    allocator.alloc_fn = counting_alloc;
+    allocator.free_fn = counting_free;
+    allocator.realloc_fn = counting_realloc;
+    allocator.ctx = &ctx;
+
+    /* Open addressing only allocates when the slot array grows, the chained
+       buckets reallocate every node they migrate */
+    htable = arc_htable_create_open_with_allocator(16, sizeof(int),
+                                                   arc_cmp_int, arc_hash_int32,
+                                                   &allocator);
+
+    ARC_ASSERT_POINTER_NOT_NULL(htable);
+    ARC_ASSERT_INT_EQ(arc_htable_insert(htable, &zero), ARC_SUCCESS);
+
+    /* Every load factor boundary is reached with a duplicate first */
+    for (i = 1; i < 500; i++)
+    {
+        unsigned long allocs = ctx.allocs;
+
+        ARC_ASSERT_INT_EQ(arc_htable_insert(htable, &zero), ARC_DUPLICATE);
+        ARC_ASSERT_ULONG_EQ(ctx.allocs, allocs);
+        ARC_ASSERT_INT_EQ(arc_htable_insert(htable, &i), ARC_SUCCESS);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_htable_size(htable), 500);
+    ARC_ASSERT_ULONG_GT(ctx.allocs, 1);
+
+    arc_htable_destroy(htable);
+}
+
+ARC_UNIT_TEST(pooled)
+{
+    int i, round, num_elems;
+    arc_htable_t htable = arc_htable_create_pooled(8, sizeof(int),
+                                                   arc_cmp_int,
+                                                   arc_hash_int32);
+
+    ARC_ASSERT_POINTER_NOT_NULL(htable);
+
+    for (round = 0; round < 3; round++)
+    {
+        /* Clearing in the middle of an incremental rehash also has to release
+           the nodes of the old buckets */
+        num_elems = 1000 + round * 7;
+
+        for (i = 0; i < num_elems; i++)
+        {
+            ARC_ASSERT_INT_EQ(arc_htable_insert(htable, &i), ARC_SUCCESS);
+        }
 
-    /*ARC_ASSERT_POINTER_NOT_NULL(htable);*/
+        for (i = 0; i < 1000; i += 3)
+        {
+            arc_htable_remove(htable, &i);
+        }
 
-    /*ARC_ASSERT_TRUE(arc_htable_empty(htable));*/
+        for (i = 1; i < 1000; i += 3)
+        {
+            int *data = arc_htable_retrieve(htable, &i);
+            ARC_ASSERT_POINTER_NOT_NULL(data);
+            ARC_ASSERT_INT_EQ(*data, i);
+        }
 
-    /*for (i = 0; i < 100; i++)*/
-    /*{*/
-        /*ARC_ASSERT_INT_EQ(arc_htable_insert(htable, (void *)&i), ARC_SUCCESS);*/
-    /*}*/
+        arc_htable_clear(htable);
 
-    /*ARC_ASSERT_INT_EQ(arc_htable_size(htable), 100);*/
+        ARC_ASSERT_TRUE(arc_htable_empty(htable));
 
-    /*ARC_ASSERT_INT_EQ(arc_htable_rehash(htable, 100), ARC_SUCCESS);*/
+        i = 1;
+        ARC_ASSERT_POINTER_NULL(arc_htable_retrieve(htable, &i));
+    }
 
-    /*for (i = 0; i < 100; i++)*/
-    /*{*/
-        /*int *data = arc_htable_retrieve(htable, (void *)&i);*/
-        /*ARC_ASSERT_INT_EQ(*data, i);*/
-    /*}*/
+    ARC_ASSERT_INT_EQ(arc_htable_insert(htable, &i), ARC_SUCCESS);
 
-    /*arc_htable_destroy(htable);*/
-/*}*/
+    arc_htable_destroy(htable);
+}
 
 ARC_UNIT_TEST_FIXTURE()
 {
     ARC_UNIT_ADD_TEST(size)
     ARC_UNIT_ADD_TEST(retrieval)
     ARC_UNIT_ADD_TEST(removal)
-    /*ARC_UNIT_ADD_TEST(rehash)*/
+    ARC_UNIT_ADD_TEST(open_retrieval)
+    ARC_UNIT_ADD_TEST(open_removal)
+    ARC_UNIT_ADD_TEST(open_alignment)
+    ARC_UNIT_ADD_TEST(rehash)
+    ARC_UNIT_ADD_TEST(incremental_rehash)
+    ARC_UNIT_ADD_TEST(seeded)
+    ARC_UNIT_ADD_TEST(retrieve_batch)
+    ARC_UNIT_ADD_TEST(allocator)
+    ARC_UNIT_ADD_TEST(duplicate_no_grow)
+    ARC_UNIT_ADD_TEST(pooled)
 }
 
 ARC_UNIT_RUN_TESTS()
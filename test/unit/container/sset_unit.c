@@ -0,0 +1,261 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <arc/container/sset.h>
+#include <arc/container/darray.h>
+#include <arc/container/avltree.h>
+#include <arc/type/function.h>
+#include <arc/test/unit.h>
+#include <arc/common/defines.h>
+
+/* Same as arc_cmp_int, but it's not recognized by the sset */
+static int int_cmp(const void *a, const void *b)
+{
+    return arc_cmp_int(a, b);
+}
+
+/* Checks every key around the elements 0, 2, ..., 2 * (num - 1) */
+static int check_evens(arc_sset_t sset, int num)
+{
+    int key;
+
+    if ((int)arc_sset_size(sset) != num)
+    {
+        return 0;
+    }
+
+    for (key = -1; key <= 2 * num; key++)
+    {
+        int * found = arc_sset_retrieve(sset, &key);
+        int * bound = arc_sset_lower_bound(sset, &key);
+
+        if ((key & 1) == 0 && key < 2 * num)
+        {
+            if (found == NULL || *found != key)
+            {
+                return 0;
+            }
+        }
+        else if (found != NULL)
+        {
+            return 0;
+        }
+
+        if (key >= 2 * num - 1)
+        {
+            if (bound != NULL)
+            {
+                return 0;
+            }
+        }
+        else if (bound == NULL || *bound != (key < 0 ? 0 : key + (key & 1)))
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+ARC_UNIT_TEST(shapes)
+{
+    int values[200];
+    int num, i;
+
+    for (i = 0; i < 200; i++)
+    {
+        values[i] = 2 * i;
+    }
+
+    /* Every shape of the last level, for the typed and the generic search */
+    for (num = 0; num <= 200; num++)
+    {
+        arc_sset_t sset = arc_sset_create(sizeof(int), &arc_cmp_int,
+                                          values, (size_t)num);
+
+        ARC_ASSERT_POINTER_NOT_NULL(sset);
+        ARC_ASSERT_TRUE(check_evens(sset, num));
+        arc_sset_destroy(sset);
+
+        sset = arc_sset_create(sizeof(int), &int_cmp, values, (size_t)num);
+
+        ARC_ASSERT_POINTER_NOT_NULL(sset);
+        ARC_ASSERT_TRUE(check_evens(sset, num));
+        arc_sset_destroy(sset);
+    }
+}
+
+ARC_UNIT_TEST(from_darray)
+{
+    int i;
+    arc_sset_t sset;
+    arc_darray_t darray = arc_darray_create(sizeof(int));
+
+    ARC_ASSERT_POINTER_NOT_NULL(darray);
+
+    /* The elements wrap around the end of the block */
+    for (i = 500; i < 1000; i++)
+    {
+        int value = 2 * i;
+        ARC_ASSERT_INT_EQ(arc_darray_push_back(darray, &value), ARC_SUCCESS);
+    }
+
+    for (i = 499; i >= 0; i--)
+    {
+        int value = 2 * i;
+        ARC_ASSERT_INT_EQ(arc_darray_push_front(darray, &value), ARC_SUCCESS);
+    }
+
+    sset = arc_sset_create_from_darray(darray, &arc_cmp_int);
+
+    ARC_ASSERT_POINTER_NOT_NULL(sset);
+    ARC_ASSERT_TRUE(check_evens(sset, 1000));
+
+    arc_sset_destroy(sset);
+    arc_darray_destroy(darray);
+}
+
+ARC_UNIT_TEST(from_avltree)
+{
+    int i;
+    arc_sset_t sset;
+    arc_avltree_t tree = arc_avltree_create(sizeof(int), &arc_cmp_int);
+
+    ARC_ASSERT_POINTER_NOT_NULL(tree);
+
+    for (i = 0; i < 1000; i++)
+    {
+        int value = 2 * ((i * 7919) % 1000);
+        ARC_ASSERT_INT_EQ(arc_avltree_insert(tree, &value), ARC_SUCCESS);
+    }
+
+    sset = arc_sset_create_from_avltree(tree);
+
+    ARC_ASSERT_POINTER_NOT_NULL(sset);
+    ARC_ASSERT_TRUE(check_evens(sset, 1000));
+
+    arc_sset_destroy(sset);
+    arc_avltree_destroy(tree);
+}
+
+ARC_UNIT_TEST(from_avltree_memcmp)
+{
+    int i;
+    unsigned char key[4];
+    arc_sset_t sset;
+    arc_avltree_t tree = arc_avltree_create(sizeof(key), NULL);
+
+    ARC_ASSERT_POINTER_NOT_NULL(tree);
+
+    /* Even numbers in big endian order, memcmp sorts them by value */
+    for (i = 0; i < 1000; i++)
+    {
+        key[0] = 0;
+        key[1] = 0;
+        key[2] = (unsigned char)((2 * i) >> 8);
+        key[3] = (unsigned char)(2 * i);
+        ARC_ASSERT_INT_EQ(arc_avltree_insert(tree, key), ARC_SUCCESS);
+    }
+
+    sset = arc_sset_create_from_avltree(tree);
+
+    ARC_ASSERT_POINTER_NOT_NULL(sset);
+    ARC_ASSERT_INT_EQ((int)arc_sset_size(sset), 1000);
+
+    for (i = 0; i < 1999; i++)
+    {
+        unsigned char *found;
+
+        key[2] = (unsigned char)(i >> 8);
+        key[3] = (unsigned char)i;
+        found = arc_sset_lower_bound(sset, key);
+
+        ARC_ASSERT_POINTER_NOT_NULL(found);
+        ARC_ASSERT_INT_EQ((found[2] << 8) | found[3], i + (i & 1));
+
+        if (i & 1)
+        {
+            ARC_ASSERT_POINTER_NULL(arc_sset_retrieve(sset, key));
+        }
+        else
+        {
+            ARC_ASSERT_POINTER_EQ(arc_sset_retrieve(sset, key), found);
+        }
+    }
+
+    /* Past the greatest element */
+    key[3] = 0xff;
+    key[2] = 0xff;
+    ARC_ASSERT_POINTER_NULL(arc_sset_lower_bound(sset, key));
+
+    arc_sset_destroy(sset);
+    arc_avltree_destroy(tree);
+}
+
+ARC_UNIT_TEST(typed)
+{
+    long lvalues[100];
+    double dvalues[100];
+    arc_sset_t lsset, dsset;
+    long lkey;
+    double dkey;
+    int i;
+
+    for (i = 0; i < 100; i++)
+    {
+        lvalues[i] = 1000L * (i - 50);
+        dvalues[i] = (i - 50) / 4.0;
+    }
+
+    lsset = arc_sset_create(sizeof(long), &arc_cmp_long, lvalues, 100);
+    dsset = arc_sset_create(sizeof(double), &arc_cmp_double, dvalues, 100);
+
+    ARC_ASSERT_POINTER_NOT_NULL(lsset);
+    ARC_ASSERT_POINTER_NOT_NULL(dsset);
+
+    for (i = 0; i < 100; i++)
+    {
+        ARC_ASSERT_POINTER_EQ(arc_sset_lower_bound(lsset, &lvalues[i]),
+                              arc_sset_retrieve(lsset, &lvalues[i]));
+        ARC_ASSERT_POINTER_EQ(arc_sset_lower_bound(dsset, &dvalues[i]),
+                              arc_sset_retrieve(dsset, &dvalues[i]));
+
+        lkey = lvalues[i] - 1;
+        dkey = dvalues[i] - 0.125;
+
+        ARC_ASSERT_POINTER_NULL(arc_sset_retrieve(lsset, &lkey));
+        ARC_ASSERT_POINTER_NULL(arc_sset_retrieve(dsset, &dkey));
+        ARC_ASSERT_TRUE(*(long *)arc_sset_lower_bound(lsset, &lkey) ==
+                        lvalues[i]);
+        ARC_ASSERT_TRUE(!(*(double *)arc_sset_lower_bound(dsset, &dkey) <
+                          dvalues[i]));
+    }
+
+    lkey = 50000;
+    dkey = 13.0;
+
+    ARC_ASSERT_POINTER_NULL(arc_sset_lower_bound(lsset, &lkey));
+    ARC_ASSERT_POINTER_NULL(arc_sset_lower_bound(dsset, &dkey));
+
+    arc_sset_destroy(dsset);
+    arc_sset_destroy(lsset);
+}
+
+ARC_UNIT_TEST_FIXTURE()
+{
+    ARC_UNIT_ADD_TEST(shapes)
+    ARC_UNIT_ADD_TEST(from_darray)
+    ARC_UNIT_ADD_TEST(from_avltree)
+    ARC_UNIT_ADD_TEST(from_avltree_memcmp)
+    ARC_UNIT_ADD_TEST(typed)
+}
+
+ARC_UNIT_RUN_TESTS()
@@ -14,6 +14,34 @@
 
 #include <string.h>
 
+struct counting_ctx
+{
+    unsigned long allocs;
+    unsigned long frees;
+};
+
+static void * counting_alloc(void *ctx, size_t size)
+{
+    ((struct counting_ctx *)ctx)->allocs++;
+    return malloc(size);
+}
+
+static void counting_free(void *ctx, void *ptr)
+{
+    ((struct counting_ctx *)ctx)->frees++;
+    free(ptr);
+}
+
+static void * counting_realloc(void *ctx, void *ptr, size_t size)
+{
+    if (ptr == NULL)
+    {
+        ((struct counting_ctx *)ctx)->allocs++;
+    }
+
+    return realloc(ptr, size);
+}
+
 ARC_UNIT_TEST(creation)
 {
     arc_stack_t stack = arc_stack_create(sizeof(int));
@@ -100,6 +128,41 @@ ARC_UNIT_TEST(destruction)
     arc_stack_destroy(stack);
 }
 
+ARC_UNIT_TEST(allocator)
+{
+    int i;
+    struct counting_ctx ctx = {0, 0};
+    struct arc_allocator allocator;
+    arc_stack_t stack;
+
+    allocator.alloc_fn = counting_alloc;
+    allocator.free_fn = counting_free;
+    allocator.realloc_fn = counting_realloc;
+    allocator.ctx = &ctx;
+
+    stack = arc_stack_create_with_allocator(sizeof(int), &allocator);
+
+    ARC_ASSERT_POINTER_NOT_NULL(stack);
+
+    for (i = 0; i < 100; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_stack_push(stack, &i), ARC_SUCCESS);
+    }
+
+    ARC_ASSERT_ULONG_EQ(ctx.allocs, 100);
+
+    for (i = 0; i < 50; i++)
+    {
+        arc_stack_pop(stack);
+    }
+
+    ARC_ASSERT_ULONG_EQ(ctx.frees, 50);
+
+    arc_stack_destroy(stack);
+
+    ARC_ASSERT_ULONG_EQ(ctx.frees, ctx.allocs);
+}
+
 ARC_UNIT_TEST_FIXTURE()
 {
     ARC_UNIT_ADD_TEST(creation)
@@ -107,6 +170,7 @@ ARC_UNIT_TEST_FIXTURE()
     ARC_UNIT_ADD_TEST(size)
     ARC_UNIT_ADD_TEST(push_pop)
     ARC_UNIT_ADD_TEST(destruction)
+    ARC_UNIT_ADD_TEST(allocator)
 }
 
 ARC_UNIT_RUN_TESTS()
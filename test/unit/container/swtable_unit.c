@@ -0,0 +1,186 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <stdio.h>
+#include <arc/container/swtable.h>
+#include <arc/test/unit.h>
+#include <arc/type/hash.h>
+#include <arc/common/defines.h>
+
+static arc_hkey_t identity_hash(const void *key, size_t size)
+{
+    ARC_UNUSED(size);
+    return (arc_hkey_t)*((const int *)key);
+}
+
+ARC_UNIT_TEST(size)
+{
+    int i = 10;
+    arc_swtable_t swtable = arc_swtable_create(32,
+                                               sizeof(int),
+                                               arc_cmp_int,
+                                               arc_hash_pearson);
+
+    ARC_ASSERT_POINTER_NOT_NULL(swtable);
+
+    ARC_ASSERT_TRUE(arc_swtable_empty(swtable));
+
+    ARC_ASSERT_INT_EQ(arc_swtable_insert(swtable, &i), ARC_SUCCESS);
+
+    ARC_ASSERT_INT_EQ(arc_swtable_size(swtable), 1);
+
+    ARC_ASSERT_FALSE(arc_swtable_empty(swtable));
+
+    ARC_ASSERT_INT_EQ(arc_swtable_insert(swtable, &i), ARC_DUPLICATE);
+
+    for (i = 0; i < 10; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_swtable_insert(swtable, &i), ARC_SUCCESS);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_swtable_size(swtable), 11);
+
+    arc_swtable_clear(swtable);
+
+    ARC_ASSERT_TRUE(arc_swtable_empty(swtable));
+
+    i = 5;
+    ARC_ASSERT_POINTER_NULL(arc_swtable_retrieve(swtable, &i));
+
+    arc_swtable_destroy(swtable);
+}
+
+ARC_UNIT_TEST(retrieval)
+{
+    int i;
+    arc_swtable_t swtable = arc_swtable_create(0,
+                                               sizeof(int),
+                                               arc_cmp_int,
+                                               identity_hash);
+
+    ARC_ASSERT_POINTER_NOT_NULL(swtable);
+
+    for (i = 0; i < 5000; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_swtable_insert(swtable, &i), ARC_SUCCESS);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_swtable_size(swtable), 5000);
+
+    for (i = 0; i < 5000; i++)
+    {
+        int *data = arc_swtable_retrieve(swtable, &i);
+        ARC_ASSERT_POINTER_NOT_NULL(data);
+        ARC_ASSERT_INT_EQ(*data, i);
+    }
+
+    for (i = 5000; i < 10000; i++)
+    {
+        ARC_ASSERT_POINTER_NULL(arc_swtable_retrieve(swtable, &i));
+    }
+
+    arc_swtable_destroy(swtable);
+}
+
+ARC_UNIT_TEST(removal)
+{
+    int i, value, round;
+    arc_swtable_t swtable = arc_swtable_create(64,
+                                               sizeof(int),
+                                               arc_cmp_int,
+                                               identity_hash);
+
+    ARC_ASSERT_POINTER_NOT_NULL(swtable);
+
+    /* Repeated insertions and removals leave tombstones behind which have to
+       be recycled without growing the table indefinitely */
+    for (round = 0; round < 50; round++)
+    {
+        for (i = 0; i < 50; i++)
+        {
+            value = round * 40 + i;
+            ARC_ASSERT_INT_EQ(arc_swtable_insert(swtable, &value), ARC_SUCCESS);
+        }
+
+        for (i = 0; i < 50; i += 2)
+        {
+            value = round * 40 + i;
+            arc_swtable_remove(swtable, &value);
+            ARC_ASSERT_POINTER_NULL(arc_swtable_retrieve(swtable, &value));
+        }
+
+        for (i = 1; i < 50; i += 2)
+        {
+            int *data;
+
+            value = round * 40 + i;
+            data = arc_swtable_retrieve(swtable, &value);
+            ARC_ASSERT_POINTER_NOT_NULL(data);
+            ARC_ASSERT_INT_EQ(*data, value);
+            arc_swtable_remove(swtable, &value);
+        }
+
+        ARC_ASSERT_TRUE(arc_swtable_empty(swtable));
+    }
+
+    /* Removing a missing element has no effect */
+    ARC_ASSERT_INT_EQ(arc_swtable_insert(swtable, &value), ARC_SUCCESS);
+    value++;
+    arc_swtable_remove(swtable, &value);
+    ARC_ASSERT_INT_EQ(arc_swtable_size(swtable), 1);
+
+    arc_swtable_destroy(swtable);
+}
+
+ARC_UNIT_TEST(rehash)
+{
+    int i;
+    arc_swtable_t swtable = arc_swtable_create(0,
+                                               sizeof(int),
+                                               arc_cmp_int,
+                                               arc_hash_djb2);
+
+    ARC_ASSERT_POINTER_NOT_NULL(swtable);
+
+    for (i = 0; i < 1000; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_swtable_insert(swtable, &i), ARC_SUCCESS);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_swtable_rehash(swtable, 10000), ARC_SUCCESS);
+
+    for (i = 0; i < 1000; i++)
+    {
+        int *data = arc_swtable_retrieve(swtable, &i);
+        ARC_ASSERT_POINTER_NOT_NULL(data);
+        ARC_ASSERT_INT_EQ(*data, i);
+    }
+
+    /* Shrinking never goes below the current size */
+    ARC_ASSERT_INT_EQ(arc_swtable_rehash(swtable, 0), ARC_SUCCESS);
+
+    for (i = 0; i < 1000; i++)
+    {
+        ARC_ASSERT_POINTER_NOT_NULL(arc_swtable_retrieve(swtable, &i));
+    }
+
+    ARC_ASSERT_INT_EQ(arc_swtable_size(swtable), 1000);
+
+    arc_swtable_destroy(swtable);
+}
+
+ARC_UNIT_TEST_FIXTURE()
+{
+    ARC_UNIT_ADD_TEST(size)
+    ARC_UNIT_ADD_TEST(retrieval)
+    ARC_UNIT_ADD_TEST(removal)
+    ARC_UNIT_ADD_TEST(rehash)
+}
+
+ARC_UNIT_RUN_TESTS()
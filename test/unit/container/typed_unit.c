@@ -0,0 +1,169 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <stdio.h>
+#include <arc/container/typed.h>
+#include <arc/test/unit.h>
+#include <arc/common/defines.h>
+#include <stdlib.h>
+
+#define int_cmp(a, b) ARC_TYPED_CMP(a, b)
+#define double_cmp(a, b) ARC_TYPED_CMP(a, b)
+
+ARC_DEFINE_DARRAY(int_vec, int)
+ARC_DEFINE_AVLTREE(int_set, int, int_cmp)
+ARC_DEFINE_AVLTREE(double_set, double, double_cmp)
+
+ARC_UNIT_TEST(darray)
+{
+    int i;
+    int_vec_t vec = int_vec_create();
+
+    ARC_ASSERT_POINTER_NOT_NULL(vec);
+    ARC_ASSERT_TRUE(int_vec_empty(vec));
+    ARC_ASSERT_POINTER_NULL(int_vec_front(vec));
+
+    /* Goes well past the initial capacity */
+    for (i = 0; i < 1000; i++)
+    {
+        ARC_ASSERT_INT_EQ(int_vec_push_back(vec, i), ARC_SUCCESS);
+    }
+
+    ARC_ASSERT_INT_EQ(int_vec_size(vec), 1000);
+    ARC_ASSERT_INT_EQ(*int_vec_front(vec), 0);
+    ARC_ASSERT_INT_EQ(*int_vec_back(vec), 999);
+
+    for (i = 0; i < 1000; i++)
+    {
+        ARC_ASSERT_INT_EQ(*int_vec_at(vec, (size_t)i), i);
+        ARC_ASSERT_INT_EQ(int_vec_data(vec)[i], i);
+    }
+
+    /* The generic functions see the same elements */
+    ARC_ASSERT_INT_EQ(*(int *)arc_darray_at(vec, 500), 500);
+
+    int_vec_pop_back(vec);
+    ARC_ASSERT_INT_EQ(*int_vec_back(vec), 998);
+
+    int_vec_clear(vec);
+    ARC_ASSERT_TRUE(int_vec_empty(vec));
+
+    int_vec_destroy(vec);
+}
+
+ARC_UNIT_TEST(avltree)
+{
+    int i;
+    int_set_t set = int_set_create();
+
+    ARC_ASSERT_POINTER_NOT_NULL(set);
+    ARC_ASSERT_TRUE(int_set_empty(set));
+
+    for (i = 0; i < 1000; i += 2)
+    {
+        ARC_ASSERT_INT_EQ(int_set_insert(set, i), ARC_SUCCESS);
+    }
+
+    ARC_ASSERT_INT_EQ(int_set_insert(set, 10), ARC_DUPLICATE);
+    ARC_ASSERT_INT_EQ(int_set_size(set), 500);
+
+    for (i = 0; i < 1000; i++)
+    {
+        int *data = int_set_retrieve(set, i);
+
+        if (i % 2 == 0)
+        {
+            ARC_ASSERT_POINTER_NOT_NULL(data);
+            ARC_ASSERT_INT_EQ(*data, i);
+        }
+        else
+        {
+            ARC_ASSERT_POINTER_NULL(data);
+        }
+    }
+
+    for (i = 0; i < 1000; i += 4)
+    {
+        int_set_remove(set, i);
+    }
+
+    /* Missing elements are ignored */
+    int_set_remove(set, 1);
+
+    ARC_ASSERT_INT_EQ(int_set_size(set), 250);
+    ARC_ASSERT_POINTER_NULL(int_set_retrieve(set, 4));
+    ARC_ASSERT_POINTER_NOT_NULL(int_set_retrieve(set, 6));
+
+    int_set_clear(set);
+    ARC_ASSERT_TRUE(int_set_empty(set));
+
+    int_set_destroy(set);
+}
+
+ARC_UNIT_TEST(avltree_generic)
+{
+    int i;
+    double value;
+    double_set_t set = double_set_create_pooled();
+    arc_avltree_iterator_t it = arc_avltree_iterator_create(set);
+
+    ARC_ASSERT_POINTER_NOT_NULL(set);
+
+    for (i = 100; i > 0; i--)
+    {
+        ARC_ASSERT_INT_EQ(double_set_insert(set, i * 0.5), ARC_SUCCESS);
+    }
+
+    /* The elements inserted by the generic functions end up in the same
+       place of the node */
+    value = 100.25;
+    ARC_ASSERT_INT_EQ(arc_avltree_insert(set, &value), ARC_SUCCESS);
+    ARC_ASSERT_POINTER_NOT_NULL(double_set_retrieve(set, 100.25));
+
+    value = 0.5;
+    ARC_ASSERT_POINTER_NOT_NULL(arc_avltree_retrieve(set, &value));
+
+    /* The iterators walk through the typed nodes in order */
+    i = 1;
+    arc_avltree_before_begin(it);
+
+    while (arc_avltree_next(it))
+    {
+        double expected = (i > 100 ? 100.25 : i * 0.5);
+
+        ARC_ASSERT_DOUBLE_EQ(*(double *)arc_avltree_data(it), expected, 0.0001);
+        i++;
+    }
+
+    ARC_ASSERT_INT_EQ(i, 102);
+
+    value = 25.0;
+    ARC_ASSERT_TRUE(arc_avltree_position(it, &value));
+    arc_avltree_erase(it);
+    ARC_ASSERT_POINTER_NULL(double_set_retrieve(set, 25.0));
+    ARC_ASSERT_INT_EQ(double_set_size(set), 100);
+
+    /* The sizes of the subtrees are kept in the typed nodes too */
+    ARC_ASSERT_INT_EQ((int)arc_avltree_rank(set, &value), 49);
+    ARC_ASSERT_DOUBLE_EQ(*(double *)arc_avltree_select(set, 49), 25.5, 0.0001);
+    ARC_ASSERT_DOUBLE_EQ(*(double *)arc_avltree_select(set, 99), 100.25,
+                         0.0001);
+
+    arc_avltree_iterator_destroy(it);
+    double_set_destroy(set);
+}
+
+ARC_UNIT_TEST_FIXTURE()
+{
+    ARC_UNIT_ADD_TEST(darray)
+    ARC_UNIT_ADD_TEST(avltree)
+    ARC_UNIT_ADD_TEST(avltree_generic)
+}
+
+ARC_UNIT_RUN_TESTS()
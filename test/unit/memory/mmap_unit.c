@@ -0,0 +1,123 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <arc/memory/allocator.h>
+#include <arc/container/darray.h>
+#include <arc/test/unit.h>
+#include <arc/common/defines.h>
+
+static void check_allocator(const struct arc_allocator *allocator)
+{
+    unsigned long i, misalignment;
+    unsigned long *ptr = ARC_ALLOC(allocator, 100 * sizeof(unsigned long));
+
+    ARC_ASSERT_POINTER_NOT_NULL(ptr);
+    misalignment = (unsigned long)ptr % sizeof(double);
+    ARC_ASSERT_ULONG_EQ(misalignment, 0);
+
+    for (i = 0; i < 100; i++)
+    {
+        ptr[i] = i;
+    }
+
+    /* Growing keeps the contents, across several pages */
+    ptr = ARC_REALLOC(allocator, ptr, 1000000 * sizeof(unsigned long));
+    ARC_ASSERT_POINTER_NOT_NULL(ptr);
+
+    for (i = 100; i < 1000000; i++)
+    {
+        ptr[i] = i;
+    }
+
+    for (i = 0; i < 1000000; i++)
+    {
+        ARC_ASSERT_ULONG_EQ(ptr[i], i);
+    }
+
+    /* And so does shrinking */
+    ptr = ARC_REALLOC(allocator, ptr, 10 * sizeof(unsigned long));
+    ARC_ASSERT_POINTER_NOT_NULL(ptr);
+
+    for (i = 0; i < 10; i++)
+    {
+        ARC_ASSERT_ULONG_EQ(ptr[i], i);
+    }
+
+    ARC_FREE(allocator, ptr);
+
+    /* A NULL pointer is allocated */
+    ptr = ARC_REALLOC(allocator, NULL, sizeof(unsigned long));
+    ARC_ASSERT_POINTER_NOT_NULL(ptr);
+    ptr[0] = 1;
+    ARC_FREE(allocator, ptr);
+}
+
+ARC_UNIT_TEST(mmap_allocator)
+{
+    check_allocator(&arc_mmap_allocator);
+}
+
+ARC_UNIT_TEST(mmap_huge_allocator)
+{
+    check_allocator(&arc_mmap_huge_allocator);
+}
+
+ARC_UNIT_TEST(large_darray)
+{
+    int i;
+    arc_darray_t darray = arc_darray_create_large(sizeof(int), 0, 1);
+
+    ARC_ASSERT_POINTER_NOT_NULL(darray);
+
+    for (i = 0; i < 1000000; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_darray_push_back(darray, &i), ARC_SUCCESS);
+    }
+
+    /* Wrap the elements around the end of the block before growing */
+    for (i = 0; i < 1000; i++)
+    {
+        int value = -1 - i;
+        ARC_ASSERT_INT_EQ(arc_darray_push_front(darray, &value),
+                          ARC_SUCCESS);
+    }
+
+    for (i = 0; i < 2000000; i++)
+    {
+        int value = 1000000 + i;
+        ARC_ASSERT_INT_EQ(arc_darray_push_back(darray, &value),
+                          ARC_SUCCESS);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_darray_size(darray), 3001000);
+
+    for (i = 0; i < 3001000; i++)
+    {
+        int expected = i - 1000;
+        ARC_ASSERT_INT_EQ(*(int *)arc_darray_at(darray, (unsigned long)i),
+                          expected);
+    }
+
+    ARC_ASSERT_INT_EQ(arc_darray_shrink_to_fit(darray), ARC_SUCCESS);
+    ARC_ASSERT_INT_EQ(*(int *)arc_darray_front(darray), -1000);
+    ARC_ASSERT_INT_EQ(*(int *)arc_darray_back(darray), 2999999);
+
+    arc_darray_destroy(darray);
+}
+
+ARC_UNIT_TEST_FIXTURE()
+{
+    ARC_UNIT_ADD_TEST(mmap_allocator)
+    ARC_UNIT_ADD_TEST(mmap_huge_allocator)
+    ARC_UNIT_ADD_TEST(large_darray)
+}
+
+ARC_UNIT_RUN_TESTS()
@@ -0,0 +1,189 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <arc/memory/slab.h>
+#include <arc/test/unit.h>
+#include <arc/common/defines.h>
+
+ARC_UNIT_TEST(alloc_free)
+{
+    int i;
+    unsigned long misalignment;
+    char *objects[1000];
+    arc_slab_t slab = arc_slab_create(24);
+
+    ARC_ASSERT_POINTER_NOT_NULL(slab);
+
+    /* Objects don't overlap and are aligned to pointers */
+    for (i = 0; i < 1000; i++)
+    {
+        objects[i] = arc_slab_alloc(slab);
+        ARC_ASSERT_POINTER_NOT_NULL(objects[i]);
+        misalignment = (unsigned long)objects[i] % sizeof(void *);
+        ARC_ASSERT_ULONG_EQ(misalignment, 0);
+        memset(objects[i], i & 0xFF, 24);
+    }
+
+    for (i = 0; i < 1000; i++)
+    {
+        ARC_ASSERT_INT_EQ(objects[i][0], (char)(i & 0xFF));
+        ARC_ASSERT_INT_EQ(objects[i][23], (char)(i & 0xFF));
+    }
+
+    /* Released objects are reused first */
+    arc_slab_free(slab, objects[10]);
+    arc_slab_free(slab, objects[20]);
+
+    ARC_ASSERT_POINTER_EQ(arc_slab_alloc(slab), objects[20]);
+    ARC_ASSERT_POINTER_EQ(arc_slab_alloc(slab), objects[10]);
+
+    arc_slab_destroy(slab);
+}
+
+ARC_UNIT_TEST(allocator)
+{
+    void *ptr;
+    struct arc_allocator allocator;
+    arc_slab_t slab = arc_slab_create(1);
+
+    ARC_ASSERT_POINTER_NOT_NULL(slab);
+
+    arc_slab_get_allocator(slab, &allocator);
+
+    /* Objects are at least as big as a pointer */
+    ptr = ARC_ALLOC(&allocator, sizeof(void *));
+    ARC_ASSERT_POINTER_NOT_NULL(ptr);
+
+    ARC_ASSERT_POINTER_EQ(ARC_REALLOC(&allocator, ptr, 1), ptr);
+    ARC_ASSERT_POINTER_NULL(ARC_REALLOC(&allocator, ptr, 4096));
+    ARC_ASSERT_POINTER_NULL(ARC_ALLOC(&allocator, 4096));
+
+    ARC_FREE(&allocator, ptr);
+
+    ARC_ASSERT_POINTER_EQ(ARC_ALLOC(&allocator, 1), ptr);
+
+    arc_slab_destroy(slab);
+}
+
+ARC_UNIT_TEST(clear)
+{
+    int i, round;
+    arc_slab_t slab = arc_slab_create(sizeof(int));
+
+    ARC_ASSERT_POINTER_NOT_NULL(slab);
+
+    arc_slab_clear(slab);
+
+    for (round = 0; round < 3; round++)
+    {
+        int *first = arc_slab_alloc(slab);
+
+        ARC_ASSERT_POINTER_NOT_NULL(first);
+        *first = round;
+
+        for (i = 0; i < 5000; i++)
+        {
+            int *ptr = arc_slab_alloc(slab);
+            ARC_ASSERT_POINTER_NOT_NULL(ptr);
+            *ptr = i;
+        }
+
+        arc_slab_free(slab, first);
+        arc_slab_clear(slab);
+    }
+
+    arc_slab_destroy(slab);
+}
+
+ARC_UNIT_TEST(big_objects)
+{
+    int i;
+    arc_slab_t slab = arc_slab_create(100000);
+
+    ARC_ASSERT_POINTER_NOT_NULL(slab);
+
+    for (i = 0; i < 4; i++)
+    {
+        char *ptr = arc_slab_alloc(slab);
+        ARC_ASSERT_POINTER_NOT_NULL(ptr);
+        memset(ptr, 0, 100000);
+    }
+
+    arc_slab_destroy(slab);
+}
+
+ARC_UNIT_TEST(alloc_array)
+{
+    int i, round;
+    arc_slab_t slab = arc_slab_create(sizeof(int));
+
+    ARC_ASSERT_POINTER_NOT_NULL(slab);
+    ARC_ASSERT_TRUE(arc_slab_object_size(slab) >= sizeof(int));
+
+    /* The size in bytes would wrap around to a couple of objects */
+    ARC_ASSERT_POINTER_NULL(arc_slab_alloc_array(slab,
+                            SIZE_MAX / arc_slab_object_size(slab) + 2));
+
+    for (round = 0; round < 2; round++)
+    {
+        /* Into an empty slab, the tail of a chunk and a chunk of its own */
+        size_t sizes[3];
+        int *arrays[3];
+        int j;
+
+        sizes[0] = 10;
+        sizes[1] = 5;
+        sizes[2] = 100000;
+
+        for (j = 0; j < 3; j++)
+        {
+            size_t step = arc_slab_object_size(slab);
+            char *ptr = arc_slab_alloc_array(slab, sizes[j]);
+
+            ARC_ASSERT_POINTER_NOT_NULL(ptr);
+            arrays[j] = (void *)ptr;
+
+            for (i = 0; i < (int)sizes[j]; i++)
+            {
+                *(int *)(void *)(ptr + (size_t)i * step) = i;
+            }
+
+            /* The slab keeps serving single objects after the array */
+            ARC_ASSERT_POINTER_NOT_NULL(arc_slab_alloc(slab));
+        }
+
+        for (j = 0; j < 3; j++)
+        {
+            size_t step = arc_slab_object_size(slab);
+            char *ptr = (char *)arrays[j];
+
+            ARC_ASSERT_INT_EQ(*(int *)(void *)(ptr + (sizes[j] - 1) * step),
+                              (int)sizes[j] - 1);
+            arc_slab_free(slab, ptr + step);
+        }
+
+        arc_slab_clear(slab);
+    }
+
+    arc_slab_destroy(slab);
+}
+
+ARC_UNIT_TEST_FIXTURE()
+{
+    ARC_UNIT_ADD_TEST(alloc_free)
+    ARC_UNIT_ADD_TEST(allocator)
+    ARC_UNIT_ADD_TEST(clear)
+    ARC_UNIT_ADD_TEST(big_objects)
+    ARC_UNIT_ADD_TEST(alloc_array)
+}
+
+ARC_UNIT_RUN_TESTS()
@@ -0,0 +1,209 @@
+/*******************************************************************************
+* Copyright (C) 2015 Anil Motilal Mahtani Mirchandani(anil.mmm@gmail.com)      *
+*                                                                              *
+* License GPLv3+: GNU GPL version 3 or later <http://gnu.org/licenses/gpl.html>*
+* This is free software: you are free to change and redistribute it.           *
+* There is NO WARRANTY, to the extent permitted by law.                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <arc/thread/pool.h>
+#include <arc/test/unit.h>
+#include <arc/common/defines.h>
+
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static int counter;
+
+static void increment(void * arg)
+{
+    pthread_mutex_lock(&mutex);
+    counter += *(int *)arg;
+    pthread_mutex_unlock(&mutex);
+}
+
+static void square(void * arg)
+{
+    int * value = arg;
+
+    *value = *value * *value;
+}
+
+struct sum_task
+{
+    arc_pool_t pool;
+    const int * values;
+    int num;
+    long sum;
+};
+
+/* Divide and conquer sum, every level forks both halves */
+static void sum(void * arg)
+{
+    struct sum_task * task = arg;
+    struct sum_task left, right;
+
+    if (task->num < 4)
+    {
+        int i;
+
+        for (task->sum = 0, i = 0; i < task->num; i++)
+        {
+            task->sum += task->values[i];
+        }
+
+        return;
+    }
+
+    left = right = *task;
+    left.num = task->num / 2;
+    right.values += left.num;
+    right.num -= left.num;
+
+    arc_pool_fork_join(task->pool, &sum, &left, &sum, &right);
+
+    task->sum = left.sum + right.sum;
+}
+
+ARC_UNIT_TEST(create)
+{
+    arc_pool_t pool = arc_pool_create(3);
+
+    ARC_ASSERT_POINTER_NOT_NULL(pool);
+    ARC_ASSERT_INT_EQ((int)arc_pool_num_threads(pool), 3);
+
+    /* Waiting on an idle pool returns straight away */
+    arc_pool_wait(pool);
+    arc_pool_destroy(pool);
+
+    pool = arc_pool_create(0);
+
+    ARC_ASSERT_POINTER_NOT_NULL(pool);
+    ARC_ASSERT_TRUE(arc_pool_num_threads(pool) > 0);
+
+    arc_pool_destroy(pool);
+}
+
+ARC_UNIT_TEST(wait)
+{
+    int i;
+    int values[1000];
+    arc_pool_t pool = arc_pool_create(4);
+
+    ARC_ASSERT_POINTER_NOT_NULL(pool);
+
+    /* More tasks than the initial size of the queue */
+    for (i = 0; i < 1000; i++)
+    {
+        values[i] = i;
+        ARC_ASSERT_INT_EQ(arc_pool_submit(pool, &square, &values[i]),
+                          ARC_SUCCESS);
+    }
+
+    arc_pool_wait(pool);
+
+    for (i = 0; i < 1000; i++)
+    {
+        ARC_ASSERT_INT_EQ(values[i], i * i);
+    }
+
+    /* The pool can be reused after waiting */
+    counter = 0;
+
+    for (i = 0; i < 1000; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_pool_submit(pool, &increment, &values[i]),
+                          ARC_SUCCESS);
+    }
+
+    arc_pool_wait(pool);
+
+    ARC_ASSERT_INT_EQ(counter, 332833500);
+
+    arc_pool_destroy(pool);
+}
+
+ARC_UNIT_TEST(destroy)
+{
+    int i;
+    int one = 1;
+    arc_pool_t pool = arc_pool_create(2);
+
+    ARC_ASSERT_POINTER_NOT_NULL(pool);
+
+    counter = 0;
+
+    for (i = 0; i < 500; i++)
+    {
+        ARC_ASSERT_INT_EQ(arc_pool_submit(pool, &increment, &one),
+                          ARC_SUCCESS);
+    }
+
+    /* The queued tasks are run before the threads stop */
+    arc_pool_destroy(pool);
+
+    ARC_ASSERT_INT_EQ(counter, 500);
+}
+
+ARC_UNIT_TEST(fork_join)
+{
+    int i;
+    unsigned num_threads;
+    int values[5000];
+    struct sum_task task, tasks[8];
+
+    for (i = 0; i < 5000; i++)
+    {
+        values[i] = i;
+    }
+
+    task.values = values;
+    task.num = 5000;
+
+    /* Without a pool both halves are run by the caller */
+    task.pool = NULL;
+    sum(&task);
+    ARC_ASSERT_TRUE(task.sum == 12497500L);
+
+    for (num_threads = 1; num_threads <= 8; num_threads *= 2)
+    {
+        arc_pool_t pool = arc_pool_create(num_threads);
+
+        ARC_ASSERT_POINTER_NOT_NULL(pool);
+
+        task.pool = pool;
+        sum(&task);
+        ARC_ASSERT_TRUE(task.sum == 12497500L);
+
+        /* Forks from tasks of the same pool, all of them at once */
+        for (i = 0; i < 8; i++)
+        {
+            tasks[i] = task;
+            tasks[i].num = 5000 - i * 100;
+            ARC_ASSERT_INT_EQ(arc_pool_submit(pool, &sum, &tasks[i]),
+                              ARC_SUCCESS);
+        }
+
+        arc_pool_wait(pool);
+
+        for (i = 0; i < 8; i++)
+        {
+            long expected = (long)tasks[i].num * (tasks[i].num - 1) / 2;
+            ARC_ASSERT_TRUE(tasks[i].sum == expected);
+        }
+
+        arc_pool_destroy(pool);
+    }
+}
+
+ARC_UNIT_TEST_FIXTURE()
+{
+    ARC_UNIT_ADD_TEST(create)
+    ARC_UNIT_ADD_TEST(wait)
+    ARC_UNIT_ADD_TEST(destroy)
+    ARC_UNIT_ADD_TEST(fork_join)
+}
+
+ARC_UNIT_RUN_TESTS()